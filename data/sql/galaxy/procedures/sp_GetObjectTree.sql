@@ -0,0 +1,85 @@
+
+/*!40101 SET @OLD_CHARACTER_SET_CLIENT=@@CHARACTER_SET_CLIENT */;
+/*!40101 SET NAMES utf8 */;
+/*!40014 SET @OLD_FOREIGN_KEY_CHECKS=@@FOREIGN_KEY_CHECKS, FOREIGN_KEY_CHECKS=0 */;
+/*!40101 SET @OLD_SQL_MODE=@@SQL_MODE, SQL_MODE='NO_AUTO_VALUE_ON_ZERO' */;
+
+DROP PROCEDURE IF EXISTS `sp_GetObjectTree`;
+
+DELIMITER //
+CREATE PROCEDURE `sp_GetObjectTree`(IN `root_id` BIGINT)
+    COMMENT 'Gets an object and everything it contains, one result set per table'
+BEGIN
+    DECLARE tree_depth INT DEFAULT 0;
+    DECLARE added INT DEFAULT 1;
+
+    DROP TEMPORARY TABLE IF EXISTS object_tree, object_tree_level;
+    CREATE TEMPORARY TABLE object_tree (id BIGINT PRIMARY KEY, depth INT NOT NULL) ENGINE=MEMORY;
+    CREATE TEMPORARY TABLE object_tree_level (id BIGINT PRIMARY KEY) ENGINE=MEMORY;
+
+    INSERT INTO object_tree VALUES (root_id, 0);
+    INSERT INTO object_tree_level VALUES (root_id);
+
+    -- A temporary table can't be opened twice in one query, so each level's
+    -- ids are copied aside before looking up their contents.
+    WHILE added > 0 DO
+        SET tree_depth = tree_depth + 1;
+
+        INSERT IGNORE INTO object_tree (id, depth)
+            SELECT object.id, tree_depth FROM object
+            INNER JOIN object_tree_level ON (object.parent_id = object_tree_level.id);
+        SET added = ROW_COUNT();
+
+        DELETE FROM object_tree_level;
+        INSERT INTO object_tree_level SELECT id FROM object_tree WHERE depth = tree_depth;
+    END WHILE;
+
+    -- Containers come before their contents.
+    SELECT object.*, iff_templates.iff_template
+    FROM object_tree
+    INNER JOIN object ON (object.id = object_tree.id)
+    LEFT JOIN iff_templates ON (object.iff_template_id = iff_templates.id)
+    ORDER BY object_tree.depth, object.id;
+
+    SELECT t.id, t.customization, t.options_bitmask, t.incap_timer,
+        t.condition_damage, t.max_condition, t.is_static
+    FROM object_tree
+    INNER JOIN tangible t ON (t.id = object_tree.id);
+
+    SELECT i.id, i.stf_detail_file, i.stf_detail_string
+    FROM object_tree
+    INNER JOIN intangible i ON (i.id = object_tree.id);
+
+    SELECT
+        creature.*,
+        mood.name as mood_animation,
+        iff_templates.iff_template as disguise_template
+    FROM object_tree
+    INNER JOIN creature ON (creature.id = object_tree.id)
+    LEFT JOIN iff_templates ON (creature.disguise_template_id = iff_templates.id)
+    LEFT JOIN mood ON (creature.mood_id = mood.id);
+
+    SELECT creatures_skills.creature_id, skill.name
+    FROM object_tree
+    INNER JOIN creatures_skills ON (creatures_skills.creature_id = object_tree.id)
+    INNER JOIN skill ON (skill.id = creatures_skills.skill_id);
+
+    SELECT creatures_skills.creature_id, skill_mod.name, skills_skill_mods.value
+    FROM object_tree
+    INNER JOIN creatures_skills ON (creatures_skills.creature_id = object_tree.id)
+    INNER JOIN skills_skill_mods ON (skills_skill_mods.skill_id = creatures_skills.skill_id)
+    INNER JOIN skill_mod ON (skill_mod.id = skills_skill_mods.skill_mod_id);
+
+    SELECT creatures_skills.creature_id, skill_command.id, skill_command.name
+    FROM object_tree
+    INNER JOIN creatures_skills ON (creatures_skills.creature_id = object_tree.id)
+    INNER JOIN skills_skill_commands ON (skills_skill_commands.skill_id = creatures_skills.skill_id)
+    INNER JOIN skill_command ON (skill_command.id = skills_skill_commands.skill_command_id);
+
+    DROP TEMPORARY TABLE object_tree, object_tree_level;
+END//
+DELIMITER ;
+
+/*!40101 SET SQL_MODE=@OLD_SQL_MODE */;
+/*!40014 SET FOREIGN_KEY_CHECKS=@OLD_FOREIGN_KEY_CHECKS */;
+/*!40101 SET CHARACTER_SET_CLIENT=@OLD_CHARACTER_SET_CLIENT */;
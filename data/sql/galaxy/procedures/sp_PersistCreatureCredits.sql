@@ -0,0 +1,22 @@
+
+/*!40101 SET @OLD_CHARACTER_SET_CLIENT=@@CHARACTER_SET_CLIENT */;
+/*!40101 SET NAMES utf8 */;
+/*!40014 SET @OLD_FOREIGN_KEY_CHECKS=@@FOREIGN_KEY_CHECKS, FOREIGN_KEY_CHECKS=0 */;
+/*!40101 SET @OLD_SQL_MODE=@@SQL_MODE, SQL_MODE='NO_AUTO_VALUE_ON_ZERO' */;
+
+DROP PROCEDURE IF EXISTS `sp_PersistCreatureCredits`;
+
+DELIMITER //
+CREATE PROCEDURE `sp_PersistCreatureCredits`(
+    IN `object_id` BIGINT, 
+    IN `in_bank_credits` BIGINT, 
+    IN `in_cash_credits` BIGINT)
+BEGIN
+    update creature set bank_credits = in_bank_credits, cash_credits = in_cash_credits
+    where creature.id = object_id;
+END//
+DELIMITER ;
+
+/*!40101 SET SQL_MODE=@OLD_SQL_MODE */;
+/*!40014 SET FOREIGN_KEY_CHECKS=@OLD_FOREIGN_KEY_CHECKS */;
+/*!40101 SET CHARACTER_SET_CLIENT=@OLD_CHARACTER_SET_CLIENT */;
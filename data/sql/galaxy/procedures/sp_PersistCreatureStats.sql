@@ -0,0 +1,59 @@
+
+/*!40101 SET @OLD_CHARACTER_SET_CLIENT=@@CHARACTER_SET_CLIENT */;
+/*!40101 SET NAMES utf8 */;
+/*!40014 SET @OLD_FOREIGN_KEY_CHECKS=@@FOREIGN_KEY_CHECKS, FOREIGN_KEY_CHECKS=0 */;
+/*!40101 SET @OLD_SQL_MODE=@@SQL_MODE, SQL_MODE='NO_AUTO_VALUE_ON_ZERO' */;
+
+DROP PROCEDURE IF EXISTS `sp_PersistCreatureStats`;
+
+DELIMITER //
+CREATE PROCEDURE `sp_PersistCreatureStats`(
+    IN `object_id` BIGINT, 
+    IN `in_health_wounds` INT, 
+    IN `in_strength_wounds` INT, 
+    IN `in_constitution_wounds` INT, 
+    IN `in_action_wounds` INT, 
+    IN `in_quickness_wounds` INT, 
+    IN `in_stamina_wounds` INT, 
+    IN `in_mind_wounds` INT, 
+    IN `in_focus_wounds` INT, 
+    IN `in_willpower_wounds` INT, 
+    IN `in_health_encumberance` INT, 
+    IN `in_strength_encumberance` INT, 
+    IN `in_constitution_encumberance` INT, 
+    IN `in_action_encumberance` INT, 
+    IN `in_quickness_encumberance` INT, 
+    IN `in_stamina_encumberance` INT, 
+    IN `in_mind_encumberance` INT, 
+    IN `in_focus_encumberance` INT, 
+    IN `in_willpower_encumberance` INT, 
+    IN `in_current_health` INT, 
+    IN `in_current_strength` INT, 
+    IN `in_current_constitution` INT, 
+    IN `in_current_action` INT, 
+    IN `in_current_quickness` INT, 
+    IN `in_current_stamina` INT, 
+    IN `in_current_mind` INT, 
+    IN `in_current_focus` INT, 
+    IN `in_current_willpower` INT, 
+    IN `in_max_health` INT, 
+    IN `in_max_strength` INT, 
+    IN `in_max_constitution` INT, 
+    IN `in_max_action` INT, 
+    IN `in_max_quickness` INT, 
+    IN `in_max_stamina` INT, 
+    IN `in_max_mind` INT, 
+    IN `in_max_focus` INT, 
+    IN `in_max_willpower` INT)
+BEGIN
+    update creature set health_wounds = in_health_wounds, strength_wounds = in_strength_wounds, constitution_wounds = in_constitution_wounds, action_wounds = in_action_wounds, quickness_wounds = in_quickness_wounds, stamina_wounds = in_stamina_wounds, mind_wounds = in_mind_wounds, focus_wounds = in_focus_wounds, willpower_wounds = in_willpower_wounds,
+        health_encumberance = in_health_encumberance, strength_encumberance = in_strength_encumberance, constitution_encumberance = in_constitution_encumberance, action_encumberance = in_action_encumberance, quickness_encumberance = in_quickness_encumberance, stamina_encumberance = in_stamina_encumberance, mind_encumberance = in_mind_encumberance, focus_encumberance = in_focus_encumberance, willpower_encumberance = in_willpower_encumberance,
+        current_health = in_current_health, current_strength = in_current_strength, current_constitution = in_current_constitution, current_action = in_current_action, current_quickness = in_current_quickness, current_stamina = in_current_stamina, current_mind = in_current_mind, current_focus = in_current_focus, current_willpower = in_current_willpower,
+        max_health = in_max_health, max_strength = in_max_strength, max_constitution = in_max_constitution, max_action = in_max_action, max_quickness = in_max_quickness, max_stamina = in_max_stamina, max_mind = in_max_mind, max_focus = in_max_focus, max_willpower = in_max_willpower
+    where creature.id = object_id;
+END//
+DELIMITER ;
+
+/*!40101 SET SQL_MODE=@OLD_SQL_MODE */;
+/*!40014 SET FOREIGN_KEY_CHECKS=@OLD_FOREIGN_KEY_CHECKS */;
+/*!40101 SET CHARACTER_SET_CLIENT=@OLD_CHARACTER_SET_CLIENT */;
@@ -0,0 +1,137 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#include "anh/byte_buffer.h"
+#include "anh/event_dispatcher.h"
+#include "swganh/object/creature/creature.h"
+#include "swganh/object/creature/creature_message_builder.h"
+
+using namespace std;
+using swganh::object::Object;
+using swganh::object::creature::Creature;
+using swganh::object::creature::CreatureMessageBuilder;
+
+namespace {
+
+struct EnterResult
+{
+    double seconds;
+    uint64_t sends;
+    uint64_t bytes;
+    uint64_t hits;
+    uint64_t misses;
+};
+
+/**
+ * Players enter the scene one at a time. Each one is sent the baselines of
+ * every player already there, and each of those is sent the newcomer's.
+ */
+EnterResult EnterScene(const vector<shared_ptr<Creature>>& players, bool rebuild_every_time)
+{
+    EnterResult result;
+    result.sends = 0;
+    result.bytes = 0;
+
+    uint64_t hits_before = Object::GetBaselinesCacheHits();
+    uint64_t misses_before = Object::GetBaselinesCacheMisses();
+
+    auto send_baselines = [&result, rebuild_every_time] (const shared_ptr<Creature>& player) {
+        if (rebuild_every_time)
+        {
+            player->InvalidateBaselines();
+        }
+
+        for (auto& baseline : *CreatureMessageBuilder::GetBaselines(player))
+        {
+            result.bytes += baseline->size();
+        }
+
+        ++result.sends;
+    };
+
+    auto start = chrono::high_resolution_clock::now();
+
+    for (size_t entering = 0; entering < players.size(); ++entering)
+    {
+        for (size_t present = 0; present < entering; ++present)
+        {
+            send_baselines(players[present]);
+            send_baselines(players[entering]);
+        }
+
+        // A change after entering means the newcomer's next send rebuilds its baselines.
+        players[entering]->SetPosture(entering % 2 ? swganh::object::creature::UPRIGHT : swganh::object::creature::CROUCHED);
+    }
+
+    result.seconds = chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+    result.hits = Object::GetBaselinesCacheHits() - hits_before;
+    result.misses = Object::GetBaselinesCacheMisses() - misses_before;
+
+    return result;
+}
+
+}  // namespace
+
+/**
+ * Measures sending creature baselines to a crowd of players entering a scene,
+ * comparing rebuilding them for every observer with the baselines snapshot cache.
+ */
+int main(int argc, char *argv[])
+{
+    uint32_t player_count = argc > 1 ? atoi(argv[1]) : 500;
+
+    boost::asio::io_service io_service;
+    anh::EventDispatcher event_dispatcher(io_service);
+
+    vector<shared_ptr<Creature>> players;
+    players.reserve(player_count);
+
+    for (uint32_t i = 0; i < player_count; ++i)
+    {
+        auto player = make_shared<Creature>();
+        player->SetEventDispatcher(&event_dispatcher);
+        player->SetObjectId(8589934593 + i);
+        player->SetCustomName(L"Player " + to_wstring(i));
+        player->SetTemplate("object/creature/player/shared_human_male.iff");
+        players.push_back(player);
+    }
+
+    cout << "Baseline benchmark: " << player_count << " players entering a scene\n\n";
+
+    cout << setw(22) << "method"
+         << setw(12) << "seconds"
+         << setw(14) << "sends/s"
+         << setw(12) << "hits"
+         << setw(12) << "misses" << "\n";
+
+    auto print_row = [] (const char* name, const EnterResult& result) {
+        cout << setw(22) << name
+             << setw(12) << fixed << setprecision(3) << result.seconds
+             << setw(14) << setprecision(0) << (result.sends / result.seconds)
+             << setw(12) << result.hits
+             << setw(12) << result.misses << "\n";
+    };
+
+    auto rebuilt = EnterScene(players, true);
+    auto cached = EnterScene(players, false);
+
+    print_row("rebuild per observer", rebuilt);
+    print_row("snapshot cache", cached);
+
+    if (rebuilt.bytes != cached.bytes)
+    {
+        cout << "Sent " << cached.bytes << " bytes, expected " << rebuilt.bytes << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,216 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#include <glm/glm.hpp>
+
+#ifdef WIN32
+#include <concurrent_queue.h>
+#else
+#include <tbb/concurrent_queue.h>
+
+namespace Concurrency {
+    using ::tbb::concurrent_queue;
+}
+
+#endif
+
+#include "anh/byte_buffer.h"
+#include "anh/event_dispatcher.h"
+#include "anh/observer/observer_interface.h"
+#include "swganh/messages/update_transform_message.h"
+#include "swganh/object/object.h"
+
+using namespace std;
+using swganh::messages::UpdateTransformMessage;
+using swganh::object::Object;
+
+namespace {
+
+/// Every heap allocation made by the process, counted by the operator new below.
+atomic<uint64_t> heap_allocations(0);
+
+}  // namespace
+
+void* operator new(size_t size)
+{
+    ++heap_allocations;
+
+    void* memory = malloc(size ? size : 1);
+    if (!memory)
+    {
+        throw bad_alloc();
+    }
+
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    free(memory);
+}
+
+namespace {
+
+/**
+ * Stands in for a player's controller, queueing messages the way a session does.
+ */
+class SessionObserver : public anh::observer::ObserverInterface
+{
+public:
+    explicit SessionObserver(uint64_t id)
+        : id_(id)
+    {}
+
+    uint64_t GetId() const { return id_; }
+
+    void Notify(const anh::ByteBuffer& message)
+    {
+        outgoing_messages_.push(make_shared<anh::ByteBuffer>(message));
+    }
+
+    void Notify(const shared_ptr<const anh::ByteBuffer>& message)
+    {
+        outgoing_messages_.push(message);
+    }
+
+    /// Empties the queue as a session update would, returning the bytes it held.
+    size_t Drain()
+    {
+        size_t bytes = 0;
+        shared_ptr<const anh::ByteBuffer> message;
+
+        while (outgoing_messages_.try_pop(message))
+        {
+            bytes += message->size();
+        }
+
+        return bytes;
+    }
+
+private:
+    uint64_t id_;
+    Concurrency::concurrent_queue<shared_ptr<const anh::ByteBuffer>> outgoing_messages_;
+};
+
+struct BroadcastResult
+{
+    double seconds;
+    uint64_t allocations;
+    uint64_t bytes;
+};
+
+template<typename Broadcast>
+BroadcastResult TimeBroadcasts(vector<shared_ptr<SessionObserver>>& observers, uint32_t broadcast_count, Broadcast broadcast)
+{
+    UpdateTransformMessage message;
+    message.object_id = 1;
+    message.position = glm::vec3(3200.0f, 12.0f, -4800.0f);
+    message.posture_id = 0;
+    message.heading = 64;
+
+    BroadcastResult result;
+    result.bytes = 0;
+
+    uint64_t allocations_before = heap_allocations;
+    auto start = chrono::high_resolution_clock::now();
+
+    for (uint32_t i = 0; i < broadcast_count; ++i)
+    {
+        message.update_counter = i;
+        broadcast(message);
+
+        for (auto& observer : observers)
+        {
+            result.bytes += observer->Drain();
+        }
+    }
+
+    result.seconds = chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+    result.allocations = heap_allocations - allocations_before;
+
+    return result;
+}
+
+}  // namespace
+
+/**
+ * Broadcasts an UpdateTransformMessage from one object to a crowd of observers,
+ * comparing serializing it for every observer with serializing it once.
+ */
+int main(int argc, char *argv[])
+{
+    uint32_t observer_count = argc > 1 ? atoi(argv[1]) : 200;
+    uint32_t broadcast_count = argc > 2 ? atoi(argv[2]) : 20000;
+
+    boost::asio::io_service io_service;
+    anh::EventDispatcher event_dispatcher(io_service);
+
+    auto object = make_shared<Object>();
+    object->SetEventDispatcher(&event_dispatcher);
+    object->SetObjectId(1);
+
+    vector<shared_ptr<SessionObserver>> observers;
+    observers.reserve(observer_count);
+
+    for (uint32_t i = 0; i < observer_count; ++i)
+    {
+        observers.push_back(make_shared<SessionObserver>(i + 2));
+        object->Subscribe(observers.back());
+    }
+
+    cout << "Broadcast benchmark: UpdateTransformMessage to " << observer_count
+         << " observers, " << broadcast_count << " broadcasts per run\n\n";
+
+    cout << setw(20) << "method"
+         << setw(16) << "broadcasts/s"
+         << setw(16) << "ns/observer"
+         << setw(18) << "allocs/broadcast" << "\n";
+
+    auto print_row = [observer_count, broadcast_count] (const char* name, const BroadcastResult& result) {
+        cout << setw(20) << name
+             << setw(16) << fixed << setprecision(0) << (broadcast_count / result.seconds)
+             << setw(16) << setprecision(1) << (result.seconds * 1e9 / broadcast_count / observer_count)
+             << setw(18) << setprecision(1) << (double(result.allocations) / broadcast_count) << "\n";
+    };
+
+    // What every broadcast cost before, a copy and a serialization per observer.
+    auto per_observer = TimeBroadcasts(observers, broadcast_count, [&observers] (const UpdateTransformMessage& message) {
+        for (auto& observer : observers)
+        {
+            anh::ByteBuffer buffer;
+            observer->Serialize(message, buffer);
+            observer->Notify(buffer);
+        }
+    });
+
+    auto serialize_once = TimeBroadcasts(observers, broadcast_count, [&object] (const UpdateTransformMessage& message) {
+        object->NotifyObservers(message);
+    });
+
+    print_row("per observer", per_observer);
+    print_row("serialize once", serialize_once);
+
+    if (per_observer.bytes != serialize_once.bytes)
+    {
+        cout << "Delivered " << serialize_once.bytes << " bytes, expected " << per_observer.bytes << "\n";
+        return 1;
+    }
+
+    return 0;
+}
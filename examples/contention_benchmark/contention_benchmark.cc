@@ -0,0 +1,170 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtx/quaternion.hpp>
+
+#include "anh/event_dispatcher.h"
+#include "swganh/object/object.h"
+
+using namespace std;
+using swganh::object::Object;
+
+namespace {
+
+/**
+ * Object state the way it was guarded before, one mutex for every field.
+ */
+class LockedObject
+{
+public:
+    LockedObject()
+        : template_string_("object/creature/player/shared_human_male.iff")
+    {}
+
+    void SetPosition(glm::vec3 position)
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        position_ = position;
+    }
+
+    glm::vec3 GetPosition()
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        return position_;
+    }
+
+    glm::quat GetOrientation()
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        return orientation_;
+    }
+
+    string GetTemplate()
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        return template_string_;
+    }
+
+private:
+    boost::mutex mutex_;
+    string template_string_;
+    glm::vec3 position_;
+    glm::quat orientation_;
+};
+
+/**
+ * Each update moves one object and then reads the transform of a handful of
+ * others, the way a movement handler and the range checks it triggers do.
+ */
+template<typename T>
+double UpdatesPerSecond(vector<shared_ptr<T>>& objects, uint32_t thread_count, uint32_t update_count, uint32_t queries_per_update)
+{
+    boost::asio::io_service io_service;
+    atomic<uint64_t> in_range(0);
+
+    uint32_t object_count = static_cast<uint32_t>(objects.size());
+
+    for (uint32_t i = 0; i < update_count; ++i)
+    {
+        io_service.post([&, i] {
+            auto& object = objects[i % object_count];
+            glm::vec3 position(float(i % 4096), 0.0f, float((i * 7) % 4096));
+            object->SetPosition(position);
+
+            uint32_t found = 0;
+            for (uint32_t j = 1; j <= queries_per_update; ++j)
+            {
+                auto& other = objects[(i + j * 31) % object_count];
+                if (glm::distance(other->GetPosition(), position) < 128.0f)
+                {
+                    ++found;
+                }
+
+                found += other->GetOrientation().w > 2.0f;
+                found += other->GetTemplate().empty();
+            }
+
+            in_range += found;
+        });
+    }
+
+    auto start = chrono::high_resolution_clock::now();
+
+    vector<thread> threads;
+    for (uint32_t i = 0; i < thread_count; ++i)
+    {
+        threads.emplace_back([&io_service] { io_service.run(); });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    double seconds = chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+    return update_count / seconds;
+}
+
+}  // namespace
+
+/**
+ * Moves and queries a shared set of objects from a growing number of io
+ * threads, comparing a single mutex per object with the lock-free transform.
+ */
+int main(int argc, char *argv[])
+{
+    uint32_t object_count = argc > 1 ? atoi(argv[1]) : 64;
+    uint32_t update_count = argc > 2 ? atoi(argv[2]) : 400000;
+    uint32_t queries_per_update = argc > 3 ? atoi(argv[3]) : 16;
+    uint32_t max_threads = max(4u, thread::hardware_concurrency());
+
+    boost::asio::io_service dispatcher_service;
+    anh::EventDispatcher event_dispatcher(dispatcher_service);
+
+    vector<shared_ptr<Object>> objects;
+    vector<shared_ptr<LockedObject>> locked_objects;
+
+    for (uint32_t i = 0; i < object_count; ++i)
+    {
+        auto object = make_shared<Object>();
+        object->SetEventDispatcher(&event_dispatcher);
+        object->SetObjectId(i + 1);
+        object->SetTemplate("object/creature/player/shared_human_male.iff");
+        objects.push_back(object);
+
+        locked_objects.push_back(make_shared<LockedObject>());
+    }
+
+    cout << "Contention benchmark: " << object_count << " objects, " << update_count
+         << " updates reading " << queries_per_update << " other objects each\n\n";
+
+    cout << setw(10) << "threads"
+         << setw(20) << "mutex updates/s"
+         << setw(20) << "seqlock updates/s" << "\n";
+
+    for (uint32_t thread_count = 1; thread_count <= max_threads; thread_count *= 2)
+    {
+        double locked = UpdatesPerSecond(locked_objects, thread_count, update_count, queries_per_update);
+        double lock_free = UpdatesPerSecond(objects, thread_count, update_count, queries_per_update);
+
+        cout << setw(10) << thread_count
+             << setw(20) << fixed << setprecision(0) << locked
+             << setw(20) << lock_free << "\n";
+    }
+
+    return 0;
+}
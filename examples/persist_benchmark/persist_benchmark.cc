@@ -0,0 +1,133 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <boost/asio.hpp>
+
+#include <mysql_driver.h>
+
+#include "anh/event_dispatcher.h"
+#include "anh/database/database_manager.h"
+#include "swganh/object/creature/creature.h"
+#include "swganh/object/creature/creature_factory.h"
+
+using namespace std;
+using anh::database::DatabaseManager;
+using anh::database::PoolMetrics;
+using anh::database::PoolOptions;
+using swganh::object::Object;
+using swganh::object::creature::Creature;
+using swganh::object::creature::CreatureFactory;
+
+namespace {
+
+struct DatabaseArgs
+{
+    string host;
+    string username;
+    string password;
+    string schema;
+};
+
+struct PersistResult
+{
+    double persists_per_second;
+    PoolMetrics metrics;
+};
+
+/**
+ * Persists the same creature over and over, each persist calls both
+ * sp_PersistTangible and the 65 parameter sp_PersistCreature. The creature is
+ * marked as changed every time, as a clean creature would not be written.
+ */
+PersistResult PersistCreatures(const DatabaseArgs& args, uint32_t statement_cache_size, uint32_t persist_count, uint64_t object_id)
+{
+    boost::asio::io_service io_service;
+    anh::EventDispatcher event_dispatcher(io_service);
+
+    PoolOptions pool_options;
+    pool_options.statement_cache_size = statement_cache_size;
+
+    DatabaseManager db_manager(sql::mysql::get_driver_instance());
+    db_manager.registerStorageType("galaxy", args.schema, args.host, args.username, args.password, pool_options);
+
+    CreatureFactory factory(&db_manager, nullptr, &event_dispatcher);
+
+    auto creature = make_shared<Creature>();
+    creature->SetEventDispatcher(&event_dispatcher);
+    creature->SetObjectId(object_id);
+    creature->SetTemplate("object/creature/player/shared_human_male.iff");
+
+    auto start = chrono::high_resolution_clock::now();
+
+    for (uint32_t i = 0; i < persist_count; ++i)
+    {
+        creature->MarkPersistDirty(Object::PERSIST_ALL);
+        factory.PersistObject(creature);
+    }
+
+    chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+
+    PersistResult result;
+    result.persists_per_second = persist_count / elapsed.count();
+    result.metrics = db_manager.getPoolMetrics("galaxy");
+
+    return result;
+}
+
+}  // namespace
+
+/**
+ * Measures creature persist throughput against a galaxy database, with
+ * statements prepared on every call and with the per connection statement
+ * cache.
+ *
+ * The default object id matches no row, so the persist procedures run
+ * without changing any data.
+ *
+ * usage: example_persist_benchmark host username password [schema] [persists] [object_id]
+ */
+int main(int argc, char *argv[])
+{
+    if (argc < 4)
+    {
+        cout << "usage: " << argv[0] << " host username password [schema] [persists] [object_id]\n";
+        return 1;
+    }
+
+    DatabaseArgs args;
+    args.host = argv[1];
+    args.username = argv[2];
+    args.password = argv[3];
+    args.schema = argc > 4 ? argv[4] : "galaxy";
+
+    uint32_t persist_count = argc > 5 ? atoi(argv[5]) : 2000;
+    uint64_t object_id = argc > 6 ? strtoull(argv[6], nullptr, 10) : 0;
+
+    cout << "Persist benchmark: " << persist_count << " creature persists on " << args.schema << "@" << args.host << "\n\n";
+
+    cout << setw(12) << "cache"
+         << setw(16) << "persists/s"
+         << setw(12) << "prepared"
+         << setw(12) << "reused" << "\n";
+
+    const uint32_t cache_sizes[] = {0, PoolOptions().statement_cache_size};
+
+    for (uint32_t cache_size : cache_sizes)
+    {
+        PersistResult result = PersistCreatures(args, cache_size, persist_count, object_id);
+
+        cout << setw(12) << (cache_size ? "on" : "off")
+             << setw(16) << fixed << setprecision(0) << result.persists_per_second
+             << setw(12) << result.metrics.statements_prepared
+             << setw(12) << result.metrics.statements_reused << "\n";
+    }
+
+    return 0;
+}
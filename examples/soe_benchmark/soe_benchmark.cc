@@ -0,0 +1,998 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+#include <boost/asio.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "anh/byte_buffer.h"
+#include "anh/crc.h"
+#include "anh/utilities.h"
+#include "anh/network/soe/packet_buffer.h"
+#include "anh/network/soe/packet_utilities.h"
+#include "anh/network/soe/protocol_packets.h"
+#include "anh/network/soe/server.h"
+#include "anh/network/soe/session.h"
+#include "anh/network/soe/session_table.h"
+#include "anh/network/soe/filters/compression_filter.h"
+
+using namespace anh;
+using namespace anh::network::soe;
+using namespace std;
+
+using boost::asio::ip::udp;
+
+namespace {
+
+/// Every heap allocation made by the process, counted by the operator new below.
+atomic<uint64_t> heap_allocations(0);
+
+/// Checksums from the crc benchmark are stored here so the calls can't be optimized away.
+volatile uint32_t crc_sink = 0;
+
+}  // namespace
+
+void* operator new(size_t size)
+{
+    ++heap_allocations;
+
+    void* memory = malloc(size ? size : 1);
+    if (!memory)
+    {
+        throw bad_alloc();
+    }
+
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    free(memory);
+}
+
+namespace {
+
+/**
+ * Minimal SOE server that keeps sessions in a map and ignores game messages.
+ */
+class BenchmarkServer : public Server
+{
+public:
+    explicit BenchmarkServer(boost::asio::io_service& io_service)
+        : Server(io_service)
+        , io_service_(io_service)
+    {}
+
+    void HandleMessage(const shared_ptr<Session>& connection, ByteBuffer message) {}
+
+    bool RemoveSession(shared_ptr<Session> session)
+    {
+        boost::lock_guard<boost::mutex> lg(session_map_mutex_);
+        session_map_.erase(session->remote_endpoint());
+        return true;
+    }
+
+    shared_ptr<Session> CreateSession(const udp::endpoint& endpoint)
+    {
+        auto session = make_shared<Session>(this, io_service_, endpoint);
+        session_map_.insert(make_pair(endpoint, session));
+        return session;
+    }
+
+    shared_ptr<Session> GetSession(const udp::endpoint& endpoint)
+    {
+        boost::lock_guard<boost::mutex> lg(session_map_mutex_);
+
+        auto find_iter = session_map_.find(endpoint);
+        if (find_iter != session_map_.end())
+        {
+            return find_iter->second;
+        }
+
+        return CreateSession(endpoint);
+    }
+
+    void CloseSessions()
+    {
+        vector<shared_ptr<Session>> sessions;
+
+        {
+            boost::lock_guard<boost::mutex> lg(session_map_mutex_);
+            for (auto& item : session_map_)
+            {
+                sessions.push_back(item.second);
+            }
+        }
+
+        for (auto& session : sessions)
+        {
+            session->Close();
+        }
+    }
+
+private:
+    boost::asio::io_service& io_service_;
+    boost::mutex session_map_mutex_;
+    map<udp::endpoint, shared_ptr<Session>> session_map_;
+};
+
+struct UdpResult
+{
+    double seconds;
+    uint64_t pongs_received;
+    ServerStatistics stats;
+
+    /// Heap allocations made by the whole process while the clients ran.
+    uint64_t heap_allocations;
+    PacketBufferPoolStatistics pool_stats;
+};
+
+/**
+ * Builds an encrypted, crc-footed ping as a connected client would send it.
+ */
+ByteBuffer BuildClientPing(uint32_t crc_seed)
+{
+    ByteBuffer ping;
+    ping.write<uint16_t>(hostToBig<uint16_t>(PING));
+
+    // Uncompressed flag, "encrypted" with the low byte of the seed.
+    ping.write<uint8_t>(static_cast<uint8_t>(crc_seed));
+
+    uint32_t crc = memcrc(ping.data(), ping.size(), crc_seed);
+    ping.write<uint8_t>(static_cast<uint8_t>(crc >> 8));
+    ping.write<uint8_t>(static_cast<uint8_t>(crc));
+
+    return ping;
+}
+
+/**
+ * Each client opens a session and then keeps a window of pings in flight against
+ * the server, every ping produces one inbound and one outbound datagram.
+ */
+void RunUdpClient(uint16_t port, uint32_t connection_id, uint32_t pings, uint32_t window, atomic<uint64_t>& pongs)
+{
+    boost::asio::io_service io_service;
+    udp::socket socket(io_service, udp::endpoint(udp::v4(), 0));
+    socket.connect(udp::endpoint(boost::asio::ip::address_v4::loopback(), port));
+
+    // asio's synchronous receive ignores SO_RCVTIMEO, use the native socket so that a
+    // lost datagram turns into a timeout instead of a hang.
+#ifdef _WIN32
+    DWORD timeout = 20;
+#else
+    struct timeval timeout = {0, 20000};
+#endif
+    setsockopt(socket.native_handle(), SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+
+    std::array<char, 496> recv_buffer;
+
+    ByteBuffer request;
+    SessionRequest(2, connection_id, 496).serialize(request);
+
+    int length = -1;
+    for (int attempt = 0; attempt < 10 && length < 10; ++attempt)
+    {
+        socket.send(boost::asio::buffer(request.data(), request.size()));
+        length = static_cast<int>(recv(socket.native_handle(), recv_buffer.data(), recv_buffer.size(), 0));
+    }
+
+    if (length < 10)
+    {
+        cerr << "client " << connection_id << " failed to establish a session" << endl;
+        return;
+    }
+
+    ByteBuffer response_buffer(reinterpret_cast<unsigned char*>(recv_buffer.data()), length);
+    SessionResponse response(response_buffer);
+
+    ByteBuffer ping = BuildClientPing(response.crc_seed);
+
+    uint32_t sent = 0, received = 0;
+    while (received < pings)
+    {
+        while (sent < pings && sent - received < window)
+        {
+            socket.send(boost::asio::buffer(ping.data(), ping.size()));
+            ++sent;
+        }
+
+        // A timeout is treated as a lost datagram and the window is refilled.
+        if (recv(socket.native_handle(), recv_buffer.data(), recv_buffer.size(), 0) > 0)
+        {
+            ++pongs;
+        }
+
+        ++received;
+    }
+}
+
+UdpResult RunUdp(bool batched, uint32_t shards, uint32_t clients, uint32_t pings, uint32_t window, uint32_t threads)
+{
+    boost::asio::io_service io_service;
+    unique_ptr<boost::asio::io_service::work> work(new boost::asio::io_service::work(io_service));
+
+    BenchmarkServer server(io_service);
+    server.batched_io(batched);
+    server.socket_shards(shards);
+    server.Start(0);
+
+    uint16_t port = server.socket()->local_endpoint().port();
+
+    vector<boost::thread> io_threads;
+    for (uint32_t i = 0; i < threads; ++i)
+    {
+        io_threads.push_back(boost::thread([&io_service] () { io_service.run(); }));
+    }
+
+    atomic<uint64_t> pongs(0);
+    uint64_t allocations_before = heap_allocations;
+    auto start = chrono::high_resolution_clock::now();
+
+    vector<boost::thread> client_threads;
+    for (uint32_t i = 0; i < clients; ++i)
+    {
+        client_threads.push_back(boost::thread([=, &pongs] () {
+            RunUdpClient(port, i + 1, pings, window, pongs);
+        }));
+    }
+
+    for_each(client_threads.begin(), client_threads.end(), mem_fn(&boost::thread::join));
+
+    UdpResult result;
+    result.seconds = chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+    result.pongs_received = pongs;
+    result.stats = server.statistics();
+    result.heap_allocations = heap_allocations - allocations_before;
+    result.pool_stats = server.packet_pool()->statistics();
+
+    server.CloseSessions();
+    server.Shutdown();
+
+    work.reset();
+    io_service.stop();
+    for_each(io_threads.begin(), io_threads.end(), mem_fn(&boost::thread::join));
+
+    return result;
+}
+
+void PrintUdpResult(const string& name, const UdpResult& result)
+{
+    uint64_t packets = result.stats.packets_received + result.stats.packets_sent;
+    uint64_t syscalls = result.stats.receive_calls + result.stats.send_calls;
+
+    cout << setw(10) << name
+         << setw(14) << fixed << setprecision(0) << (packets / result.seconds)
+         << setw(14) << setprecision(3) << (packets ? double(syscalls) / packets : 0.0)
+         << setw(12) << result.stats.packets_received
+         << setw(12) << result.stats.packets_sent
+         << setw(12) << result.pongs_received
+         << setw(12) << setprecision(3) << (packets ? double(result.heap_allocations) / packets : 0.0)
+         << setw(12) << result.pool_stats.heap_allocations << "\n";
+}
+
+int BenchmarkUdp(const vector<string>& args)
+{
+    uint32_t clients = args.size() > 0 ? atoi(args[0].c_str()) : 64;
+    uint32_t pings = args.size() > 1 ? atoi(args[1].c_str()) : 5000;
+    uint32_t window = args.size() > 2 ? atoi(args[2].c_str()) : 32;
+    uint32_t shards = args.size() > 3 ? atoi(args[3].c_str()) : boost::thread::hardware_concurrency();
+    uint32_t threads = max<uint32_t>(1, boost::thread::hardware_concurrency() - 1);
+
+    cout << "Loopback ping benchmark: " << clients << " clients x " << pings
+         << " pings, window " << window << ", " << threads << " io threads\n\n";
+
+    cout << setw(10) << "mode"
+         << setw(14) << "packets/sec"
+         << setw(14) << "syscalls/pkt"
+         << setw(12) << "received"
+         << setw(12) << "sent"
+         << setw(12) << "pongs"
+         << setw(12) << "allocs/pkt"
+         << setw(12) << "pool blocks" << "\n";
+
+    PrintUdpResult("standard", RunUdp(false, 1, clients, pings, window, threads));
+    PrintUdpResult("batched", RunUdp(true, 1, clients, pings, window, threads));
+
+    if (shards > 1)
+    {
+        cout << "\nWith " << shards << " SO_REUSEPORT shards:\n";
+
+        PrintUdpResult("standard", RunUdp(false, shards, clients, pings, window, threads));
+        PrintUdpResult("batched", RunUdp(true, shards, clients, pings, window, threads));
+    }
+
+    return 0;
+}
+
+/**
+ * The session lookup the services used before SessionTable: a map guarded by a mutex.
+ */
+class LockedSessionMap
+{
+public:
+    shared_ptr<uint32_t> Find(const udp::endpoint& endpoint)
+    {
+        boost::lock_guard<boost::mutex> lg(mutex_);
+
+        auto find_iter = map_.find(endpoint);
+        return find_iter != map_.end() ? find_iter->second : nullptr;
+    }
+
+    void Insert(const udp::endpoint& endpoint, shared_ptr<uint32_t> session)
+    {
+        boost::lock_guard<boost::mutex> lg(mutex_);
+        map_.insert(make_pair(endpoint, session));
+    }
+
+    void Erase(const udp::endpoint& endpoint)
+    {
+        boost::lock_guard<boost::mutex> lg(mutex_);
+        map_.erase(endpoint);
+    }
+
+    template<typename Functor>
+    void ForEach(Functor functor)
+    {
+        boost::lock_guard<boost::mutex> lg(mutex_);
+        for (auto& item : map_)
+        {
+            functor(item.second);
+        }
+    }
+
+private:
+    boost::mutex mutex_;
+    map<udp::endpoint, shared_ptr<uint32_t>> map_;
+};
+
+udp::endpoint MakeSessionEndpoint(uint32_t index)
+{
+    return udp::endpoint(boost::asio::ip::address_v4(0x0A000000 + index / 1000), static_cast<uint16_t>(1024 + index % 1000));
+}
+
+/**
+ * Runs lookup threads against a populated container for a fixed duration while one
+ * thread churns connects/disconnects and another walks every session like the
+ * service Update pump.
+ *
+ * @return Lookups per second across all lookup threads.
+ */
+template<typename Container>
+double RunSessionLookups(uint32_t sessions, uint32_t threads, double seconds)
+{
+    Container container;
+    for (uint32_t i = 0; i < sessions; ++i)
+    {
+        container.Insert(MakeSessionEndpoint(i), make_shared<uint32_t>(i));
+    }
+
+    atomic<bool> done(false);
+    atomic<uint64_t> lookups(0);
+
+    vector<boost::thread> workers;
+    for (uint32_t t = 0; t < threads; ++t)
+    {
+        workers.push_back(boost::thread([&, t] () {
+            uint64_t count = 0;
+            uint32_t index = t * 7919;
+
+            while (!done)
+            {
+                for (int i = 0; i < 256; ++i)
+                {
+                    index = (index + 7919) % sessions;
+                    if (container.Find(MakeSessionEndpoint(index)))
+                    {
+                        ++count;
+                    }
+                }
+            }
+
+            lookups += count;
+        }));
+    }
+
+    // Connect/disconnect churn on endpoints outside of the looked up range.
+    workers.push_back(boost::thread([&] () {
+        uint32_t index = 0;
+        while (!done)
+        {
+            auto endpoint = MakeSessionEndpoint(sessions + (index++ % 1000));
+            container.Insert(endpoint, make_shared<uint32_t>(index));
+            container.Erase(endpoint);
+        }
+    }));
+
+    // Update pump.
+    workers.push_back(boost::thread([&] () {
+        while (!done)
+        {
+            uint32_t visited = 0;
+            container.ForEach([&visited] (const shared_ptr<uint32_t>&) { ++visited; });
+            boost::this_thread::sleep(boost::posix_time::milliseconds(5));
+        }
+    }));
+
+    boost::this_thread::sleep(boost::posix_time::milliseconds(static_cast<int64_t>(seconds * 1000)));
+    done = true;
+
+    for_each(workers.begin(), workers.end(), mem_fn(&boost::thread::join));
+
+    return lookups / seconds;
+}
+
+int BenchmarkSessions(const vector<string>& args)
+{
+    uint32_t threads = args.size() > 0 ? atoi(args[0].c_str()) : max<uint32_t>(2, boost::thread::hardware_concurrency());
+    double seconds = args.size() > 1 ? atof(args[1].c_str()) : 1.0;
+
+    cout << "Session lookup benchmark: " << threads << " lookup threads, "
+         << "1 churn thread, 1 update thread, " << seconds << "s per run\n\n";
+
+    cout << setw(10) << "sessions"
+         << setw(18) << "map lookups/sec"
+         << setw(20) << "table lookups/sec"
+         << setw(10) << "speedup" << "\n";
+
+    for (uint32_t sessions : {1000, 2500, 5000, 10000})
+    {
+        double locked = RunSessionLookups<LockedSessionMap>(sessions, threads, seconds);
+        double table = RunSessionLookups<SessionTable<uint32_t>>(sessions, threads, seconds);
+
+        cout << setw(10) << sessions
+             << setw(18) << fixed << setprecision(0) << locked
+             << setw(20) << table
+             << setw(10) << setprecision(2) << (table / locked) << "\n";
+    }
+
+    return 0;
+}
+
+/// Size of the packets fed to the compression benchmark.
+const uint32_t kTrafficPacketSize = 488;
+
+/**
+ * Appends a baseline shaped like the ones sent for creatures and tangibles: object
+ * header, template strings, a unicode name, positions and mostly zeroed counters.
+ */
+void AppendBaseline(ByteBuffer& packet, uint64_t object_id, uint32_t variant)
+{
+    static const char* templates[] = {
+        "object/creature/player/shared_human_male.iff",
+        "object/tangible/wearables/shirt/shared_shirt_s14.iff",
+        "object/building/player/shared_player_house_tatooine_small_style_01.iff",
+        "object/weapon/ranged/rifle/shared_rifle_t21.iff"
+    };
+
+    string template_name = templates[variant % 4];
+    string name = "Player" + to_string(object_id % 1000);
+
+    packet.write<uint16_t>(5);
+    packet.write<uint32_t>(0x68A75F0C);
+    packet.write<uint64_t>(object_id);
+    packet.write<uint32_t>(0x4352454F);
+    packet.write<uint8_t>(3);
+    packet.write<uint32_t>(static_cast<uint32_t>(40 + template_name.size() + name.size() * 2));
+    packet.write<uint16_t>(12);
+    packet.write<float>(1.0f);
+    packet.write<uint16_t>(static_cast<uint16_t>(template_name.size()));
+    packet.write(reinterpret_cast<const unsigned char*>(template_name.data()), template_name.size());
+    packet.write<uint32_t>(0);
+    packet.write<uint32_t>(static_cast<uint32_t>(name.size()));
+
+    for (char c : name)
+    {
+        packet.write<uint16_t>(static_cast<uint16_t>(c));
+    }
+
+    packet.write<float>(3512.5f + variant);
+    packet.write<float>(4.0f);
+    packet.write<float>(-4795.25f - variant);
+
+    for (int i = 0; i < 6; ++i)
+    {
+        packet.write<uint32_t>(i == 2 ? variant : 0);
+    }
+}
+
+/**
+ * Appends a batch of small deltas (position, posture and ham updates) in a multi
+ * message, the shape of per tick update traffic.
+ */
+void AppendDeltas(ByteBuffer& packet, uint64_t object_id, uint32_t count)
+{
+    packet.write<uint16_t>(hostToBig<uint16_t>(0x19));
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        packet.write<uint8_t>(25);
+        packet.write<uint16_t>(5);
+        packet.write<uint32_t>(0x12862153);
+        packet.write<uint64_t>(object_id + i);
+        packet.write<uint32_t>(0x4352454F);
+        packet.write<uint8_t>(6);
+        packet.write<uint32_t>(6);
+        packet.write<uint16_t>(1);
+        packet.write<uint16_t>(static_cast<uint16_t>(i % 3));
+    }
+}
+
+/**
+ * Builds a data channel packet just under the remote end's buffer size, only packets
+ * this large are considered by the compression filter.
+ */
+ByteBuffer BuildTrafficPacket(const string& kind, uint32_t index, uint32_t& random_state)
+{
+    ByteBuffer packet;
+    packet.write<uint16_t>(hostToBig<uint16_t>(CHILD_DATA_A));
+    packet.write<uint16_t>(hostToBig<uint16_t>(static_cast<uint16_t>(index)));
+
+    if (kind == "baselines")
+    {
+        while (packet.size() < kTrafficPacketSize)
+        {
+            AppendBaseline(packet, 0x100000 + index * 7 + packet.size(), index + packet.size());
+        }
+    }
+    else if (kind == "deltas")
+    {
+        AppendDeltas(packet, 0x200000 + index * 18, 18);
+    }
+    else
+    {
+        // Already compressed payloads, e.g. baselines carrying compressed blobs.
+        while (packet.size() < kTrafficPacketSize)
+        {
+            random_state = random_state * 1103515245 + 12345;
+            packet.write<uint8_t>(static_cast<uint8_t>(random_state >> 16));
+        }
+    }
+
+    packet.resize(kTrafficPacketSize);
+    return packet;
+}
+
+/**
+ * What the compression filter did before streams were reused: set up and tear down a
+ * deflate stream for every packet, with the output copied through temporary buffers.
+ */
+ByteBuffer CompressPerPacket(const ByteBuffer& message, int level)
+{
+    const unsigned char* packet_data = message.data();
+    uint32_t packet_size = message.size();
+    uint16_t offset = (packet_data[0] == 0x00) ? 2 : 1;
+
+    z_stream zstream;
+    zstream.zalloc = Z_NULL;
+    zstream.zfree = Z_NULL;
+    zstream.opaque = Z_NULL;
+
+    deflateInit(&zstream, level);
+
+    vector<uint8_t> compression_output(packet_size);
+
+    zstream.next_in = const_cast<Bytef*>(packet_data + offset);
+    zstream.avail_in = packet_size - offset;
+    zstream.next_out = &compression_output[0];
+    zstream.avail_out = packet_size;
+
+    deflate(&zstream, Z_FINISH);
+
+    ByteBuffer compressed(packet_data, offset);
+    compressed.write(&compression_output[0], zstream.total_out);
+
+    deflateEnd(&zstream);
+
+    compressed.write<uint8_t>(1);
+    return compressed;
+}
+
+int BenchmarkCompression(const vector<string>& args)
+{
+    uint32_t iterations = args.size() > 0 ? atoi(args[0].c_str()) : 20000;
+
+    boost::asio::io_service io_service;
+    BenchmarkServer server(io_service);
+    auto session = make_shared<Session>(&server, io_service, udp::endpoint());
+    auto pool = session->packet_pool();
+
+    cout << "Compression benchmark: " << iterations << " packets per run, "
+         << session->receive_buffer_size() << " byte client buffer\n\n";
+
+    cout << setw(14) << "traffic"
+         << setw(16) << "mode"
+         << setw(12) << "us/packet"
+         << setw(12) << "out/in"
+         << setw(14) << "compressed" << "\n";
+
+    for (string kind : {"baselines", "deltas", "precompressed"})
+    {
+        uint32_t random_state = 42;
+
+        vector<ByteBuffer> traffic;
+        uint64_t input_bytes = 0;
+
+        for (uint32_t i = 0; i < 64; ++i)
+        {
+            traffic.push_back(BuildTrafficPacket(kind, i, random_state));
+        }
+
+        for (uint32_t i = 0; i < iterations; ++i)
+        {
+            input_bytes += traffic[i % traffic.size()].size() + 1;
+        }
+
+        auto print_row = [&] (const string& mode, double seconds, uint64_t output_bytes, uint64_t compressed) {
+            cout << setw(14) << kind
+                 << setw(16) << mode
+                 << setw(12) << fixed << setprecision(2) << (seconds * 1e6 / iterations)
+                 << setw(12) << setprecision(3) << (double(output_bytes) / input_bytes)
+                 << setw(13) << setprecision(0) << (100.0 * compressed / iterations) << "%\n";
+        };
+
+        {
+            uint64_t output_bytes = 0;
+            auto start = chrono::high_resolution_clock::now();
+
+            for (uint32_t i = 0; i < iterations; ++i)
+            {
+                output_bytes += CompressPerPacket(traffic[i % traffic.size()], Z_DEFAULT_COMPRESSION).size();
+            }
+
+            print_row("per-packet init",
+                chrono::duration<double>(chrono::high_resolution_clock::now() - start).count(),
+                output_bytes, iterations);
+        }
+
+        for (int level : {1, 6, 9})
+        {
+            filters::CompressionFilter filter(level);
+            uint64_t output_bytes = 0;
+            auto start = chrono::high_resolution_clock::now();
+
+            for (uint32_t i = 0; i < iterations; ++i)
+            {
+                const ByteBuffer& message = traffic[i % traffic.size()];
+                PacketBuffer packet = pool->Copy(message.data(), message.size());
+
+                filter(session.get(), &packet);
+                output_bytes += packet.size();
+            }
+
+            print_row("level " + to_string(level),
+                chrono::duration<double>(chrono::high_resolution_clock::now() - start).count(),
+                output_bytes, filter.compressed_packets());
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Builds an outgoing game message: mostly small deltas, some baselines and the odd
+ * message too large for a datagram.
+ */
+ByteBuffer BuildGameMessage(uint32_t& random_state)
+{
+    random_state = random_state * 1103515245 + 12345;
+    uint32_t roll = (random_state >> 16) % 100;
+
+    ByteBuffer message;
+
+    if (roll < 85)
+    {
+        message.write<uint16_t>(5);
+        message.write<uint32_t>(0x12862153);
+        message.write<uint64_t>(random_state);
+        message.write<uint32_t>(0x4352454F);
+        message.write<uint8_t>(6);
+        message.write<uint32_t>(6);
+        message.write<uint16_t>(1);
+        message.write<uint16_t>(static_cast<uint16_t>(roll % 3));
+    }
+    else
+    {
+        AppendBaseline(message, random_state, roll);
+
+        // Stand in for large lists, e.g. inventories and waypoints.
+        if (roll >= 97)
+        {
+            vector<unsigned char> contents(800 + (random_state >> 20) % 800, 0x42);
+            message.write(&contents[0], contents.size());
+        }
+    }
+
+    return message;
+}
+
+/// Number of game messages in a data channel payload.
+uint32_t CountPackedMessages(const ByteBuffer& payload)
+{
+    if (payload.size() < 2 || payload.data()[0] != 0x00 || payload.data()[1] != 0x19)
+    {
+        return 1;
+    }
+
+    uint32_t count = 0;
+
+    for (uint32_t offset = 2; offset < payload.size(); ++count)
+    {
+        uint32_t size = payload.data()[offset++];
+
+        if (size == 0xFF)
+        {
+            size = (payload.data()[offset] << 8) | payload.data()[offset + 1];
+            offset += 2;
+        }
+
+        offset += size;
+    }
+
+    return count;
+}
+
+struct PackingResult
+{
+    PackingResult()
+        : datagrams(0), fragments(0), bytes(0), resent_datagrams(0), resent_bytes(0)
+        , messages(0), messages_waiting_on_resend(0)
+    {}
+
+    uint64_t datagrams;
+    uint64_t fragments;
+    uint64_t bytes;
+    uint64_t resent_datagrams;
+    uint64_t resent_bytes;
+    uint64_t messages;
+    uint64_t messages_waiting_on_resend;
+};
+
+/**
+ * Sends a payload over a lossy link, fragmenting it if necessary. Every lost datagram
+ * is resent until it arrives, and the payload's messages wait on those resends.
+ */
+void SimulatePayload(ByteBuffer payload, uint32_t max_size, uint32_t loss_percent,
+    uint32_t& random_state, PackingResult& result)
+{
+    // The soe header, compression flag and crc footer.
+    const uint32_t kOverhead = 4 + 1 + 2;
+
+    vector<uint32_t> datagram_sizes;
+
+    if (payload.size() > max_size)
+    {
+        list<ByteBuffer> fragments = SplitDataChannelMessage(payload, max_size);
+
+        for (auto& fragment : fragments)
+        {
+            datagram_sizes.push_back(fragment.size() + kOverhead);
+        }
+
+        result.fragments += fragments.size();
+    }
+    else
+    {
+        datagram_sizes.push_back(payload.size() + kOverhead);
+    }
+
+    uint32_t messages = CountPackedMessages(payload);
+    bool waited = false;
+
+    for (uint32_t size : datagram_sizes)
+    {
+        ++result.datagrams;
+        result.bytes += size;
+
+        for (;;)
+        {
+            random_state = random_state * 1103515245 + 12345;
+            if ((random_state >> 16) % 100 >= loss_percent)
+            {
+                break;
+            }
+
+            waited = true;
+            ++result.resent_datagrams;
+            result.resent_bytes += size;
+        }
+    }
+
+    result.messages += messages;
+    result.messages_waiting_on_resend += waited ? messages : 0;
+}
+
+int BenchmarkPacking(const vector<string>& args)
+{
+    uint32_t bursts = args.size() > 0 ? atoi(args[0].c_str()) : 20000;
+    uint32_t loss_percent = args.size() > 1 ? atoi(args[1].c_str()) : 2;
+
+    // A 496 byte client buffer less the soe header, compression flag and crc footer.
+    const uint32_t max_size = 496 - 4 - 1 - 2;
+
+    PackingResult single_payload, packed_payloads;
+    uint32_t message_state = 42;
+    uint32_t single_loss_state = 7;
+    uint32_t packed_loss_state = 7;
+
+    for (uint32_t burst = 0; burst < bursts; ++burst)
+    {
+        message_state = message_state * 1103515245 + 12345;
+        uint32_t message_count = 1 + (message_state >> 16) % 64;
+
+        list<ByteBuffer> messages;
+
+        for (uint32_t i = 0; i < message_count; ++i)
+        {
+            messages.push_back(BuildGameMessage(message_state));
+        }
+
+        // The previous behaviour: one payload for the burst, fragmented as a whole.
+        SimulatePayload(PackDataChannelMessages(messages), max_size, loss_percent,
+            single_loss_state, single_payload);
+
+        list<ByteBuffer> payloads = PackDataChannelPayloads(move(messages), max_size);
+
+        for (auto& payload : payloads)
+        {
+            SimulatePayload(move(payload), max_size, loss_percent, packed_loss_state, packed_payloads);
+        }
+    }
+
+    cout << "Packing benchmark: " << bursts << " bursts of 1-64 messages, "
+         << loss_percent << "% datagram loss, " << max_size << " byte payloads\n\n";
+
+    cout << setw(18) << "packer"
+         << setw(12) << "datagrams"
+         << setw(12) << "fragments"
+         << setw(12) << "KB sent"
+         << setw(12) << "resent"
+         << setw(14) << "KB resent"
+         << setw(16) << "msgs waiting" << "\n";
+
+    auto print_row = [] (const string& name, const PackingResult& result) {
+        cout << setw(18) << name
+             << setw(12) << result.datagrams
+             << setw(12) << result.fragments
+             << setw(12) << result.bytes / 1024
+             << setw(12) << result.resent_datagrams
+             << setw(14) << result.resent_bytes / 1024
+             << setw(15) << fixed << setprecision(1)
+             << (100.0 * result.messages_waiting_on_resend / result.messages) << "%\n";
+    };
+
+    print_row("single payload", single_payload);
+    print_row("packed payloads", packed_payloads);
+
+    return 0;
+}
+
+const char* CrcEngineName(CrcEngine engine)
+{
+    switch (engine)
+    {
+    case CRC_ENGINE_BYTEWISE: return "bytewise";
+    case CRC_ENGINE_SLICE_BY_8: return "slice-by-8";
+    case CRC_ENGINE_CARRYLESS_MULTIPLY: return "pclmulqdq";
+    }
+
+    return "unknown";
+}
+
+int BenchmarkCrc(const vector<string>& args)
+{
+    uint32_t iterations = args.size() > 0 ? atoi(args[0].c_str()) : 200000;
+
+    vector<unsigned char> data(496);
+    uint32_t random_state = 42;
+
+    for (unsigned char& byte : data)
+    {
+        random_state = random_state * 1103515245 + 12345;
+        byte = static_cast<unsigned char>(random_state >> 16);
+    }
+
+    // Endpoint hashes checksum strings like this one for every new session.
+    string endpoint = "192.168.100.200:44453";
+
+    cout << "Crc benchmark: " << iterations << " checksums per run, active engine "
+         << CrcEngineName(ActiveCrcEngine()) << "\n\n";
+
+    cout << setw(14) << "engine"
+         << setw(16) << "input"
+         << setw(12) << "ns/call"
+         << setw(12) << "MB/s" << "\n";
+
+    for (CrcEngine engine : {CRC_ENGINE_BYTEWISE, CRC_ENGINE_SLICE_BY_8, CRC_ENGINE_CARRYLESS_MULTIPLY})
+    {
+        if (!IsCrcEngineSupported(engine))
+        {
+            cout << setw(14) << CrcEngineName(engine) << "   not supported by this cpu\n";
+            continue;
+        }
+
+        auto print_row = [&] (const string& input, uint32_t length, double seconds) {
+            cout << setw(14) << CrcEngineName(engine)
+                 << setw(16) << input
+                 << setw(12) << fixed << setprecision(1) << (seconds * 1e9 / iterations)
+                 << setw(12) << setprecision(0) << (double(length) * iterations / seconds / 1e6) << "\n";
+        };
+
+        uint32_t crc = 0;
+
+        {
+            auto start = chrono::high_resolution_clock::now();
+
+            for (uint32_t i = 0; i < iterations; ++i)
+            {
+                crc += memcrc(endpoint.c_str(), endpoint.length(), engine);
+            }
+
+            print_row("endpoint string", endpoint.length(),
+                chrono::duration<double>(chrono::high_resolution_clock::now() - start).count());
+        }
+
+        for (uint32_t length : {16u, 64u, 496u})
+        {
+            auto start = chrono::high_resolution_clock::now();
+
+            for (uint32_t i = 0; i < iterations; ++i)
+            {
+                crc = memcrc(&data[0], length, crc, engine);
+            }
+
+            print_row(to_string(length) + " byte packet", length,
+                chrono::duration<double>(chrono::high_resolution_clock::now() - start).count());
+        }
+
+        crc_sink = crc;
+    }
+
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    map<string, function<int (const vector<string>&)>> benchmarks;
+    benchmarks["udp"] = &BenchmarkUdp;
+    benchmarks["sessions"] = &BenchmarkSessions;
+    benchmarks["compression"] = &BenchmarkCompression;
+    benchmarks["crc"] = &BenchmarkCrc;
+    benchmarks["packing"] = &BenchmarkPacking;
+
+    if (argc < 2 || benchmarks.find(argv[1]) == benchmarks.end())
+    {
+        cout << "Usage: " << argv[0] << " <benchmark> [args...]\n\n"
+             << "Available benchmarks:\n"
+             << "   udp [clients] [pings per client] [window] [shards]\n"
+             << "   sessions [lookup threads] [seconds per run]\n"
+             << "   compression [packets per run]\n"
+             << "   crc [checksums per run]\n"
+             << "   packing [bursts] [loss percent]\n";
+        return 0;
+    }
+
+    return benchmarks[argv[1]](vector<string>(argv + 2, argv + argc));
+}
@@ -0,0 +1,417 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#include <glm/glm.hpp>
+
+#include "anh/event_dispatcher.h"
+#include "swganh/object/object.h"
+#include "swganh/simulation/spatial_provider_interface.h"
+#include "pub14_core/simulation/quadtree_spatial_provider.h"
+#include "grid_spatial/grid_spatial_provider.h"
+
+using namespace std;
+using swganh::object::Object;
+using swganh::simulation::SpatialProviderInterface;
+using plugins::grid_spatial::GridSpatialProvider;
+
+namespace {
+
+/// Every heap allocation made by the process, counted by the operator new below.
+atomic<uint64_t> heap_allocations(0);
+
+/// Result counts are stored here so the queries can't be optimized away.
+volatile size_t result_sink = 0;
+
+}  // namespace
+
+void* operator new(size_t size)
+{
+    ++heap_allocations;
+
+    void* memory = malloc(size ? size : 1);
+    if (!memory)
+    {
+        throw bad_alloc();
+    }
+
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    free(memory);
+}
+
+namespace {
+
+/// Half the width of a planet, the playable area spans [-8300, 8300] on both axes.
+const float kMapExtent = 8300.0f;
+
+/**
+ * The spatial providers the benchmarks can run against, by name.
+ */
+map<string, function<shared_ptr<SpatialProviderInterface> ()>> SpatialProviders()
+{
+    map<string, function<shared_ptr<SpatialProviderInterface> ()>> providers;
+    providers["quadtree"] = [] () { return make_shared<QuadtreeSpatialProvider>(nullptr); };
+    providers["grid"] = [] () { return make_shared<GridSpatialProvider>(nullptr, kMapExtent, 64.0f); };
+    return providers;
+}
+
+/**
+ * Objects scattered uniformly over the whole map.
+ */
+class World
+{
+public:
+    World(anh::EventDispatcher* event_dispatcher, uint32_t object_count, uint32_t seed)
+    {
+        mt19937 generator(seed);
+        uniform_real_distribution<float> coordinate(-kMapExtent, kMapExtent);
+
+        objects.reserve(object_count);
+        positions.reserve(object_count);
+
+        for (uint32_t i = 0; i < object_count; ++i)
+        {
+            auto object = make_shared<Object>();
+            object->SetEventDispatcher(event_dispatcher);
+            object->SetObjectId(i + 1);
+
+            glm::vec3 position(coordinate(generator), 0.0f, coordinate(generator));
+            object->SetPosition(position);
+
+            objects.push_back(object);
+            positions.push_back(position);
+        }
+    }
+
+    /// Counts the objects within range by testing every one of them.
+    size_t CountInRange(const glm::vec3& point, float range) const
+    {
+        size_t count = 0;
+        float range_squared = range * range;
+
+        for (const glm::vec3& position : positions)
+        {
+            float dx = position.x - point.x;
+            float dz = position.z - point.z;
+
+            if (dx * dx + dz * dz <= range_squared)
+            {
+                ++count;
+            }
+        }
+
+        return count;
+    }
+
+    vector<shared_ptr<Object>> objects;
+    vector<glm::vec3> positions;
+};
+
+struct QueryResult
+{
+    double seconds;
+    uint64_t results;
+    uint64_t allocations;
+};
+
+template<typename Query>
+QueryResult TimeQueries(const vector<glm::vec3>& centers, uint32_t query_count, Query query)
+{
+    QueryResult result;
+    result.results = 0;
+
+    uint64_t allocations_before = heap_allocations;
+    auto start = chrono::high_resolution_clock::now();
+
+    for (uint32_t i = 0; i < query_count; ++i)
+    {
+        result.results += query(centers[i % centers.size()]);
+    }
+
+    result.seconds = chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+    result.allocations = heap_allocations - allocations_before;
+
+    result_sink = static_cast<size_t>(result.results);
+
+    return result;
+}
+
+/**
+ * Measures radius and box queries against a populated map, comparing the vector and
+ * visitor forms with a brute force scan over every object.
+ */
+int BenchmarkRange(const vector<string>& args)
+{
+    uint32_t object_count = args.size() > 0 ? atoi(args[0].c_str()) : 50000;
+    uint32_t query_count = args.size() > 1 ? atoi(args[1].c_str()) : 20000;
+    string provider_name = args.size() > 2 ? args[2] : "quadtree";
+
+    auto providers = SpatialProviders();
+    if (providers.find(provider_name) == providers.end())
+    {
+        cout << "Unknown spatial provider: " << provider_name << "\n";
+        return 1;
+    }
+
+    boost::asio::io_service io_service;
+    anh::EventDispatcher event_dispatcher(io_service);
+
+    World world(&event_dispatcher, object_count, 42);
+    auto provider = providers[provider_name]();
+
+    for (auto& object : world.objects)
+    {
+        provider->AddObject(object);
+    }
+
+    mt19937 generator(7);
+    uniform_real_distribution<float> coordinate(-kMapExtent, kMapExtent);
+
+    vector<glm::vec3> centers(1024);
+    for (glm::vec3& center : centers)
+    {
+        center = glm::vec3(coordinate(generator), 0.0f, coordinate(generator));
+    }
+
+    // A full scan is orders of magnitude slower, keep its run short.
+    uint32_t scan_count = max(query_count / 100, 1u);
+
+    cout << "Range benchmark: " << object_count << " objects on a "
+         << static_cast<int>(kMapExtent * 2) << "m map, " << query_count << " queries per run, "
+         << provider_name << " provider\n\n";
+
+    cout << setw(10) << "range"
+         << setw(16) << "query"
+         << setw(14) << "queries/s"
+         << setw(12) << "results"
+         << setw(14) << "allocs/query" << "\n";
+
+    auto print_row = [] (float range, const string& name, uint32_t queries, const QueryResult& result) {
+        cout << setw(10) << fixed << setprecision(0) << range
+             << setw(16) << name
+             << setw(14) << (queries / result.seconds)
+             << setw(12) << setprecision(1) << (double(result.results) / queries)
+             << setw(14) << setprecision(2) << (double(result.allocations) / queries) << "\n";
+    };
+
+    for (float range : {32.0f, 128.0f, 256.0f, 1024.0f})
+    {
+        auto scan = TimeQueries(centers, scan_count, [&] (const glm::vec3& center) {
+            return world.CountInRange(center, range);
+        });
+
+        auto vector_query = TimeQueries(centers, query_count, [&] (const glm::vec3& center) {
+            return provider->GetObjectsInRange(center, range).size();
+        });
+
+        auto visitor_query = TimeQueries(centers, query_count, [&] (const glm::vec3& center) {
+            size_t count = 0;
+            provider->VisitObjectsInRange(center, range, [&count] (const shared_ptr<Object>&) { ++count; });
+            return count;
+        });
+
+        auto box_query = TimeQueries(centers, query_count, [&] (const glm::vec3& center) {
+            size_t count = 0;
+            glm::vec3 extent(range, 0.0f, range);
+            provider->VisitObjectsInBox(center - extent, center + extent, [&count] (const shared_ptr<Object>&) { ++count; });
+            return count;
+        });
+
+        print_row(range, "scan", scan_count, scan);
+        print_row(range, "range vector", query_count, vector_query);
+        print_row(range, "range visitor", query_count, visitor_query);
+        print_row(range, "box visitor", query_count, box_query);
+
+        // Every form must agree with the scan on the queries both ran.
+        for (uint32_t i = 0; i < min<uint32_t>(scan_count, centers.size()); ++i)
+        {
+            size_t visited = 0;
+            provider->VisitObjectsInRange(centers[i], range, [&visited] (const shared_ptr<Object>&) { ++visited; });
+
+            if (visited != world.CountInRange(centers[i], range))
+            {
+                cout << "Range query mismatch at " << centers[i].x << ", " << centers[i].z << "\n";
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * One recorded step of an object, replayed against every provider.
+ */
+struct Move
+{
+    uint32_t object;
+    glm::vec3 position;
+};
+
+/**
+ * Replays one movement trace against each provider. Every tick a share of the objects
+ * takes a step and a batch of range queries is run around the objects that moved, the
+ * way the simulation looks for what a moving player can see.
+ */
+int BenchmarkMovement(const vector<string>& args)
+{
+    uint32_t object_count = args.size() > 0 ? atoi(args[0].c_str()) : 50000;
+    uint32_t tick_count = args.size() > 1 ? atoi(args[1].c_str()) : 50;
+    uint32_t mover_percent = args.size() > 2 ? atoi(args[2].c_str()) : 20;
+    float query_range = 128.0f;
+
+    boost::asio::io_service io_service;
+    anh::EventDispatcher event_dispatcher(io_service);
+
+    World world(&event_dispatcher, object_count, 42);
+
+    // Record the trace up front so that every provider sees exactly the same moves.
+    vector<vector<Move>> trace(tick_count);
+    {
+        mt19937 generator(11);
+        uniform_int_distribution<uint32_t> pick(0, object_count - 1);
+        uniform_real_distribution<float> step(-8.0f, 8.0f);
+
+        vector<glm::vec3> positions = world.positions;
+        uint32_t moves_per_tick = object_count * mover_percent / 100;
+
+        for (auto& tick : trace)
+        {
+            tick.reserve(moves_per_tick);
+
+            for (uint32_t i = 0; i < moves_per_tick; ++i)
+            {
+                uint32_t object = pick(generator);
+                glm::vec3& position = positions[object];
+
+                position.x = max(-kMapExtent + 1.0f, min(kMapExtent - 1.0f, position.x + step(generator)));
+                position.z = max(-kMapExtent + 1.0f, min(kMapExtent - 1.0f, position.z + step(generator)));
+
+                Move move = {object, position};
+                tick.push_back(move);
+            }
+        }
+    }
+
+    cout << "Movement benchmark: " << object_count << " objects, " << tick_count << " ticks, "
+         << mover_percent << "% moving per tick, " << static_cast<int>(query_range) << "m queries\n\n";
+
+    cout << setw(10) << "provider"
+         << setw(12) << "adds/s"
+         << setw(14) << "updates/s"
+         << setw(14) << "allocs/upd"
+         << setw(14) << "queries/s"
+         << setw(14) << "results" << "\n";
+
+    uint64_t expected_results = 0;
+
+    for (auto& entry : SpatialProviders())
+    {
+        auto provider = entry.second();
+        vector<glm::vec3> positions = world.positions;
+
+        auto start = chrono::high_resolution_clock::now();
+
+        for (auto& object : world.objects)
+        {
+            provider->AddObject(object);
+        }
+
+        double add_seconds = chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+
+        double update_seconds = 0.0;
+        double query_seconds = 0.0;
+        uint64_t updates = 0;
+        uint64_t update_allocations = 0;
+        uint64_t queries = 0;
+        uint64_t results = 0;
+
+        for (auto& tick : trace)
+        {
+            uint64_t allocations_before = heap_allocations;
+            start = chrono::high_resolution_clock::now();
+
+            for (const Move& move : tick)
+            {
+                provider->UpdateObject(world.objects[move.object], positions[move.object], move.position);
+                positions[move.object] = move.position;
+            }
+
+            update_seconds += chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+            update_allocations += heap_allocations - allocations_before;
+            updates += tick.size();
+
+            start = chrono::high_resolution_clock::now();
+
+            for (size_t i = 0; i < tick.size(); i += 10)
+            {
+                provider->VisitObjectsInRange(tick[i].position, query_range, [&results] (const shared_ptr<Object>&) { ++results; });
+                ++queries;
+            }
+
+            query_seconds += chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+        }
+
+        cout << setw(10) << entry.first
+             << setw(12) << fixed << setprecision(0) << (object_count / add_seconds)
+             << setw(14) << (updates / update_seconds)
+             << setw(14) << setprecision(2) << (double(update_allocations) / updates)
+             << setw(14) << setprecision(0) << (queries / query_seconds)
+             << setw(14) << results << "\n";
+
+        // Identical traces must produce identical query results.
+        if (expected_results && expected_results != results)
+        {
+            cout << "Providers disagree on the query results\n";
+            return 1;
+        }
+
+        expected_results = results;
+        result_sink = static_cast<size_t>(results);
+    }
+
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    map<string, function<int (const vector<string>&)>> benchmarks;
+    benchmarks["range"] = &BenchmarkRange;
+    benchmarks["movement"] = &BenchmarkMovement;
+
+    if (argc < 2 || benchmarks.find(argv[1]) == benchmarks.end())
+    {
+        cout << "Usage: " << argv[0] << " <benchmark> [args...]\n\n"
+             << "Available benchmarks:\n"
+             << "   range [objects] [queries per run] [provider]\n"
+             << "   movement [objects] [ticks] [percent moving per tick]\n";
+        return 0;
+    }
+
+    return benchmarks[argv[1]](vector<string>(argv + 2, argv + argc));
+}
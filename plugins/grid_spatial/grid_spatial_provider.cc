@@ -0,0 +1,293 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include "grid_spatial_provider.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "swganh/object/object.h"
+
+using namespace plugins::grid_spatial;
+using namespace std;
+
+using anh::app::KernelInterface;
+using swganh::object::Object;
+using swganh::simulation::ObjectVisitor;
+
+namespace {
+
+/**
+ * The squared distance from (x, z) to the closest point of a cell's bounds.
+ */
+float DistanceSquaredToBounds(float x, float z, float min_x, float min_z, float max_x, float max_z)
+{
+    float dx = max(max(min_x - x, x - max_x), 0.0f);
+    float dz = max(max(min_z - z, z - max_z), 0.0f);
+    return dx * dx + dz * dz;
+}
+
+/**
+ * The squared distance from (x, z) to the farthest point of a cell's bounds.
+ */
+float FarthestDistanceSquaredToBounds(float x, float z, float min_x, float min_z, float max_x, float max_z)
+{
+    float dx = max(x - min_x, max_x - x);
+    float dz = max(z - min_z, max_z - z);
+    return dx * dx + dz * dz;
+}
+
+}  // namespace
+
+GridSpatialProvider::GridSpatialProvider(KernelInterface* kernel, float map_extent, float cell_size)
+    : SpatialProviderInterface(kernel)
+    , map_extent_(map_extent)
+    , cell_size_(cell_size)
+    , inverse_cell_size_(1.0f / cell_size)
+    , cells_per_side_(max(1u, static_cast<uint32_t>(ceil(map_extent * 2.0f / cell_size))))
+    , cells_(cells_per_side_ * cells_per_side_)
+{}
+
+GridSpatialProvider::~GridSpatialProvider()
+{}
+
+void GridSpatialProvider::AddObject(shared_ptr<Object> obj)
+{
+    glm::vec3 position = obj->GetPosition();
+    uint64_t object_id = obj->GetObjectId();
+
+    auto find_iter = handles_.find(object_id);
+    if (find_iter != handles_.end())
+    {
+        // Already indexed, treat the add as a move to the current position.
+        Handle handle = find_iter->second;
+        RemoveFromCell_(handle);
+        InsertIntoCell_(handle, CellIndex_(position.x, position.z), position.x, position.z);
+        return;
+    }
+
+    Handle handle;
+    if (!free_handles_.empty())
+    {
+        handle = free_handles_.back();
+        free_handles_.pop_back();
+    }
+    else
+    {
+        handle = static_cast<Handle>(slots_.size());
+        slots_.push_back(Slot());
+    }
+
+    slots_[handle].object = move(obj);
+    handles_.insert(make_pair(object_id, handle));
+
+    InsertIntoCell_(handle, CellIndex_(position.x, position.z), position.x, position.z);
+}
+
+void GridSpatialProvider::RemoveObject(shared_ptr<Object> obj)
+{
+    auto find_iter = handles_.find(obj->GetObjectId());
+    if (find_iter == handles_.end())
+    {
+        return;
+    }
+
+    Handle handle = find_iter->second;
+    handles_.erase(find_iter);
+
+    RemoveFromCell_(handle);
+    slots_[handle].object.reset();
+    free_handles_.push_back(handle);
+}
+
+void GridSpatialProvider::UpdateObject(shared_ptr<Object> obj, glm::vec3 old_position, glm::vec3 new_position)
+{
+    auto find_iter = handles_.find(obj->GetObjectId());
+    if (find_iter == handles_.end())
+    {
+        return;
+    }
+
+    Handle handle = find_iter->second;
+    Slot& slot = slots_[handle];
+    uint32_t cell_index = CellIndex_(new_position.x, new_position.z);
+
+    if (cell_index == slot.cell)
+    {
+        Cell& cell = cells_[cell_index];
+        cell.x[slot.index] = new_position.x;
+        cell.z[slot.index] = new_position.z;
+        return;
+    }
+
+    RemoveFromCell_(handle);
+    InsertIntoCell_(handle, cell_index, new_position.x, new_position.z);
+}
+
+vector<shared_ptr<Object>> GridSpatialProvider::GetObjectsInRange(glm::vec3 point, float range)
+{
+    vector<shared_ptr<Object>> objects;
+
+    VisitObjectsInRange(point, range, [&objects] (const shared_ptr<Object>& obj) {
+        objects.push_back(obj);
+    });
+
+    return objects;
+}
+
+vector<shared_ptr<Object>> GridSpatialProvider::GetObjectsInBox(glm::vec3 min, glm::vec3 max)
+{
+    vector<shared_ptr<Object>> objects;
+
+    VisitObjectsInBox(min, max, [&objects] (const shared_ptr<Object>& obj) {
+        objects.push_back(obj);
+    });
+
+    return objects;
+}
+
+void GridSpatialProvider::VisitObjectsInRange(glm::vec3 point, float range, const ObjectVisitor& visitor)
+{
+    float range_squared = range * range;
+
+    uint32_t min_x = CellCoordinate_(point.x - range);
+    uint32_t max_x = CellCoordinate_(point.x + range);
+    uint32_t min_z = CellCoordinate_(point.z - range);
+    uint32_t max_z = CellCoordinate_(point.z + range);
+
+    for (uint32_t cell_z = min_z; cell_z <= max_z; ++cell_z)
+    {
+        // Border cells also hold the objects clamped into them, so they extend to infinity.
+        float bounds_min_z = (cell_z == 0) ? -numeric_limits<float>::infinity() : -map_extent_ + cell_z * cell_size_;
+        float bounds_max_z = (cell_z == cells_per_side_ - 1) ? numeric_limits<float>::infinity() : -map_extent_ + (cell_z + 1) * cell_size_;
+
+        for (uint32_t cell_x = min_x; cell_x <= max_x; ++cell_x)
+        {
+            const Cell& cell = cells_[cell_z * cells_per_side_ + cell_x];
+            if (cell.handles.empty())
+            {
+                continue;
+            }
+
+            float bounds_min_x = (cell_x == 0) ? -numeric_limits<float>::infinity() : -map_extent_ + cell_x * cell_size_;
+            float bounds_max_x = (cell_x == cells_per_side_ - 1) ? numeric_limits<float>::infinity() : -map_extent_ + (cell_x + 1) * cell_size_;
+
+            if (DistanceSquaredToBounds(point.x, point.z, bounds_min_x, bounds_min_z, bounds_max_x, bounds_max_z) > range_squared)
+            {
+                continue;
+            }
+
+            size_t count = cell.handles.size();
+
+            if (FarthestDistanceSquaredToBounds(point.x, point.z, bounds_min_x, bounds_min_z, bounds_max_x, bounds_max_z) <= range_squared)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    visitor(slots_[cell.handles[i]].object);
+                }
+
+                continue;
+            }
+
+            const float* x = cell.x.data();
+            const float* z = cell.z.data();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                float dx = x[i] - point.x;
+                float dz = z[i] - point.z;
+
+                if (dx * dx + dz * dz <= range_squared)
+                {
+                    visitor(slots_[cell.handles[i]].object);
+                }
+            }
+        }
+    }
+}
+
+void GridSpatialProvider::VisitObjectsInBox(glm::vec3 min, glm::vec3 max, const ObjectVisitor& visitor)
+{
+    uint32_t min_x = CellCoordinate_(min.x);
+    uint32_t max_x = CellCoordinate_(max.x);
+    uint32_t min_z = CellCoordinate_(min.z);
+    uint32_t max_z = CellCoordinate_(max.z);
+
+    for (uint32_t cell_z = min_z; cell_z <= max_z; ++cell_z)
+    {
+        for (uint32_t cell_x = min_x; cell_x <= max_x; ++cell_x)
+        {
+            const Cell& cell = cells_[cell_z * cells_per_side_ + cell_x];
+
+            const float* x = cell.x.data();
+            const float* z = cell.z.data();
+            size_t count = cell.handles.size();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (x[i] >= min.x && x[i] <= max.x && z[i] >= min.z && z[i] <= max.z)
+                {
+                    visitor(slots_[cell.handles[i]].object);
+                }
+            }
+        }
+    }
+}
+
+size_t GridSpatialProvider::size() const
+{
+    return handles_.size();
+}
+
+uint32_t GridSpatialProvider::CellCoordinate_(float coordinate) const
+{
+    float cell = (coordinate + map_extent_) * inverse_cell_size_;
+
+    if (!(cell > 0.0f))
+    {
+        return 0;
+    }
+
+    return min(static_cast<uint32_t>(cell), cells_per_side_ - 1);
+}
+
+uint32_t GridSpatialProvider::CellIndex_(float x, float z) const
+{
+    return CellCoordinate_(z) * cells_per_side_ + CellCoordinate_(x);
+}
+
+void GridSpatialProvider::InsertIntoCell_(Handle handle, uint32_t cell_index, float x, float z)
+{
+    Cell& cell = cells_[cell_index];
+    Slot& slot = slots_[handle];
+
+    slot.cell = cell_index;
+    slot.index = static_cast<uint32_t>(cell.handles.size());
+
+    cell.x.push_back(x);
+    cell.z.push_back(z);
+    cell.handles.push_back(handle);
+}
+
+void GridSpatialProvider::RemoveFromCell_(Handle handle)
+{
+    const Slot& slot = slots_[handle];
+    Cell& cell = cells_[slot.cell];
+
+    // Move the last entry of the cell into the vacated index.
+    uint32_t last = static_cast<uint32_t>(cell.handles.size() - 1);
+    if (slot.index != last)
+    {
+        Handle moved = cell.handles[last];
+
+        cell.x[slot.index] = cell.x[last];
+        cell.z[slot.index] = cell.z[last];
+        cell.handles[slot.index] = moved;
+        slots_[moved].index = slot.index;
+    }
+
+    cell.x.pop_back();
+    cell.z.pop_back();
+    cell.handles.pop_back();
+}
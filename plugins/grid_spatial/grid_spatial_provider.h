@@ -0,0 +1,92 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef PLUGINS_GRID_SPATIAL_GRID_SPATIAL_PROVIDER_H_
+#define PLUGINS_GRID_SPATIAL_GRID_SPATIAL_PROVIDER_H_
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "swganh/simulation/spatial_provider_interface.h"
+
+namespace plugins {
+namespace grid_spatial {
+
+/**
+ * Spatial index over a uniform grid of square cells.
+ *
+ * Each cell keeps its objects' coordinates in flat float arrays so a query tests
+ * positions without touching the objects themselves. Objects are tracked by a slot
+ * handle, which makes adding, removing and moving an object constant time. Positions
+ * outside of the map are clamped into the border cells rather than rejected.
+ */
+class GridSpatialProvider : public swganh::simulation::SpatialProviderInterface
+{
+public:
+    /**
+     * @param map_extent Half the width of the indexed area, centered on the origin.
+     * @param cell_size Width of a grid cell, ideally close to the common query range.
+     */
+    GridSpatialProvider(anh::app::KernelInterface* kernel, float map_extent = 8300.0f, float cell_size = 64.0f);
+    virtual ~GridSpatialProvider();
+
+    virtual void AddObject(std::shared_ptr<swganh::object::Object> obj);
+    virtual void RemoveObject(std::shared_ptr<swganh::object::Object> obj);
+    virtual void UpdateObject(std::shared_ptr<swganh::object::Object> obj, glm::vec3 old_position, glm::vec3 new_position);
+
+    virtual std::vector<std::shared_ptr<swganh::object::Object>> GetObjectsInRange(glm::vec3 point, float range);
+    virtual std::vector<std::shared_ptr<swganh::object::Object>> GetObjectsInBox(glm::vec3 min, glm::vec3 max);
+
+    virtual void VisitObjectsInRange(glm::vec3 point, float range, const swganh::simulation::ObjectVisitor& visitor);
+    virtual void VisitObjectsInBox(glm::vec3 min, glm::vec3 max, const swganh::simulation::ObjectVisitor& visitor);
+
+    /// The number of objects currently indexed.
+    size_t size() const;
+
+private:
+    typedef uint32_t Handle;
+
+    /**
+     * The objects in one grid cell, stored as parallel arrays.
+     */
+    struct Cell
+    {
+        std::vector<float> x;
+        std::vector<float> z;
+        std::vector<Handle> handles;
+    };
+
+    /**
+     * Where an indexed object lives, addressed by its handle.
+     */
+    struct Slot
+    {
+        std::shared_ptr<swganh::object::Object> object;
+        uint32_t cell;
+        uint32_t index;
+    };
+
+    uint32_t CellCoordinate_(float coordinate) const;
+    uint32_t CellIndex_(float x, float z) const;
+
+    void InsertIntoCell_(Handle handle, uint32_t cell_index, float x, float z);
+    void RemoveFromCell_(Handle handle);
+
+    float map_extent_;
+    float cell_size_;
+    float inverse_cell_size_;
+    uint32_t cells_per_side_;
+
+    std::vector<Cell> cells_;
+    std::vector<Slot> slots_;
+    std::vector<Handle> free_handles_;
+    std::unordered_map<uint64_t, Handle> handles_;
+};
+
+}}  // namespace plugins::grid_spatial
+
+#endif  // PLUGINS_GRID_SPATIAL_GRID_SPATIAL_PROVIDER_H_
@@ -0,0 +1,171 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE Grid Spatial Provider Test
+#include <boost/test/unit_test.hpp>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/random.hpp>
+
+#include "anh/event_dispatcher.h"
+#include "swganh/object/object.h"
+
+#include "grid_spatial_provider.h"
+
+using namespace plugins::grid_spatial;
+using swganh::object::Object;
+
+namespace {
+
+size_t CountInRange(GridSpatialProvider& provider, glm::vec3 point, float range)
+{
+    size_t count = 0;
+    provider.VisitObjectsInRange(point, range, [&count] (const std::shared_ptr<Object>&) { ++count; });
+    return count;
+}
+
+}  // namespace
+
+///
+class GridSpatialProviderTest {
+public:
+    GridSpatialProviderTest()
+        : event_dispatcher_(io_service_)
+        , provider_(nullptr, 3000.0f, 64.0f)
+    {}
+
+protected:
+    std::shared_ptr<Object> CreateObject(uint64_t object_id, glm::vec3 position)
+    {
+        auto object = std::make_shared<Object>();
+        object->SetEventDispatcher(&event_dispatcher_);
+        object->SetObjectId(object_id);
+        object->SetPosition(position);
+        return object;
+    }
+
+    boost::asio::io_service io_service_;
+    anh::EventDispatcher event_dispatcher_;
+    GridSpatialProvider provider_;
+};
+
+BOOST_FIXTURE_TEST_SUITE(GridSpatialProvider, GridSpatialProviderTest)
+
+///
+BOOST_AUTO_TEST_CASE(CanAddRemoveObject)
+{
+    auto obj = CreateObject(1, glm::vec3(10.0f, 0.0f, 10.0f));
+
+    provider_.AddObject(obj);
+    BOOST_CHECK_EQUAL(1, provider_.size());
+    BOOST_CHECK_EQUAL(1, provider_.GetObjectsInRange(glm::vec3(10.0f, 0.0f, 10.0f), 1.0f).size());
+
+    provider_.RemoveObject(obj);
+    BOOST_CHECK_EQUAL(0, provider_.size());
+    BOOST_CHECK_EQUAL(0, provider_.GetObjectsInRange(glm::vec3(10.0f, 0.0f, 10.0f), 1.0f).size());
+}
+
+///
+BOOST_AUTO_TEST_CASE(RangeQueryFiltersByDistance)
+{
+    auto inside = CreateObject(1, glm::vec3(105.0f, 0.0f, 95.0f));
+    auto corner = CreateObject(2, glm::vec3(108.0f, 0.0f, 108.0f));
+
+    provider_.AddObject(inside);
+    provider_.AddObject(corner);
+
+    auto objects = provider_.GetObjectsInRange(glm::vec3(100.0f, 0.0f, 100.0f), 10.0f);
+    BOOST_REQUIRE_EQUAL(1, objects.size());
+    BOOST_CHECK_EQUAL(1, objects[0]->GetObjectId());
+
+    BOOST_CHECK_EQUAL(2, provider_.GetObjectsInBox(glm::vec3(90.0f, 0.0f, 90.0f), glm::vec3(110.0f, 0.0f, 110.0f)).size());
+}
+
+///
+BOOST_AUTO_TEST_CASE(UpdateMovesObjectBetweenCells)
+{
+    auto obj = CreateObject(1, glm::vec3(10.0f, 0.0f, 10.0f));
+    auto neighbor = CreateObject(2, glm::vec3(12.0f, 0.0f, 12.0f));
+
+    provider_.AddObject(obj);
+    provider_.AddObject(neighbor);
+
+    glm::vec3 new_position(-500.0f, 0.0f, 400.0f);
+    provider_.UpdateObject(obj, obj->GetPosition(), new_position);
+
+    BOOST_CHECK_EQUAL(1, CountInRange(provider_, glm::vec3(10.0f, 0.0f, 10.0f), 5.0f));
+    BOOST_CHECK_EQUAL(1, CountInRange(provider_, new_position, 5.0f));
+
+    // Moving within a cell only changes the stored coordinates.
+    provider_.UpdateObject(neighbor, neighbor->GetPosition(), glm::vec3(40.0f, 0.0f, 40.0f));
+    BOOST_CHECK_EQUAL(0, CountInRange(provider_, glm::vec3(10.0f, 0.0f, 10.0f), 5.0f));
+    BOOST_CHECK_EQUAL(1, CountInRange(provider_, glm::vec3(40.0f, 0.0f, 40.0f), 1.0f));
+
+    provider_.RemoveObject(obj);
+    BOOST_CHECK_EQUAL(0, CountInRange(provider_, new_position, 5.0f));
+    BOOST_CHECK_EQUAL(1, CountInRange(provider_, glm::vec3(40.0f, 0.0f, 40.0f), 1.0f));
+}
+
+///
+BOOST_AUTO_TEST_CASE(OutOfBoundsPositionsAreClamped)
+{
+    auto obj = CreateObject(1, glm::vec3(5000.0f, 0.0f, -5000.0f));
+
+    BOOST_CHECK_NO_THROW(provider_.AddObject(obj));
+
+    BOOST_CHECK_EQUAL(1, CountInRange(provider_, glm::vec3(5000.0f, 0.0f, -5000.0f), 1.0f));
+    BOOST_CHECK_EQUAL(0, CountInRange(provider_, glm::vec3(2990.0f, 0.0f, -2990.0f), 20.0f));
+}
+
+///
+BOOST_AUTO_TEST_CASE(RangeQueryMatchesBruteForce)
+{
+    std::vector<std::shared_ptr<Object>> objects;
+    std::vector<glm::vec3> positions;
+    boost::random::mt19937 gen;
+    boost::random::uniform_real_distribution<> random_generator(-3000.0f, 3000.0f);
+
+    for (int i = 0; i < 5000; i++)
+    {
+        glm::vec3 position(random_generator(gen), 0.0f, random_generator(gen));
+        objects.push_back(CreateObject(i + 1, position));
+        positions.push_back(position);
+        provider_.AddObject(objects[i]);
+    }
+
+    // Move half of the objects and remove a tenth of them.
+    for (int i = 0; i < 5000; i += 2)
+    {
+        glm::vec3 position(random_generator(gen), 0.0f, random_generator(gen));
+        provider_.UpdateObject(objects[i], positions[i], position);
+        positions[i] = position;
+    }
+
+    for (int i = 0; i < 5000; i += 10)
+    {
+        provider_.RemoveObject(objects[i]);
+    }
+
+    BOOST_CHECK_EQUAL(4500, provider_.size());
+
+    const float ranges[] = {16.0f, 128.0f, 1024.0f};
+    for (int q = 0; q < 30; q++)
+    {
+        glm::vec3 center(random_generator(gen), 0.0f, random_generator(gen));
+        float range = ranges[q % 3];
+
+        size_t expected = 0;
+        for (int i = 0; i < 5000; i++)
+        {
+            float dx = positions[i].x - center.x, dz = positions[i].z - center.z;
+            if (i % 10 != 0 && dx * dx + dz * dz <= range * range)
+                ++expected;
+        }
+
+        BOOST_CHECK_EQUAL(expected, CountInRange(provider_, center, range));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,87 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <iostream>
+
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/variables_map.hpp>
+
+#include "anh/logger.h"
+
+#include "anh/app/kernel_interface.h"
+#include "anh/plugin/bindings.h"
+#include "anh/plugin/plugin_manager.h"
+
+#include "grid_spatial_provider.h"
+
+#include "version.h"
+
+using namespace anh::app;
+using namespace anh::plugin;
+using namespace plugins::grid_spatial;
+using namespace std;
+
+using boost::any_cast;
+using boost::program_options::options_description;
+using boost::program_options::variables_map;
+
+struct GridSpatialConfig
+{
+    float map_extent;
+    float cell_size;
+} config;
+
+extern "C" PLUGIN_API void ExitModule()
+{
+    return;
+}
+
+
+extern "C" PLUGIN_API  void ConfigurePlugin(options_description& description)
+{
+    description.add_options()
+        ("grid_spatial.map_extent", boost::program_options::value<float>(&config.map_extent)->default_value(8300.0f),
+            "Half the width of the indexed area, positions beyond it share the border cells")
+        ("grid_spatial.cell_size", boost::program_options::value<float>(&config.cell_size)->default_value(64.0f),
+            "Width of a grid cell, best kept close to the most common query range")
+    ;
+
+    return;
+}
+
+extern "C" PLUGIN_API ExitFunc InitializePlugin(KernelInterface* kernel) 
+{
+    // Fall back to the defaults when no plugin configuration was loaded.
+    if (!(config.map_extent > 0.0f))
+    {
+        config.map_extent = 8300.0f;
+    }
+
+    if (!(config.cell_size > 0.0f))
+    {
+        config.cell_size = 64.0f;
+    }
+
+    ObjectRegistration registration;
+    registration.version.major = VERSION_MAJOR;
+    registration.version.minor = VERSION_MINOR;
+
+    registration.CreateObject = [kernel] (ObjectParams* params) -> void * {
+        return new GridSpatialProvider(kernel, config.map_extent, config.cell_size);
+    };
+    
+    registration.DestroyObject = [] (void * object) {
+        if (object) {
+            delete static_cast<GridSpatialProvider*>(object);
+        }
+    };
+    
+    // The first registration of an object name wins, load this plugin before pub14_core
+    // to replace the quadtree provider.
+    if (!kernel->GetPluginManager()->RegisterObject("SimulationService::SpatialProvider", &registration))
+    {
+        LOG(warning) << "grid_spatial: a spatial provider is already registered, load this plugin before pub14_core";
+    }
+
+    return ExitModule;
+}
@@ -0,0 +1,91 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include "anh/cpu_features.h"
+
+#include <cstdint>
+
+#if defined(ANH_X86_INTRINSICS) && defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(ANH_X86_INTRINSICS)
+#include <cpuid.h>
+#endif
+
+using namespace anh;
+
+namespace {
+
+#ifdef ANH_X86_INTRINSICS
+    bool Cpuid(uint32_t leaf, uint32_t registers[4])
+    {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        if (static_cast<uint32_t>(info[0]) < leaf)
+        {
+            return false;
+        }
+
+        __cpuidex(info, leaf, 0);
+        for (int i = 0; i < 4; ++i)
+        {
+            registers[i] = static_cast<uint32_t>(info[i]);
+        }
+
+        return true;
+#else
+        if (__get_cpuid_max(0, nullptr) < leaf)
+        {
+            return false;
+        }
+
+        __cpuid_count(leaf, 0, registers[0], registers[1], registers[2], registers[3]);
+        return true;
+#endif
+    }
+
+    /// The os must save the ymm registers on context switches before avx can be used.
+    bool OsSavesYmmRegisters()
+    {
+#ifdef _MSC_VER
+        return (_xgetbv(0) & 0x6) == 0x6;
+#else
+        uint32_t eax, edx;
+        __asm__ ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (eax & 0x6) == 0x6;
+#endif
+    }
+#endif
+
+    CpuFeatures DetectCpuFeatures()
+    {
+        CpuFeatures features = { false, false, false, false };
+
+#ifdef ANH_X86_INTRINSICS
+        uint32_t registers[4]; // eax, ebx, ecx, edx
+
+        if (Cpuid(1, registers))
+        {
+            features.sse2 = (registers[3] & (1u << 26)) != 0;
+            features.sse41 = (registers[2] & (1u << 19)) != 0;
+            features.pclmul = (registers[2] & (1u << 1)) != 0;
+
+            bool osxsave = (registers[2] & (1u << 27)) != 0;
+
+            if (osxsave && OsSavesYmmRegisters() && Cpuid(7, registers))
+            {
+                features.avx2 = (registers[1] & (1u << 5)) != 0;
+            }
+        }
+#endif
+
+        return features;
+    }
+
+}  // namespace
+
+const CpuFeatures& anh::GetCpuFeatures()
+{
+    static const CpuFeatures features = DetectCpuFeatures();
+    return features;
+}
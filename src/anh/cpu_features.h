@@ -0,0 +1,39 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef LIBANH_CPU_FEATURES_H_
+#define LIBANH_CPU_FEATURES_H_
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+/// Defined when x86 intrinsics can be compiled for individual functions.
+#define ANH_X86_INTRINSICS
+/// Enables instruction sets beyond the build's baseline for a single function.
+#define ANH_TARGET(instruction_sets) __attribute__((target(instruction_sets)))
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define ANH_X86_INTRINSICS
+#define ANH_TARGET(instruction_sets)
+#endif
+
+namespace anh {
+
+/**
+ * @brief Instruction set extensions of the cpu the process runs on.
+ *
+ * Detected once on first use. Always false on non-x86 builds.
+ */
+struct CpuFeatures
+{
+    bool sse2;
+    bool sse41;
+    bool pclmul;
+    bool avx2;
+};
+
+/**
+ * @return The features of the current cpu.
+ */
+const CpuFeatures& GetCpuFeatures();
+
+}  // namespace anh
+
+#endif  // LIBANH_CPU_FEATURES_H_
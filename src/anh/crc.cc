@@ -3,6 +3,12 @@
 
 #include "anh/crc.h"
 
+#include "anh/cpu_features.h"
+
+#ifdef ANH_X86_INTRINSICS
+#include <immintrin.h>
+#endif
+
 using namespace anh;
 
 const uint32_t CRC_TABLE[256] = {
@@ -106,14 +112,266 @@ const uint32_t CRC_ZIP_TABLE[256] = {
   0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d
 };
 
-uint32_t anh::memcrc(const char* source_string, uint32_t length) 
+namespace {
+
+    /**
+     * Tables for processing 8 bytes per step, table[k][b] is the crc of byte b followed
+     * by k zero bytes. Built on first use so checksums calculated during static
+     * initialization (e.g. HashString constants) are safe.
+     */
+    struct SliceTables
+    {
+        SliceTables()
+        {
+            for (uint32_t i = 0; i < 256; ++i)
+            {
+                cksum[0][i] = CRC_TABLE[i];
+                zip[0][i] = CRC_ZIP_TABLE[i];
+            }
+
+            for (uint32_t k = 1; k < 8; ++k)
+            {
+                for (uint32_t i = 0; i < 256; ++i)
+                {
+                    cksum[k][i] = (cksum[k - 1][i] << 8) ^ CRC_TABLE[cksum[k - 1][i] >> 24];
+                    zip[k][i] = (zip[k - 1][i] >> 8) ^ CRC_ZIP_TABLE[zip[k - 1][i] & 0xFF];
+                }
+            }
+        }
+
+        uint32_t cksum[8][256];
+        uint32_t zip[8][256];
+    };
+
+    const SliceTables& GetSliceTables()
+    {
+        static const SliceTables tables;
+        return tables;
+    }
+
+    uint32_t CksumBytewise(uint32_t crc, const unsigned char* data, uint32_t length)
+    {
+        for (uint32_t i = 0; i < length; ++i)
+        {
+            crc = CRC_TABLE[data[i] ^ (crc >> 24)] ^ (crc << 8);
+        }
+
+        return crc;
+    }
+
+    uint32_t CksumSliceBy8(uint32_t crc, const unsigned char* data, uint32_t length)
+    {
+        const SliceTables& tables = GetSliceTables();
+
+        for (; length >= 8; length -= 8, data += 8)
+        {
+            crc ^= (uint32_t(data[0]) << 24) | (uint32_t(data[1]) << 16)
+                | (uint32_t(data[2]) << 8) | data[3];
+
+            crc = tables.cksum[7][crc >> 24] ^ tables.cksum[6][(crc >> 16) & 0xFF]
+                ^ tables.cksum[5][(crc >> 8) & 0xFF] ^ tables.cksum[4][crc & 0xFF]
+                ^ tables.cksum[3][data[4]] ^ tables.cksum[2][data[5]]
+                ^ tables.cksum[1][data[6]] ^ tables.cksum[0][data[7]];
+        }
+
+        return CksumBytewise(crc, data, length);
+    }
+
+    uint32_t ZipBytewise(uint32_t crc, const unsigned char* data, uint32_t length)
+    {
+        for (uint32_t i = 0; i < length; ++i)
+        {
+            crc = CRC_ZIP_TABLE[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+
+        return crc;
+    }
+
+    uint32_t ZipSliceBy8(uint32_t crc, const unsigned char* data, uint32_t length)
+    {
+        const SliceTables& tables = GetSliceTables();
+
+        for (; length >= 8; length -= 8, data += 8)
+        {
+            crc ^= data[0] | (uint32_t(data[1]) << 8)
+                | (uint32_t(data[2]) << 16) | (uint32_t(data[3]) << 24);
+
+            crc = tables.zip[7][crc & 0xFF] ^ tables.zip[6][(crc >> 8) & 0xFF]
+                ^ tables.zip[5][(crc >> 16) & 0xFF] ^ tables.zip[4][crc >> 24]
+                ^ tables.zip[3][data[4]] ^ tables.zip[2][data[5]]
+                ^ tables.zip[1][data[6]] ^ tables.zip[0][data[7]];
+        }
+
+        return ZipBytewise(crc, data, length);
+    }
+
+#ifdef ANH_X86_INTRINSICS
+    /**
+     * Folds 64 byte blocks with carryless multiplies and Barrett reduces the result,
+     * following Intel's "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ".
+     * The constants are for the bit-reflected zip polynomial.
+     *
+     * @param length At least 64 and a multiple of 16.
+     */
+    ANH_TARGET("pclmul,sse4.1")
+    uint32_t ZipCarrylessMultiply(uint32_t crc, const unsigned char* data, uint32_t length)
+    {
+        const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+        const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+        const __m128i k5k0 = _mm_set_epi64x(0, 0x0163cd6124);
+        const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+        const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+        __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x00));
+        __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x10));
+        __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x20));
+        __m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x30));
+
+        x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+
+        data += 64;
+        length -= 64;
+
+        // Fold four lanes in parallel while whole blocks remain.
+        for (; length >= 64; length -= 64, data += 64)
+        {
+            __m128i x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+            __m128i x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+            __m128i x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+            __m128i x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+
+            x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+            x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+            x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+            x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+
+            x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x00)));
+            x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x10)));
+            x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x20)));
+            x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x30)));
+        }
+
+        // Fold the four lanes into one, then any remaining 16 byte blocks into that.
+        __m128i lanes[3] = { x2, x3, x4 };
+        for (int i = 0; i < 3; ++i)
+        {
+            __m128i x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+            x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+            x1 = _mm_xor_si128(_mm_xor_si128(x1, lanes[i]), x5);
+        }
+
+        for (; length >= 16; length -= 16, data += 16)
+        {
+            __m128i x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+            x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+            x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data))), x5);
+        }
+
+        // Fold 128 bits to 64.
+        x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+        x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+        x2 = _mm_srli_si128(x1, 4);
+        x1 = _mm_and_si128(x1, mask32);
+        x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k5k0, 0x00), x2);
+
+        // Barrett reduce to 32 bits.
+        x2 = _mm_and_si128(x1, mask32);
+        x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+        x2 = _mm_and_si128(x2, mask32);
+        x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+        x1 = _mm_xor_si128(x1, x2);
+
+        return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+    }
+#endif
+
+    CrcEngine DetectCrcEngine()
+    {
+#ifdef ANH_X86_INTRINSICS
+        if (GetCpuFeatures().pclmul && GetCpuFeatures().sse41)
+        {
+            return CRC_ENGINE_CARRYLESS_MULTIPLY;
+        }
+#endif
+
+        return CRC_ENGINE_SLICE_BY_8;
+    }
+
+    uint32_t Cksum(const char* source_string, uint32_t length, CrcEngine engine)
+    {
+        // Bytes are unsigned, a signed char would index before the table.
+        const unsigned char* data = reinterpret_cast<const unsigned char*>(source_string);
+        uint32_t crc = 0xffffffff;  // starting seed
+
+        if (engine == CRC_ENGINE_BYTEWISE)
+        {
+            crc = CksumBytewise(crc, data, length);
+        }
+        else
+        {
+            crc = CksumSliceBy8(crc, data, length);
+        }
+
+        return ~crc;
+    }
+
+    uint32_t SeededZip(const unsigned char* src_buffer, uint32_t length, uint32_t seed, CrcEngine engine)
+    {
+        // The seed is checksummed as 4 little endian bytes ahead of the data.
+        const unsigned char seed_bytes[4] = {
+            static_cast<unsigned char>(seed),
+            static_cast<unsigned char>(seed >> 8),
+            static_cast<unsigned char>(seed >> 16),
+            static_cast<unsigned char>(seed >> 24)
+        };
+
+        uint32_t crc = ZipBytewise(0xffffffff, seed_bytes, sizeof(seed_bytes));
+
+        if (engine == CRC_ENGINE_BYTEWISE)
+        {
+            return ~ZipBytewise(crc, src_buffer, length);
+        }
+
+#ifdef ANH_X86_INTRINSICS
+        if (engine == CRC_ENGINE_CARRYLESS_MULTIPLY && length >= 64 && IsCrcEngineSupported(engine))
+        {
+            uint32_t folded_length = length & ~15u;
+
+            crc = ZipCarrylessMultiply(crc, src_buffer, folded_length);
+            src_buffer += folded_length;
+            length -= folded_length;
+        }
+#endif
+
+        return ~ZipSliceBy8(crc, src_buffer, length);
+    }
+
+}  // namespace
+
+CrcEngine anh::ActiveCrcEngine()
+{
+    static const CrcEngine engine = DetectCrcEngine();
+    return engine;
+}
+
+bool anh::IsCrcEngineSupported(CrcEngine engine)
 {
-    uint32_t crc = 0xffffffff;  // starting seed
-    for (uint32_t i = 0; i < length; ++i) {
-        crc = CRC_TABLE[source_string[i] ^ (crc >> 24)] ^ (crc << 8);
+    switch (engine)
+    {
+    case CRC_ENGINE_BYTEWISE:
+    case CRC_ENGINE_SLICE_BY_8:
+        return true;
+    case CRC_ENGINE_CARRYLESS_MULTIPLY:
+        return ActiveCrcEngine() == CRC_ENGINE_CARRYLESS_MULTIPLY;
     }
 
-    return ~crc;
+    return false;
+}
+
+uint32_t anh::memcrc(const char* source_string, uint32_t length)
+{
+    return Cksum(source_string, length, ActiveCrcEngine());
 }
 
 uint32_t anh::memcrc(const std::string& source_string) 
@@ -123,26 +381,15 @@ uint32_t anh::memcrc(const std::string& source_string)
 
 uint32_t anh::memcrc(const unsigned char* src_buffer, uint32_t length, uint32_t seed)
 {
-	uint32_t newCRC = 0, index = 0;
-
-    newCRC = CRC_ZIP_TABLE[(~seed) & 0xFF];
-    newCRC ^= 0x00FFFFFF;
-    index = (seed >> 8) ^ newCRC;
-    newCRC = (newCRC >> 8) & 0x00FFFFFF;
-    newCRC ^= CRC_ZIP_TABLE[index & 0xFF];
-    index = (seed >> 16) ^ newCRC;
-    newCRC = (newCRC >> 8) & 0x00FFFFFF;
-    newCRC ^= CRC_ZIP_TABLE[index & 0xFF];
-    index = (seed >> 24) ^ newCRC;
-    newCRC = (newCRC >> 8) &0x00FFFFFF;
-    newCRC ^= CRC_ZIP_TABLE[index & 0xFF];
-
-    for(uint32_t i = 0; i < length; i++ )
-    {
-        index = (src_buffer[i]) ^ newCRC;
-        newCRC = (newCRC >> 8) & 0x00FFFFFF;
-        newCRC ^= CRC_ZIP_TABLE[index & 0xFF];
-    }
+    return SeededZip(src_buffer, length, seed, ActiveCrcEngine());
+}
 
-    return ~newCRC;
-}
\ No newline at end of file
+uint32_t anh::memcrc(const char* source_string, uint32_t length, CrcEngine engine)
+{
+    return Cksum(source_string, length, engine);
+}
+
+uint32_t anh::memcrc(const unsigned char* src_buffer, uint32_t length, uint32_t seed, CrcEngine engine)
+{
+    return SeededZip(src_buffer, length, seed, engine);
+}
@@ -46,6 +46,46 @@ uint32_t memcrc(const std::string& source_string);
  */
 uint32_t memcrc(const unsigned char* src_buffer, uint32_t length, uint32_t seed);
 
+/**
+ * @brief The implementations the memcrc functions can run on.
+ *
+ * All engines produce identical checksums, the fastest one the cpu supports is
+ * selected the first time a checksum is calculated.
+ */
+enum CrcEngine
+{
+    CRC_ENGINE_BYTEWISE = 0,    ///< One table lookup per byte.
+    CRC_ENGINE_SLICE_BY_8,      ///< Eight table lookups per 8 bytes.
+    CRC_ENGINE_CARRYLESS_MULTIPLY  ///< PCLMULQDQ folding of 64 byte blocks (x86 only).
+};
+
+/**
+ * @return The engine used by the memcrc functions.
+ */
+CrcEngine ActiveCrcEngine();
+
+/**
+ * @return True if the engine can run on this cpu.
+ */
+bool IsCrcEngineSupported(CrcEngine engine);
+
+/**
+ * @brief Calculates a 32-bit checksum of a c-style string on a specific engine.
+ *
+ * The cksum polynomial has no carryless multiply path, that engine falls back to
+ * slice-by-8 here. Intended for tests and benchmarks.
+ */
+uint32_t memcrc(const char* source_string, uint32_t length, CrcEngine engine);
+
+/**
+ * @brief Calculates a 32-bit checksum of a buffer using a custom seed on a specific
+ * engine.
+ *
+ * Falls back to slice-by-8 if the engine is not supported. Intended for tests and
+ * benchmarks.
+ */
+uint32_t memcrc(const unsigned char* src_buffer, uint32_t length, uint32_t seed, CrcEngine engine);
+
 }  // namespace anh
 
 #endif  // LIBANH_CRC_H_
@@ -1,13 +1,67 @@
 // This file is part of SWGANH which is released under the MIT license.
 // See file LICENSE or go to http://swganh.com/LICENSE
 
+#include <cstdlib>
+#include <vector>
 #include <boost/test/unit_test.hpp>
 
 #include "anh/crc.h"
 
-using anh::memcrc;
+using namespace anh;
 #define BOOST_TEST_MAIN
 #define BOOST_TEST_MODULE ANH CRC
+
+namespace {
+
+const CrcEngine kEngines[] = {
+    CRC_ENGINE_BYTEWISE,
+    CRC_ENGINE_SLICE_BY_8,
+    CRC_ENGINE_CARRYLESS_MULTIPLY
+};
+
+struct SeededVector
+{
+    uint32_t length;
+    uint32_t crc_with_seed;
+    uint32_t crc_without_seed;
+};
+
+/// Checksums of the first length bytes of GoldenData(), taken from the original
+/// byte at a time implementation. Lengths straddle the 8, 16 and 64 byte blocks.
+const SeededVector kSeededVectors[] = {
+    { 0, 0xAB6F2AD5, 0x2144DF1C },
+    { 1, 0xBA74335F, 0x584662BE },
+    { 7, 0xE08C4D08, 0xC8A357B0 },
+    { 8, 0x7C33098A, 0xB9A11D2E },
+    { 15, 0x435AED87, 0x82AC3033 },
+    { 16, 0x2995F905, 0xE558784D },
+    { 63, 0x0CBD2715, 0x939F7BC5 },
+    { 64, 0x67DE9D9B, 0xE1926D13 },
+    { 65, 0xB0B82CCF, 0x535D6B2D },
+    { 127, 0x20D90428, 0x063FAB8E },
+    { 128, 0xA4FE7719, 0x9B6D976B },
+    { 200, 0xFF0B072C, 0xB75B6A3E },
+    { 496, 0x7373151F, 0xF30DA797 },
+    { 512, 0x87BE39DA, 0x03686848 },
+    { 1024, 0x90F04C26, 0x890D0C2B },
+};
+
+const uint32_t kGoldenSeed = 0x3C5A1F0D;
+
+std::vector<unsigned char> GoldenData()
+{
+    std::vector<unsigned char> data(1024);
+
+    for (uint32_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<unsigned char>(i * 31 + 7);
+    }
+
+    return data;
+}
+
+}  // namespace
+
 BOOST_AUTO_TEST_SUITE(ANHCRC)
 /// This test shows how to find the 32bit checksum of a c-style string.
 BOOST_AUTO_TEST_CASE(CanCrcCstyleStrings) {
@@ -22,4 +76,75 @@ BOOST_AUTO_TEST_CASE(CanCrcStdStrings) {
     BOOST_CHECK_EQUAL(0x2643D57C, memcrc(std::string("anothertest")));
     BOOST_CHECK_EQUAL(0x19522193, memcrc(std::string("aThirdTest")));
 }
-BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
+
+/// Verifies every engine matches the cksum check value and the golden strings.
+BOOST_AUTO_TEST_CASE(StringEnginesMatchGoldenValues) {
+    for (CrcEngine engine : kEngines)
+    {
+        BOOST_CHECK_EQUAL(0xFC891918, memcrc("123456789", 9, engine));
+        BOOST_CHECK_EQUAL(0x338BCFAC, memcrc("test", 4, engine));
+        BOOST_CHECK_EQUAL(0xAF1DC1A1, memcrc("object/creature/player/shared_human_male.iff", 44, engine));
+    }
+}
+
+/// Verifies bytes above 0x7F are checksummed as unsigned values.
+BOOST_AUTO_TEST_CASE(StringBytesAreUnsigned) {
+    for (CrcEngine engine : kEngines)
+    {
+        BOOST_CHECK_EQUAL(0x343F160D, memcrc("\xC3\xA9t\xC3\xA9", 5, engine));
+    }
+}
+
+/// Verifies the seeded soe checksum of the standard check string.
+BOOST_AUTO_TEST_CASE(CanCrcSeededBuffers) {
+    const unsigned char* check = reinterpret_cast<const unsigned char*>("123456789");
+
+    BOOST_CHECK_EQUAL(0x22896B0A, memcrc(check, 9, 0));
+    BOOST_CHECK_EQUAL(0x4D8E8339, memcrc(check, 9, 0xDEADBEEF));
+}
+
+/// Verifies every engine produces the golden seeded checksums.
+BOOST_AUTO_TEST_CASE(SeededEnginesMatchGoldenValues) {
+    std::vector<unsigned char> data = GoldenData();
+
+    for (CrcEngine engine : kEngines)
+    {
+        for (const SeededVector& vector : kSeededVectors)
+        {
+            BOOST_CHECK_EQUAL(vector.crc_with_seed, memcrc(&data[0], vector.length, kGoldenSeed, engine));
+            BOOST_CHECK_EQUAL(vector.crc_without_seed, memcrc(&data[0], vector.length, 0, engine));
+        }
+    }
+}
+
+/// Verifies the engines agree on every length and alignment a packet can have.
+BOOST_AUTO_TEST_CASE(SeededEnginesAgreeOnUnalignedBuffers) {
+    std::vector<unsigned char> data(600);
+    srand(1);
+
+    for (unsigned char& byte : data)
+    {
+        byte = static_cast<unsigned char>(rand());
+    }
+
+    for (uint32_t offset = 0; offset < 16; offset += 3)
+    {
+        for (uint32_t length = 0; length <= 496; ++length)
+        {
+            uint32_t seed = length * 2654435761u;
+            uint32_t expected = memcrc(&data[offset], length, seed, CRC_ENGINE_BYTEWISE);
+
+            BOOST_CHECK_EQUAL(expected, memcrc(&data[offset], length, seed, CRC_ENGINE_SLICE_BY_8));
+            BOOST_CHECK_EQUAL(expected, memcrc(&data[offset], length, seed, CRC_ENGINE_CARRYLESS_MULTIPLY));
+            BOOST_CHECK_EQUAL(expected, memcrc(&data[offset], length, seed));
+        }
+    }
+}
+
+/// Verifies the engine selected at runtime is one the cpu supports.
+BOOST_AUTO_TEST_CASE(ActiveEngineIsSupported) {
+    BOOST_CHECK(IsCrcEngineSupported(ActiveCrcEngine()));
+    BOOST_CHECK(IsCrcEngineSupported(CRC_ENGINE_BYTEWISE));
+    BOOST_CHECK(IsCrcEngineSupported(CRC_ENGINE_SLICE_BY_8));
+}
+BOOST_AUTO_TEST_SUITE_END()
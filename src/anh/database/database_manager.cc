@@ -6,24 +6,35 @@
 #include "anh/database/database_manager.h"
 
 #include <algorithm>
+#include <atomic>
+#include <deque>
 #include <functional>
+#include <list>
 #include <memory>
-#include <queue>
+#include <string>
+#include <unordered_map>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/chrono.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
 
 #include <cppconn/driver.h>
 #include <cppconn/connection.h>
+#include <cppconn/exception.h>
 #include <cppconn/prepared_statement.h>
+#include <cppconn/statement.h>
+
+#include "anh/logger.h"
 
 #ifdef WIN32
 #include <concurrent_unordered_map.h>
-#include <concurrent_queue.h>
 #else
 #include <tbb/concurrent_unordered_map.h>
-#include <tbb/concurrent_queue.h>
 
 namespace Concurrency {
     using ::tbb::concurrent_unordered_map;
-    using ::tbb::concurrent_queue;
 }
 
 #endif
@@ -33,42 +44,136 @@ using namespace std;
 
 class anh::database::DatabaseManagerImpl {
 public:
-     
-    struct ConnectionData {
-        ConnectionData(std::string schema_, std::string host_, std::string username_, std::string password_)
+    typedef boost::chrono::steady_clock Clock;
+
+    struct IdleConnection {
+        IdleConnection(std::shared_ptr<sql::Connection> connection_, Clock::time_point idle_since_)
+            : connection(std::move(connection_))
+            , idle_since(idle_since_)
+        {}
+
+        std::shared_ptr<sql::Connection> connection;
+        Clock::time_point idle_since;
+    };
+
+    /*! Statements prepared on a pooled connection, keyed by their sql text.
+    */
+    struct StatementCache {
+        typedef std::list<std::pair<std::string, std::shared_ptr<sql::PreparedStatement>>> StatementList;
+
+        void clear() {
+            index.clear();
+            statements.clear();
+        }
+
+        // the most recently used first, evicted from the back
+        StatementList statements;
+        std::unordered_map<std::string, StatementList::iterator> index;
+    };
+
+    struct ConnectionPool;
+
+    /*! Deleter of the connections handed out, returns them to their pool.
+    */
+    struct ConnectionReleaser {
+        ConnectionReleaser(std::weak_ptr<ConnectionPool> pool_)
+            : pool(std::move(pool_))
+            , statements(std::make_shared<StatementCache>())
+        {}
+
+        void operator()(sql::Connection* connection) const {
+            recycleConnection_(*this, connection);
+        }
+
+        std::weak_ptr<ConnectionPool> pool;
+
+        // shared by every handle of the same connection
+        std::shared_ptr<StatementCache> statements;
+    };
+
+    struct ConnectionPool {
+        ConnectionPool(std::string schema_, std::string host_, std::string username_, std::string password_, const PoolOptions& options_)
             : schema(std::move(schema_))
             , host(std::move(host_))
             , username(std::move(username_))
             , password(std::move(password_))
-        {}
+            , options(options_)
+            , open(0)
+            , in_use(0)
+            , waiters(0)
+            , checkouts(0)
+            , timeouts(0)
+            , reconnects(0)
+            , statements_prepared(0)
+            , statements_reused(0)
+            , closing(false)
+        {
+            options.max_connections = std::max(1u, options.max_connections);
+            options.min_connections = std::min(options.min_connections, options.max_connections);
+
+            std::fill(std::begin(wait_histogram), std::end(wait_histogram), 0);
+        }
     
         std::string schema;
         std::string host;
         std::string username;
         std::string password;
+        PoolOptions options;
+
+        boost::mutex mutex;
+        boost::condition_variable condition;
+
+        // most recently returned connections are at the back
+        std::deque<IdleConnection> idle;
+
+        uint32_t open;
+        uint32_t in_use;
+        uint32_t waiters;
+        uint64_t checkouts;
+        uint64_t timeouts;
+        uint64_t reconnects;
+        uint64_t wait_histogram[PoolMetrics::WAIT_BUCKETS];
+
+        // updated by the connection's holder without taking the mutex
+        std::atomic<uint64_t> statements_prepared;
+        std::atomic<uint64_t> statements_reused;
+
+        // set once the manager shuts down, connections returned after are closed
+        bool closing;
     };
 
-    explicit DatabaseManagerImpl(sql::Driver* driver)
-        : driver_(driver) {}
+    DatabaseManagerImpl(sql::Driver* driver, uint32_t thread_count)
+        : driver_(driver) 
+        , thread_count_(std::max(1u, thread_count)) {}
 
     ~DatabaseManagerImpl() {
+        // let the queries already submitted finish first
+        {
+            boost::lock_guard<boost::mutex> lock(threads_mutex_);
+            work_.reset();
+        }
+
+        threads_.join_all();
+
         std::for_each(connections_.begin(), connections_.end(), [] (ConnectionPoolMap::value_type& conn) {
-            if (conn.second.empty()) {
-                return;
+            std::deque<IdleConnection> idle;
+
+            {
+                boost::lock_guard<boost::mutex> lock(conn.second->mutex);
+                conn.second->closing = true;
+                idle.swap(conn.second->idle);
+                conn.second->condition.notify_all();
             }
 
-            do {
-                // close each connection and pop it from the list
-                std::shared_ptr<sql::Connection> connection;
-                if (conn.second.try_pop(connection)) {
-                    connection->close();
-                }
-            } while (!conn.second.empty());
+            // close each connection and drop it from the pool
+            std::for_each(idle.begin(), idle.end(), [] (IdleConnection& idle_connection) {
+                idle_connection.connection->close();
+            });
         });
     }
     
     bool hasStorageType(const StorageType& storage_type) const {
-        return connection_data_.find(storage_type) != connection_data_.end();
+        return connections_.find(storage_type) != connections_.end();
     }
 
     bool registerStorageType(
@@ -76,36 +181,39 @@ public:
         const std::string& schema, 
         const std::string& host, 
         const std::string& username, 
-        const std::string& password) 
+        const std::string& password,
+        const PoolOptions& pool_options) 
     {
         if (hasStorageType(storage_type)) 
         {
             return false;
         }
 
-        // create a valid connection to verify the integrity of the data passed in
-        auto connection = std::shared_ptr<sql::Connection>(
-            driver_->connect(host, username, password), 
-            bind(&DatabaseManagerImpl::recycleConnection_, this, storage_type, placeholders::_1));
+        auto pool = make_shared<ConnectionPool>(schema, host, username, password, pool_options);
 
-        connection->setSchema(schema);
+        // create the initial connections, at least one to verify the integrity 
+        // of the data passed in
+        auto connection_count = std::max(1u, pool->options.min_connections);
 
-        // insert the data
-        connection_data_.insert(make_pair(storage_type, make_shared<ConnectionData>(schema, host, username, password)));
+        for (uint32_t i = 0; i < connection_count; ++i)
+        {
+            auto connection = createConnection_(pool);
 
-        // add the created connection to the connection pool
-        connections_[storage_type].push(connection);
+            ++pool->open;
+            pool->idle.push_back(IdleConnection(connection, Clock::now()));
+        }
 
-        return true;
+        return connections_.insert(make_pair(storage_type, pool)).second;
     }
 
     bool hasConnection(const StorageType& storage_type) const {
-        // return whether or not the connection pool for this storage type is empty
+        // return whether or not the connection pool for this storage type has idle connections
         auto find_iter = connections_.find(storage_type);
 
         if (find_iter != end(connections_))
         {
-            return !find_iter->second.empty();
+            boost::lock_guard<boost::mutex> lock(find_iter->second->mutex);
+            return !find_iter->second->idle.empty();
         }
 
         return false;
@@ -115,68 +223,333 @@ public:
     {
         auto connection_pool_iter = connections_.find(storage_type);
 
-        if (connection_pool_iter == connections_.end() || connection_pool_iter->second.empty())
+        if (connection_pool_iter == connections_.end())
+        {
+            assert(false && "Requested a storage type that has not been registered");
+            return nullptr;
+        }
+
+        auto pool = connection_pool_iter->second;
+        auto started = Clock::now();
+        auto deadline = started + boost::chrono::milliseconds(pool->options.checkout_timeout_ms);
+        bool reconnecting = false;
+
+        for (;;)
         {
-            auto connection_data_iter = connection_data_.find(storage_type);
-            if (connection_data_iter == connection_data_.end())
+            std::shared_ptr<sql::Connection> connection;
+            Clock::time_point idle_since;
+
+            {
+                boost::unique_lock<boost::mutex> lock(pool->mutex);
+
+                while (pool->idle.empty() && pool->open >= pool->options.max_connections)
+                {
+                    ++pool->waiters;
+                    auto status = pool->condition.wait_until(lock, deadline);
+                    --pool->waiters;
+
+                    if (status == boost::cv_status::timeout && pool->idle.empty() && pool->open >= pool->options.max_connections)
+                    {
+                        ++pool->timeouts;
+
+                        LOG(warning) << "Timed out after " << pool->options.checkout_timeout_ms 
+                            << "ms waiting for one of " << pool->open << " connections to " << pool->schema;
+                        throw sql::SQLException("Timed out waiting for a database connection");
+                    }
+                }
+
+                ++pool->in_use;
+
+                if (!pool->idle.empty())
+                {
+                    connection = std::move(pool->idle.back().connection);
+                    idle_since = pool->idle.back().idle_since;
+                    pool->idle.pop_back();
+                }
+                else
+                {
+                    // reserve the slot for the connection opened below
+                    ++pool->open;
+                }
+            }
+
+            if (!connection)
+            {
+                try {
+                    connection = createConnection_(pool);
+                } catch(...) {
+                    boost::lock_guard<boost::mutex> lock(pool->mutex);
+                    --pool->open;
+                    --pool->in_use;
+                    pool->condition.notify_one();
+                    throw;
+                }
+
+                recordCheckout_(pool, started, reconnecting);
+                return connection;
+            }
+
+            if (isValid_(connection, idle_since, pool->options))
             {
-                assert(false && "Requested a storage type that has not been registered");
-                return nullptr;
+                recordCheckout_(pool, started, reconnecting);
+                return connection;
             }
-        
-            // create a valid connection to verify the integrity of the data passed in
-            return CreateConnection(connection_data_iter->second, storage_type);
+
+            // the connection was lost while idle, closing it before it is dropped 
+            // keeps it from being recycled, then retry with another one
+            try {
+                connection->close();
+            } catch(sql::SQLException&) {}
+
+            connection.reset();
+            reconnecting = true;
         }
+    }
+
+    std::shared_ptr<sql::PreparedStatement> prepareStatement(const std::shared_ptr<sql::Connection>& connection, const std::string& sql)
+    {
+        auto releaser = std::get_deleter<ConnectionReleaser>(connection);
+        auto pool = releaser ? releaser->pool.lock() : nullptr;
 
-        std::shared_ptr<sql::Connection> connection;        
-        if (!connection_pool_iter->second.try_pop(connection))
+        if (!pool)
         {
-            return nullptr;
+            return std::shared_ptr<sql::PreparedStatement>(connection->prepareStatement(sql));
         }
-        
-        if (connection->isClosed())
+
+        if (pool->options.statement_cache_size == 0)
         {
-            return nullptr;
+            ++pool->statements_prepared;
+            return std::shared_ptr<sql::PreparedStatement>(connection->prepareStatement(sql));
         }
 
-        return connection;
+        // the connection is only used by its holder, the cache needs no lock
+        auto& cache = *releaser->statements;
+
+        auto find_iter = cache.index.find(sql);
+        if (find_iter != cache.index.end())
+        {
+            ++pool->statements_reused;
+
+            cache.statements.splice(cache.statements.begin(), cache.statements, find_iter->second);
+
+            auto& statement = find_iter->second->second;
+            drainResults_(*statement);
+            statement->clearParameters();
+            return statement;
+        }
+
+        auto statement = std::shared_ptr<sql::PreparedStatement>(connection->prepareStatement(sql));
+        ++pool->statements_prepared;
+
+        if (cache.statements.size() >= pool->options.statement_cache_size)
+        {
+            cache.index.erase(cache.statements.back().first);
+            cache.statements.pop_back();
+        }
+
+        cache.statements.push_front(make_pair(sql, statement));
+        cache.index.insert(make_pair(sql, cache.statements.begin()));
+
+        return statement;
+    }
+
+    void post(std::function<void ()> task)
+    {
+        startThreads_();
+        io_service_.post(std::move(task));
+    }
+
+    PoolMetrics getPoolMetrics(const StorageType& storage_type) const
+    {
+        PoolMetrics metrics = PoolMetrics();
+
+        auto find_iter = connections_.find(storage_type);
+        if (find_iter == connections_.end())
+        {
+            return metrics;
+        }
+
+        auto& pool = find_iter->second;
+        boost::lock_guard<boost::mutex> lock(pool->mutex);
+
+        metrics.open = pool->open;
+        metrics.in_use = pool->in_use;
+        metrics.idle = static_cast<uint32_t>(pool->idle.size());
+        metrics.waiters = pool->waiters;
+        metrics.checkouts = pool->checkouts;
+        metrics.timeouts = pool->timeouts;
+        metrics.reconnects = pool->reconnects;
+        metrics.statements_prepared = pool->statements_prepared;
+        metrics.statements_reused = pool->statements_reused;
+        std::copy(std::begin(pool->wait_histogram), std::end(pool->wait_histogram), std::begin(metrics.wait_histogram));
+
+        return metrics;
     }
 
 private:
 
-    std::shared_ptr<sql::Connection> CreateConnection(const shared_ptr<ConnectionData>& connection_data, const StorageType& storage_type)
+    std::shared_ptr<sql::Connection> createConnection_(const shared_ptr<ConnectionPool>& pool)
     {
-        auto connection = std::shared_ptr<sql::Connection>(driver_->connect(connection_data->host, connection_data->username, connection_data->password), 
-                std::bind(&DatabaseManagerImpl::recycleConnection_, this, storage_type, std::placeholders::_1));
-        connection->setSchema(connection_data->schema);
+        auto connection = std::shared_ptr<sql::Connection>(driver_->connect(pool->host, pool->username, pool->password), 
+                ConnectionReleaser(pool));
+        connection->setSchema(pool->schema);
 
         return connection;
     }
 
-    void recycleConnection_(const StorageType& storage_type, sql::Connection* connection) {
-        if (connection->isClosed()) 
+    static bool isValid_(const std::shared_ptr<sql::Connection>& connection, Clock::time_point idle_since, const PoolOptions& options)
+    {
+        if (connection->isClosed())
+        {
+            return false;
+        }
+
+        // the server may have dropped connections that sat idle for a while
+        if (Clock::now() - idle_since < boost::chrono::milliseconds(options.validation_idle_ms))
+        {
+            return true;
+        }
+
+        try {
+            std::unique_ptr<sql::Statement> statement(connection->createStatement());
+            statement->execute("SELECT 1");
+        } catch(sql::SQLException &e) {
+            LOG(warning) << "Dropping lost database connection: " << e.what();
+            return false;
+        }
+
+        return true;
+    }
+
+    static void recordCheckout_(const shared_ptr<ConnectionPool>& pool, Clock::time_point started, bool reconnected)
+    {
+        auto waited = boost::chrono::duration_cast<boost::chrono::microseconds>(Clock::now() - started).count();
+
+        uint32_t bucket = 0;
+        for (int64_t limit = 1000; bucket < PoolMetrics::WAIT_BUCKETS - 1 && waited >= limit; limit *= 10)
+        {
+            ++bucket;
+        }
+
+        boost::lock_guard<boost::mutex> lock(pool->mutex);
+
+        ++pool->checkouts;
+        ++pool->wait_histogram[bucket];
+
+        if (reconnected)
+        {
+            ++pool->reconnects;
+        }
+    }
+
+    /*! Reads the results a statement left pending on its connection.
+    *
+    * A CALL ends with a status result, which has to be read before the
+    * connection runs its next command; a cached statement is never destroyed
+    * between uses, so nothing else reads it.
+    */
+    static void drainResults_(sql::PreparedStatement& statement) {
+        try {
+            while (statement.getMoreResults())
+            {}
+        } catch(sql::SQLException &e) {
+            LOG(warning) << "Failed to read pending results: " << e.what();
+        }
+    }
+
+    static void recycleConnection_(const ConnectionReleaser& releaser, sql::Connection* connection) {
+        bool closed = connection->isClosed();
+
+        if (!closed)
+        {
+            // the next holder starts on a connection with nothing pending
+            for (auto& entry : releaser.statements->statements)
+            {
+                drainResults_(*entry.second);
+            }
+        }
+
+        auto pool = releaser.pool.lock();
+        if (!pool)
+        {
+            destroyConnection_(releaser, connection);
+            return;
+        }
+
+        boost::lock_guard<boost::mutex> lock(pool->mutex);
+
+        if (pool->closing)
+        {
+            destroyConnection_(releaser, connection);
+            return;
+        }
+
+        --pool->in_use;
+
+        if (closed) 
+        {
+            --pool->open;
+            destroyConnection_(releaser, connection);
+        }
+        else
+        {
+            pool->idle.push_back(IdleConnection(shared_ptr<sql::Connection>(connection, releaser), Clock::now()));
+        }
+
+        pool->condition.notify_one();
+    }
+
+    static void destroyConnection_(const ConnectionReleaser& releaser, sql::Connection* connection) {
+        // statements go before the connection they were prepared on
+        releaser.statements->clear();
+        delete connection;
+    }
+
+    void startThreads_()
+    {
+        boost::lock_guard<boost::mutex> lock(threads_mutex_);
+
+        if (work_)
         {
-            delete connection;
             return;
         }
-        
-        connections_[storage_type].push(shared_ptr<sql::Connection>(
-            connection, 
-            bind(&DatabaseManagerImpl::recycleConnection_, this, storage_type, placeholders::_1)));
+
+        work_.reset(new boost::asio::io_service::work(io_service_));
+
+        for (uint32_t i = 0; i < thread_count_; ++i)
+        {
+            threads_.create_thread([this] () {
+                driver_->threadInit();
+
+                for (;;)
+                {
+                    try {
+                        io_service_.run();
+                        break;
+                    } catch(const std::exception& e) {
+                        LOG(error) << "Database task failed: " << e.what();
+                    }
+                }
+
+                driver_->threadEnd();
+            });
+        }
     }
        
     sql::Driver* driver_;
     
-    typedef Concurrency::concurrent_unordered_map<StorageType, std::shared_ptr<ConnectionData>> ConnectionDataMap;
-    ConnectionDataMap connection_data_;
-    
-    typedef Concurrency::concurrent_queue<std::shared_ptr<sql::Connection>> ConnectionPool;
-    typedef Concurrency::concurrent_unordered_map<StorageType, ConnectionPool> ConnectionPoolMap;
+    typedef Concurrency::concurrent_unordered_map<StorageType, std::shared_ptr<ConnectionPool>> ConnectionPoolMap;
     ConnectionPoolMap connections_;
+
+    uint32_t thread_count_;
+    boost::mutex threads_mutex_;
+    boost::asio::io_service io_service_;
+    std::unique_ptr<boost::asio::io_service::work> work_;
+    boost::thread_group threads_;
 };
 
-DatabaseManager::DatabaseManager(sql::Driver* driver)   
-: pimpl_(std::unique_ptr<DatabaseManagerImpl>(new DatabaseManagerImpl(driver)))
+DatabaseManager::DatabaseManager(sql::Driver* driver, uint32_t thread_count)   
+: pimpl_(std::unique_ptr<DatabaseManagerImpl>(new DatabaseManagerImpl(driver, thread_count)))
 {}
 
 DatabaseManager::~DatabaseManager() {}
@@ -186,8 +559,8 @@ bool DatabaseManager::hasStorageType(const StorageType& storage_type) const {
     return pimpl_->hasStorageType(storage_type);
 }
 
-bool DatabaseManager::registerStorageType(const StorageType& storage_type, const std::string& schema, const std::string& host, const std::string& username, const std::string& password) {
-    return pimpl_->registerStorageType(storage_type, schema, host, username, password);
+bool DatabaseManager::registerStorageType(const StorageType& storage_type, const std::string& schema, const std::string& host, const std::string& username, const std::string& password, const PoolOptions& pool_options) {
+    return pimpl_->registerStorageType(storage_type, schema, host, username, password, pool_options);
 }
 
 bool DatabaseManager::hasConnection(const StorageType& storage_type) const {
@@ -197,3 +570,15 @@ bool DatabaseManager::hasConnection(const StorageType& storage_type) const {
 shared_ptr<sql::Connection> DatabaseManager::getConnection(const StorageType& storage_type) {
     return pimpl_->getConnection(storage_type);
 }
+
+void DatabaseManager::post(std::function<void ()> task) {
+    pimpl_->post(std::move(task));
+}
+
+shared_ptr<sql::PreparedStatement> DatabaseManager::prepareStatement(const shared_ptr<sql::Connection>& connection, const std::string& sql) {
+    return pimpl_->prepareStatement(connection, sql);
+}
+
+PoolMetrics DatabaseManager::getPoolMetrics(const StorageType& storage_type) const {
+    return pimpl_->getPoolMetrics(storage_type);
+}
@@ -21,8 +21,10 @@ public:
     *
     * @param driver An instance of the sql driver used to provide concrete 
     *      functionality for the database layer.
+    * @param thread_count Number of threads running submitted queries, they
+    *      are only started once the first query is submitted.
     */
-    explicit DatabaseManager(sql::Driver* driver);
+    explicit DatabaseManager(sql::Driver* driver, uint32_t thread_count = 2);
 
     ~DatabaseManager();
 
@@ -30,13 +32,22 @@ public:
     bool hasStorageType(const StorageType& storage_type) const;
     
     /// @see DatabaseManagerInterface::registerStorageType
-    bool registerStorageType(const StorageType& storage_type, const std::string& schema, const std::string& host, const std::string& username, const std::string& password);
+    bool registerStorageType(const StorageType& storage_type, const std::string& schema, const std::string& host, const std::string& username, const std::string& password, const PoolOptions& pool_options = PoolOptions());
     
     /// @see DatabaseManagerInterface::hasConnection
     bool hasConnection(const StorageType& storage_type) const;
     
     /// @see DatabaseManagerInterface::getConnection
     std::shared_ptr<sql::Connection> getConnection(const StorageType& storage_type);
+
+    /// @see DatabaseManagerInterface::prepareStatement
+    std::shared_ptr<sql::PreparedStatement> prepareStatement(const std::shared_ptr<sql::Connection>& connection, const std::string& sql);
+
+    /// @see DatabaseManagerInterface::post
+    void post(std::function<void ()> task);
+
+    /// @see DatabaseManagerInterface::getPoolMetrics
+    PoolMetrics getPoolMetrics(const StorageType& storage_type) const;
     
 private:
     // disable the default constructor to ensure that DatabaseManager is always
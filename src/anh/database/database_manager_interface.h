@@ -5,15 +5,22 @@
 #define ANH_DATABASE_DATABASE_MANAGER_INTERFACE_H_
 
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 
+#include <boost/exception/exception.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/thread/future.hpp>
+#include <cppconn/exception.h>
 #include "anh/hash_string.h"
 
 namespace sql {
     class Connection;
     class Driver;
+    class PreparedStatement;
 }
   
 /*! An identifier used to label different persistant data storage types.
@@ -22,6 +29,56 @@ typedef anh::HashString StorageType;
 
 namespace anh {
 namespace database {
+
+/*! Sizing of the connection pool kept for a storage type.
+*/
+struct PoolOptions {
+    PoolOptions()
+        : min_connections(1)
+        , max_connections(8)
+        , checkout_timeout_ms(5000)
+        , validation_idle_ms(30000)
+        , statement_cache_size(64)
+    {}
+
+    /// Connections opened when the storage type is registered.
+    uint32_t min_connections;
+
+    /// Most connections open at once, further requests wait for one to be returned.
+    uint32_t max_connections;
+
+    /// Longest a request waits for a connection before giving up.
+    uint32_t checkout_timeout_ms;
+
+    /// Connections idle at least this long are pinged before being handed out.
+    uint32_t validation_idle_ms;
+
+    /// Most statements kept prepared on each connection, 0 disables the cache.
+    uint32_t statement_cache_size;
+};
+
+/*! Snapshot of a connection pool's state and history.
+*/
+struct PoolMetrics {
+    /// Buckets of the wait histogram: under 1ms, 10ms, 100ms, 1s and longer.
+    static const uint32_t WAIT_BUCKETS = 5;
+
+    uint32_t open;
+    uint32_t in_use;
+    uint32_t idle;
+    uint32_t waiters;
+
+    uint64_t checkouts;
+    uint64_t timeouts;
+    uint64_t reconnects;
+
+    uint64_t statements_prepared;
+    uint64_t statements_reused;
+
+    /// Number of checkouts by how long they waited for a connection.
+    uint64_t wait_histogram[WAIT_BUCKETS];
+};
+
 /*! Interface class that exposes an API for managing mysql connector/c++
 * connections.
 */
@@ -40,9 +97,10 @@ public:
     * to the datastore to validate the settings, which is then immediately placed
     * in the connection pool for use.
     *
+    * @param pool_options Sizing of the storage type's connection pool.
     * @return bool True if the storage type was registered, false if registration already exist.
     */
-    virtual bool registerStorageType(const StorageType& storage_type, const std::string& schema, const std::string& host, const std::string& username, const std::string& password) = 0;
+    virtual bool registerStorageType(const StorageType& storage_type, const std::string& schema, const std::string& host, const std::string& username, const std::string& password, const PoolOptions& pool_options = PoolOptions()) = 0;
 
     /*! Check to see whether a connection exists already for a given storage type.
     *
@@ -52,11 +110,77 @@ public:
 
     /*! Processes a request for a connection to a specific storage type. 
     *
+    * Connections are validated before being handed out and reopened when they
+    * were lost. When the pool is at its limit the request waits for another
+    * connection to be returned, up to the pool's checkout timeout.
+    *
     * @param storage_type The storage type a connection is being requested for.
-    * @return Returns a connection or nullptr if one could not be created, or if
-    *   the storage type has not been seen before.
+    * @return Returns a connection or nullptr if the storage type has not been seen before.
+    * @throws sql::SQLException when no connection could be opened or none was
+    *   returned to the pool in time.
     */
     virtual std::shared_ptr<sql::Connection> getConnection(const StorageType& storage_type) = 0;
+
+    /*! Prepares a statement on a connection handed out by this manager.
+    *
+    * Pooled connections keep the statements prepared on them, keyed by their
+    * sql text, so each statement is prepared once per connection and reused
+    * by later requests with its parameters cleared.
+    *
+    * @param connection The connection the statement is executed on.
+    * @param sql The statement's sql text.
+    * @return The prepared statement, only valid while the connection is held.
+    */
+    virtual std::shared_ptr<sql::PreparedStatement> prepareStatement(const std::shared_ptr<sql::Connection>& connection, const std::string& sql) = 0;
+
+    /*! Runs a query on one of the database threads with a connection to the
+    * given storage type, so the caller never blocks on the database.
+    *
+    * \code{.cpp}
+    *
+    *  auto count = db_manager->submit("galaxy", [] (const std::shared_ptr<sql::Connection>& connection) {
+    *      ...
+    *      return result->getUInt(1);
+    *  });
+    *
+    * @param query Invoked with the connection, its result or exception is delivered through the future.
+    *   sql::SQLException is rethrown as is by the future, other errors may arrive as std::exception.
+    * @return A future for the query's result.
+    */
+    template<typename Query>
+    boost::unique_future<typename std::result_of<Query(const std::shared_ptr<sql::Connection>&)>::type>
+    submit(const StorageType& storage_type, Query query)
+    {
+        typedef typename std::result_of<Query(const std::shared_ptr<sql::Connection>&)>::type ResultType;
+
+        auto task = std::make_shared<boost::packaged_task<ResultType>>([this, storage_type, query] () -> ResultType {
+            auto connection = getConnection(storage_type);
+            if (!connection) {
+                throw std::runtime_error("Submitted a query for a storage type that has not been registered");
+            }
+
+            // rethrown so the future carries the sql error rather than a generic one
+            try {
+                return query(connection);
+            } catch(sql::SQLException &e) {
+                throw boost::enable_current_exception(e);
+            }
+        });
+
+        post([task] () {
+            (*task)();
+        });
+
+        return task->get_future();
+    }
+
+    /*! Runs the task on one of the database threads.
+    */
+    virtual void post(std::function<void ()> task) = 0;
+
+    /*! @return The state of the connection pool kept for the storage type.
+    */
+    virtual PoolMetrics getPoolMetrics(const StorageType& storage_type) const = 0;
 };
 } // database
 } // anh
@@ -4,6 +4,8 @@
 #include <boost/test/unit_test.hpp>
 #include <turtle/mock.hpp>
 
+#include <cppconn/exception.h>
+
 #include "anh/database/mock_cppconn.h"
 
 #include "anh/database/database_manager.h"
@@ -204,6 +206,361 @@ BOOST_AUTO_TEST_CASE(DeletingConnectionReturnsItToThePool) {
     BOOST_CHECK(manager.hasStorageType("my_storage_type"));
 }
 
+/// Requests wait for a connection while the pool is at its limit and fail
+/// once the checkout timeout passes.
+BOOST_AUTO_TEST_CASE(ExhaustedPoolTimesOutWaitingForConnection) {
+    MockDriver mock_driver;
+    MockConnection* mock_connection = new MockConnection();
+
+    MOCK_EXPECT(*mock_connection, setSchema)
+        .with(sql::SQLString("galaxy"))
+        .once();
+
+    mock::sequence s;
+    MOCK_EXPECT(*mock_connection, isClosed)
+        .once()
+        .in(s)
+        .returns(false);
+
+    MOCK_EXPECT(*mock_connection, isClosed)
+        .once()
+        .in(s)
+        .returns(true);
+
+    // Only one connection may be opened.
+    MOCK_EXPECT(mock_driver, connect3)
+        .once()
+        .returns(mock_connection);
+
+    DatabaseManager manager(&mock_driver);
+
+    PoolOptions pool_options;
+    pool_options.max_connections = 1;
+    pool_options.checkout_timeout_ms = 10;
+
+    manager.registerStorageType("my_storage_type", "galaxy", host_, username_, password_, pool_options);
+
+    auto connection = manager.getConnection("my_storage_type");
+    BOOST_CHECK(connection != nullptr);
+
+    BOOST_CHECK_THROW(manager.getConnection("my_storage_type"), sql::SQLException);
+
+    PoolMetrics metrics = manager.getPoolMetrics("my_storage_type");
+    BOOST_CHECK_EQUAL(1u, metrics.open);
+    BOOST_CHECK_EQUAL(1u, metrics.in_use);
+    BOOST_CHECK_EQUAL(1u, metrics.checkouts);
+    BOOST_CHECK_EQUAL(1u, metrics.timeouts);
+}
+
+/// A connection that was lost while in the pool is replaced by a new one
+/// when it is checked out.
+BOOST_AUTO_TEST_CASE(LostConnectionIsReopenedOnCheckout) {
+    MockDriver mock_driver;
+    MockConnection* lost_connection = new MockConnection();
+    MockConnection* new_connection = new MockConnection();
+
+    MOCK_EXPECT(*lost_connection, setSchema)
+        .with(sql::SQLString("galaxy"))
+        .once();
+
+    // Open when first checked out and returned, closed on the next checkout.
+    mock::sequence lost;
+    MOCK_EXPECT(*lost_connection, isClosed)
+        .exactly(2)
+        .in(lost)
+        .returns(false);
+
+    MOCK_EXPECT(*lost_connection, isClosed)
+        .once()
+        .in(lost)
+        .returns(true);
+
+    MOCK_EXPECT(*lost_connection, close)
+        .once()
+        .in(lost);
+
+    MOCK_EXPECT(*lost_connection, isClosed)
+        .once()
+        .in(lost)
+        .returns(true);
+
+    MOCK_EXPECT(*new_connection, setSchema)
+        .with(sql::SQLString("galaxy"))
+        .once();
+
+    MOCK_EXPECT(*new_connection, isClosed)
+        .once()
+        .returns(true);
+
+    mock::sequence connects;
+    MOCK_EXPECT(mock_driver, connect3)
+        .once()
+        .in(connects)
+        .returns(lost_connection);
+
+    MOCK_EXPECT(mock_driver, connect3)
+        .once()
+        .in(connects)
+        .returns(new_connection);
+
+    DatabaseManager manager(&mock_driver);
+
+    manager.registerStorageType("my_storage_type", "galaxy", host_, username_, password_);
+
+    {
+        auto connection = manager.getConnection("my_storage_type");
+        BOOST_CHECK(connection != nullptr);
+    }
+
+    auto connection = manager.getConnection("my_storage_type");
+    BOOST_CHECK(connection.get() == new_connection);
+
+    PoolMetrics metrics = manager.getPoolMetrics("my_storage_type");
+    BOOST_CHECK_EQUAL(1u, metrics.open);
+    BOOST_CHECK_EQUAL(1u, metrics.reconnects);
+}
+
+/// Submitted queries run on a database thread and deliver their result
+/// through the returned future.
+BOOST_AUTO_TEST_CASE(SubmittedQueryDeliversResult) {
+    MockDriver mock_driver;
+    MockConnection* mock_connection = new MockConnection();
+
+    MOCK_EXPECT(*mock_connection, setSchema)
+        .with(sql::SQLString("galaxy"))
+        .once();
+
+    mock::sequence s;
+    MOCK_EXPECT(*mock_connection, isClosed)
+        .once()
+        .in(s)
+        .returns(false);
+
+    MOCK_EXPECT(*mock_connection, isClosed)
+        .once()
+        .in(s)
+        .returns(true);
+
+    MOCK_EXPECT(mock_driver, connect3)
+        .once()
+        .returns(mock_connection);
+
+    // The database thread registers itself with the driver.
+    MOCK_EXPECT(mock_driver, threadInit)
+        .once();
+
+    MOCK_EXPECT(mock_driver, threadEnd)
+        .once();
+
+    DatabaseManager manager(&mock_driver, 1);
+
+    manager.registerStorageType("my_storage_type", "galaxy", host_, username_, password_);
+
+    auto result = manager.submit("my_storage_type", [] (const std::shared_ptr<sql::Connection>& connection) {
+        return connection != nullptr ? 42 : 0;
+    });
+
+    BOOST_CHECK_EQUAL(42, result.get());
+}
+
+/// A statement is prepared once per connection, later requests for the same
+/// sql reuse it with its parameters cleared.
+BOOST_AUTO_TEST_CASE(PreparedStatementsAreReusedByConnection) {
+    MockDriver mock_driver;
+    MockConnection* mock_connection = new MockConnection();
+    MockPreparedStatement* mock_statement = new MockPreparedStatement();
+
+    MOCK_EXPECT(*mock_connection, setSchema)
+        .with(sql::SQLString("galaxy"))
+        .once();
+
+    mock::sequence s;
+    MOCK_EXPECT(*mock_connection, isClosed)
+        .exactly(3)
+        .in(s)
+        .returns(false);
+
+    MOCK_EXPECT(*mock_connection, isClosed)
+        .once()
+        .in(s)
+        .returns(true);
+
+    MOCK_EXPECT(mock_driver, connect3)
+        .once()
+        .returns(mock_connection);
+
+    // Only the first request prepares the statement.
+    MOCK_EXPECT(*mock_connection, tag1)
+        .with(sql::SQLString("CALL sp_GetType(?);"))
+        .once()
+        .returns(mock_statement);
+
+    MOCK_EXPECT(*mock_statement, clearParameters)
+        .once();
+
+    MOCK_EXPECT(*mock_statement, getMoreResults)
+        .returns(false);
+
+    DatabaseManager manager(&mock_driver);
+
+    manager.registerStorageType("my_storage_type", "galaxy", host_, username_, password_);
+
+    std::shared_ptr<sql::PreparedStatement> first_statement;
+    {
+        auto connection = manager.getConnection("my_storage_type");
+        first_statement = manager.prepareStatement(connection, "CALL sp_GetType(?);");
+    }
+
+    auto connection = manager.getConnection("my_storage_type");
+    auto statement = manager.prepareStatement(connection, "CALL sp_GetType(?);");
+
+    BOOST_CHECK(statement == first_statement);
+
+    PoolMetrics metrics = manager.getPoolMetrics("my_storage_type");
+    BOOST_CHECK_EQUAL(1u, metrics.statements_prepared);
+    BOOST_CHECK_EQUAL(1u, metrics.statements_reused);
+}
+
+/// The status result a CALL leaves pending is read when the connection goes
+/// back to the pool and again before the cached statement is handed out.
+BOOST_AUTO_TEST_CASE(CachedStatementResultsAreDrainedBeforeReuse) {
+    MockDriver mock_driver;
+    MockConnection* mock_connection = new MockConnection();
+    MockPreparedStatement* mock_statement = new MockPreparedStatement();
+
+    MOCK_EXPECT(*mock_connection, setSchema)
+        .with(sql::SQLString("galaxy"))
+        .once();
+
+    mock::sequence closed_sequence;
+    MOCK_EXPECT(*mock_connection, isClosed)
+        .exactly(3)
+        .in(closed_sequence)
+        .returns(false);
+
+    MOCK_EXPECT(*mock_connection, isClosed)
+        .once()
+        .in(closed_sequence)
+        .returns(true);
+
+    MOCK_EXPECT(mock_driver, connect3)
+        .once()
+        .returns(mock_connection);
+
+    MOCK_EXPECT(*mock_connection, tag1)
+        .with(sql::SQLString("CALL sp_GetType(?);"))
+        .once()
+        .returns(mock_statement);
+
+    mock::sequence s;
+
+    // Releasing the connection reads the pending status result.
+    MOCK_EXPECT(*mock_statement, getMoreResults)
+        .once()
+        .in(s)
+        .returns(true);
+
+    MOCK_EXPECT(*mock_statement, getMoreResults)
+        .once()
+        .in(s)
+        .returns(false);
+
+    // Reusing the statement checks again before clearing its parameters.
+    MOCK_EXPECT(*mock_statement, getMoreResults)
+        .once()
+        .in(s)
+        .returns(false);
+
+    MOCK_EXPECT(*mock_statement, clearParameters)
+        .once()
+        .in(s);
+
+    DatabaseManager manager(&mock_driver);
+
+    manager.registerStorageType("my_storage_type", "galaxy", host_, username_, password_);
+
+    {
+        auto connection = manager.getConnection("my_storage_type");
+        manager.prepareStatement(connection, "CALL sp_GetType(?);");
+    }
+
+    auto connection = manager.getConnection("my_storage_type");
+    manager.prepareStatement(connection, "CALL sp_GetType(?);");
+}
+
+/// A full cache makes room by dropping the statement used longest ago, so the
+/// ones in use keep being reused.
+BOOST_AUTO_TEST_CASE(FullStatementCacheEvictsTheLeastRecentlyUsed) {
+    MockDriver mock_driver;
+    MockConnection* mock_connection = new MockConnection();
+    MockPreparedStatement* first_statement = new MockPreparedStatement();
+    MockPreparedStatement* second_statement = new MockPreparedStatement();
+    MockPreparedStatement* third_statement = new MockPreparedStatement();
+    MockPreparedStatement* second_statement_again = new MockPreparedStatement();
+
+    MOCK_EXPECT(*mock_connection, setSchema)
+        .with(sql::SQLString("galaxy"))
+        .once();
+
+    MOCK_EXPECT(*mock_connection, isClosed)
+        .returns(false);
+
+    MOCK_EXPECT(mock_driver, connect3)
+        .once()
+        .returns(mock_connection);
+
+    MOCK_EXPECT(*mock_connection, tag1)
+        .with(sql::SQLString("CALL sp_First();"))
+        .once()
+        .returns(first_statement);
+
+    mock::sequence s;
+    MOCK_EXPECT(*mock_connection, tag1)
+        .with(sql::SQLString("CALL sp_Second();"))
+        .once()
+        .in(s)
+        .returns(second_statement);
+
+    // Evicted by the third statement and prepared again.
+    MOCK_EXPECT(*mock_connection, tag1)
+        .with(sql::SQLString("CALL sp_Second();"))
+        .once()
+        .in(s)
+        .returns(second_statement_again);
+
+    MOCK_EXPECT(*mock_connection, tag1)
+        .with(sql::SQLString("CALL sp_Third();"))
+        .once()
+        .returns(third_statement);
+
+    MOCK_EXPECT(*first_statement, clearParameters)
+        .exactly(2);
+
+    for (auto statement : { first_statement, second_statement, third_statement, second_statement_again }) {
+        MOCK_EXPECT(*statement, getMoreResults)
+            .returns(false);
+    }
+
+    DatabaseManager manager(&mock_driver);
+
+    PoolOptions options;
+    options.statement_cache_size = 2;
+
+    manager.registerStorageType("my_storage_type", "galaxy", host_, username_, password_, options);
+
+    auto connection = manager.getConnection("my_storage_type");
+    manager.prepareStatement(connection, "CALL sp_First();");
+    manager.prepareStatement(connection, "CALL sp_Second();");
+    manager.prepareStatement(connection, "CALL sp_First();");
+    manager.prepareStatement(connection, "CALL sp_Third();");
+    manager.prepareStatement(connection, "CALL sp_First();");
+    manager.prepareStatement(connection, "CALL sp_Second();");
+
+    PoolMetrics metrics = manager.getPoolMetrics("my_storage_type");
+    BOOST_CHECK_EQUAL(4u, metrics.statements_prepared);
+    BOOST_CHECK_EQUAL(2u, metrics.statements_reused);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 /*****************************************************************************/
 // Implementation for the test fixture //
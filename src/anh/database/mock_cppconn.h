@@ -105,7 +105,9 @@ MOCK_BASE_CLASS(MockPreparedStatement, sql::PreparedStatement)
     MOCK_METHOD_EXT(executeUpdate, 1, int(const sql::SQLString& sql), tag5);
     MOCK_METHOD_EXT(executeUpdate, 0, int(), tag6);
     MOCK_METHOD(getMetaData, 0);
+    MOCK_METHOD(getMoreResults, 0);
     MOCK_METHOD(getParameterMetaData, 0);
+    MOCK_METHOD(getResultSet, 0);
     MOCK_METHOD(setBigInt, 2);
     MOCK_METHOD(setBlob, 2);
     MOCK_METHOD(setBoolean, 2);
@@ -13,9 +13,12 @@ namespace database{
 MOCK_BASE_CLASS(MockDatabaseManager, DatabaseManagerInterface)
 {
     MOCK_CONST_METHOD_EXT(hasStorageType, 1, bool(const StorageType& storage_type), hasStorageType);
-    MOCK_METHOD(registerStorageType, 5);
+    MOCK_METHOD(registerStorageType, 6);
     MOCK_CONST_METHOD_EXT(hasConnection, 1, bool(const StorageType& storage_type), hasConnection);
     MOCK_METHOD(getConnection, 1);    
+    MOCK_METHOD(prepareStatement, 2);
+    MOCK_METHOD(post, 1);
+    MOCK_CONST_METHOD_EXT(getPoolMetrics, 1, PoolMetrics(const StorageType& storage_type), getPoolMetrics);
 };
 } //namespace database
 } //namespace anh
@@ -0,0 +1,65 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef ANH_DATABASE_SCOPED_TRANSACTION_H_
+#define ANH_DATABASE_SCOPED_TRANSACTION_H_
+
+#include <memory>
+
+#include <boost/noncopyable.hpp>
+#include <cppconn/connection.h>
+#include <cppconn/exception.h>
+
+namespace anh {
+namespace database {
+
+/*! Groups the statements executed on a connection into one transaction.
+*
+* Used to write a set of rows with a single commit instead of one per row.
+* Unless commit is called the transaction is rolled back when the scope is
+* left, and the connection goes back to committing every statement.
+*
+* \code{.cpp}
+*
+*  ScopedTransaction transaction(connection);
+*  for (auto& row : rows) {
+*      ...
+*      statement->execute();
+*  }
+*  transaction.commit();
+*/
+class ScopedTransaction : private boost::noncopyable {
+public:
+    explicit ScopedTransaction(std::shared_ptr<sql::Connection> connection)
+        : connection_(std::move(connection))
+        , committed_(false)
+    {
+        connection_->setAutoCommit(false);
+    }
+
+    ~ScopedTransaction() {
+        try {
+            if (!committed_) {
+                connection_->rollback();
+            }
+
+            connection_->setAutoCommit(true);
+        } catch(sql::SQLException&) {
+            // nothing more can be done with a connection that failed here
+        }
+    }
+
+    void commit() {
+        connection_->commit();
+        committed_ = true;
+    }
+
+private:
+    std::shared_ptr<sql::Connection> connection_;
+    bool committed_;
+};
+
+}  // namespace database
+}  // namespace anh
+
+#endif  // ANH_DATABASE_SCOPED_TRANSACTION_H_
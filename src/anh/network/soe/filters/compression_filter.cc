@@ -3,11 +3,14 @@
 
 #include "compression_filter.h"
 
-#include <vector>
+#include <algorithm>
+#include <stdexcept>
 
 #include <zlib.h>
 
-#include "anh/byte_buffer.h"
+#include <boost/thread/tss.hpp>
+
+#include "anh/network/soe/packet_buffer.h"
 #include "anh/network/soe/session.h"
 
 using namespace anh;
@@ -15,51 +18,155 @@ using namespace network::soe;
 using namespace filters;
 using namespace std;
 
-void CompressionFilter::operator()(Session* session, ByteBuffer* message)
-{
-    if(message->size() > session->receive_buffer_size() - 20)
+namespace {
+    /// Compressed data must save at least 1/2^kMinSavingsShift of the input to be used.
+    const uint32_t kMinSavingsShift = 4;
+
+    /// Most candidates skipped after a run of packets that did not shrink.
+    const uint32_t kMaxSkippedPackets = 8;
+
+    /**
+     * A deflate stream that is reset between packets. The deflate state is around
+     * 256KB, so streams are kept per thread rather than per session.
+     */
+    class DeflateStream : private boost::noncopyable
     {
-        Compress_(message);
+    public:
+        explicit DeflateStream(int level)
+            : level_(level)
+        {
+            stream_.zalloc = Z_NULL;
+            stream_.zfree = Z_NULL;
+            stream_.opaque = Z_NULL;
+
+            if (deflateInit(&stream_, level_) != Z_OK)
+            {
+                throw runtime_error("Unable to initialize deflate stream");
+            }
+        }
+
+        ~DeflateStream()
+        {
+            deflateEnd(&stream_);
+        }
+
+        z_stream* Reset(int level)
+        {
+            deflateReset(&stream_);
+
+            // Services may use different levels, switching is cheap on a reset stream.
+            if (level != level_)
+            {
+                deflateParams(&stream_, level, Z_DEFAULT_STRATEGY);
+                level_ = level;
+            }
+
+            return &stream_;
+        }
+
+    private:
+        z_stream stream_;
+        int level_;
+    };
+
+    boost::thread_specific_ptr<DeflateStream> deflate_stream;
+}
+
+CompressionFilter::CompressionFilter(int level)
+    : level_(min(Z_BEST_COMPRESSION, max(Z_DEFAULT_COMPRESSION, level)))
+    , failed_attempts_(0)
+    , skip_remaining_(0)
+    , compressed_packets_(0)
+    , incompressible_packets_(0)
+{}
 
-        message->write<uint8_t>(1); // compressed
-    } 
-    else 
-    {        
-        message->write<uint8_t>(0); // not compressed
+void CompressionFilter::operator()(Session* session, PacketBuffer* message)
+{
+    if(level_ != Z_NO_COMPRESSION
+        && message->size() > session->receive_buffer_size() - 20
+        && Compress_(session, message))
+    {
+        *message->Append(1) = 1; // compressed
     }
+    else
+    {
+        *message->Append(1) = 0; // not compressed
+    }
+}
+
+int CompressionFilter::level() const
+{
+    return level_;
+}
+
+uint64_t CompressionFilter::compressed_packets() const
+{
+    return compressed_packets_;
+}
+
+uint64_t CompressionFilter::incompressible_packets() const
+{
+    return incompressible_packets_;
 }
 
-void CompressionFilter::Compress_(ByteBuffer* message) 
+bool CompressionFilter::Compress_(Session* session, PacketBuffer* message)
 {
-    vector<uint8_t>& packet_data = message->raw();
+    // Back off after packets that did not shrink, the data is likely already compressed.
+    uint32_t skip = skip_remaining_;
+    while (skip > 0)
+    {
+        if (skip_remaining_.compare_exchange_weak(skip, skip - 1))
+        {
+            ++incompressible_packets_;
+            return false;
+        }
+    }
+
+    const unsigned char* packet_data = message->data();
     uint32_t packet_size = message->size();
 
     // Determine the offset to begin compressing data at
     uint16_t offset = (packet_data[0] == 0x00) ? 2 : 1;
-    
-    z_stream zstream_;
+    uint32_t data_size = packet_size - offset;
 
-    zstream_.zalloc = Z_NULL;
-    zstream_.zfree = Z_NULL;
-    zstream_.opaque = Z_NULL;
-    zstream_.avail_in = Z_NULL;
-    zstream_.next_in = Z_NULL;
+    // Deflate into a pooled packet behind a copy of the header, leaving room for the
+    // compression flag and crc footer.
+    PacketBuffer compressed = session->packet_pool()->Acquire();
+    compressed.Append(packet_data, offset);
 
-    deflateInit(&zstream_, Z_DEFAULT_COMPRESSION);
+    // Bounding the output makes deflate give up as soon as the savings are out of reach.
+    uint32_t available = min(
+        data_size - (data_size >> kMinSavingsShift),
+        compressed.tailroom() - PacketBufferPool::kDefaultTailroom);
 
-    vector<uint8_t> compression_output(packet_size);
+    if (!deflate_stream.get())
+    {
+        deflate_stream.reset(new DeflateStream(level_));
+    }
+
+    z_stream* zstream = deflate_stream->Reset(level_);
 
-    zstream_.next_in = reinterpret_cast<Bytef *>(&packet_data[offset]);
-    zstream_.avail_in = packet_size - offset;
-    zstream_.next_out = reinterpret_cast<Bytef *>(&compression_output[0]);
-    zstream_.avail_out = packet_size;
+    zstream->next_in = const_cast<Bytef *>(packet_data + offset);
+    zstream->avail_in = data_size;
+    zstream->next_out = reinterpret_cast<Bytef *>(compressed.data() + offset);
+    zstream->avail_out = available;
 
-    deflate(&zstream_, Z_FINISH);
+    int result = deflate(zstream, Z_FINISH);
 
-    ByteBuffer compressed(&packet_data[0], offset);
-    compressed.write(&compression_output[0], zstream_.total_out);
-    
-    deflateEnd(&zstream_);
+    if (result != Z_STREAM_END)
+    {
+        uint32_t failures = ++failed_attempts_;
+        skip_remaining_ = min(kMaxSkippedPackets, 1u << min(failures - 1, 31u));
 
+        ++incompressible_packets_;
+        return false;
+    }
+
+    failed_attempts_ = 0;
+    ++compressed_packets_;
+
+    compressed.Append(static_cast<uint32_t>(zstream->total_out));
     message->swap(compressed);
+
+    return true;
 }
@@ -4,25 +4,66 @@
 #ifndef ANH_NETWORK_SOE_COMPRESSION_FILTER_H_
 #define ANH_NETWORK_SOE_COMPRESSION_FILTER_H_
 
-namespace anh {
+#include <atomic>
+#include <cstdint>
 
-    class ByteBuffer;
+#include <boost/noncopyable.hpp>
 
+namespace anh {
 namespace network {
 namespace soe {
 
+    class PacketBuffer;
     class Session;
 
 namespace filters {
 
-class CompressionFilter {
-public:    
-    void operator()(Session* session, ByteBuffer* message);
+/**
+ * @brief Compresses outgoing packets that are close to the remote end's buffer size.
+ *
+ * The deflate stream is kept per thread and reset between packets rather than set up
+ * for every packet. Packets that do not shrink by at least 1/16th are sent as is, and
+ * after such a packet the next few candidates are sent uncompressed without trying, so
+ * a run of already compressed data (e.g. baselines carrying compressed blobs) costs
+ * little CPU.
+ */
+class CompressionFilter : private boost::noncopyable {
+public:
+    /**
+     * @param level The zlib compression level, 0 disables compression and 1-9 trade
+     *  speed for size. -1 selects zlib's default (6).
+     */
+    explicit CompressionFilter(int level = -1);
+
+    void operator()(Session* session, PacketBuffer* message);
+
+    int level() const;
+
+    /**
+     * @return The number of packets compressed.
+     */
+    uint64_t compressed_packets() const;
+
+    /**
+     * @return The number of candidate packets sent uncompressed, either because they
+     *  did not shrink or because they were skipped after ones that did not.
+     */
+    uint64_t incompressible_packets() const;
 
 private:
-	void Compress_(ByteBuffer* message);
+	bool Compress_(Session* session, PacketBuffer* message);
+
+    int level_;
+
+    // Number of upcoming candidates to send without trying, grows with each
+    // consecutive packet that did not shrink.
+    std::atomic<uint32_t> failed_attempts_;
+    std::atomic<uint32_t> skip_remaining_;
+
+    std::atomic<uint64_t> compressed_packets_;
+    std::atomic<uint64_t> incompressible_packets_;
 };
 
 }}}} // namespace anh::network::soe::filters
 
-#endif // ANH_NETWORK_SOE_DECOMPRESSION_FILTER_H_
+#endif // ANH_NETWORK_SOE_COMPRESSION_FILTER_H_
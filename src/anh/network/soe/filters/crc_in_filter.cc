@@ -3,8 +3,10 @@
 
 #include "crc_in_filter.h"
 
-#include "anh/byte_buffer.h"
+#include <stdexcept>
+
 #include "anh/crc.h"
+#include "anh/network/soe/packet_buffer.h"
 #include "anh/network/soe/session.h"
 
 using namespace anh;
@@ -12,21 +14,25 @@ using namespace network::soe;
 using namespace filters;
 using namespace std;
 
-void CrcInFilter::operator()(Session* session, ByteBuffer* message) const
+void CrcInFilter::operator()(Session* session, PacketBuffer* message) const
 {
     uint32_t crc_length = session->crc_length();
-    
+
     // If crc length is 0 then crc testing is not being used, return the packet.
     if (crc_length == 0)
     {
         return;
     }
-        
-    // Peel off the crc bits from the packet data.
-    uint32_t message_size = message->size() - crc_length;
-    vector<uint8_t> crc_bits(message->data() + message_size, message->data() + message->size());
-    message->resize(message_size);
-    
+
+    if (message->size() <= crc_length)
+    {
+        throw runtime_error("Message too small for crc footer");
+    }
+
+    // Peel off the crc bits from the packet data, they stay in place in the tailroom.
+    message->TrimBack(crc_length);
+    const unsigned char* crc_bits = message->data() + message->size();
+
     uint32_t packet_crc = memcrc(message->data(), message->size(), session->crc_seed());
     uint32_t test_crc = 0;
     uint32_t mask = 0;
@@ -39,7 +45,7 @@ void CrcInFilter::operator()(Session* session, ByteBuffer* message) const
 
     packet_crc &= mask;
 
-    if (test_crc != packet_crc) 
+    if (test_crc != packet_crc)
     {
         throw runtime_error("Crc mismatch");
     }
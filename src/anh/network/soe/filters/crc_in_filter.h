@@ -5,12 +5,10 @@
 #define ANH_NETWORK_SOE_CRC_IN_FILTER_H_
 
 namespace anh {
-
-    class ByteBuffer;
-
 namespace network {
 namespace soe {
     
+    class PacketBuffer;
     class Session;
 
 namespace filters {
@@ -18,7 +16,7 @@ namespace filters {
     struct CrcInFilter 
     {
     public:
-        void operator()(Session* session, ByteBuffer* message) const;
+        void operator()(Session* session, PacketBuffer* message) const;
     };
 
 }}}} // namespace anh::network::soe::filters
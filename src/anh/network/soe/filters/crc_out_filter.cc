@@ -3,8 +3,8 @@
 
 #include "crc_out_filter.h"
 
-#include "anh/byte_buffer.h"
 #include "anh/crc.h"
+#include "anh/network/soe/packet_buffer.h"
 #include "anh/network/soe/session.h"
 
 using namespace anh;
@@ -12,13 +12,15 @@ using namespace network::soe;
 using namespace filters;
 using namespace std;
 
-void CrcOutFilter::operator()(Session* session, ByteBuffer* message) 
+void CrcOutFilter::operator()(Session* session, PacketBuffer* message) 
 {
     uint32_t packet_crc = memcrc(message->data(), message->size(), session->crc_seed());
     
     uint8_t crc_low = (uint8_t)packet_crc;
     uint8_t crc_high = (uint8_t)(packet_crc >> 8);
     
-    message->write<uint8_t>(crc_high);
-    message->write<uint8_t>(crc_low);
+    // Written straight into the tailroom behind the packet.
+    unsigned char* footer = message->Append(2);
+    footer[0] = crc_high;
+    footer[1] = crc_low;
 }
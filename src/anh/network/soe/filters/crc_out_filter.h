@@ -7,19 +7,17 @@
 #include <memory>
 
 namespace anh {
-
-    class ByteBuffer;
-
 namespace network {
 namespace soe {
 
+    class PacketBuffer;
     class Session;
 
 namespace filters {
 	
     struct CrcOutFilter {
     public:    
-        void operator()(Session* session, ByteBuffer* message);
+        void operator()(Session* session, PacketBuffer* message);
     };
 
 }}}} // namespace anh::network::soe::filters
@@ -3,7 +3,15 @@
 
 #include "anh/network/soe/filters/decompression_filter.h"
 
-#include "anh/byte_buffer.h"
+#include <algorithm>
+#include <stdexcept>
+
+#include <zlib.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/thread/tss.hpp>
+
+#include "anh/network/soe/packet_buffer.h"
 #include "anh/network/soe/session.h"
 
 using namespace anh;
@@ -11,46 +19,90 @@ using namespace network::soe;
 using namespace filters;
 using namespace std;
 
+namespace {
+    /**
+     * An inflate stream that is reset between packets instead of set up for each one.
+     */
+    class InflateStream : private boost::noncopyable
+    {
+    public:
+        InflateStream()
+        {
+            stream_.zalloc = Z_NULL;
+            stream_.zfree = Z_NULL;
+            stream_.opaque = Z_NULL;
+            stream_.avail_in = 0;
+            stream_.next_in = Z_NULL;
+
+            if (inflateInit(&stream_) != Z_OK)
+            {
+                throw runtime_error("Unable to initialize inflate stream");
+            }
+        }
+
+        ~InflateStream()
+        {
+            inflateEnd(&stream_);
+        }
+
+        z_stream* Reset()
+        {
+            inflateReset(&stream_);
+            return &stream_;
+        }
+
+    private:
+        z_stream stream_;
+    };
+
+    boost::thread_specific_ptr<InflateStream> inflate_stream;
+}
+
 DecompressionFilter::DecompressionFilter(uint32_t max_message_size)
     : max_message_size_(max_message_size)
-    , decompression_output_(max_message_size_)
 {}
 
-void DecompressionFilter::operator()(Session* session, ByteBuffer* message)
+void DecompressionFilter::operator()(Session* session, PacketBuffer* message)
 {
     uint32_t size_without_compression_bit = message->size() - 1;
-    uint8_t compressed_bit = message->peekAt<uint8_t>(size_without_compression_bit);
-   
-    message->resize(size_without_compression_bit);
+    uint8_t compressed_bit = message->data()[size_without_compression_bit];
+
+    message->TrimBack(1);
 
     if(compressed_bit == 1) {
-        Decompress_(message);
+        Decompress_(session, message);
     }
 }
 
-void DecompressionFilter::Decompress_(ByteBuffer* buffer) 
+void DecompressionFilter::Decompress_(Session* session, PacketBuffer* buffer)
 {
-    auto packet_data = buffer->raw();    
-
+    const unsigned char* packet_data = buffer->data();
     uint16_t offset = (packet_data[0] == 0x00) ? 2 : 1;
-    
-    zstream_.zalloc = Z_NULL;
-    zstream_.zfree = Z_NULL;
-    zstream_.opaque = Z_NULL;
-    zstream_.avail_in= Z_NULL;
-    zstream_.next_in = Z_NULL;
-    
-    inflateInit(&zstream_);
-
-    zstream_.next_in   = reinterpret_cast<Bytef *>(&packet_data[offset]);
-    zstream_.avail_in  = packet_data.size() - offset;
-    zstream_.next_out  = reinterpret_cast<Bytef *>(&decompression_output_[0]);
-    zstream_.avail_out = decompression_output_.size();
-
-    inflate(&zstream_, Z_FINISH); // Decompress Data
-    
-    buffer->write_position(offset);
-    buffer->write(&decompression_output_[0], zstream_.total_out);
-    
-    inflateEnd(&zstream_);
+
+    // Inflate into a pooled packet behind a copy of the header.
+    PacketBuffer decompressed = session->packet_pool()->Acquire(0);
+    decompressed.Append(packet_data, offset);
+
+    if (!inflate_stream.get())
+    {
+        inflate_stream.reset(new InflateStream);
+    }
+
+    z_stream* zstream = inflate_stream->Reset();
+
+    zstream->next_in   = const_cast<Bytef *>(packet_data + offset);
+    zstream->avail_in  = buffer->size() - offset;
+    zstream->next_out  = reinterpret_cast<Bytef *>(decompressed.data() + offset);
+    zstream->avail_out = min(max_message_size_, decompressed.tailroom());
+
+    int result = inflate(zstream, Z_FINISH); // Decompress Data
+    uint32_t decompressed_size = zstream->total_out;
+
+    if (result != Z_STREAM_END)
+    {
+        throw runtime_error("Malformed message received: invalid compressed data");
+    }
+
+    decompressed.Append(decompressed_size);
+    buffer->swap(decompressed);
 }
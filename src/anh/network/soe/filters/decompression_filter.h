@@ -6,23 +6,20 @@
 
 #include <cstdint>
 #include <memory>
-#include <vector>
-
-#include <zlib.h>
 
 namespace anh {
-
-    class ByteBuffer;
-
 namespace network {
 namespace soe {
 
+    class PacketBuffer;
     class Session;
 
 namespace filters {
 
     /**
      * @brief Decompresses packet data that is flagged as compressed.
+     *
+     * Uses an inflate stream kept per thread that is reset between packets.
      */
     class DecompressionFilter {
     public:
@@ -31,17 +28,14 @@ namespace filters {
          */
         explicit DecompressionFilter(uint32_t max_message_size);
     
-        void operator()(Session* session, ByteBuffer* message);
+        void operator()(Session* session, PacketBuffer* message);
     
     private:
         DecompressionFilter();
     
-    	void Decompress_(anh::ByteBuffer* buffer);
+    	void Decompress_(Session* session, PacketBuffer* buffer);
         
         uint32_t max_message_size_;
-        
-        z_stream zstream_;
-        std::vector<uint8_t> decompression_output_;
     };
 
 }}}} // namespace anh::network::soe::filters
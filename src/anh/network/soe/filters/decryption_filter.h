@@ -8,12 +8,10 @@
 #include <memory>
 
 namespace anh {
-
-    class ByteBuffer;
-
 namespace network {
 namespace soe {
 
+    class PacketBuffer;
     class Session;
 
 namespace filters {
@@ -21,10 +19,7 @@ namespace filters {
     class DecryptionFilter
     {
     public:
-        void operator()(Session* session, ByteBuffer* message) const;
-    
-    private:
-    	int Decrypt_(char* buffer, uint32_t len, uint32_t seed) const;
+        void operator()(Session* session, PacketBuffer* message) const;
     };
 
 }}}} // namespace anh::network::soe::filters
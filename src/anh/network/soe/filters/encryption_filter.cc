@@ -3,35 +3,21 @@
 
 #include "anh/network/soe/filters/encryption_filter.h"
 
-#include "anh/byte_buffer.h"
+#include "anh/network/soe/packet_buffer.h"
 #include "anh/network/soe/session.h"
+#include "anh/network/soe/filters/xor_chain.h"
 
 using namespace anh;
 using namespace network::soe;
 using namespace filters;
 using namespace std;
 
-void EncryptionFilter::operator()(Session* session, ByteBuffer* message)
+void EncryptionFilter::operator()(Session* session, PacketBuffer* message)
 {
-    uint16_t offset = (message->peek<uint8_t>() == 0x00) ? 2 : 1;
+    uint16_t offset = (message->data()[0] == 0x00) ? 2 : 1;
             
-    Encrypt_(
-        (char*)message->data() + offset,
+    EncryptXorChain(
+        message->data() + offset,
         message->size() - offset, 
         session->crc_seed());
 }
-
-void EncryptionFilter::Encrypt_(char* data, uint32_t len, uint32_t seed) const
-{
-    uint32_t blockCount = (len / 4);
-    uint32_t byteCount = (len % 4);
-
-    for(uint32_t count = 0; count < blockCount; count++) {
-        ((uint32_t*)data)[count] ^= seed;
-        seed = ((uint32_t*)data)[count];
-    }
-
-    for(uint32_t count = blockCount * 4; count < blockCount * 4 + byteCount; count++) {
-        data[count] ^= seed;
-    }
-}
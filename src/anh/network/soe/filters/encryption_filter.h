@@ -8,22 +8,17 @@
 #include <memory>
 
 namespace anh {
-
-    class ByteBuffer;
-
 namespace network {
 namespace soe {
 
+    class PacketBuffer;
     class Session;
 
 namespace filters {
 
 class EncryptionFilter {
 public:
-    void operator()(Session* session, ByteBuffer* message);
-
-private:
-	void Encrypt_(char* buffer, uint32_t len, uint32_t seed) const;
+    void operator()(Session* session, PacketBuffer* message);
 };
 
 }}}} // namespace anh::network::soe::filters
@@ -3,7 +3,9 @@
 
 #include "anh/network/soe/filters/security_filter.h"
 
-#include "anh/byte_buffer.h"
+#include <stdexcept>
+
+#include "anh/network/soe/packet_buffer.h"
 #include "anh/network/soe/session.h"
 
 using namespace anh;
@@ -15,7 +17,7 @@ SecurityFilter::SecurityFilter(uint32_t max_receive_size)
     : max_receive_size_(max_receive_size)
 {}
 
-void SecurityFilter::operator()(Session* session, ByteBuffer* message) const
+void SecurityFilter::operator()(Session* session, PacketBuffer* message) const
 {
     uint32_t message_size = message->size();
 
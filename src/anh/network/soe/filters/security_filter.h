@@ -8,12 +8,10 @@
 #include <memory>
 
 namespace anh {
-
-    class ByteBuffer;
-
 namespace network {
 namespace soe {
 
+    class PacketBuffer;
     class Session;
 
 namespace filters {
@@ -28,7 +26,7 @@ namespace filters {
          */
         explicit SecurityFilter(uint32_t max_receive_size);
     
-        void operator()(Session* session, ByteBuffer* message) const;
+        void operator()(Session* session, PacketBuffer* message) const;
     
     private:
         // Disable default construction.
@@ -0,0 +1,183 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include "anh/network/soe/filters/xor_chain.h"
+
+#include <cstring>
+
+#include "anh/cpu_features.h"
+
+#ifdef ANH_X86_INTRINSICS
+#include <immintrin.h>
+#endif
+
+using namespace anh;
+using namespace network::soe;
+using namespace filters;
+
+namespace {
+
+    // Words are read and written with memcpy, packet bodies start at odd offsets.
+    uint32_t LoadWord(const unsigned char* data)
+    {
+        uint32_t word;
+        memcpy(&word, data, sizeof(word));
+        return word;
+    }
+
+    void StoreWord(unsigned char* data, uint32_t word)
+    {
+        memcpy(data, &word, sizeof(word));
+    }
+
+    void XorTail(unsigned char* data, uint32_t length, uint32_t seed)
+    {
+        unsigned char key = static_cast<unsigned char>(seed);
+
+        for (uint32_t i = (length / 4) * 4; i < length; ++i)
+        {
+            data[i] ^= key;
+        }
+    }
+
+    /**
+     * Decrypts words [0, end) front to back, carrying each encrypted word over to the
+     * next in a register.
+     */
+    void DecryptWordsScalar(unsigned char* data, uint32_t end, uint32_t seed)
+    {
+        for (unsigned char* word = data; word != data + end * 4; word += 4)
+        {
+            uint32_t cipher = LoadWord(word);
+            StoreWord(word, cipher ^ seed);
+            seed = cipher;
+        }
+    }
+
+#ifdef ANH_X86_INTRINSICS
+    /**
+     * Decrypts whole vectors of words ending at end, back to front, each one xor'd with
+     * the same vector loaded one word earlier. Going back to front means the earlier
+     * word is still encrypted when it is read. Word 0 is left for the scalar loop as it
+     * is xor'd with the seed.
+     *
+     * @return The first word not decrypted.
+     */
+    ANH_TARGET("sse2")
+    uint32_t DecryptWordsSse2(unsigned char* data, uint32_t end)
+    {
+        for (; end >= 5; end -= 4)
+        {
+            unsigned char* block = data + (end - 4) * 4;
+
+            __m128i cipher = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+            __m128i previous = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block - 4));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(block), _mm_xor_si128(cipher, previous));
+        }
+
+        return end;
+    }
+
+    ANH_TARGET("avx2")
+    uint32_t DecryptWordsAvx2(unsigned char* data, uint32_t end)
+    {
+        for (; end >= 9; end -= 8)
+        {
+            unsigned char* block = data + (end - 8) * 4;
+
+            __m256i cipher = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+            __m256i previous = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block - 4));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(block), _mm256_xor_si256(cipher, previous));
+        }
+
+        return end;
+    }
+#endif
+
+    XorChainEngine DetectXorChainEngine()
+    {
+        const CpuFeatures& features = GetCpuFeatures();
+
+        if (features.avx2)
+        {
+            return XOR_CHAIN_AVX2;
+        }
+
+        if (features.sse2)
+        {
+            return XOR_CHAIN_SSE2;
+        }
+
+        return XOR_CHAIN_SCALAR;
+    }
+
+}  // namespace
+
+XorChainEngine filters::ActiveXorChainEngine()
+{
+    static const XorChainEngine engine = DetectXorChainEngine();
+    return engine;
+}
+
+bool filters::IsXorChainEngineSupported(XorChainEngine engine)
+{
+    switch (engine)
+    {
+    case XOR_CHAIN_SCALAR:
+        return true;
+    case XOR_CHAIN_SSE2:
+        return GetCpuFeatures().sse2;
+    case XOR_CHAIN_AVX2:
+        return GetCpuFeatures().avx2;
+    }
+
+    return false;
+}
+
+void filters::EncryptXorChain(unsigned char* data, uint32_t length, uint32_t seed)
+{
+    unsigned char* words_end = data + (length / 4) * 4;
+
+    for (unsigned char* word = data; word != words_end; word += 4)
+    {
+        seed ^= LoadWord(word);
+        StoreWord(word, seed);
+    }
+
+    XorTail(data, length, seed);
+}
+
+void filters::DecryptXorChain(unsigned char* data, uint32_t length, uint32_t seed)
+{
+    DecryptXorChain(data, length, seed, ActiveXorChainEngine());
+}
+
+void filters::DecryptXorChain(unsigned char* data, uint32_t length, uint32_t seed, XorChainEngine engine)
+{
+    uint32_t word_count = length / 4;
+
+    if (word_count == 0)
+    {
+        XorTail(data, length, seed);
+        return;
+    }
+
+    // The tail is keyed by the last encrypted word, decrypt it before that word is.
+    XorTail(data, length, LoadWord(data + (word_count - 1) * 4));
+
+    uint32_t end = word_count;
+
+#ifdef ANH_X86_INTRINSICS
+    if (engine == XOR_CHAIN_AVX2 && IsXorChainEngineSupported(engine))
+    {
+        end = DecryptWordsAvx2(data, end);
+    }
+
+    if (engine != XOR_CHAIN_SCALAR && IsXorChainEngineSupported(XOR_CHAIN_SSE2))
+    {
+        end = DecryptWordsSse2(data, end);
+    }
+#endif
+
+    DecryptWordsScalar(data, end, seed);
+}
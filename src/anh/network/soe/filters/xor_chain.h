@@ -0,0 +1,72 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef ANH_NETWORK_SOE_XOR_CHAIN_H_
+#define ANH_NETWORK_SOE_XOR_CHAIN_H_
+
+#include <cstdint>
+
+namespace anh {
+namespace network {
+namespace soe {
+namespace filters {
+
+/**
+ * @brief The implementations DecryptXorChain can run on.
+ *
+ * All engines produce identical output, the fastest one the cpu supports is selected
+ * the first time a packet is decrypted.
+ */
+enum XorChainEngine
+{
+    XOR_CHAIN_SCALAR = 0,   ///< One 32-bit word at a time.
+    XOR_CHAIN_SSE2,         ///< Four words per step.
+    XOR_CHAIN_AVX2          ///< Eight words per step.
+};
+
+/**
+ * @return The engine used by DecryptXorChain.
+ */
+XorChainEngine ActiveXorChainEngine();
+
+/**
+ * @return True if the engine can run on this cpu.
+ */
+bool IsXorChainEngineSupported(XorChainEngine engine);
+
+/**
+ * @brief Encrypts a packet body in place.
+ *
+ * Each 32-bit word is xor'd with the previous encrypted word, the first with the
+ * seed. Trailing bytes are xor'd with the low byte of the last encrypted word.
+ * Every word depends on the one before it, so this is always scalar.
+ *
+ * @param data The body to encrypt, no alignment is required.
+ * @param length The length of the body in bytes.
+ * @param seed The session's crc seed.
+ */
+void EncryptXorChain(unsigned char* data, uint32_t length, uint32_t seed);
+
+/**
+ * @brief Decrypts a packet body in place.
+ *
+ * Reverses EncryptXorChain. Each plain word only depends on its own and the previous
+ * encrypted word, so whole vectors are decrypted at once.
+ *
+ * @param data The body to decrypt, no alignment is required.
+ * @param length The length of the body in bytes.
+ * @param seed The session's crc seed.
+ */
+void DecryptXorChain(unsigned char* data, uint32_t length, uint32_t seed);
+
+/**
+ * @brief Decrypts a packet body in place on a specific engine.
+ *
+ * Falls back to the scalar engine if the engine is not supported. Intended for tests
+ * and benchmarks.
+ */
+void DecryptXorChain(unsigned char* data, uint32_t length, uint32_t seed, XorChainEngine engine);
+
+}}}} // namespace anh::network::soe::filters
+
+#endif // ANH_NETWORK_SOE_XOR_CHAIN_H_
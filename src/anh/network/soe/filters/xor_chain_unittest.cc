@@ -0,0 +1,140 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "anh/network/soe/filters/xor_chain.h"
+
+using namespace anh::network::soe::filters;
+using namespace std;
+
+namespace {
+
+const XorChainEngine kEngines[] = { XOR_CHAIN_SCALAR, XOR_CHAIN_SSE2, XOR_CHAIN_AVX2 };
+
+/// The original filter loops, with the word accesses made alignment safe.
+void ReferenceEncrypt(unsigned char* data, uint32_t len, uint32_t seed)
+{
+    uint32_t block_count = len / 4;
+
+    for (uint32_t count = 0; count < block_count; ++count) {
+        uint32_t word;
+        memcpy(&word, data + count * 4, 4);
+        word ^= seed;
+        memcpy(data + count * 4, &word, 4);
+        seed = word;
+    }
+
+    for (uint32_t count = block_count * 4; count < len; ++count) {
+        data[count] ^= seed;
+    }
+}
+
+void ReferenceDecrypt(unsigned char* data, uint32_t len, uint32_t seed)
+{
+    uint32_t block_count = len / 4;
+
+    for (uint32_t count = 0; count < block_count; ++count) {
+        uint32_t word;
+        memcpy(&word, data + count * 4, 4);
+        uint32_t next_seed = word;
+        word ^= seed;
+        memcpy(data + count * 4, &word, 4);
+        seed = next_seed;
+    }
+
+    for (uint32_t count = block_count * 4; count < len; ++count) {
+        data[count] ^= seed;
+    }
+}
+
+vector<unsigned char> RandomPayload(uint32_t length)
+{
+    vector<unsigned char> payload(length + 3);
+
+    for (unsigned char& byte : payload)
+    {
+        byte = static_cast<unsigned char>(rand());
+    }
+
+    return payload;
+}
+
+BOOST_AUTO_TEST_SUITE(XorChainTests)
+
+/// Verifies encryption matches the original filter on every length and alignment.
+BOOST_AUTO_TEST_CASE(EncryptMatchesReference)
+{
+    srand(1);
+
+    for (uint32_t length = 0; length <= 496; ++length)
+    {
+        for (uint32_t offset = 0; offset < 3; ++offset)
+        {
+            vector<unsigned char> expected = RandomPayload(length);
+            vector<unsigned char> actual = expected;
+            uint32_t seed = static_cast<uint32_t>(rand()) * 2654435761u;
+
+            ReferenceEncrypt(&expected[offset], length, seed);
+            EncryptXorChain(&actual[offset], length, seed);
+
+            BOOST_REQUIRE(expected == actual);
+        }
+    }
+}
+
+/// Verifies every engine decrypts the same as the original filter.
+BOOST_AUTO_TEST_CASE(DecryptEnginesMatchReference)
+{
+    srand(2);
+
+    for (XorChainEngine engine : kEngines)
+    {
+        for (uint32_t length = 0; length <= 496; ++length)
+        {
+            for (uint32_t offset = 0; offset < 3; ++offset)
+            {
+                vector<unsigned char> expected = RandomPayload(length);
+                vector<unsigned char> actual = expected;
+                uint32_t seed = static_cast<uint32_t>(rand()) * 2654435761u;
+
+                ReferenceDecrypt(&expected[offset], length, seed);
+                DecryptXorChain(&actual[offset], length, seed, engine);
+
+                BOOST_REQUIRE(expected == actual);
+            }
+        }
+    }
+}
+
+/// Verifies decrypting an encrypted payload restores it.
+BOOST_AUTO_TEST_CASE(DecryptReversesEncrypt)
+{
+    srand(3);
+
+    for (uint32_t length : { 1u, 4u, 37u, 255u, 496u })
+    {
+        vector<unsigned char> original = RandomPayload(length);
+        vector<unsigned char> payload = original;
+
+        EncryptXorChain(&payload[1], length, 0xDEADBEEF);
+        BOOST_CHECK(payload != original);
+
+        DecryptXorChain(&payload[1], length, 0xDEADBEEF);
+        BOOST_CHECK(payload == original);
+    }
+}
+
+/// Verifies the engine selected at runtime is one the cpu supports.
+BOOST_AUTO_TEST_CASE(ActiveEngineIsSupported)
+{
+    BOOST_CHECK(IsXorChainEngineSupported(ActiveXorChainEngine()));
+    BOOST_CHECK(IsXorChainEngineSupported(XOR_CHAIN_SCALAR));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
@@ -30,6 +30,12 @@ MOCK_BASE_CLASS(MockServer, ServerInterface )
 
     MOCK_METHOD(socket, 0);
     MOCK_METHOD(max_receive_size, 0);
+    MOCK_METHOD(packet_pool, 0);
+    MOCK_METHOD(timer_wheel, 0);
+    MOCK_METHOD(send_window, 0);
+    MOCK_METHOD(max_flush_latency, 0);
+    MOCK_METHOD(max_flush_batch_size, 0);
+    MOCK_METHOD(compression_level, 0);
 };
     
 }}}  // namespace anh::network::soe
@@ -0,0 +1,320 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include "anh/network/soe/packet_buffer.h"
+
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+using namespace anh;
+using namespace anh::network::soe;
+using namespace std;
+
+/**
+ * Header placed in front of the packet memory, both live in a single allocation.
+ */
+struct PacketBuffer::Block
+{
+    static Block* Create(uint32_t capacity)
+    {
+        void* memory = ::operator new(sizeof(Block) + capacity);
+        return new (memory) Block(capacity);
+    }
+
+    static void Destroy(Block* block)
+    {
+        block->~Block();
+        ::operator delete(block);
+    }
+
+    explicit Block(uint32_t capacity_)
+        : references(1)
+        , capacity(capacity_)
+    {}
+
+    unsigned char* memory()
+    {
+        return reinterpret_cast<unsigned char*>(this + 1);
+    }
+
+    std::atomic<uint32_t> references;
+    uint32_t capacity;
+
+    // Set while the block is handed out, keeps the pool alive until it is returned.
+    std::shared_ptr<PacketBufferPool> pool;
+};
+
+PacketBuffer::PacketBuffer()
+    : block_(nullptr)
+    , offset_(0)
+    , size_(0)
+{}
+
+PacketBuffer::PacketBuffer(Block* block, uint32_t headroom)
+    : block_(block)
+    , offset_(min(headroom, block->capacity))
+    , size_(0)
+{}
+
+PacketBuffer::PacketBuffer(const PacketBuffer& other)
+    : block_(other.block_)
+    , offset_(other.offset_)
+    , size_(other.size_)
+{
+    if (block_)
+    {
+        ++block_->references;
+    }
+}
+
+PacketBuffer::PacketBuffer(PacketBuffer&& other)
+    : block_(other.block_)
+    , offset_(other.offset_)
+    , size_(other.size_)
+{
+    other.block_ = nullptr;
+    other.offset_ = 0;
+    other.size_ = 0;
+}
+
+PacketBuffer& PacketBuffer::operator=(PacketBuffer other)
+{
+    other.swap(*this);
+    return *this;
+}
+
+PacketBuffer::~PacketBuffer()
+{
+    if (block_ && --block_->references == 0)
+    {
+        if (block_->pool)
+        {
+            // Hold the pool until the block is back on its free list.
+            auto pool = move(block_->pool);
+            pool->Release_(block_);
+        }
+        else
+        {
+            Block::Destroy(block_);
+        }
+    }
+}
+
+void PacketBuffer::swap(PacketBuffer& other)
+{
+    std::swap(block_, other.block_);
+    std::swap(offset_, other.offset_);
+    std::swap(size_, other.size_);
+}
+
+PacketBuffer PacketBuffer::Allocate(uint32_t capacity, uint32_t headroom)
+{
+    return PacketBuffer(Block::Create(capacity), headroom);
+}
+
+unsigned char* PacketBuffer::data()
+{
+    return block_ ? block_->memory() + offset_ : nullptr;
+}
+
+const unsigned char* PacketBuffer::data() const
+{
+    return block_ ? block_->memory() + offset_ : nullptr;
+}
+
+uint32_t PacketBuffer::size() const
+{
+    return size_;
+}
+
+uint32_t PacketBuffer::headroom() const
+{
+    return offset_;
+}
+
+uint32_t PacketBuffer::tailroom() const
+{
+    return block_ ? block_->capacity - offset_ - size_ : 0;
+}
+
+unsigned char* PacketBuffer::Prepend(uint32_t length)
+{
+    if (length > headroom())
+    {
+        throw length_error("Not enough headroom in packet buffer");
+    }
+
+    offset_ -= length;
+    size_ += length;
+
+    return data();
+}
+
+unsigned char* PacketBuffer::Append(uint32_t length)
+{
+    if (length > tailroom())
+    {
+        throw length_error("Not enough tailroom in packet buffer");
+    }
+
+    unsigned char* appended = data() + size_;
+    size_ += length;
+
+    return appended;
+}
+
+void PacketBuffer::Append(const unsigned char* data, uint32_t length)
+{
+    if (length)
+    {
+        memcpy(Append(length), data, length);
+    }
+}
+
+void PacketBuffer::AppendBig16(uint16_t value)
+{
+    unsigned char* appended = Append(2);
+    appended[0] = static_cast<unsigned char>(value >> 8);
+    appended[1] = static_cast<unsigned char>(value);
+}
+
+void PacketBuffer::TrimFront(uint32_t length)
+{
+    length = min(length, size_);
+    offset_ += length;
+    size_ -= length;
+}
+
+void PacketBuffer::TrimBack(uint32_t length)
+{
+    size_ -= min(length, size_);
+}
+
+void PacketBuffer::Resize(uint32_t size)
+{
+    if (size > size_)
+    {
+        Append(size - size_);
+    }
+    else
+    {
+        size_ = size;
+    }
+}
+
+uint32_t PacketBuffer::use_count() const
+{
+    return block_ ? block_->references.load() : 0;
+}
+
+ByteBuffer PacketBuffer::ToByteBuffer() const
+{
+    return size_ ? ByteBuffer(data(), size_) : ByteBuffer();
+}
+
+const uint32_t PacketBufferPool::kDefaultHeadroom;
+const uint32_t PacketBufferPool::kDefaultTailroom;
+
+PacketBufferPool::PacketBufferPool(uint32_t block_size, uint32_t max_pooled)
+    : block_size_(block_size)
+    , max_pooled_(max_pooled)
+    , heap_allocations_(0)
+    , acquisitions_(0)
+    , heap_frees_(0)
+{
+    free_blocks_.reserve(max_pooled_);
+}
+
+PacketBufferPool::~PacketBufferPool()
+{
+    for (auto block : free_blocks_)
+    {
+        PacketBuffer::Block::Destroy(block);
+    }
+}
+
+PacketBuffer PacketBufferPool::Acquire(uint32_t headroom)
+{
+    PacketBuffer::Block* block = nullptr;
+
+    {
+        boost::lock_guard<boost::mutex> lg(free_blocks_mutex_);
+        if (!free_blocks_.empty())
+        {
+            block = free_blocks_.back();
+            free_blocks_.pop_back();
+        }
+    }
+
+    if (block)
+    {
+        block->references = 1;
+    }
+    else
+    {
+        block = PacketBuffer::Block::Create(block_size_);
+        ++heap_allocations_;
+    }
+
+    block->pool = shared_from_this();
+    ++acquisitions_;
+
+    return PacketBuffer(block, headroom);
+}
+
+PacketBuffer PacketBufferPool::Copy(const unsigned char* data, uint32_t length)
+{
+    PacketBuffer buffer;
+
+    if (length + kDefaultHeadroom + kDefaultTailroom <= block_size_)
+    {
+        buffer = Acquire(kDefaultHeadroom);
+    }
+    else
+    {
+        // Oversized packets are rare (e.g. before fragmentation), give them their own block.
+        buffer = PacketBuffer::Allocate(length + kDefaultHeadroom + kDefaultTailroom, kDefaultHeadroom);
+        ++heap_allocations_;
+    }
+
+    buffer.Append(data, length);
+
+    return buffer;
+}
+
+uint32_t PacketBufferPool::block_size() const
+{
+    return block_size_;
+}
+
+PacketBufferPoolStatistics PacketBufferPool::statistics() const
+{
+    PacketBufferPoolStatistics stats;
+
+    stats.heap_allocations = heap_allocations_;
+    stats.acquisitions = acquisitions_;
+    stats.heap_frees = heap_frees_;
+
+    {
+        boost::lock_guard<boost::mutex> lg(free_blocks_mutex_);
+        stats.pooled = free_blocks_.size();
+    }
+
+    return stats;
+}
+
+void PacketBufferPool::Release_(PacketBuffer::Block* block)
+{
+    {
+        boost::lock_guard<boost::mutex> lg(free_blocks_mutex_);
+        if (free_blocks_.size() < max_pooled_)
+        {
+            free_blocks_.push_back(block);
+            return;
+        }
+    }
+
+    PacketBuffer::Block::Destroy(block);
+    ++heap_frees_;
+}
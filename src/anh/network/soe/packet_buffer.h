@@ -0,0 +1,206 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef ANH_NETWORK_SOE_PACKET_BUFFER_H_
+#define ANH_NETWORK_SOE_PACKET_BUFFER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "anh/byte_buffer.h"
+
+namespace anh {
+namespace network {
+namespace soe {
+
+class PacketBufferPool;
+
+/**
+ * @brief A view onto reference counted packet memory.
+ *
+ * Copying a PacketBuffer shares the underlying memory instead of copying it, which lets
+ * the send queue and the resend ring hold the same packet. Each copy has its own view
+ * (start and length) into the memory, space left before and after the view (headroom and
+ * tailroom) is used to prepend headers and append footers without moving the data.
+ *
+ * Writes through one copy are visible to every other copy of the same memory, a packet
+ * should be treated as immutable once it has been shared.
+ */
+class PacketBuffer
+{
+public:
+    /// Creates an empty buffer with no memory attached.
+    PacketBuffer();
+
+    PacketBuffer(const PacketBuffer& other);
+    PacketBuffer(PacketBuffer&& other);
+    PacketBuffer& operator=(PacketBuffer other);
+
+    ~PacketBuffer();
+
+    void swap(PacketBuffer& other);
+
+    /**
+     * Allocates a buffer directly from the heap, bypassing any pool.
+     *
+     * @param capacity The total capacity of the memory block.
+     * @param headroom The space reserved in front of the (initially empty) view.
+     */
+    static PacketBuffer Allocate(uint32_t capacity, uint32_t headroom);
+
+    unsigned char* data();
+    const unsigned char* data() const;
+
+    /// @return The length of the view.
+    uint32_t size() const;
+
+    /// @return The space available in front of the view.
+    uint32_t headroom() const;
+
+    /// @return The space available after the view.
+    uint32_t tailroom() const;
+
+    /**
+     * Extends the view to the front.
+     *
+     * @return A pointer to the new start of the view.
+     * @throws std::length_error If there is not enough headroom.
+     */
+    unsigned char* Prepend(uint32_t length);
+
+    /**
+     * Extends the view to the back.
+     *
+     * @return A pointer to the start of the appended space.
+     * @throws std::length_error If there is not enough tailroom.
+     */
+    unsigned char* Append(uint32_t length);
+
+    /**
+     * Copies data to the end of the view.
+     *
+     * @throws std::length_error If there is not enough tailroom.
+     */
+    void Append(const unsigned char* data, uint32_t length);
+
+    /**
+     * Appends a value in network byte order.
+     */
+    void AppendBig16(uint16_t value);
+
+    /// Shrinks the view from the front, the bytes become headroom.
+    void TrimFront(uint32_t length);
+
+    /// Shrinks the view from the back, the bytes become tailroom.
+    void TrimBack(uint32_t length);
+
+    /**
+     * Sets the length of the view, growing into or shrinking from the tailroom.
+     *
+     * @throws std::length_error If there is not enough tailroom.
+     */
+    void Resize(uint32_t size);
+
+    /**
+     * @return The number of PacketBuffers sharing this buffer's memory.
+     */
+    uint32_t use_count() const;
+
+    /**
+     * @return A copy of the view in a ByteBuffer, for handing off to the message layer.
+     */
+    anh::ByteBuffer ToByteBuffer() const;
+
+private:
+    friend class PacketBufferPool;
+
+    struct Block;
+
+    PacketBuffer(Block* block, uint32_t headroom);
+
+    Block* block_;
+    uint32_t offset_;
+    uint32_t size_;
+};
+
+/**
+ * @brief Allocation counters for a PacketBufferPool.
+ */
+struct PacketBufferPoolStatistics
+{
+    /// Blocks allocated from the heap, stays flat once the pool has warmed up.
+    uint64_t heap_allocations;
+
+    /// Buffers handed out by Acquire.
+    uint64_t acquisitions;
+
+    /// Blocks freed back to the heap because the pool was full.
+    uint64_t heap_frees;
+
+    /// Blocks currently idle in the pool.
+    uint64_t pooled;
+};
+
+/**
+ * @brief A pool of fixed size packet memory blocks.
+ *
+ * Released blocks go back on a free list and are handed out again by Acquire, so once
+ * the pool holds enough blocks for the packets in flight no further heap allocations
+ * are made. Outstanding buffers keep the pool alive, it may be released while packets
+ * are still queued.
+ */
+class PacketBufferPool : public std::enable_shared_from_this<PacketBufferPool>, private boost::noncopyable
+{
+public:
+    /// Space reserved in front of a packet for protocol headers.
+    static const uint32_t kDefaultHeadroom = 16;
+
+    /// Space reserved after a packet for the compression flag and crc footer.
+    static const uint32_t kDefaultTailroom = 16;
+
+    /**
+     * @param block_size The capacity of each block.
+     * @param max_pooled The most idle blocks kept around, extra blocks go back to the heap.
+     */
+    explicit PacketBufferPool(uint32_t block_size, uint32_t max_pooled = 8192);
+    ~PacketBufferPool();
+
+    /**
+     * @param headroom The space reserved in front of the (initially empty) view.
+     * @return An empty buffer backed by a block from the pool.
+     */
+    PacketBuffer Acquire(uint32_t headroom = kDefaultHeadroom);
+
+    /**
+     * @return A buffer holding a copy of the data, with the default headroom.
+     */
+    PacketBuffer Copy(const unsigned char* data, uint32_t length);
+
+    uint32_t block_size() const;
+
+    PacketBufferPoolStatistics statistics() const;
+
+private:
+    friend class PacketBuffer;
+
+    void Release_(PacketBuffer::Block* block);
+
+    uint32_t block_size_;
+    uint32_t max_pooled_;
+
+    mutable boost::mutex free_blocks_mutex_;
+    std::vector<PacketBuffer::Block*> free_blocks_;
+
+    std::atomic<uint64_t> heap_allocations_;
+    std::atomic<uint64_t> acquisitions_;
+    std::atomic<uint64_t> heap_frees_;
+};
+
+}}}  // namespace anh::network::soe
+
+#endif  // ANH_NETWORK_SOE_PACKET_BUFFER_H_
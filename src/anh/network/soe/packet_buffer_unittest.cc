@@ -0,0 +1,133 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "anh/network/soe/packet_buffer.h"
+
+using namespace anh::network::soe;
+using namespace std;
+
+namespace {
+
+BOOST_AUTO_TEST_SUITE(PacketBufferTests)
+
+/// Verifies that headers and footers are written around the data without moving it.
+BOOST_AUTO_TEST_CASE(HeadroomAndTailroomAreUsedInPlace)
+{
+    auto pool = make_shared<PacketBufferPool>(64);
+    PacketBuffer packet = pool->Acquire(4);
+
+    const unsigned char payload[] = { 0xDE, 0xAD, 0xBA, 0xBE };
+    packet.Append(payload, sizeof(payload));
+
+    const unsigned char* payload_start = packet.data();
+
+    unsigned char* header = packet.Prepend(2);
+    header[0] = 0x00;
+    header[1] = 0x09;
+
+    packet.AppendBig16(0x1234);
+
+    BOOST_CHECK(payload_start - 2 == packet.data());
+    BOOST_CHECK_EQUAL(8U, packet.size());
+    BOOST_CHECK_EQUAL(2U, packet.headroom());
+    BOOST_CHECK_EQUAL(0x09, packet.data()[1]);
+    BOOST_CHECK_EQUAL(0xDE, packet.data()[2]);
+    BOOST_CHECK_EQUAL(0x12, packet.data()[6]);
+    BOOST_CHECK_EQUAL(0x34, packet.data()[7]);
+
+    packet.TrimBack(2);
+    packet.TrimFront(2);
+
+    BOOST_CHECK(payload_start == packet.data());
+    BOOST_CHECK_EQUAL(4U, packet.size());
+
+    BOOST_CHECK_THROW(packet.Prepend(5), length_error);
+    BOOST_CHECK_THROW(packet.Append(packet.tailroom() + 1), length_error);
+}
+
+/// Verifies that copies share memory and the block is released with the last copy.
+BOOST_AUTO_TEST_CASE(CopiesShareMemory)
+{
+    auto pool = make_shared<PacketBufferPool>(64);
+    PacketBuffer packet = pool->Acquire();
+    packet.AppendBig16(0x0015);
+
+    {
+        PacketBuffer copy = packet;
+
+        BOOST_CHECK(packet.data() == copy.data());
+        BOOST_CHECK_EQUAL(2U, packet.use_count());
+        BOOST_CHECK_EQUAL(0U, pool->statistics().pooled);
+    }
+
+    BOOST_CHECK_EQUAL(1U, packet.use_count());
+
+    packet = PacketBuffer();
+
+    BOOST_CHECK_EQUAL(1U, pool->statistics().pooled);
+}
+
+/// Verifies that once warmed up the pool hands out released blocks instead of allocating.
+BOOST_AUTO_TEST_CASE(PoolReusesReleasedBlocks)
+{
+    auto pool = make_shared<PacketBufferPool>(64);
+
+    for (int round = 0; round < 100; ++round)
+    {
+        vector<PacketBuffer> in_flight;
+
+        for (int i = 0; i < 8; ++i)
+        {
+            in_flight.push_back(pool->Acquire());
+            in_flight.back().AppendBig16(static_cast<uint16_t>(i));
+        }
+    }
+
+    auto stats = pool->statistics();
+
+    BOOST_CHECK_EQUAL(8U, stats.heap_allocations);
+    BOOST_CHECK_EQUAL(800U, stats.acquisitions);
+    BOOST_CHECK_EQUAL(8U, stats.pooled);
+}
+
+/// Verifies that data too large for a pooled block still gets a buffer.
+BOOST_AUTO_TEST_CASE(OversizedCopiesGetTheirOwnBlock)
+{
+    auto pool = make_shared<PacketBufferPool>(64);
+
+    vector<unsigned char> data(200, 0x42);
+    PacketBuffer packet = pool->Copy(&data[0], data.size());
+
+    BOOST_CHECK_EQUAL(200U, packet.size());
+    BOOST_CHECK_EQUAL(PacketBufferPool::kDefaultHeadroom, packet.headroom());
+    BOOST_CHECK_EQUAL(0x42, packet.data()[199]);
+
+    packet = PacketBuffer();
+
+    BOOST_CHECK_EQUAL(0U, pool->statistics().pooled);
+}
+
+/// Verifies that buffers outliving their pool are released safely.
+BOOST_AUTO_TEST_CASE(BuffersKeepTheirPoolAlive)
+{
+    auto pool = make_shared<PacketBufferPool>(64);
+    weak_ptr<PacketBufferPool> weak_pool = pool;
+
+    PacketBuffer packet = pool->Acquire();
+    pool.reset();
+
+    BOOST_CHECK(!weak_pool.expired());
+
+    packet = PacketBuffer();
+
+    BOOST_CHECK(weak_pool.expired());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
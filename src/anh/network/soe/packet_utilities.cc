@@ -73,6 +73,70 @@ ByteBuffer PackDataChannelMessages(list<ByteBuffer> data_list) {
     return output_buffer;
 }
 
+list<ByteBuffer> PackDataChannelPayloads(list<ByteBuffer> data_list, uint32_t max_size) {
+    list<ByteBuffer> payloads;
+
+    // Messages waiting to be packed into the current payload and the size they will
+    // have once packed.
+    list<ByteBuffer> pending;
+    uint32_t pending_size = 0;
+
+    auto size_in_multi_message = [] (const ByteBuffer& message) {
+        return message.size() + ((message.size() >= 255) ? 3 : 1);
+    };
+
+    // Datagrams needed to send a payload, larger ones are split with a 4 byte total
+    // size in front of the first fragment.
+    auto datagram_count = [max_size] (uint32_t payload_size) {
+        return (payload_size <= max_size) ? 1 : (payload_size + 4 + max_size - 1) / max_size;
+    };
+
+    auto flush_pending = [&payloads, &pending, &pending_size] () {
+        if (!pending.empty()) {
+            payloads.push_back(PackDataChannelMessages(move(pending)));
+            pending.clear();
+            pending_size = 0;
+        }
+    };
+
+    while (!data_list.empty()) {
+        ByteBuffer& message = data_list.front();
+
+        if (pending.empty()) {
+            pending_size = message.size();
+            pending.push_back(move(message));
+            data_list.pop_front();
+            continue;
+        }
+
+        // A lone message is sent as is, adding another turns it into a 0x19
+        // multi-message which prefixes every message with its size.
+        uint32_t packed_size = (pending.size() == 1)
+            ? 2 + size_in_multi_message(pending.front())
+            : pending_size;
+
+        packed_size += size_in_multi_message(message);
+
+        // Only pack the message in if that saves a datagram, e.g. it fits in the current
+        // datagram or in the unused end of an oversized message's last fragment. This
+        // keeps each fragmented payload, and the messages stalled by losing one of its
+        // fragments, as small as possible.
+        if (datagram_count(packed_size) < datagram_count(pending_size) + datagram_count(message.size())) {
+            pending_size = packed_size;
+        } else {
+            flush_pending();
+            pending_size = message.size();
+        }
+
+        pending.push_back(move(message));
+        data_list.pop_front();
+    }
+
+    flush_pending();
+
+    return payloads;
+}
+
 list<ByteBuffer> SplitDataChannelMessage(ByteBuffer message, uint32_t max_size) {
     uint32_t message_size = message.size();  
     
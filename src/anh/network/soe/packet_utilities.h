@@ -40,6 +40,21 @@ anh::ByteBuffer BuildFragmentedDataChannelHeader(uint16_t sequence);
  */
 anh::ByteBuffer PackDataChannelMessages(std::list<anh::ByteBuffer> data_list);
 
+/**
+ * Packs a list of game messages into data channel payloads that fit in a datagram.
+ *
+ * Messages are kept in order and each payload is filled up to max_size before the next
+ * is started, so a burst of small messages goes out in as few datagrams as possible.
+ * Only payloads holding a message too large for a datagram on its own exceed max_size,
+ * these are to be split with SplitDataChannelMessage and share their fragments with
+ * no more messages than fit in the unused end of the last one.
+ *
+ * @param data_list A list of game messages to pack.
+ * @param max_size The maximum size of a payload.
+ * @return The in-order payloads, each containing 1 or more game messages.
+ */
+std::list<anh::ByteBuffer> PackDataChannelPayloads(std::list<anh::ByteBuffer> data_list, uint32_t max_size);
+
 /**
  * Splits a large data channel message into fragments.
  *
@@ -1,9 +1,11 @@
 // This file is part of SWGANH which is released under the MIT license.
 // See file LICENSE or go to http://swganh.com/LICENSE
 
+#include <iterator>
 #include <list>
 #include <stdexcept>
 #include <tuple>
+#include <vector>
 #include <boost/test/unit_test.hpp>
 #include "anh/network/soe/packet_utilities.h"
 #include "anh/byte_buffer.h"
@@ -108,6 +110,103 @@ BOOST_AUTO_TEST_CASE(LargeSwgMessagesHaveBytePlus16ByteSizePrefix) {
     }
 }
 
+/// This test ensures that small messages are packed into as few payloads as fit within the
+/// max size instead of one payload holding all of them.
+BOOST_AUTO_TEST_CASE(PackingPayloadsFillsEachUpToMaxSize) {
+    list<ByteBuffer> buffer_list;
+
+    for (uint32_t i = 0; i < 10; ++i) {
+        ByteBuffer small_buffer;
+        small_buffer.write<uint32_t>(i);
+        buffer_list.push_back(small_buffer);
+    }
+
+    // Each message takes 5 bytes in a multi-message, after the 2 byte header 3 fit in 20.
+    list<ByteBuffer> payloads = PackDataChannelPayloads(move(buffer_list), 20);
+
+    BOOST_REQUIRE_EQUAL(4, payloads.size());
+
+    uint32_t expected_value = 0;
+
+    for (auto it = payloads.begin(); it != payloads.end(); ++it) {
+        BOOST_CHECK(it->size() <= 20);
+
+        // The last payload holds a lone message which is not given a multi-message header.
+        if (next(it) == payloads.end()) {
+            BOOST_CHECK_EQUAL(4, it->size());
+            BOOST_CHECK_EQUAL(expected_value++, it->read<uint32_t>());
+            continue;
+        }
+
+        BOOST_CHECK_EQUAL(anh::bigToHost<uint16_t>(0x19), it->read<uint16_t>());
+
+        for (int i = 0; i < 3; ++i) {
+            BOOST_CHECK_EQUAL(4, it->read<uint8_t>()); // size
+            BOOST_CHECK_EQUAL(expected_value++, it->read<uint32_t>()); // data, in order
+        }
+    }
+}
+
+/// This test ensures that small messages fill the unused end of an oversized message's last
+/// fragment, rather than taking datagrams of their own.
+BOOST_AUTO_TEST_CASE(PackingPayloadsFillsLastFragmentOfOversizedMessages) {
+    ByteBuffer small_buffer;
+    small_buffer.write<uint32_t>(500);
+
+    ByteBuffer large_buffer;
+    large_buffer.write<string>(PacketUtilitiesTests::long_string);
+
+    list<ByteBuffer> buffer_list;
+    buffer_list.push_back(small_buffer);
+    buffer_list.push_back(large_buffer);
+    buffer_list.push_back(small_buffer);
+
+    list<ByteBuffer> payloads = PackDataChannelPayloads(move(buffer_list), 200);
+
+    // 0x19 header + 3 size prefixed messages, split into the same 2 fragments the large
+    // message alone would need.
+    BOOST_REQUIRE_EQUAL(1, payloads.size());
+    BOOST_CHECK_EQUAL(2 + 5 + 305 + 5, payloads.front().size());
+    BOOST_CHECK_EQUAL(2, SplitDataChannelMessage(payloads.front(), 200).size());
+}
+
+/// This test ensures that a message is not packed with an oversized message if that would
+/// need another fragment.
+BOOST_AUTO_TEST_CASE(PackingPayloadsKeepsOversizedMessagesSeparate) {
+    vector<unsigned char> medium_data(190, 0x01);
+
+    ByteBuffer large_buffer;
+    large_buffer.write<string>(PacketUtilitiesTests::long_string);
+    ByteBuffer medium_buffer(medium_data);
+
+    list<ByteBuffer> buffer_list;
+    buffer_list.push_back(large_buffer);
+    buffer_list.push_back(medium_buffer);
+
+    list<ByteBuffer> payloads = PackDataChannelPayloads(move(buffer_list), 200);
+
+    BOOST_REQUIRE_EQUAL(2, payloads.size());
+    BOOST_CHECK(large_buffer == payloads.front());
+    BOOST_CHECK(medium_buffer == payloads.back());
+}
+
+/// This test ensures that a payload is never packed past the max size, even by the size prefix.
+BOOST_AUTO_TEST_CASE(PackingPayloadsAccountsForSizePrefixes) {
+    vector<unsigned char> first_data(100, 0x01);
+    vector<unsigned char> second_data(96, 0x02);
+
+    ByteBuffer first_buffer(first_data);
+    ByteBuffer second_buffer(second_data);
+
+    list<ByteBuffer> buffer_list;
+    buffer_list.push_back(first_buffer);
+    buffer_list.push_back(second_buffer);
+
+    // Packed together these take 2 + 101 + 97 = 200 bytes.
+    BOOST_CHECK_EQUAL(1, PackDataChannelPayloads(buffer_list, 200).size());
+    BOOST_CHECK_EQUAL(2, PackDataChannelPayloads(buffer_list, 199).size());
+}
+
 BOOST_AUTO_TEST_CASE(CanSplitDataChannelMessages) {
     ByteBuffer large_message;
     large_message.write(PacketUtilitiesTests::long_string);
@@ -3,9 +3,21 @@
 
 #include "anh/network/soe/server.h"
 
+#include <atomic>
+#include <cstring>
+
 #include "anh/logger.h"
 #include <boost/pool/pool_alloc.hpp>
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <cerrno>
+#define ANH_HAS_BATCHED_UDP 1
+#endif
+
 #include "anh/byte_buffer.h"
 
 #include "anh/network/soe/session.h"
@@ -17,40 +29,283 @@ using namespace std;
 using boost::asio::ip::udp;
 using boost::asio::buffer;
 
+namespace {
+    /// Maximum number of datagrams moved per recvmmsg/sendmmsg call.
+    const uint32_t kBatchSize = 64;
+
+    /// Upper bound on the number of batches drained per socket wakeup so that a
+    /// flood on one socket can not starve other handlers on the io_service.
+    const uint32_t kMaxBatchesPerWakeup = 4;
+
+    /// Resolution of the session timer wheel.
+    const boost::posix_time::time_duration kTimerWheelTick = boost::posix_time::milliseconds(10);
+
+#ifdef SO_REUSEPORT
+    typedef boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT> ReusePort;
+#endif
+
+    void PinThreadToCore(boost::thread& thread, uint32_t core)
+    {
+#ifdef __linux__
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(core % max(1u, boost::thread::hardware_concurrency()), &cpu_set);
+
+        pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set), &cpu_set);
+#endif
+    }
+}
+
+#ifdef ANH_HAS_BATCHED_UDP
+
+struct Server::BatchBuffers
+{
+    BatchBuffers(PacketBufferPool& pool, uint32_t max_receive_size)
+        : max_receive_size(max_receive_size)
+    {
+        for (uint32_t i = 0; i < kBatchSize; ++i)
+        {
+            RefillReceivePacket(pool, i);
+        }
+    }
+
+    /// Replaces a packet that was handed off to a session with a fresh one from the pool.
+    void RefillReceivePacket(PacketBufferPool& pool, uint32_t index)
+    {
+        receive_packets[index] = pool.Acquire(0);
+        receive_iovecs[index].iov_base = receive_packets[index].data();
+        receive_iovecs[index].iov_len = max_receive_size;
+    }
+
+    void ResetReceiveHeaders()
+    {
+        memset(receive_headers, 0, sizeof(receive_headers));
+
+        for (uint32_t i = 0; i < kBatchSize; ++i)
+        {
+            receive_headers[i].msg_hdr.msg_name = &receive_addresses[i];
+            receive_headers[i].msg_hdr.msg_namelen = sizeof(receive_addresses[i]);
+            receive_headers[i].msg_hdr.msg_iov = &receive_iovecs[i];
+            receive_headers[i].msg_hdr.msg_iovlen = 1;
+        }
+    }
+
+    uint32_t max_receive_size;
+
+    // Datagrams are received straight into pooled packets which are then passed on
+    // to the sessions without copying.
+    PacketBuffer receive_packets[kBatchSize];
+    iovec receive_iovecs[kBatchSize];
+    sockaddr_storage receive_addresses[kBatchSize];
+    mmsghdr receive_headers[kBatchSize];
+
+    iovec send_iovecs[kBatchSize];
+    mmsghdr send_headers[kBatchSize];
+};
+
+#else
+
+struct Server::BatchBuffers
+{
+    BatchBuffers(PacketBufferPool&, uint32_t) {}
+};
+
+#endif
+
+struct Server::Shard
+{
+    Shard(boost::asio::io_service& shared_io_service, bool dedicated)
+        : owned_io_service(dedicated ? new boost::asio::io_service : nullptr)
+        , io_service(dedicated ? *owned_io_service : shared_io_service)
+        , strand(io_service)
+        , socket(io_service)
+        , send_flush_pending(false)
+        , bytes_recv(0)
+        , bytes_sent(0)
+        , packets_recv(0)
+        , packets_sent(0)
+        , receive_calls(0)
+        , send_calls(0)
+    {}
+
+    // Only set when the shard runs its receive loop on a dedicated thread.
+    std::unique_ptr<boost::asio::io_service> owned_io_service;
+    std::unique_ptr<boost::asio::io_service::work> work;
+
+    boost::asio::io_service& io_service;
+    boost::asio::strand strand;
+
+    udp::socket socket;
+    udp::endpoint current_remote_endpoint;
+    PacketBuffer recv_packet;
+
+    std::unique_ptr<BatchBuffers> batch_buffers;
+
+    boost::mutex send_queue_mutex;
+    SendQueue send_queue;
+    bool send_flush_pending;
+
+    // Swapped with send_queue by the flush so both keep their capacity, only touched
+    // on the strand.
+    SendQueue flushing_queue;
+
+    std::atomic<uint64_t> bytes_recv;
+    std::atomic<uint64_t> bytes_sent;
+    std::atomic<uint64_t> packets_recv;
+    std::atomic<uint64_t> packets_sent;
+    std::atomic<uint64_t> receive_calls;
+    std::atomic<uint64_t> send_calls;
+};
+
 Server::Server(boost::asio::io_service& io_service)
     : io_service_(io_service)
-    , strand_(io_service)
-    , socket_(io_service)
+    , timer_wheel_(kTimerWheelTick)
+    , timer_wheel_tick_(io_service)
+    , batched_io_(false)
+    , socket_shards_(1)
     , max_receive_size_(496)
+    , packet_pool_(make_shared<PacketBufferPool>(
+        max_receive_size_ + PacketBufferPool::kDefaultHeadroom + PacketBufferPool::kDefaultTailroom))
+    , send_window_(128)
+    , max_flush_latency_(boost::posix_time::milliseconds(0))
+    , max_flush_batch_size_(64)
+    , compression_level_(6)
 {}
 
 Server::~Server(void)
-{	
+{
+    Shutdown();
 }
 
 void Server::Start(uint16_t port)
 {
-    socket_.open(udp::v4());
-    socket_.bind(udp::endpoint(udp::v4(), port));
-    
-    AsyncReceive();
+    uint32_t shard_count = socket_shards_;
+
+#ifndef SO_REUSEPORT
+    if (shard_count > 1)
+    {
+        LOG(warning) << "SO_REUSEPORT is not supported on this platform, using a single socket";
+        shard_count = 1;
+    }
+#endif
+
+    bool dedicated_threads = shard_count > 1;
+
+    for (uint32_t i = 0; i < shard_count; ++i)
+    {
+        unique_ptr<Shard> shard(new Shard(io_service_, dedicated_threads));
+
+        shard->socket.open(udp::v4());
+
+#ifdef SO_REUSEPORT
+        if (shard_count > 1)
+        {
+            shard->socket.set_option(ReusePort(true));
+        }
+#endif
+
+        shard->socket.bind(udp::endpoint(udp::v4(), port));
+
+        // When binding to an ephemeral port the remaining shards join the port
+        // picked for the first one.
+        port = shard->socket.local_endpoint().port();
+
+        if (batched_io_)
+        {
+            shard->batch_buffers.reset(new BatchBuffers(*packet_pool_, max_receive_size_));
+            shard->socket.non_blocking(true);
+        }
+
+        shards_.push_back(move(shard));
+    }
+
+    LOG(info) << "Listening on port " << port << " with " << shard_count << " socket(s)"
+        << (batched_io_ ? " using batched datagram I/O" : "");
+
+    for (uint32_t i = 0; i < shards_.size(); ++i)
+    {
+        Shard* shard = shards_[i].get();
+
+        if (batched_io_)
+        {
+            AsyncReceiveBatch_(shard);
+        }
+        else
+        {
+            AsyncReceive(shard);
+        }
+
+        if (shard->owned_io_service)
+        {
+            shard->work.reset(new boost::asio::io_service::work(*shard->owned_io_service));
+
+            boost::thread shard_thread([shard] () {
+                shard->owned_io_service->run();
+            });
+
+            PinThreadToCore(shard_thread, i);
+
+            shard_threads_.push_back(move(shard_thread));
+        }
+    }
+
+    timer_wheel_start_ = boost::posix_time::microsec_clock::universal_time();
+    ScheduleTimerWheelTick_();
 }
 
 void Server::Shutdown(void) {
-    socket_.close();
+    boost::system::error_code error;
+    timer_wheel_tick_.cancel(error);
+
+    for (auto& shard : shards_)
+    {
+        boost::system::error_code error;
+        shard->socket.close(error);
+
+        shard->work.reset();
+
+        if (shard->owned_io_service)
+        {
+            shard->owned_io_service->stop();
+        }
+    }
+
+    for_each(shard_threads_.begin(), shard_threads_.end(), mem_fn(&boost::thread::join));
+    shard_threads_.clear();
 }
-    
-void Server::SendTo(const udp::endpoint& endpoint, ByteBuffer buffer) {
-    socket_.async_send_to(boost::asio::buffer(buffer.data(), buffer.size()), 
-        endpoint, 
-        [this] (const boost::system::error_code& error, std::size_t bytes_transferred)
+
+void Server::SendTo(const udp::endpoint& endpoint, PacketBuffer buffer) {
+    Shard* shard = GetShard_(endpoint);
+
+    if (batched_io_)
+    {
+        boost::lock_guard<boost::mutex> lg(shard->send_queue_mutex);
+        shard->send_queue.push_back(make_pair(endpoint, move(buffer)));
+
+        if (!shard->send_flush_pending)
+        {
+            shard->send_flush_pending = true;
+            shard->strand.post([this, shard] () { FlushSendQueue_(shard); });
+        }
+
+        return;
+    }
+
+    ++shard->send_calls;
+
+    // The handler holds a reference to the packet memory until the send completes.
+    auto send_buffer = boost::asio::buffer(buffer.data(), buffer.size());
+    shard->socket.async_send_to(send_buffer,
+        endpoint,
+        [shard, buffer] (const boost::system::error_code& error, std::size_t bytes_transferred)
     {
         if (bytes_transferred == 0)
         {
             LOG(warning) << "Sent 0 bytes";
         }
 
-        bytes_sent_ += bytes_transferred;
+        ++shard->packets_sent;
+        shard->bytes_sent += bytes_transferred;
     });
 }
 
@@ -63,29 +318,364 @@ string Server::Resolve(const string& hostname)
     return resolved_endpoint.address().to_string();
 }
 
-void Server::AsyncReceive() {
-    socket_.async_receive_from(
-        buffer(&recv_buffer_[0], recv_buffer_.size()), 
-        current_remote_endpoint_,
-        [this] (const boost::system::error_code& error, std::size_t bytes_transferred) {
+Server::Shard* Server::GetShard_(const udp::endpoint& endpoint)
+{
+    // Any socket bound to the listen port can send to a client, spreading the
+    // sends over the shards keeps their send queues independent.
+    if (shards_.size() == 1)
+    {
+        return shards_.front().get();
+    }
+
+    size_t hash = endpoint.port();
+    if (endpoint.address().is_v4())
+    {
+        hash ^= endpoint.address().to_v4().to_ulong() * 2654435761u;
+    }
+
+    return shards_[hash % shards_.size()].get();
+}
+
+void Server::AsyncReceive(Shard* shard) {
+    if (!shard->recv_packet.data())
+    {
+        shard->recv_packet = packet_pool_->Acquire(0);
+    }
+
+    shard->socket.async_receive_from(
+        buffer(shard->recv_packet.data(), max_receive_size_),
+        shard->current_remote_endpoint,
+        [this, shard] (const boost::system::error_code& error, std::size_t bytes_transferred) {
+            if (error == boost::asio::error::operation_aborted || !shard->socket.is_open())
+            {
+                return;
+            }
+
+            ++shard->receive_calls;
+
             if(bytes_transferred > 2 || !error || error == boost::asio::error::message_size)
             {
-                bytes_recv_ += bytes_transferred;
+                ++shard->packets_recv;
+                shard->bytes_recv += bytes_transferred;
 
-                ByteBuffer message;
-                message.write((const unsigned char*)recv_buffer_.data(), bytes_transferred);
+                // Hand the packet itself to the session, the next receive gets a new one.
+                PacketBuffer message;
+                message.swap(shard->recv_packet);
+                message.Resize(bytes_transferred);
 
-                GetSession(current_remote_endpoint_)->HandleProtocolMessage(move(message));
+                GetSession(shard->current_remote_endpoint)->HandleProtocolMessage(move(message));
             }
 
-            AsyncReceive();
+            AsyncReceive(shard);
     });
 }
 
+#ifdef ANH_HAS_BATCHED_UDP
+
+void Server::AsyncReceiveBatch_(Shard* shard)
+{
+    // Wait for the socket to become readable and then drain it directly, this
+    // lets a single wakeup pull in many datagrams with one system call.
+    shard->socket.async_receive(
+        boost::asio::null_buffers(),
+        [this, shard] (const boost::system::error_code& error, std::size_t)
+    {
+        if (error == boost::asio::error::operation_aborted || !shard->socket.is_open())
+        {
+            return;
+        }
+
+        BatchBuffers* batch_buffers = shard->batch_buffers.get();
+
+        for (uint32_t batch = 0; batch < kMaxBatchesPerWakeup; ++batch)
+        {
+            batch_buffers->ResetReceiveHeaders();
+
+            int received = recvmmsg(
+                shard->socket.native_handle(),
+                batch_buffers->receive_headers,
+                kBatchSize,
+                MSG_DONTWAIT,
+                nullptr);
+
+            ++shard->receive_calls;
+
+            if (received <= 0)
+            {
+                if (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+                {
+                    LOG(warning) << "Batched receive failed: " << errno;
+                }
+
+                break;
+            }
+
+            for (int i = 0; i < received; ++i)
+            {
+                const mmsghdr& header = batch_buffers->receive_headers[i];
+                uint32_t bytes_transferred = header.msg_len;
+
+                if (bytes_transferred <= 2 || header.msg_hdr.msg_namelen > sizeof(sockaddr_storage))
+                {
+                    continue;
+                }
+
+                ++shard->packets_recv;
+                shard->bytes_recv += bytes_transferred;
+
+                udp::endpoint remote_endpoint;
+                memcpy(remote_endpoint.data(), header.msg_hdr.msg_name, header.msg_hdr.msg_namelen);
+                remote_endpoint.resize(header.msg_hdr.msg_namelen);
+
+                PacketBuffer message;
+                message.swap(batch_buffers->receive_packets[i]);
+                message.Resize(bytes_transferred);
+
+                batch_buffers->RefillReceivePacket(*packet_pool_, i);
+
+                GetSession(remote_endpoint)->HandleProtocolMessage(move(message));
+            }
+
+            if (static_cast<uint32_t>(received) < kBatchSize)
+            {
+                break;
+            }
+        }
+
+        AsyncReceiveBatch_(shard);
+    });
+}
+
+void Server::FlushSendQueue_(Shard* shard)
+{
+    SendQueue& pending = shard->flushing_queue;
+
+    {
+        boost::lock_guard<boost::mutex> lg(shard->send_queue_mutex);
+        pending.swap(shard->send_queue);
+    }
+
+    BatchBuffers* batch_buffers = shard->batch_buffers.get();
+    size_t offset = 0;
+
+    while (offset < pending.size() && shard->socket.is_open())
+    {
+        uint32_t count = static_cast<uint32_t>(
+            std::min<size_t>(kBatchSize, pending.size() - offset));
+
+        memset(batch_buffers->send_headers, 0, sizeof(batch_buffers->send_headers));
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            auto& item = pending[offset + i];
+
+            batch_buffers->send_iovecs[i].iov_base = const_cast<unsigned char*>(item.second.data());
+            batch_buffers->send_iovecs[i].iov_len = item.second.size();
+
+            msghdr& header = batch_buffers->send_headers[i].msg_hdr;
+            header.msg_name = item.first.data();
+            header.msg_namelen = item.first.size();
+            header.msg_iov = &batch_buffers->send_iovecs[i];
+            header.msg_iovlen = 1;
+        }
+
+        int sent = sendmmsg(shard->socket.native_handle(), batch_buffers->send_headers, count, MSG_DONTWAIT);
+        ++shard->send_calls;
+
+        if (sent < 0)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                // The socket send buffer is full; requeue the remainder at the front and
+                // resume once the socket is writable again.
+                boost::lock_guard<boost::mutex> lg(shard->send_queue_mutex);
+                shard->send_queue.insert(
+                    shard->send_queue.begin(),
+                    make_move_iterator(pending.begin() + offset),
+                    make_move_iterator(pending.end()));
+                pending.clear();
+
+                shard->socket.async_send(
+                    boost::asio::null_buffers(),
+                    shard->strand.wrap([this, shard] (const boost::system::error_code& error, std::size_t) {
+                        FlushSendQueue_(shard);
+                    }));
+
+                return;
+            }
+
+            LOG(warning) << "Batched send failed: " << errno;
+
+            // Drop the packet that failed, the reliability layer will resend it.
+            sent = 1;
+        }
+
+        for (int i = 0; i < sent; ++i)
+        {
+            ++shard->packets_sent;
+            shard->bytes_sent += pending[offset + i].second.size();
+        }
+
+        offset += sent;
+    }
+
+    // Releases the sent packets while keeping the queue's capacity.
+    pending.clear();
+
+    boost::lock_guard<boost::mutex> lg(shard->send_queue_mutex);
+
+    if (shard->send_queue.empty())
+    {
+        shard->send_flush_pending = false;
+    }
+    else
+    {
+        shard->strand.post([this, shard] () { FlushSendQueue_(shard); });
+    }
+}
+
+#else
+
+void Server::AsyncReceiveBatch_(Shard* shard)
+{
+    AsyncReceive(shard);
+}
+
+void Server::FlushSendQueue_(Shard* shard)
+{
+    SendQueue& pending = shard->flushing_queue;
+
+    {
+        boost::lock_guard<boost::mutex> lg(shard->send_queue_mutex);
+        pending.swap(shard->send_queue);
+        shard->send_flush_pending = false;
+    }
+
+    for (auto& item : pending)
+    {
+        boost::system::error_code error;
+        shard->bytes_sent += shard->socket.send_to(buffer(item.second.data(), item.second.size()), item.first, 0, error);
+
+        ++shard->packets_sent;
+        ++shard->send_calls;
+    }
+
+    pending.clear();
+}
+
+#endif
+
 boost::asio::ip::udp::socket* Server::socket() {
-    return &socket_;
+    return shards_.empty() ? nullptr : &shards_.front()->socket;
 }
 
 uint32_t Server::max_receive_size() {
     return max_receive_size_;
 }
+
+shared_ptr<PacketBufferPool> Server::packet_pool() {
+    return packet_pool_;
+}
+
+TimerWheel* Server::timer_wheel() {
+    return &timer_wheel_;
+}
+
+uint32_t Server::send_window() {
+    return send_window_;
+}
+
+void Server::send_window(uint32_t window) {
+    send_window_ = max(1u, window);
+}
+
+boost::posix_time::time_duration Server::max_flush_latency() {
+    return max_flush_latency_;
+}
+
+void Server::max_flush_latency(boost::posix_time::time_duration latency) {
+    max_flush_latency_ = latency;
+}
+
+uint32_t Server::max_flush_batch_size() {
+    return max_flush_batch_size_;
+}
+
+void Server::max_flush_batch_size(uint32_t batch_size) {
+    max_flush_batch_size_ = max(1u, batch_size);
+}
+
+int Server::compression_level() {
+    return compression_level_;
+}
+
+void Server::compression_level(int level) {
+    compression_level_ = min(9, max(0, level));
+}
+
+void Server::ScheduleTimerWheelTick_()
+{
+    timer_wheel_tick_.expires_from_now(timer_wheel_.tick_duration());
+    timer_wheel_tick_.async_wait([this] (const boost::system::error_code& error) {
+        HandleTimerWheelTick_(error);
+    });
+}
+
+void Server::HandleTimerWheelTick_(const boost::system::error_code& error)
+{
+    if (error)
+    {
+        return;
+    }
+
+    // Catch up on every tick that elapsed, the deadline timer may fire late under load.
+    auto elapsed = boost::posix_time::microsec_clock::universal_time() - timer_wheel_start_;
+    uint64_t target_tick = elapsed.total_microseconds() / timer_wheel_.tick_duration().total_microseconds();
+    uint64_t current_tick = timer_wheel_.current_tick();
+
+    if (target_tick > current_tick)
+    {
+        timer_wheel_.Advance(target_tick - current_tick);
+    }
+
+    ScheduleTimerWheelTick_();
+}
+
+void Server::batched_io(bool enabled) {
+#ifdef ANH_HAS_BATCHED_UDP
+    batched_io_ = enabled;
+#else
+    if (enabled)
+    {
+        LOG(warning) << "Batched datagram I/O is not supported on this platform";
+    }
+#endif
+}
+
+bool Server::batched_io() const {
+    return batched_io_;
+}
+
+void Server::socket_shards(uint32_t shards) {
+    socket_shards_ = max(1u, shards);
+}
+
+uint32_t Server::socket_shards() const {
+    return socket_shards_;
+}
+
+ServerStatistics Server::statistics() const {
+    ServerStatistics stats = {};
+
+    for (auto& shard : shards_)
+    {
+        stats.bytes_received += shard->bytes_recv;
+        stats.bytes_sent += shard->bytes_sent;
+        stats.packets_received += shard->packets_recv;
+        stats.packets_sent += shard->packets_sent;
+        stats.receive_calls += shard->receive_calls;
+        stats.send_calls += shard->send_calls;
+    }
+
+    return stats;
+}
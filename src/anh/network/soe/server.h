@@ -6,21 +6,42 @@
 
 #include <cstdint>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include <boost/asio.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
 
+#include "anh/byte_buffer.h"
+#include "anh/network/soe/packet_buffer.h"
 #include "anh/network/soe/server_interface.h"
+#include "anh/network/soe/timer_wheel.h"
 
 namespace anh {
-
-class ByteBuffer;
-
 namespace network {
 namespace soe {
 
 // FORWARD DECLARATION
 class Session;
 
+/**
+ * @brief Counters describing the datagram traffic handled by a Server.
+ */
+struct ServerStatistics
+{
+    uint64_t bytes_received;
+    uint64_t bytes_sent;
+    uint64_t packets_received;
+    uint64_t packets_sent;
+
+    /// Number of receive system calls issued (one per datagram unless batching).
+    uint64_t receive_calls;
+
+    /// Number of send system calls issued (one per datagram unless batching).
+    uint64_t send_calls;
+};
+
 /**
  * @brief An SOE Protocol Service.
  *
@@ -47,12 +68,117 @@ public:
     /**
      * @brief Sends a message on the wire to the target endpoint.
      */
-    void SendTo(const boost::asio::ip::udp::endpoint& endpoint, anh::ByteBuffer buffer);
+    void SendTo(const boost::asio::ip::udp::endpoint& endpoint, PacketBuffer buffer);
 
+    /**
+     * @return The socket of the first shard or nullptr if the server is not started.
+     */
     boost::asio::ip::udp::socket* socket();
     
     uint32_t max_receive_size();
 
+    /**
+     * @return The pool inbound datagrams are received into and outbound packets are
+     *  built in, its statistics count the heap allocations made for packet memory.
+     */
+    std::shared_ptr<PacketBufferPool> packet_pool();
+
+    /**
+     * @return The timer wheel driving the retransmit timers of this server's sessions.
+     */
+    TimerWheel* timer_wheel();
+
+    /**
+     * @return The maximum number of unacknowledged data channel packets a session keeps in flight.
+     */
+    uint32_t send_window();
+
+    /**
+     * Sets the maximum number of unacknowledged data channel packets a session keeps
+     * in flight, further packets are queued until acknowledgements open the window.
+     *
+     * \note Only applies to sessions created after the call.
+     */
+    void send_window(uint32_t window);
+
+    /**
+     * @return The longest a session holds queued data channel messages before flushing.
+     */
+    boost::posix_time::time_duration max_flush_latency();
+
+    /**
+     * Sets the longest a session holds queued data channel messages to batch them
+     * together before flushing. With zero a session flushes as soon as its strand is
+     * free, which still coalesces messages queued while it was busy.
+     *
+     * \note Only applies to sessions created after the call.
+     */
+    void max_flush_latency(boost::posix_time::time_duration latency);
+
+    /**
+     * @return The number of queued data channel messages that triggers an immediate flush.
+     */
+    uint32_t max_flush_batch_size();
+
+    /**
+     * Sets the number of queued data channel messages that makes a session flush
+     * without waiting for the flush latency.
+     *
+     * \note Only applies to sessions created after the call.
+     */
+    void max_flush_batch_size(uint32_t batch_size);
+
+    /**
+     * @return The zlib level sessions compress large outgoing packets with.
+     */
+    int compression_level();
+
+    /**
+     * Sets the zlib level sessions compress large outgoing packets with. 0 disables
+     * compression, 1 is fastest and 9 gives the smallest packets.
+     *
+     * \note Only applies to sessions created after the call.
+     */
+    void compression_level(int level);
+
+    /**
+     * Enables batched datagram I/O.
+     *
+     * When enabled on a platform that supports recvmmsg/sendmmsg each socket wakeup
+     * drains up to a full batch of datagrams with a single call, and outbound packets
+     * are queued and flushed together. Has no effect on other platforms.
+     *
+     * \note Must be set before the server is started.
+     */
+    void batched_io(bool enabled);
+
+    /**
+     * @return True if batched datagram I/O is in use.
+     */
+    bool batched_io() const;
+
+    /**
+     * Sets the number of sockets opened on the listen port.
+     *
+     * With more than one shard each socket is bound to the same port with
+     * SO_REUSEPORT and gets its own receive loop running on a dedicated thread
+     * pinned to a core. The kernel hashes each remote endpoint to a single socket
+     * so all traffic for a client is always received by the same shard.
+     *
+     * \note Must be set before the server is started.
+     */
+    void socket_shards(uint32_t shards);
+
+    /**
+     * @return The number of sockets opened on the listen port.
+     */
+    uint32_t socket_shards() const;
+
+    /**
+     * @return A snapshot of the server's traffic counters.
+     */
+    ServerStatistics statistics() const;
+
     /**
      * Resolves a hostname to its ip.
      *
@@ -64,18 +190,42 @@ public:
 private:
     Server();
     
-    void AsyncReceive();
+    // Receive loop, socket and send queue state for one socket on the listen port.
+    struct Shard;
+
+    // Platform specific buffers used by the batched receive/send paths.
+    struct BatchBuffers;
+
+    typedef std::vector<
+        std::pair<boost::asio::ip::udp::endpoint, PacketBuffer>
+    > SendQueue;
+
+    void AsyncReceive(Shard* shard);
+    void AsyncReceiveBatch_(Shard* shard);
+    void FlushSendQueue_(Shard* shard);
+
+    Shard* GetShard_(const boost::asio::ip::udp::endpoint& endpoint);
+
+    void ScheduleTimerWheelTick_();
+    void HandleTimerWheelTick_(const boost::system::error_code& error);
 
     boost::asio::io_service& io_service_;
-    boost::asio::strand strand_;
-    
-    boost::asio::ip::udp::socket socket_;
-    boost::asio::ip::udp::endpoint current_remote_endpoint_;
-    std::array<char, 496> recv_buffer_;
-    
-    uint64_t bytes_recv_;
-    uint64_t bytes_sent_;
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::vector<boost::thread> shard_threads_;
+
+    TimerWheel timer_wheel_;
+    boost::asio::deadline_timer timer_wheel_tick_;
+    boost::posix_time::ptime timer_wheel_start_;
+
+    bool batched_io_;
+    uint32_t socket_shards_;
     uint32_t max_receive_size_;
+    std::shared_ptr<PacketBufferPool> packet_pool_;
+    uint32_t send_window_;
+    boost::posix_time::time_duration max_flush_latency_;
+    uint32_t max_flush_batch_size_;
+    int compression_level_;
 };
 
 }}} // namespace anh::network::soe
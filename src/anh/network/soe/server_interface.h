@@ -6,6 +6,8 @@
 
 #include <memory>
 
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
 #ifdef SendMessage
 #undef SendMessage
 #endif
@@ -23,9 +25,12 @@ namespace anh {
 namespace network {
 namespace soe {
 
+class PacketBuffer;
+class PacketBufferPool;
 class Session;
 class SessionManager;
 class Socket;
+class TimerWheel;
 
 class ServerInterface {
 public:
@@ -35,7 +40,11 @@ public:
     
     virtual void Shutdown(void) = 0;
 
-    virtual void SendTo(const boost::asio::ip::udp::endpoint& endpoint, anh::ByteBuffer buffer) = 0;
+    /**
+     * Puts a fully processed packet on the wire, the packet's memory may still be shared
+     * with the sending session's resend queue and must not be modified.
+     */
+    virtual void SendTo(const boost::asio::ip::udp::endpoint& endpoint, PacketBuffer buffer) = 0;
 
     virtual void HandleMessage(
         const std::shared_ptr<Session>& connection, 
@@ -50,6 +59,40 @@ public:
     virtual boost::asio::ip::udp::socket* socket() = 0;
 
     virtual uint32_t max_receive_size() = 0;
+
+    /**
+     * @return The pool packets are received into and built in, sessions allocate their
+     *  own pool if this is empty.
+     */
+    virtual std::shared_ptr<PacketBufferPool> packet_pool() = 0;
+
+    /**
+     * @return The timer wheel driving the retransmit timers of this server's sessions.
+     */
+    virtual TimerWheel* timer_wheel() = 0;
+
+    /**
+     * @return The maximum number of unacknowledged data channel packets a session keeps in flight.
+     */
+    virtual uint32_t send_window() = 0;
+
+    /**
+     * @return The longest a session holds queued data channel messages to batch them
+     *  together before flushing, zero flushes as soon as the session's strand is free.
+     */
+    virtual boost::posix_time::time_duration max_flush_latency() = 0;
+
+    /**
+     * @return The number of queued data channel messages that makes a session flush
+     *  without waiting for max_flush_latency.
+     */
+    virtual uint32_t max_flush_batch_size() = 0;
+
+    /**
+     * @return The zlib level sessions compress large outgoing packets with, 0 disables
+     *  compression.
+     */
+    virtual int compression_level() = 0;
 };
 
 }}} // namespace anh::network::soe
@@ -17,24 +17,67 @@ using namespace anh::network;
 using namespace anh::network::soe;
 using namespace std;
 
+namespace {
+    /// Retransmission timeout used until the first round trip time sample.
+    const boost::posix_time::time_duration kInitialRetransmitTimeout = boost::posix_time::milliseconds(500);
+    const boost::posix_time::time_duration kMinRetransmitTimeout = boost::posix_time::milliseconds(100);
+    const boost::posix_time::time_duration kMaxRetransmitTimeout = boost::posix_time::seconds(8);
+
+    /// Half the sequence space, larger windows would make acknowledgements ambiguous.
+    const uint32_t kMaxSendWindow = 0x8000;
+}
+
 Session::Session(ServerInterface* server, boost::asio::io_service& io_service, boost::asio::ip::udp::endpoint remote_endpoint)
     : std::enable_shared_from_this<Session>()
     , remote_endpoint_(remote_endpoint)
     , server_(server)
     , strand_(io_service)
+    , packet_pool_(server_->packet_pool())
+    , send_window_(min(kMaxSendWindow, max(1u, server_->send_window())))
+    , timer_wheel_(server_->timer_wheel())
+    , retransmit_timer_(0)
+    , retransmit_generation_(0)
+    , smoothed_rtt_(boost::posix_time::milliseconds(0))
+    , rtt_variance_(boost::posix_time::milliseconds(0))
+    , retransmit_timeout_(kInitialRetransmitTimeout)
+    , has_rtt_sample_(false)
+    , resent_packets_(0)
     , connected_(false)
+    , receive_buffer_size_(server_->max_receive_size())
+    , crc_length_(0)
     , crc_seed_(0xDEADBABE)
-    , last_acknowledged_sequence_(0)
+    , oldest_unacknowledged_sequence_(0)
     , next_client_sequence_(0)
     , current_client_sequence_(0)
     , server_sequence_()
     , server_net_stats_(0, 0, 0, 0, 0, 0)
+    , max_flush_latency_(server_->max_flush_latency())
+    , max_flush_batch_size_(max(1u, server_->max_flush_batch_size()))
+    , queued_data_messages_(0)
+    , flush_posted_(false)
+    , flush_timer_armed_(false)
     , incoming_fragmented_total_len_(0)
     , incoming_fragmented_curr_len_(0)
+    , compression_filter_(server_->compression_level())
     , decompression_filter_(server_->max_receive_size())
     , security_filter_(server_->max_receive_size())
 {
     server_sequence_ = 0;
+
+    if (!packet_pool_)
+    {
+        packet_pool_ = make_shared<PacketBufferPool>(
+            server_->max_receive_size() + PacketBufferPool::kDefaultHeadroom + PacketBufferPool::kDefaultTailroom);
+    }
+
+    // Size the ring to a power of 2 so a sequence maps to its slot with a mask.
+    size_t ring_size = 1;
+    while (ring_size < send_window_)
+    {
+        ring_size <<= 1;
+    }
+
+    send_ring_.resize(ring_size);
 }
 
 Session::~Session(void)
@@ -75,17 +118,45 @@ uint32_t Session::crc_seed() const {
 vector<ByteBuffer> Session::GetUnacknowledgedMessages() const {
     vector<ByteBuffer> unacknowledged_messages;
 
-    for_each(
-        sent_messages_.begin(),
-        sent_messages_.end(),
-        [&unacknowledged_messages] (const SequencedMessageMap::value_type& i)
+    boost::lock_guard<boost::mutex> lg(reliable_mutex_);
+
+    uint16_t in_flight = PacketsInFlight_();
+    for (uint16_t i = 0; i < in_flight; ++i)
     {
-        unacknowledged_messages.push_back(i.second);
-    });
+        const SentPacket& sent_packet = send_ring_[(oldest_unacknowledged_sequence_ + i) & (send_ring_.size() - 1)];
+        if (!sent_packet.acknowledged)
+        {
+            unacknowledged_messages.push_back(sent_packet.packet.ToByteBuffer());
+        }
+    }
 
     return unacknowledged_messages;
 }
 
+uint32_t Session::send_window() const {
+    return send_window_;
+}
+
+uint32_t Session::queued_message_count() const {
+    boost::lock_guard<boost::mutex> lg(reliable_mutex_);
+    return queued_messages_.size();
+}
+
+boost::posix_time::time_duration Session::smoothed_rtt() const {
+    boost::lock_guard<boost::mutex> lg(reliable_mutex_);
+    return smoothed_rtt_;
+}
+
+boost::posix_time::time_duration Session::retransmit_timeout() const {
+    boost::lock_guard<boost::mutex> lg(reliable_mutex_);
+    return retransmit_timeout_;
+}
+
+uint32_t Session::resent_packet_count() const {
+    boost::lock_guard<boost::mutex> lg(reliable_mutex_);
+    return resent_packets_;
+}
+
 void Session::Update() {
     // Exit as quickly as possible if there is no work currently.
     if (outgoing_data_messages_.empty()) {
@@ -95,37 +166,98 @@ void Session::Update() {
     // Build up a list of data messages to process
     uint32_t message_count = outgoing_data_messages_.unsafe_size();
     list<ByteBuffer> process_list;
-    ByteBuffer tmp;
+    shared_ptr<const ByteBuffer> tmp;
 
     for (uint32_t i = 0; i < message_count; ++i) {
         if (outgoing_data_messages_.try_pop(tmp)) {
-            process_list.push_back(tmp);
+            if (tmp.use_count() == 1) {
+                // Nobody else holds the message, take its storage instead of copying it.
+                process_list.push_back(move(const_cast<ByteBuffer&>(*tmp)));
+            } else {
+                process_list.push_back(*tmp);
+            }
         }
     }
 
-    // Pack the message list into a single data channel payload and send it.
-    ByteBuffer data_channel_payload = PackDataChannelMessages(std::move(process_list));
+    queued_data_messages_ -= process_list.size();
 
-    // Split up the message if it's too big
-    // \note: in determining the max size 3 is the size of the soe header + the compression flag.
-    uint32_t max_data_channel_size = receive_buffer_size_ - crc_length_ - 3;
+    // \note: in determining the max size 5 is the size of the soe header (opcode and
+    // sequence) + the compression flag.
+    uint32_t max_data_channel_size = receive_buffer_size_ - crc_length_ - 5;
 
-    if (data_channel_payload.size() > max_data_channel_size) {
-        list<ByteBuffer> fragmented_message = SplitDataChannelMessage(
-            data_channel_payload,
-            max_data_channel_size);
+    // Pack the messages into as few datagrams as they fit in and send them, only messages
+    // too big for a datagram of their own are split up.
+    list<ByteBuffer> payloads = PackDataChannelPayloads(move(process_list), max_data_channel_size);
 
-        for_each(fragmented_message.begin(), fragmented_message.end(), [this] (ByteBuffer& fragment) {
-            SendSequencedMessage_(&BuildFragmentedDataChannelHeader, move(fragment));
-        });
-    } else {
-        SendSequencedMessage_(&BuildDataChannelHeader, move(data_channel_payload));
-    }
+    for_each(payloads.begin(), payloads.end(), [this, max_data_channel_size] (ByteBuffer& payload) {
+        if (payload.size() > max_data_channel_size) {
+            list<ByteBuffer> fragmented_message = SplitDataChannelMessage(
+                move(payload),
+                max_data_channel_size);
+
+            for_each(fragmented_message.begin(), fragmented_message.end(), [this] (ByteBuffer& fragment) {
+                SendSequencedMessage_(DATA_FRAG_A, packet_pool_->Copy(fragment.data(), fragment.size()));
+            });
+        } else {
+            SendSequencedMessage_(CHILD_DATA_A, packet_pool_->Copy(payload.data(), payload.size()));
+        }
+    });
 }
 
 void Session::SendTo(ByteBuffer message)
+{
+    outgoing_data_messages_.push(make_shared<ByteBuffer>(move(message)));
+    ScheduleFlush_();
+}
+
+void Session::SendTo(shared_ptr<const ByteBuffer> message)
 {
     outgoing_data_messages_.push(move(message));
+    ScheduleFlush_();
+}
+
+void Session::ScheduleFlush_()
+{
+    uint32_t queued = ++queued_data_messages_;
+
+    if (max_flush_latency_.total_microseconds() <= 0 || queued >= max_flush_batch_size_ || !timer_wheel_)
+    {
+        // Messages queued before the strand gets to the flush are packed along with it.
+        if (!flush_posted_.exchange(true))
+        {
+            strand_.post(bind(&Session::Flush_, shared_from_this()));
+        }
+
+        return;
+    }
+
+    // Hold the first message of a batch for at most the flush latency.
+    if (!flush_timer_armed_.exchange(true))
+    {
+        weak_ptr<Session> weak_session = shared_from_this();
+
+        timer_wheel_->Schedule(max_flush_latency_, [weak_session] ()
+        {
+            auto session = weak_session.lock();
+            if (session)
+            {
+                session->flush_timer_armed_ = false;
+
+                if (!session->flush_posted_.exchange(true))
+                {
+                    session->strand_.post(bind(&Session::Flush_, session));
+                }
+            }
+        });
+    }
+}
+
+void Session::Flush_()
+{
+    // Clear the flag first, anything queued from here on schedules another flush.
+    flush_posted_ = false;
+
+    Update();
 }
 
 void Session::Close(void)
@@ -134,6 +266,12 @@ void Session::Close(void)
     {
         connected_ = false;
 
+        {
+            boost::lock_guard<boost::mutex> lg(reliable_mutex_);
+            CancelRetransmitTimer_();
+            queued_messages_.clear();
+        }
+
         Disconnect disconnect(connection_id_);
         ByteBuffer buffer;
 
@@ -152,6 +290,11 @@ ServerInterface* Session::server()
     return server_;
 }
 
+const shared_ptr<PacketBufferPool>& Session::packet_pool() const
+{
+    return packet_pool_;
+}
+
 void Session::HandleMessage(anh::ByteBuffer message)
 {
     strand_.post(bind(&Session::HandleMessageInternal, shared_from_this(), move(message)));
@@ -191,12 +334,12 @@ void Session::HandleMessageInternal(anh::ByteBuffer message)
     }
 }
 
-void Session::HandleProtocolMessage(anh::ByteBuffer message)
+void Session::HandleProtocolMessage(PacketBuffer message)
 {
     strand_.post(bind(&Session::HandleProtocolMessageInternal, shared_from_this(), move(message)));
 }
 
-void Session::HandleProtocolMessageInternal(anh::ByteBuffer message)
+void Session::HandleProtocolMessageInternal(PacketBuffer message)
 {
     try {
         security_filter_(this, &message);
@@ -208,27 +351,200 @@ void Session::HandleProtocolMessageInternal(anh::ByteBuffer message)
             decompression_filter_(this, &message);
         }
 
-        HandleMessage(move(message));
+        const unsigned char* data = message.data();
+        uint16_t soe_opcode = (data[0] << 8) | data[1];
+
+        // Acknowledgements and pings make up most of the inbound traffic, read them
+        // straight from the packet instead of copying it into a message.
+        if (soe_opcode == PING)
+        {
+            handlePing_(Ping());
+            return;
+        }
+
+        if ((soe_opcode == ACK_A || soe_opcode == OUT_OF_ORDER_A) && message.size() >= 4)
+        {
+            uint16_t sequence = (data[2] << 8) | data[3];
+
+            if (soe_opcode == ACK_A)
+            {
+                handleAckA_(AckA(sequence));
+            }
+            else
+            {
+                handleOutOfOrderA_(OutOfOrderA(sequence));
+            }
+
+            return;
+        }
+
+        // Already on the strand, no need to go through HandleMessage.
+        HandleMessageInternal(message.ToByteBuffer());
     } catch(const std::exception& e) {
         LOG(warning) << "Error handling protocol message\n\n" << e.what();
     }
 }
 
 
-void Session::SendSequencedMessage_(HeaderBuilder header_builder, ByteBuffer message) {
+void Session::SendSequencedMessage_(uint16_t soe_opcode, PacketBuffer message) {
+    boost::lock_guard<boost::mutex> lg(reliable_mutex_);
+
+    // Hold the message back while the window is full, it goes out in order once
+    // acknowledgements make room.
+    if (!queued_messages_.empty() || PacketsInFlight_() >= send_window_)
+    {
+        queued_messages_.push_back(make_pair(soe_opcode, move(message)));
+        return;
+    }
+
+    TransmitSequencedMessage_(soe_opcode, move(message));
+}
+
+void Session::TransmitSequencedMessage_(uint16_t soe_opcode, PacketBuffer message) {
     // Get the next sequence number
     uint16_t message_sequence = server_sequence_++;
 
-    // Allocate a new packet
-    ByteBuffer data_channel_message;
-    data_channel_message.append(header_builder(message_sequence));
-    data_channel_message.append(move(message));
+    // Write the header into the headroom in front of the payload
+    unsigned char* header = message.Prepend(4);
+    header[0] = static_cast<unsigned char>(soe_opcode >> 8);
+    header[1] = static_cast<unsigned char>(soe_opcode);
+    header[2] = static_cast<unsigned char>(message_sequence >> 8);
+    header[3] = static_cast<unsigned char>(message_sequence);
+
+    ProcessOutgoing_(&message);
+
+    // Store it for resending later if necessary, this shares the packet's memory
+    SentPacket& sent_packet = send_ring_[message_sequence & (send_ring_.size() - 1)];
+    sent_packet.packet = message;
+    sent_packet.last_sent = boost::posix_time::microsec_clock::universal_time();
+    sent_packet.transmissions = 1;
+    sent_packet.acknowledged = false;
 
     // Send it over the wire
-    SendSoePacket_(data_channel_message);
+    server_->SendTo(remote_endpoint_, move(message));
+
+    if (!retransmit_timer_)
+    {
+        ArmRetransmitTimer_();
+    }
+}
+
+void Session::ResendPacket_(SentPacket& sent_packet, const boost::posix_time::ptime& now) {
+    sent_packet.last_sent = now;
+    ++sent_packet.transmissions;
+    ++resent_packets_;
+
+    // Already processed when it was first sent.
+    server_->SendTo(remote_endpoint_, sent_packet.packet);
+}
+
+void Session::SendQueuedMessages_() {
+    while (!queued_messages_.empty() && PacketsInFlight_() < send_window_)
+    {
+        auto& queued = queued_messages_.front();
+        TransmitSequencedMessage_(queued.first, move(queued.second));
+        queued_messages_.pop_front();
+    }
+}
+
+void Session::ArmRetransmitTimer_() {
+    if (!timer_wheel_ || PacketsInFlight_() == 0)
+    {
+        return;
+    }
+
+    weak_ptr<Session> weak_session = shared_from_this();
+    uint32_t generation = ++retransmit_generation_;
+
+    retransmit_timer_ = timer_wheel_->Schedule(retransmit_timeout_, [weak_session, generation] ()
+    {
+        auto session = weak_session.lock();
+        if (session)
+        {
+            session->strand_.post(bind(&Session::HandleRetransmitTimeout_, session, generation));
+        }
+    });
+}
+
+void Session::CancelRetransmitTimer_() {
+    if (retransmit_timer_)
+    {
+        // The timer may already have fired with its timeout waiting on the strand.
+        ++retransmit_generation_;
+
+        timer_wheel_->Cancel(retransmit_timer_);
+        retransmit_timer_ = 0;
+    }
+}
+
+void Session::UpdateRoundTripTime_(boost::posix_time::time_duration sample) {
+    // Smoothed round trip time and variance as described in RFC 6298.
+    if (!has_rtt_sample_)
+    {
+        smoothed_rtt_ = sample;
+        rtt_variance_ = sample / 2;
+        has_rtt_sample_ = true;
+    }
+    else
+    {
+        boost::posix_time::time_duration delta = smoothed_rtt_ - sample;
+        if (delta.is_negative())
+        {
+            delta = delta.invert_sign();
+        }
 
-    // Store it for resending later if necessary
-    sent_messages_.push_back(make_pair(message_sequence, move(data_channel_message)));
+        rtt_variance_ = (rtt_variance_ * 3 + delta) / 4;
+        smoothed_rtt_ = (smoothed_rtt_ * 7 + sample) / 8;
+    }
+
+    boost::posix_time::time_duration granularity = timer_wheel_ ? timer_wheel_->tick_duration() : boost::posix_time::milliseconds(10);
+    retransmit_timeout_ = smoothed_rtt_ + max(granularity, rtt_variance_ * 4);
+    retransmit_timeout_ = min(kMaxRetransmitTimeout, max(kMinRetransmitTimeout, retransmit_timeout_));
+}
+
+uint16_t Session::PacketsInFlight_() const {
+    return static_cast<uint16_t>(server_sequence_ - oldest_unacknowledged_sequence_);
+}
+
+void Session::HandleRetransmitTimeout_(uint32_t generation) {
+    boost::lock_guard<boost::mutex> lg(reliable_mutex_);
+
+    // The timer was cancelled or re-armed after it fired.
+    if (generation != retransmit_generation_)
+    {
+        return;
+    }
+
+    retransmit_timer_ = 0;
+
+    if (!connected_)
+    {
+        return;
+    }
+
+    // Resend only the packets that have gone unacknowledged for a full timeout, packets
+    // resent recently or selectively acknowledged are left alone.
+    auto now = boost::posix_time::microsec_clock::universal_time();
+    bool resent = false;
+
+    uint16_t in_flight = PacketsInFlight_();
+    for (uint16_t i = 0; i < in_flight; ++i)
+    {
+        SentPacket& sent_packet = send_ring_[(oldest_unacknowledged_sequence_ + i) & (send_ring_.size() - 1)];
+        if (!sent_packet.acknowledged && now - sent_packet.last_sent >= retransmit_timeout_)
+        {
+            ResendPacket_(sent_packet, now);
+            resent = true;
+        }
+    }
+
+    // Back off until an acknowledgement brings a fresh round trip sample.
+    if (resent)
+    {
+        retransmit_timeout_ = min(kMaxRetransmitTimeout, retransmit_timeout_ * 2);
+    }
+
+    ArmRetransmitTimer_();
 }
 
 void Session::handleSessionRequest_(SessionRequest packet)
@@ -244,7 +560,7 @@ void Session::handleSessionRequest_(SessionRequest packet)
     session_response.serialize(buffer);
 
     // Directly put this on the wire, it requires no outgoing processing.
-    server_->SendTo(remote_endpoint_, move(buffer));
+    server_->SendTo(remote_endpoint_, packet_pool_->Copy(buffer.data(), buffer.size()));
 
     connected_ = true;
     LOG(info) << "Created Session [" << connection_id_ << "] @ " << remote_endpoint_.address().to_string() << ":" << remote_endpoint_.port();
@@ -268,11 +584,10 @@ void Session::handleDisconnect_(Disconnect packet)
 
 void Session::handlePing_(Ping packet)
 {
-    Ping pong;
+    PacketBuffer pong = packet_pool_->Acquire();
+    pong.AppendBig16(PING);
 
-    ByteBuffer buffer;
-    pong.serialize(buffer);
-    SendSoePacket_(std::move(buffer));
+    SendSoePacket_(std::move(pong));
 }
 
 void Session::handleNetStatsClient_(NetStatsClient packet)
@@ -348,43 +663,97 @@ void Session::handleDataFragA_(DataFragA packet)
 
 void Session::handleAckA_(AckA packet)
 {
-    auto it = find_if(
-        sent_messages_.begin(),
-        sent_messages_.end(),
-        [this, &packet] (const SequencedMessageMap::value_type& message)
+    boost::lock_guard<boost::mutex> lg(reliable_mutex_);
+
+    // Acknowledgements are cumulative, ignore stale or out of range sequences.
+    uint16_t acknowledged = static_cast<uint16_t>(packet.sequence - oldest_unacknowledged_sequence_);
+    if (acknowledged >= PacketsInFlight_())
     {
-        return (message.first == packet.sequence) ? true : false;
-    });
+        return;
+    }
+
+    size_t ring_mask = send_ring_.size() - 1;
 
-    sent_messages_.erase(sent_messages_.begin(), it);
+    // Only packets sent once give an unambiguous round trip sample.
+    SentPacket& acknowledged_packet = send_ring_[packet.sequence & ring_mask];
+    if (acknowledged_packet.transmissions == 1)
+    {
+        UpdateRoundTripTime_(boost::posix_time::microsec_clock::universal_time() - acknowledged_packet.last_sent);
+    }
 
-    last_acknowledged_sequence_ = packet.sequence;
+    for (uint16_t i = 0; i <= acknowledged; ++i)
+    {
+        send_ring_[(oldest_unacknowledged_sequence_ + i) & ring_mask].packet = PacketBuffer();
+    }
+
+    oldest_unacknowledged_sequence_ = packet.sequence + 1;
+
+    SendQueuedMessages_();
+
+    // Restart the timer for the oldest packet still in flight.
+    CancelRetransmitTimer_();
+    ArmRetransmitTimer_();
 }
 
 void Session::handleOutOfOrderA_(OutOfOrderA packet)
 {
-    std::for_each(
-        begin(sent_messages_),
-        end(sent_messages_),
-        [=](const SequencedMessageMap::value_type& item)
+    boost::lock_guard<boost::mutex> lg(reliable_mutex_);
+
+    // The remote end received this sequence ahead of some earlier ones.
+    uint16_t offset = static_cast<uint16_t>(packet.sequence - oldest_unacknowledged_sequence_);
+    if (offset >= PacketsInFlight_())
     {
-        SendSoePacket_(item.second);
-    });
+        return;
+    }
+
+    size_t ring_mask = send_ring_.size() - 1;
+    send_ring_[packet.sequence & ring_mask].acknowledged = true;
+
+    // Resend the gaps before it, skipping packets that were sent too recently for their
+    // acknowledgement to have arrived yet. Every out of order packet the client receives
+    // triggers one of these, so without this a single loss is resent many times over.
+    auto now = boost::posix_time::microsec_clock::universal_time();
+
+    for (uint16_t i = 0; i < offset; ++i)
+    {
+        SentPacket& sent_packet = send_ring_[(oldest_unacknowledged_sequence_ + i) & ring_mask];
+        if (!sent_packet.acknowledged && now - sent_packet.last_sent >= smoothed_rtt_)
+        {
+            ResendPacket_(sent_packet, now);
+        }
+    }
 }
 
 void Session::SendSoePacket_(anh::ByteBuffer message)
 {
-    LOG_NET << "SendSoePacket: Server -> Endpoint: " << remote_endpoint_.address().to_string() << " \n" << message;
-    strand_.post(bind(&Session::SendSoePacketInternal, shared_from_this(), std::move(message)));
+    SendSoePacket_(packet_pool_->Copy(message.data(), message.size()));
 }
 
-void Session::SendSoePacketInternal(anh::ByteBuffer message)
+void Session::SendSoePacket_(PacketBuffer message)
 {
-    compression_filter_(this, &message);
-    encryption_filter_(this, &message);
-    crc_output_filter_(this, &message);
+    LOG_NET << "SendSoePacket: Server -> Endpoint: " << remote_endpoint_.address().to_string() << " \n" << message.ToByteBuffer();
+
+    ProcessOutgoing_(&message);
 
-    server_->SendTo(remote_endpoint(), move(message));
+    server_->SendTo(remote_endpoint_, move(message));
+}
+
+void Session::ProcessOutgoing_(PacketBuffer* message)
+{
+    // The filters only read the session's connection parameters, so packets are
+    // processed on the sending thread instead of being posted to the strand.
+    compression_filter_(this, message);
+    encryption_filter_(this, message);
+    crc_output_filter_(this, message);
+}
+
+PacketBuffer Session::BuildSequencePacket_(uint16_t soe_opcode, uint16_t sequence)
+{
+    PacketBuffer packet = packet_pool_->Acquire();
+    packet.AppendBig16(soe_opcode);
+    packet.AppendBig16(sequence);
+
+    return packet;
 }
 
 bool Session::SequenceIsValid_(const uint16_t& sequence)
@@ -396,10 +765,7 @@ bool Session::SequenceIsValid_(const uint16_t& sequence)
     else
     {
         // Tell the client we have received an Out of Order sequence.
-        OutOfOrderA	out_of_order(sequence);
-        ByteBuffer buffer;
-        out_of_order.serialize(buffer);
-        SendSoePacket_(move(buffer));
+        SendSoePacket_(BuildSequencePacket_(OUT_OF_ORDER_A, sequence));
 
         return false;
     }
@@ -407,10 +773,7 @@ bool Session::SequenceIsValid_(const uint16_t& sequence)
 
 void Session::AcknowledgeSequence_(const uint16_t& sequence)
 {
-    AckA ack(sequence);
-    ByteBuffer buffer;
-    ack.serialize(buffer);
-    SendSoePacket_(move(buffer));
+    SendSoePacket_(BuildSequencePacket_(ACK_A, sequence));
 
     next_client_sequence_ = sequence + 1;
     current_client_sequence_ = sequence;
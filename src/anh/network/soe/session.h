@@ -5,6 +5,7 @@
 #define ANH_NETWORK_SOE_SESSION_H_
 
 #include <atomic>
+#include <deque>
 #include <list>
 #include <memory>
 #include <vector>
@@ -21,9 +22,12 @@ namespace Concurrency {
 #endif
 
 #include <boost/asio.hpp>
+#include <boost/thread/mutex.hpp>
 
+#include "anh/network/soe/packet_buffer.h"
 #include "anh/network/soe/protocol_packets.h"
 #include "anh/network/soe/server_interface.h"
+#include "anh/network/soe/timer_wheel.h"
 
 #include "anh/network/soe/filters/crc_in_filter.h"
 #include "anh/network/soe/filters/decryption_filter.h"
@@ -89,6 +93,31 @@ public:
      */
     std::vector<anh::ByteBuffer> GetUnacknowledgedMessages() const;
 
+    /**
+     * @return The maximum number of unacknowledged data channel packets kept in flight.
+     */
+    uint32_t send_window() const;
+
+    /**
+     * @return The number of data channel packets waiting for the send window to open.
+     */
+    uint32_t queued_message_count() const;
+
+    /**
+     * @return The smoothed round trip time estimated from acknowledgements.
+     */
+    boost::posix_time::time_duration smoothed_rtt() const;
+
+    /**
+     * @return The current retransmission timeout, including any backoff.
+     */
+    boost::posix_time::time_duration retransmit_timeout() const;
+
+    /**
+     * @return The number of data channel packets that have been sent more than once.
+     */
+    uint32_t resent_packet_count() const;
+
     /**
     * Sends a data channel message to the remote client.
     *
@@ -100,6 +129,16 @@ public:
     */
     void SendTo(anh::ByteBuffer message);
 
+    /**
+    * Sends a data channel message that may be shared with other sessions.
+    *
+    * The buffer is queued as is and only copied once it is packed into packets, so
+    * a broadcast can hand the same buffer to every recipient.
+    *
+    * @param message The payload to send in the data channel message(s), it must not be modified.
+    */
+    void SendTo(std::shared_ptr<const anh::ByteBuffer> message);
+
     /**
     * Sends a data channel message to the remote client.
     *
@@ -111,18 +150,26 @@ public:
     */
     template<typename T>
     void SendTo(const T& message) {
-        ByteBuffer message_buffer;
-        message.Serialize(message_buffer);
+        auto message_buffer = std::make_shared<ByteBuffer>();
+        message.Serialize(*message_buffer);
 
         outgoing_data_messages_.push(std::move(message_buffer));
+        ScheduleFlush_();
     }
 
     void HandleMessage(anh::ByteBuffer message);
 
-    void HandleProtocolMessage(anh::ByteBuffer message);
+    /**
+     * Runs a datagram received from the remote end through the inbound filters and
+     * handles it, the filters work on the packet in place.
+     */
+    void HandleProtocolMessage(PacketBuffer message);
 
     /**
-     * Clears each message pump.
+     * Packs the queued data channel messages and sends them.
+     *
+     * Sessions flush themselves on their strand once queued messages reach the server's
+     * flush latency or batch size, this only needs to be called directly to force a flush.
      */
     void Update();
 
@@ -139,12 +186,41 @@ public:
 
     ServerInterface* server();
 
-private:
-    typedef std::list<std::pair<uint16_t, anh::ByteBuffer>> SequencedMessageMap;
-
-    typedef anh::ByteBuffer(*HeaderBuilder)(uint16_t);
+    /**
+     * @return The pool outgoing packets are built in.
+     */
+    const std::shared_ptr<PacketBufferPool>& packet_pool() const;
 
-    void SendSequencedMessage_(HeaderBuilder header_builder, ByteBuffer message);
+private:
+    /**
+     * A sent data channel packet kept until the remote end acknowledges it.
+     *
+     * The packet is stored as it went out on the wire and shares its memory with the
+     * server's send queue, resending it needs no further processing.
+     */
+    struct SentPacket
+    {
+        PacketBuffer packet;
+        boost::posix_time::ptime last_sent;
+        uint32_t transmissions;
+        bool acknowledged;
+    };
+
+    void SendSequencedMessage_(uint16_t soe_opcode, PacketBuffer message);
+
+    // The methods below require reliable_mutex_ to be held.
+    void TransmitSequencedMessage_(uint16_t soe_opcode, PacketBuffer message);
+    void ResendPacket_(SentPacket& sent_packet, const boost::posix_time::ptime& now);
+    void SendQueuedMessages_();
+    void ArmRetransmitTimer_();
+    void CancelRetransmitTimer_();
+    void UpdateRoundTripTime_(boost::posix_time::time_duration sample);
+    uint16_t PacketsInFlight_() const;
+
+    void HandleRetransmitTimeout_(uint32_t generation);
+
+    void ScheduleFlush_();
+    void Flush_();
 
     virtual void OnClose() {}
 
@@ -158,9 +234,11 @@ private:
     void handleAckA_(AckA packet);
     void handleOutOfOrderA_(OutOfOrderA packet);
     void SendSoePacket_(anh::ByteBuffer message);
-    void SendSoePacketInternal(anh::ByteBuffer message);
+    void SendSoePacket_(PacketBuffer message);
+    void ProcessOutgoing_(PacketBuffer* message);
+    PacketBuffer BuildSequencePacket_(uint16_t soe_opcode, uint16_t sequence);
     void HandleMessageInternal(anh::ByteBuffer message);
-    void HandleProtocolMessageInternal(anh::ByteBuffer message);
+    void HandleProtocolMessageInternal(PacketBuffer message);
 
     bool SequenceIsValid_(const uint16_t& sequence);
     void AcknowledgeSequence_(const uint16_t& sequence);
@@ -168,8 +246,24 @@ private:
     boost::asio::ip::udp::endpoint		remote_endpoint_; // ip_address
     ServerInterface*					server_; // owner
     boost::asio::strand strand_;
-
-    SequencedMessageMap					sent_messages_;
+    std::shared_ptr<PacketBufferPool>   packet_pool_;
+
+    // Reliable delivery state, guarded by reliable_mutex_. Sent packets live in a ring
+    // indexed by sequence that is sized to the send window.
+    mutable boost::mutex                reliable_mutex_;
+    std::vector<SentPacket>             send_ring_;
+    std::deque<std::pair<uint16_t, PacketBuffer>> queued_messages_;
+    uint32_t                            send_window_;
+    TimerWheel*                         timer_wheel_;
+    TimerWheel::TimerId                 retransmit_timer_;
+    // Bumped whenever the retransmit timer is armed or cancelled, a timeout posted by
+    // an older timer no longer matches and is ignored.
+    uint32_t                            retransmit_generation_;
+    boost::posix_time::time_duration    smoothed_rtt_;
+    boost::posix_time::time_duration    rtt_variance_;
+    boost::posix_time::time_duration    retransmit_timeout_;
+    bool                                has_rtt_sample_;
+    uint32_t                            resent_packets_;
 
     bool								connected_;
 
@@ -180,7 +274,7 @@ private:
     uint32_t                            crc_seed_;
 
     // Sequences
-    uint16_t							last_acknowledged_sequence_;
+    uint16_t							oldest_unacknowledged_sequence_;
     uint16_t							next_client_sequence_;
     uint16_t							current_client_sequence_;
     std::atomic<uint16_t>				server_sequence_;
@@ -190,7 +284,14 @@ private:
     // Net Stats
     NetStatsServer						server_net_stats_;
 
-    Concurrency::concurrent_queue<anh::ByteBuffer> outgoing_data_messages_;
+    Concurrency::concurrent_queue<std::shared_ptr<const anh::ByteBuffer>> outgoing_data_messages_;
+
+    // Flush scheduling
+    boost::posix_time::time_duration    max_flush_latency_;
+    uint32_t                            max_flush_batch_size_;
+    std::atomic<uint32_t>               queued_data_messages_;
+    std::atomic<bool>                   flush_posted_;
+    std::atomic<bool>                   flush_timer_armed_;
 
     std::list<anh::ByteBuffer>			incoming_fragmented_messages_;
     uint16_t							incoming_fragmented_total_len_;
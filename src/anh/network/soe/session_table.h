@@ -0,0 +1,451 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef ANH_NETWORK_SOE_SESSION_TABLE_H_
+#define ANH_NETWORK_SOE_SESSION_TABLE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <boost/asio/ip/udp.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+
+namespace anh {
+namespace network {
+namespace soe {
+
+/**
+ * Packs an endpoint into a 64 bit key.
+ *
+ * IPv4 endpoints map to a unique key (address in the upper bits, port in the lower 16),
+ * other address families are folded into a hash and rely on the full endpoint comparison
+ * the SessionTable performs on each match.
+ *
+ * @param endpoint The endpoint to pack.
+ * @return The key for the endpoint.
+ */
+inline uint64_t PackEndpointKey(const boost::asio::ip::udp::endpoint& endpoint)
+{
+    uint64_t key = endpoint.port();
+
+    if (endpoint.address().is_v4())
+    {
+        key |= static_cast<uint64_t>(endpoint.address().to_v4().to_ulong()) << 16;
+    }
+    else
+    {
+        auto bytes = endpoint.address().to_v6().to_bytes();
+        for (size_t i = 0; i < bytes.size(); ++i)
+        {
+            key = (key * 31) ^ bytes[i];
+        }
+
+        key |= 1ULL << 63;
+    }
+
+    return key;
+}
+
+/**
+ * @brief Concurrent endpoint to session lookup table.
+ *
+ * An open-addressed table with linear probing keyed by PackEndpointKey. Lookups and
+ * iteration take no locks: each slot holds an atomic pointer to an immutable entry,
+ * writers are serialized among themselves and publish new entries (or a grown slot array)
+ * with a single atomic store. Entries and slot arrays that have been unlinked are retired
+ * and only freed once every reader that could still observe them has left the table
+ * (two-epoch reclamation), so inserts and removals never block readers.
+ */
+template<typename T>
+class SessionTable : private boost::noncopyable
+{
+public:
+    typedef std::shared_ptr<T> SessionPtr;
+
+    /**
+     * @param initial_capacity The number of slots to start with, rounded up to a power of 2.
+     */
+    explicit SessionTable(uint32_t initial_capacity = 1024)
+        : slots_(new Slots(RoundUpToPowerOf2_(initial_capacity)))
+        , size_(0)
+        , used_slots_(0)
+        , epoch_(0)
+    {
+        readers_[0] = 0;
+        readers_[1] = 0;
+    }
+
+    ~SessionTable()
+    {
+        Slots* slots = slots_.load();
+
+        for (size_t i = 0; i <= slots->mask; ++i)
+        {
+            Entry* entry = slots->slots[i].load();
+            if (entry && entry != &tombstone_)
+            {
+                delete entry;
+            }
+        }
+
+        delete slots;
+
+        FreeRetired_(0);
+        FreeRetired_(1);
+    }
+
+    /**
+     * Finds the session for an endpoint without taking any locks.
+     *
+     * @return The session or nullptr if none is registered.
+     */
+    SessionPtr Find(const boost::asio::ip::udp::endpoint& endpoint) const
+    {
+        ReadGuard guard(*this);
+
+        Entry* entry = FindEntry_(slots_.load(), PackEndpointKey(endpoint), endpoint);
+        return entry ? entry->session : nullptr;
+    }
+
+    /**
+     * Inserts a session for an endpoint unless one is already registered.
+     *
+     * @return The session registered for the endpoint after the call, either the one
+     *  passed in or the one that was already present.
+     */
+    SessionPtr Insert(const boost::asio::ip::udp::endpoint& endpoint, SessionPtr session)
+    {
+        uint64_t key = PackEndpointKey(endpoint);
+
+        boost::lock_guard<boost::mutex> lg(writer_mutex_);
+
+        Slots* slots = slots_.load();
+
+        Entry* existing = FindEntry_(slots, key, endpoint);
+        if (existing)
+        {
+            return existing->session;
+        }
+
+        // Keep the load factor (counting tombstones) below 1/2 to keep probes short.
+        if ((used_slots_ + 1) * 2 > slots->mask + 1)
+        {
+            slots = Rehash_(slots);
+        }
+
+        Entry* entry = new Entry(key, endpoint, session);
+
+        for (size_t i = Hash_(key) & slots->mask; ; i = (i + 1) & slots->mask)
+        {
+            Entry* current = slots->slots[i].load();
+            if (current == nullptr || current == &tombstone_)
+            {
+                if (current == nullptr)
+                {
+                    ++used_slots_;
+                }
+
+                slots->slots[i].store(entry);
+                break;
+            }
+        }
+
+        ++size_;
+
+        Reclaim_();
+
+        return session;
+    }
+
+    /**
+     * Removes the session registered for an endpoint.
+     *
+     * @return True if a session was removed.
+     */
+    bool Erase(const boost::asio::ip::udp::endpoint& endpoint)
+    {
+        uint64_t key = PackEndpointKey(endpoint);
+
+        boost::lock_guard<boost::mutex> lg(writer_mutex_);
+
+        Slots* slots = slots_.load();
+
+        for (size_t i = Hash_(key) & slots->mask, probes = 0; probes <= slots->mask; i = (i + 1) & slots->mask, ++probes)
+        {
+            Entry* entry = slots->slots[i].load();
+            if (entry == nullptr)
+            {
+                break;
+            }
+
+            if (entry != &tombstone_ && entry->key == key && entry->endpoint == endpoint)
+            {
+                slots->slots[i].store(&tombstone_);
+                --size_;
+
+                Retire_(entry);
+                Reclaim_();
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Invokes a functor for every registered session without taking any locks.
+     *
+     * Sessions added or removed while iterating may or may not be visited.
+     */
+    template<typename Functor>
+    void ForEach(Functor functor) const
+    {
+        ReadGuard guard(*this);
+
+        Slots* slots = slots_.load();
+
+        for (size_t i = 0; i <= slots->mask; ++i)
+        {
+            Entry* entry = slots->slots[i].load();
+            if (entry && entry != &tombstone_)
+            {
+                functor(entry->session);
+            }
+        }
+    }
+
+    /**
+     * @return The first session matching the predicate or nullptr.
+     */
+    template<typename Predicate>
+    SessionPtr FindIf(Predicate predicate) const
+    {
+        ReadGuard guard(*this);
+
+        Slots* slots = slots_.load();
+
+        for (size_t i = 0; i <= slots->mask; ++i)
+        {
+            Entry* entry = slots->slots[i].load();
+            if (entry && entry != &tombstone_ && predicate(entry->session))
+            {
+                return entry->session;
+            }
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @return The number of registered sessions.
+     */
+    size_t size() const
+    {
+        return size_;
+    }
+
+private:
+    struct Entry
+    {
+        Entry()
+            : key(0) {}
+
+        Entry(uint64_t key_, const boost::asio::ip::udp::endpoint& endpoint_, SessionPtr session_)
+            : key(key_)
+            , endpoint(endpoint_)
+            , session(std::move(session_)) {}
+
+        uint64_t key;
+        boost::asio::ip::udp::endpoint endpoint;
+        SessionPtr session;
+    };
+
+    struct Slots
+    {
+        explicit Slots(size_t capacity)
+            : mask(capacity - 1)
+            , slots(new std::atomic<Entry*>[capacity])
+        {
+            for (size_t i = 0; i < capacity; ++i)
+            {
+                slots[i] = nullptr;
+            }
+        }
+
+        size_t mask;
+        std::unique_ptr<std::atomic<Entry*>[]> slots;
+    };
+
+    /**
+     * Registers a reader in the current epoch for the lifetime of the guard.
+     */
+    class ReadGuard
+    {
+    public:
+        explicit ReadGuard(const SessionTable& table)
+            : table_(table)
+        {
+            for (;;)
+            {
+                epoch_ = table_.epoch_.load();
+                ++table_.readers_[epoch_ & 1];
+
+                // Make sure the epoch did not advance between reading it and registering.
+                if (table_.epoch_.load() == epoch_)
+                {
+                    break;
+                }
+
+                --table_.readers_[epoch_ & 1];
+            }
+        }
+
+        ~ReadGuard()
+        {
+            --table_.readers_[epoch_ & 1];
+        }
+
+    private:
+        const SessionTable& table_;
+        uint32_t epoch_;
+    };
+
+    static size_t RoundUpToPowerOf2_(uint32_t value)
+    {
+        size_t capacity = 16;
+        while (capacity < value)
+        {
+            capacity <<= 1;
+        }
+
+        return capacity;
+    }
+
+    static size_t Hash_(uint64_t key)
+    {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+
+        return static_cast<size_t>(key);
+    }
+
+    Entry* FindEntry_(Slots* slots, uint64_t key, const boost::asio::ip::udp::endpoint& endpoint) const
+    {
+        for (size_t i = Hash_(key) & slots->mask, probes = 0; probes <= slots->mask; i = (i + 1) & slots->mask, ++probes)
+        {
+            Entry* entry = slots->slots[i].load();
+            if (entry == nullptr)
+            {
+                return nullptr;
+            }
+
+            if (entry != &tombstone_ && entry->key == key && entry->endpoint == endpoint)
+            {
+                return entry;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Builds a new slot array without tombstones, growing it if the live entries
+    // alone would exceed the load factor, and publishes it. Writer lock must be held.
+    Slots* Rehash_(Slots* old_slots)
+    {
+        size_t capacity = old_slots->mask + 1;
+        while ((size_ + 1) * 2 > capacity / 2)
+        {
+            capacity <<= 1;
+        }
+
+        Slots* new_slots = new Slots(capacity);
+
+        for (size_t i = 0; i <= old_slots->mask; ++i)
+        {
+            Entry* entry = old_slots->slots[i].load();
+            if (entry == nullptr || entry == &tombstone_)
+            {
+                continue;
+            }
+
+            for (size_t j = Hash_(entry->key) & new_slots->mask; ; j = (j + 1) & new_slots->mask)
+            {
+                if (new_slots->slots[j].load() == nullptr)
+                {
+                    new_slots->slots[j].store(entry);
+                    break;
+                }
+            }
+        }
+
+        used_slots_ = size_;
+        slots_.store(new_slots);
+
+        retired_slots_[epoch_.load() & 1].push_back(old_slots);
+
+        return new_slots;
+    }
+
+    void Retire_(Entry* entry)
+    {
+        retired_entries_[epoch_.load() & 1].push_back(entry);
+    }
+
+    // Frees everything retired in the previous epoch once no reader remains in it and
+    // advances the epoch. Writer lock must be held.
+    void Reclaim_()
+    {
+        uint32_t current = epoch_.load();
+        uint32_t previous = (current + 1) & 1;
+
+        if (readers_[previous].load() != 0)
+        {
+            return;
+        }
+
+        FreeRetired_(previous);
+
+        if (!retired_entries_[current & 1].empty() || !retired_slots_[current & 1].empty())
+        {
+            epoch_.store(current + 1);
+        }
+    }
+
+    void FreeRetired_(uint32_t parity)
+    {
+        for (Entry* entry : retired_entries_[parity])
+        {
+            delete entry;
+        }
+
+        for (Slots* slots : retired_slots_[parity])
+        {
+            delete slots;
+        }
+
+        retired_entries_[parity].clear();
+        retired_slots_[parity].clear();
+    }
+
+    std::atomic<Slots*> slots_;
+    std::atomic<size_t> size_;
+    size_t used_slots_;
+
+    Entry tombstone_;
+
+    mutable std::atomic<uint32_t> epoch_;
+    mutable std::atomic<int32_t> readers_[2];
+
+    boost::mutex writer_mutex_;
+    std::vector<Entry*> retired_entries_[2];
+    std::vector<Slots*> retired_slots_[2];
+};
+
+}}}  // namespace anh::network::soe
+
+#endif  // ANH_NETWORK_SOE_SESSION_TABLE_H_
@@ -0,0 +1,148 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <boost/asio.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "anh/network/soe/session_table.h"
+
+using namespace anh::network::soe;
+using namespace boost::asio::ip;
+using namespace std;
+
+namespace {
+
+udp::endpoint MakeEndpoint(uint32_t index)
+{
+    return udp::endpoint(address_v4(0x7F000000 + (index >> 16)), static_cast<uint16_t>(index));
+}
+
+BOOST_AUTO_TEST_SUITE(SessionTableTests)
+
+/// Verifies that the packed key keeps the address and port distinct.
+BOOST_AUTO_TEST_CASE(PackedKeyCombinesAddressAndPort)
+{
+    udp::endpoint endpoint(address_v4::from_string("10.0.0.1"), 44453);
+
+    BOOST_CHECK_EQUAL((0x0A000001ULL << 16) | 44453, PackEndpointKey(endpoint));
+    BOOST_CHECK(PackEndpointKey(endpoint) != PackEndpointKey(udp::endpoint(endpoint.address(), 44454)));
+}
+
+/// Verifies inserted sessions can be found and that a second insert returns the existing session.
+BOOST_AUTO_TEST_CASE(InsertReturnsExistingSession)
+{
+    SessionTable<int> table;
+
+    auto first = make_shared<int>(1);
+    auto second = make_shared<int>(2);
+
+    BOOST_CHECK(table.Insert(MakeEndpoint(1), first) == first);
+    BOOST_CHECK(table.Insert(MakeEndpoint(1), second) == first);
+    BOOST_CHECK(table.Find(MakeEndpoint(1)) == first);
+    BOOST_CHECK(table.Find(MakeEndpoint(2)) == nullptr);
+    BOOST_CHECK_EQUAL(1U, table.size());
+}
+
+/// Verifies that erasing and reinserting many entries grows and compacts the table correctly.
+BOOST_AUTO_TEST_CASE(EraseAndGrowKeepsRemainingSessions)
+{
+    SessionTable<uint32_t> table(16);
+
+    for (uint32_t i = 0; i < 5000; ++i)
+    {
+        table.Insert(MakeEndpoint(i), make_shared<uint32_t>(i));
+    }
+
+    for (uint32_t i = 0; i < 5000; i += 2)
+    {
+        BOOST_CHECK(table.Erase(MakeEndpoint(i)));
+    }
+
+    BOOST_CHECK(!table.Erase(MakeEndpoint(0)));
+    BOOST_CHECK_EQUAL(2500U, table.size());
+
+    for (uint32_t i = 0; i < 5000; ++i)
+    {
+        auto session = table.Find(MakeEndpoint(i));
+        if (i % 2)
+        {
+            BOOST_REQUIRE(session);
+            BOOST_CHECK_EQUAL(i, *session);
+        }
+        else
+        {
+            BOOST_CHECK(!session);
+        }
+    }
+
+    uint32_t visited = 0;
+    table.ForEach([&visited] (const shared_ptr<uint32_t>&) { ++visited; });
+    BOOST_CHECK_EQUAL(2500U, visited);
+
+    auto found = table.FindIf([] (const shared_ptr<uint32_t>& value) { return *value == 4999; });
+    BOOST_REQUIRE(found);
+    BOOST_CHECK_EQUAL(4999U, *found);
+}
+
+/// Verifies that readers always see stable sessions while writers churn the table.
+BOOST_AUTO_TEST_CASE(ConcurrentReadersSeeStableSessions)
+{
+    SessionTable<uint32_t> table(16);
+
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+        table.Insert(MakeEndpoint(i), make_shared<uint32_t>(i));
+    }
+
+    atomic<bool> done(false);
+    atomic<uint32_t> failures(0);
+
+    vector<boost::thread> readers;
+    for (int i = 0; i < 3; ++i)
+    {
+        readers.push_back(boost::thread([&] () {
+            while (!done)
+            {
+                for (uint32_t j = 0; j < 256; ++j)
+                {
+                    auto session = table.Find(MakeEndpoint(j));
+                    if (!session || *session != j)
+                    {
+                        ++failures;
+                    }
+                }
+            }
+        }));
+    }
+
+    // Churn a disjoint set of endpoints, forcing tombstones and rehashes.
+    for (uint32_t round = 0; round < 50; ++round)
+    {
+        for (uint32_t i = 1000; i < 1500; ++i)
+        {
+            table.Insert(MakeEndpoint(i), make_shared<uint32_t>(i));
+        }
+
+        for (uint32_t i = 1000; i < 1500; ++i)
+        {
+            table.Erase(MakeEndpoint(i));
+        }
+    }
+
+    done = true;
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    BOOST_CHECK_EQUAL(0U, failures.load());
+    BOOST_CHECK_EQUAL(256U, table.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
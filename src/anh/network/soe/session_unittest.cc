@@ -1,13 +1,18 @@
 // This file is part of SWGANH which is released under the MIT license.
 // See file LICENSE or go to http://swganh.com/LICENSE
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include <boost/asio.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
 
 #include "anh/byte_buffer.h"
+#include "anh/network/soe/packet_buffer.h"
 #include "anh/network/soe/session.h"
+#include "anh/network/soe/timer_wheel.h"
 
 #include "anh/network/soe/mock_server.h"
 
@@ -36,6 +41,72 @@ protected:
     shared_ptr<MockServer> buildMockServer() const;
 };
 
+/**
+ * Stands in for the server of connected sessions, it counts the packets put on the
+ * wire and owns a timer wheel the tests advance by hand.
+ */
+class FakeServer : public ServerInterface {
+public:
+    explicit FakeServer(
+        uint32_t send_window = 64,
+        boost::posix_time::time_duration max_flush_latency = boost::posix_time::milliseconds(0),
+        uint32_t max_flush_batch_size = 64)
+        : sent_packets(0)
+        , send_window_(send_window)
+        , max_flush_latency_(max_flush_latency)
+        , max_flush_batch_size_(max_flush_batch_size)
+    {}
+
+    void Start(uint16_t port) {}
+    void Shutdown() {}
+
+    void SendTo(const udp::endpoint& endpoint, PacketBuffer buffer) { ++sent_packets; }
+
+    void HandleMessage(const shared_ptr<Session>& connection, ByteBuffer message) {}
+
+    bool RemoveSession(shared_ptr<Session> session) { return true; }
+    shared_ptr<Session> CreateSession(const udp::endpoint& endpoint) { return nullptr; }
+    shared_ptr<Session> GetSession(const udp::endpoint& endpoint) { return nullptr; }
+
+    udp::socket* socket() { return nullptr; }
+    uint32_t max_receive_size() { return 496; }
+    shared_ptr<PacketBufferPool> packet_pool() { return nullptr; }
+    TimerWheel* timer_wheel() { return &wheel; }
+    uint32_t send_window() { return send_window_; }
+    boost::posix_time::time_duration max_flush_latency() { return max_flush_latency_; }
+    uint32_t max_flush_batch_size() { return max_flush_batch_size_; }
+    int compression_level() { return 0; }
+
+    TimerWheel wheel;
+    uint32_t sent_packets;
+
+private:
+    uint32_t send_window_;
+    boost::posix_time::time_duration max_flush_latency_;
+    uint32_t max_flush_batch_size_;
+};
+
+class SessionReliabilityTests {
+protected:
+    // creates a session that has completed the session request
+    shared_ptr<Session> buildConnectedSession(FakeServer& server);
+
+    // sends one data channel packet
+    void sendPacket(const shared_ptr<Session>& session) const;
+
+    // queues a message for the session to flush on its own
+    void queueMessage(const shared_ptr<Session>& session) const;
+
+    void acknowledge(const shared_ptr<Session>& session, uint16_t sequence) const;
+
+    void acknowledgeOutOfOrder(const shared_ptr<Session>& session, uint16_t sequence) const;
+
+    // runs the handlers waiting on the sessions' strands
+    void runHandlers();
+
+    boost::asio::io_service io_service_;
+};
+
 BOOST_FIXTURE_TEST_SUITE(SessionTest, SessionTests)
 
 /// This test verifies that new sessions have a send sequence of 0
@@ -80,6 +151,203 @@ BOOST_AUTO_TEST_CASE(DataChannelMessagesAreStoredForResending) {
 }
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_FIXTURE_TEST_SUITE(SessionReliabilityTest, SessionReliabilityTests)
+
+/// The first acknowledgement seeds the smoothed round trip time, the retransmit
+/// timeout follows from it as in RFC 6298 but never drops below 100ms.
+BOOST_AUTO_TEST_CASE(AcknowledgementSetsRoundTripTimeAndRetransmitTimeout) {
+    FakeServer server;
+    auto session = buildConnectedSession(server);
+
+    BOOST_CHECK_EQUAL(boost::posix_time::milliseconds(500), session->retransmit_timeout());
+
+    sendPacket(session);
+    boost::this_thread::sleep(boost::posix_time::milliseconds(40));
+    acknowledge(session, 0);
+    runHandlers();
+
+    auto smoothed_rtt = session->smoothed_rtt();
+    BOOST_CHECK(smoothed_rtt >= boost::posix_time::milliseconds(40));
+    BOOST_CHECK_EQUAL(
+        max<boost::posix_time::time_duration>(boost::posix_time::milliseconds(100), smoothed_rtt + (smoothed_rtt / 2) * 4),
+        session->retransmit_timeout());
+
+    session->Close();
+}
+
+/// A packet unacknowledged for a full timeout is resent and the timeout doubles.
+BOOST_AUTO_TEST_CASE(RetransmitTimeoutResendsAndBacksOff) {
+    FakeServer server;
+    auto session = buildConnectedSession(server);
+
+    sendPacket(session);
+    acknowledge(session, 0);
+    runHandlers();
+
+    BOOST_REQUIRE_EQUAL(boost::posix_time::milliseconds(100), session->retransmit_timeout());
+
+    sendPacket(session);
+    boost::this_thread::sleep(boost::posix_time::milliseconds(110));
+    server.wheel.Advance(20);
+    runHandlers();
+
+    BOOST_CHECK_EQUAL(1u, session->resent_packet_count());
+    BOOST_CHECK_EQUAL(boost::posix_time::milliseconds(200), session->retransmit_timeout());
+    BOOST_CHECK_EQUAL(1u, server.wheel.size());
+
+    session->Close();
+}
+
+/// A timeout that fired while an acknowledgement re-armed the timer is ignored
+/// instead of arming a second timer.
+BOOST_AUTO_TEST_CASE(StaleRetransmitTimeoutIsIgnored) {
+    FakeServer server;
+    auto session = buildConnectedSession(server);
+
+    sendPacket(session);
+    sendPacket(session);
+    BOOST_REQUIRE_EQUAL(1u, server.wheel.size());
+
+    // The acknowledgement reaches the strand before the timeout does.
+    acknowledge(session, 0);
+    server.wheel.Advance(60);
+    runHandlers();
+
+    BOOST_CHECK_EQUAL(1u, server.wheel.size());
+    BOOST_CHECK_EQUAL(0u, session->resent_packet_count());
+
+    session->Close();
+}
+
+/// An out of order acknowledgement resends the gaps before it, but only those
+/// sent at least a round trip ago, and never the acknowledged packet itself.
+BOOST_AUTO_TEST_CASE(OutOfOrderResendsOnlyTheGapsBeforeIt) {
+    FakeServer server;
+    auto session = buildConnectedSession(server);
+
+    sendPacket(session);
+    boost::this_thread::sleep(boost::posix_time::milliseconds(20));
+    acknowledge(session, 0);
+    runHandlers();
+
+    for (int i = 0; i < 3; ++i) {
+        sendPacket(session);
+    }
+
+    // Too recent for their acknowledgements to have arrived.
+    acknowledgeOutOfOrder(session, 3);
+    runHandlers();
+    BOOST_CHECK_EQUAL(0u, session->resent_packet_count());
+
+    boost::this_thread::sleep(session->smoothed_rtt() + boost::posix_time::milliseconds(5));
+
+    acknowledgeOutOfOrder(session, 3);
+    runHandlers();
+    BOOST_CHECK_EQUAL(2u, session->resent_packet_count());
+
+    // The gaps were just resent.
+    acknowledgeOutOfOrder(session, 3);
+    runHandlers();
+    BOOST_CHECK_EQUAL(2u, session->resent_packet_count());
+
+    BOOST_CHECK_EQUAL(2u, session->GetUnacknowledgedMessages().size());
+
+    session->Close();
+}
+
+/// Packets beyond the send window wait until acknowledgements make room.
+BOOST_AUTO_TEST_CASE(SendWindowQueuesPacketsUntilAcknowledged) {
+    FakeServer server(4);
+    auto session = buildConnectedSession(server);
+
+    for (int i = 0; i < 6; ++i) {
+        sendPacket(session);
+    }
+
+    BOOST_CHECK_EQUAL(4, session->server_sequence());
+    BOOST_CHECK_EQUAL(2u, session->queued_message_count());
+
+    acknowledge(session, 1);
+    runHandlers();
+
+    BOOST_CHECK_EQUAL(6, session->server_sequence());
+    BOOST_CHECK_EQUAL(0u, session->queued_message_count());
+    BOOST_CHECK_EQUAL(4u, session->GetUnacknowledgedMessages().size());
+
+    session->Close();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_FIXTURE_TEST_SUITE(SessionFlushTest, SessionReliabilityTests)
+
+/// Queued messages are flushed as soon as they reach the batch size, packed
+/// together into a single packet.
+BOOST_AUTO_TEST_CASE(FlushesWhenTheBatchSizeIsReached) {
+    FakeServer server(64, boost::posix_time::seconds(10), 3);
+    auto session = buildConnectedSession(server);
+
+    queueMessage(session);
+    queueMessage(session);
+    runHandlers();
+
+    BOOST_CHECK_EQUAL(0, session->server_sequence());
+
+    queueMessage(session);
+    runHandlers();
+
+    BOOST_CHECK_EQUAL(1, session->server_sequence());
+
+    session->Close();
+}
+
+/// A message short of the batch size waits for the flush latency at most.
+BOOST_AUTO_TEST_CASE(FlushesAfterTheMaxFlushLatency) {
+    FakeServer server(64, boost::posix_time::milliseconds(50), 64);
+    auto session = buildConnectedSession(server);
+
+    queueMessage(session);
+    queueMessage(session);
+    runHandlers();
+
+    BOOST_CHECK_EQUAL(0, session->server_sequence());
+
+    // A single flush timer covers the whole batch.
+    BOOST_CHECK_EQUAL(1u, server.wheel.size());
+
+    server.wheel.Advance(4);
+    runHandlers();
+    BOOST_CHECK_EQUAL(0, session->server_sequence());
+
+    server.wheel.Advance(1);
+    runHandlers();
+    BOOST_CHECK_EQUAL(1, session->server_sequence());
+
+    session->Close();
+}
+
+/// Messages queued while a flush is pending don't post another one, each
+/// posted flush holds a reference to the session.
+BOOST_AUTO_TEST_CASE(OnlyOneFlushIsPosted) {
+    FakeServer server;
+    auto session = buildConnectedSession(server);
+
+    for (int i = 0; i < 5; ++i) {
+        queueMessage(session);
+    }
+
+    BOOST_CHECK_EQUAL(2, session.use_count());
+
+    runHandlers();
+
+    BOOST_CHECK_EQUAL(1, session.use_count());
+    BOOST_CHECK_EQUAL(1, session->server_sequence());
+
+    session->Close();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 // SessionTest member implementations
 
 ByteBuffer SessionTests::buildSimpleMessage() const {
@@ -137,8 +405,73 @@ shared_ptr<MockServer> SessionTests::buildMockServer() const {
     MOCK_EXPECT(*server, max_receive_size)
         .at_least(1)
         .returns(496);
+
+    MOCK_EXPECT(*server, packet_pool)
+        .returns(shared_ptr<PacketBufferPool>());
+
+    MOCK_EXPECT(*server, SendTo);
+
+    MOCK_EXPECT(*server, timer_wheel)
+        .returns(static_cast<TimerWheel*>(nullptr));
+
+    MOCK_EXPECT(*server, send_window)
+        .returns(64);
+
+    MOCK_EXPECT(*server, max_flush_latency)
+        .returns(boost::posix_time::milliseconds(0));
+
+    MOCK_EXPECT(*server, max_flush_batch_size)
+        .returns(64);
+
+    MOCK_EXPECT(*server, compression_level)
+        .returns(6);
         
     return server;
 }
 
+// SessionReliabilityTest member implementations
+
+shared_ptr<Session> SessionReliabilityTests::buildConnectedSession(FakeServer& server) {
+    auto session = make_shared<Session>(&server, io_service_, udp::endpoint(address_v4::from_string("127.0.0.1"), 1000));
+
+    ByteBuffer buffer;
+    SessionRequest(0, 1, 496).serialize(buffer);
+    session->HandleMessage(move(buffer));
+    runHandlers();
+
+    BOOST_REQUIRE(session->connected());
+
+    return session;
+}
+
+void SessionReliabilityTests::sendPacket(const shared_ptr<Session>& session) const {
+    queueMessage(session);
+    session->Update();
+}
+
+void SessionReliabilityTests::queueMessage(const shared_ptr<Session>& session) const {
+    ByteBuffer message;
+    message.write<uint16_t>(1);
+    message.write<uint32_t>(0xDEADBABE);
+
+    session->SendTo(move(message));
+}
+
+void SessionReliabilityTests::acknowledge(const shared_ptr<Session>& session, uint16_t sequence) const {
+    ByteBuffer buffer;
+    AckA(sequence).serialize(buffer);
+    session->HandleMessage(move(buffer));
+}
+
+void SessionReliabilityTests::acknowledgeOutOfOrder(const shared_ptr<Session>& session, uint16_t sequence) const {
+    ByteBuffer buffer;
+    OutOfOrderA(sequence).serialize(buffer);
+    session->HandleMessage(move(buffer));
+}
+
+void SessionReliabilityTests::runHandlers() {
+    io_service_.reset();
+    io_service_.poll();
+}
+
 }}}  // namespace anh::network::soe
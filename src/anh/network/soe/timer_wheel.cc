@@ -0,0 +1,155 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include "anh/network/soe/timer_wheel.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace anh::network::soe;
+using namespace std;
+
+TimerWheel::TimerWheel(boost::posix_time::time_duration tick_duration)
+    : tick_duration_(tick_duration)
+    , current_tick_(0)
+    , next_id_(1)
+{
+    if (tick_duration_.total_microseconds() <= 0)
+    {
+        tick_duration_ = boost::posix_time::milliseconds(1);
+    }
+}
+
+TimerWheel::TimerId TimerWheel::Schedule(boost::posix_time::time_duration delay, Callback callback)
+{
+    int64_t tick_us = tick_duration_.total_microseconds();
+    int64_t delay_us = max<int64_t>(0, delay.total_microseconds());
+
+    // Round up and always wait at least one full tick.
+    uint64_t ticks = max<uint64_t>(1, (delay_us + tick_us - 1) / tick_us);
+
+    boost::lock_guard<boost::mutex> lg(mutex_);
+
+    TimerId id = next_id_++;
+    Timer timer = { id, current_tick_ + ticks, move(callback) };
+
+    Slot staging;
+    staging.push_back(move(timer));
+    Insert_(staging, staging.begin());
+
+    return id;
+}
+
+bool TimerWheel::Cancel(TimerId id)
+{
+    boost::lock_guard<boost::mutex> lg(mutex_);
+
+    auto find_iter = timers_.find(id);
+    if (find_iter == timers_.end())
+    {
+        return false;
+    }
+
+    find_iter->second.slot->erase(find_iter->second.iterator);
+    timers_.erase(find_iter);
+
+    return true;
+}
+
+size_t TimerWheel::Advance(uint64_t ticks)
+{
+    size_t fired = 0;
+    vector<Callback> expired;
+
+    for (uint64_t i = 0; i < ticks; ++i)
+    {
+        {
+            boost::lock_guard<boost::mutex> lg(mutex_);
+
+            ++current_tick_;
+
+            // Refill the lower levels from the top down whenever they wrap around.
+            if ((current_tick_ & kSlotMask) == 0)
+            {
+                uint32_t top = 1;
+                while (top + 1 < kLevels && ((current_tick_ >> (kSlotBits * top)) & kSlotMask) == 0)
+                {
+                    ++top;
+                }
+
+                for (uint32_t level = top; level > 0; --level)
+                {
+                    Cascade_(level);
+                }
+            }
+
+            Slot& slot = levels_[0][current_tick_ & kSlotMask];
+            for (auto& timer : slot)
+            {
+                timers_.erase(timer.id);
+                expired.push_back(move(timer.callback));
+            }
+
+            slot.clear();
+        }
+
+        for (auto& callback : expired)
+        {
+            callback();
+        }
+
+        fired += expired.size();
+        expired.clear();
+    }
+
+    return fired;
+}
+
+boost::posix_time::time_duration TimerWheel::tick_duration() const
+{
+    return tick_duration_;
+}
+
+uint64_t TimerWheel::current_tick() const
+{
+    boost::lock_guard<boost::mutex> lg(mutex_);
+    return current_tick_;
+}
+
+size_t TimerWheel::size() const
+{
+    boost::lock_guard<boost::mutex> lg(mutex_);
+    return timers_.size();
+}
+
+void TimerWheel::Insert_(Slot& source, Slot::iterator timer)
+{
+    // Timers further out than the wheel can represent wait in the top level and are
+    // re-examined each time that slot cascades.
+    uint64_t max_delta = (1ULL << (kSlotBits * kLevels)) - 1;
+    uint64_t expiry = min(timer->expiry, current_tick_ + max_delta);
+    uint64_t delta = expiry - current_tick_;
+
+    uint32_t level = 0;
+    while (level + 1 < kLevels && delta >= (1ULL << (kSlotBits * (level + 1))))
+    {
+        ++level;
+    }
+
+    Slot& target = levels_[level][(expiry >> (kSlotBits * level)) & kSlotMask];
+    target.splice(target.end(), source, timer);
+
+    Location location = { &target, timer };
+    timers_[timer->id] = location;
+}
+
+void TimerWheel::Cascade_(uint32_t level)
+{
+    Slot slot;
+    slot.swap(levels_[level][(current_tick_ >> (kSlotBits * level)) & kSlotMask]);
+
+    while (!slot.empty())
+    {
+        Insert_(slot, slot.begin());
+    }
+}
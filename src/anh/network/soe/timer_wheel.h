@@ -0,0 +1,120 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef ANH_NETWORK_SOE_TIMER_WHEEL_H_
+#define ANH_NETWORK_SOE_TIMER_WHEEL_H_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+
+namespace anh {
+namespace network {
+namespace soe {
+
+/**
+ * @brief Hierarchical timer wheel shared by all sessions of a server.
+ *
+ * Timers are kept in 4 levels of 64 slots; the first level has a resolution of one tick
+ * and each level above covers 64 times the range of the one below it. Scheduling and
+ * cancelling are O(1), and advancing the wheel touches only the slot that expires plus an
+ * occasional cascade from a higher level. This keeps the cost of thousands of session
+ * retransmit timers independent of how many are pending.
+ *
+ * The wheel does not track time itself; its owner calls Advance as ticks elapse. Callbacks
+ * are invoked from Advance outside of the wheel's lock, so they may schedule or cancel
+ * other timers.
+ */
+class TimerWheel : private boost::noncopyable
+{
+public:
+    typedef uint64_t TimerId;
+    typedef std::function<void ()> Callback;
+
+    /**
+     * @param tick_duration The resolution of the wheel.
+     */
+    explicit TimerWheel(boost::posix_time::time_duration tick_duration = boost::posix_time::milliseconds(10));
+
+    /**
+     * Schedules a callback to be invoked once after a delay.
+     *
+     * The delay is rounded up to whole ticks, a timer never fires early.
+     *
+     * @return An id that can be used to cancel the timer, never 0.
+     */
+    TimerId Schedule(boost::posix_time::time_duration delay, Callback callback);
+
+    /**
+     * Cancels a pending timer.
+     *
+     * @return True if the timer was pending and will no longer fire.
+     */
+    bool Cancel(TimerId id);
+
+    /**
+     * Advances the wheel, invoking every timer that expires along the way.
+     *
+     * @param ticks The number of ticks that have elapsed.
+     * @return The number of callbacks invoked.
+     */
+    size_t Advance(uint64_t ticks);
+
+    /**
+     * @return The resolution of the wheel.
+     */
+    boost::posix_time::time_duration tick_duration() const;
+
+    /**
+     * @return The number of ticks the wheel has advanced.
+     */
+    uint64_t current_tick() const;
+
+    /**
+     * @return The number of pending timers.
+     */
+    size_t size() const;
+
+private:
+    static const uint32_t kLevels = 4;
+    static const uint32_t kSlotBits = 6;
+    static const uint32_t kSlots = 1 << kSlotBits;
+    static const uint64_t kSlotMask = kSlots - 1;
+
+    struct Timer
+    {
+        TimerId id;
+        uint64_t expiry;
+        Callback callback;
+    };
+
+    typedef std::list<Timer> Slot;
+
+    struct Location
+    {
+        Slot* slot;
+        Slot::iterator iterator;
+    };
+
+    void Insert_(Slot& source, Slot::iterator timer);
+    void Cascade_(uint32_t level);
+
+    mutable boost::mutex mutex_;
+
+    boost::posix_time::time_duration tick_duration_;
+    uint64_t current_tick_;
+    TimerId next_id_;
+
+    std::array<std::array<Slot, kSlots>, kLevels> levels_;
+    std::unordered_map<TimerId, Location> timers_;
+};
+
+}}}  // namespace anh::network::soe
+
+#endif  // ANH_NETWORK_SOE_TIMER_WHEEL_H_
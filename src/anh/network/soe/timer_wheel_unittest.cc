@@ -0,0 +1,105 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <functional>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#include "anh/network/soe/timer_wheel.h"
+
+using namespace anh::network::soe;
+using namespace boost::posix_time;
+using namespace std;
+
+namespace {
+
+BOOST_AUTO_TEST_SUITE(TimerWheelTests)
+
+/// Verifies that timers fire on the tick their delay rounds up to and not before.
+BOOST_AUTO_TEST_CASE(TimersFireAfterTheirDelay)
+{
+    TimerWheel wheel(milliseconds(10));
+
+    int fired = 0;
+    wheel.Schedule(milliseconds(25), [&fired] () { ++fired; });
+
+    BOOST_CHECK_EQUAL(0U, wheel.Advance(2));
+    BOOST_CHECK_EQUAL(0, fired);
+
+    BOOST_CHECK_EQUAL(1U, wheel.Advance(1));
+    BOOST_CHECK_EQUAL(1, fired);
+    BOOST_CHECK_EQUAL(0U, wheel.size());
+}
+
+/// Verifies that timers in the higher levels cascade down and fire on the exact tick.
+BOOST_AUTO_TEST_CASE(LongTimersCascadeToTheExactTick)
+{
+    TimerWheel wheel(milliseconds(1));
+
+    // Start mid-revolution so cascades do not line up with the schedule time.
+    wheel.Advance(37);
+
+    vector<uint64_t> delays;
+    delays.push_back(63);
+    delays.push_back(64);
+    delays.push_back(65);
+    delays.push_back(4095);
+    delays.push_back(4096);
+    delays.push_back(70000);
+    delays.push_back(300000);
+
+    vector<uint64_t> fired_at(delays.size(), 0);
+
+    for (size_t i = 0; i < delays.size(); ++i)
+    {
+        uint64_t* slot = &fired_at[i];
+        wheel.Schedule(milliseconds(delays[i]), [&wheel, slot] () { *slot = wheel.current_tick(); });
+    }
+
+    wheel.Advance(300000);
+
+    for (size_t i = 0; i < delays.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(37 + delays[i], fired_at[i]);
+    }
+}
+
+/// Verifies that cancelled timers never fire.
+BOOST_AUTO_TEST_CASE(CancelledTimersDoNotFire)
+{
+    TimerWheel wheel(milliseconds(10));
+
+    int fired = 0;
+    auto id = wheel.Schedule(milliseconds(100), [&fired] () { ++fired; });
+    wheel.Schedule(milliseconds(100), [&fired] () { fired += 10; });
+
+    BOOST_CHECK(wheel.Cancel(id));
+    BOOST_CHECK(!wheel.Cancel(id));
+
+    wheel.Advance(20);
+
+    BOOST_CHECK_EQUAL(10, fired);
+}
+
+/// Verifies that a callback can schedule a new timer on the same wheel.
+BOOST_AUTO_TEST_CASE(CallbacksCanReschedule)
+{
+    TimerWheel wheel(milliseconds(10));
+
+    int fired = 0;
+    function<void ()> repeat = [&] () {
+        if (++fired < 5)
+        {
+            wheel.Schedule(milliseconds(10), repeat);
+        }
+    };
+
+    wheel.Schedule(milliseconds(10), repeat);
+    wheel.Advance(100);
+
+    BOOST_CHECK_EQUAL(5, fired);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
@@ -4,6 +4,9 @@
 #ifndef ANH_OBSERVER_OBSERVER_INTERFACE_H_
 #define ANH_OBSERVER_OBSERVER_INTERFACE_H_
 
+#include <limits>
+#include <memory>
+
 #include "anh/byte_buffer.h"
 
 namespace anh {
@@ -57,6 +60,63 @@ namespace observer {
         };
     }
 
+    /**
+     * A message serialized once and shared by every observer it is delivered to.
+     *
+     * Messages that address their observer carry the observer id at a fixed offset
+     * reported by T::ObservableIdOffset(), only those bytes are patched per observer.
+     * Every other message reaches all observers as the same immutable buffer.
+     */
+    class BroadcastMessage
+    {
+    public:
+        template<typename T>
+        explicit BroadcastMessage(const T& message,
+            typename std::enable_if<detail::HasObservableId<T>::value>::type* = 0)
+            : observable_id_offset_(T::ObservableIdOffset())
+        {
+            auto buffer = std::make_shared<anh::ByteBuffer>();
+            message.Serialize(*buffer);
+            buffer_ = std::move(buffer);
+        }
+
+        template<typename T>
+        explicit BroadcastMessage(const T& message,
+            typename std::enable_if<!detail::HasObservableId<T>::value>::type* = 0)
+            : observable_id_offset_(NoObservableId())
+        {
+            auto buffer = std::make_shared<anh::ByteBuffer>();
+            message.Serialize(*buffer);
+            buffer_ = std::move(buffer);
+        }
+
+        explicit BroadcastMessage(anh::ByteBuffer message)
+            : buffer_(std::make_shared<anh::ByteBuffer>(std::move(message)))
+            , observable_id_offset_(NoObservableId())
+        {}
+
+        /**
+         * @return The serialized message as it should be delivered to the given observer.
+         */
+        std::shared_ptr<const anh::ByteBuffer> GetBufferFor(uint64_t observer_id) const
+        {
+            if (observable_id_offset_ == NoObservableId())
+            {
+                return buffer_;
+            }
+
+            auto buffer = std::make_shared<anh::ByteBuffer>(*buffer_);
+            buffer->writeAt<uint64_t>(observable_id_offset_, observer_id);
+            return buffer;
+        }
+
+    private:
+        static size_t NoObservableId() { return std::numeric_limits<size_t>::max(); }
+
+        std::shared_ptr<const anh::ByteBuffer> buffer_;
+        size_t observable_id_offset_;
+    };
+
     class ObserverInterface
     {
     public:
@@ -98,6 +158,24 @@ namespace observer {
          * @param message Message containing the updated state of the observable object.
          */
         virtual void Notify(const anh::ByteBuffer& message) = 0;
+
+        /**
+         * Notifies observer with a message serialized once for all of its observers.
+         *
+         * Observers that queue messages should override this to keep the shared buffer
+         * rather than copy it.
+         *
+         * @param message Buffer shared with the other observers, it must not be modified.
+         */
+        virtual void Notify(const std::shared_ptr<const anh::ByteBuffer>& message)
+        {
+            Notify(*message);
+        }
+
+        void Notify(const BroadcastMessage& message)
+        {
+            Notify(message.GetBufferFor(GetId()));
+        }
     };
 
 }}  // namespace anh::observer
@@ -0,0 +1,154 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef ANH_SEQLOCK_H_
+#define ANH_SEQLOCK_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace anh {
+
+/**
+ * Holds a small, trivially copyable value that is read far more often than
+ * it is written.
+ *
+ * Readers never block or write shared memory. They copy the value and retry
+ * if a writer changed it in the meantime. Writers are serialized among
+ * themselves through the sequence counter, which is odd while a write is in
+ * progress. The value is stored as relaxed atomic words, so a torn read is
+ * discarded rather than being a data race.
+ */
+template<typename T>
+class Seqlock
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock values must be trivially copyable");
+
+public:
+    Seqlock()
+        : sequence_(0)
+    {
+        Write_(T());
+    }
+
+    explicit Seqlock(const T& value)
+        : sequence_(0)
+    {
+        Write_(value);
+    }
+
+    /**
+     * @return A consistent copy of the value.
+     */
+    T Load() const
+    {
+        for (;;)
+        {
+            uint32_t before = sequence_.load(std::memory_order_acquire);
+
+            if (before & 1)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            T value = Read_();
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (sequence_.load(std::memory_order_relaxed) == before)
+            {
+                return value;
+            }
+        }
+    }
+
+    /**
+     * Replaces the value.
+     */
+    void Store(const T& value)
+    {
+        uint32_t sequence = BeginWrite_();
+        Write_(value);
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * Replaces the value with what the modifier makes of it, with no other
+     * write in between.
+     *
+     * @param modifier Called with a copy of the current value to change in place.
+     */
+    template<typename Modifier>
+    void Modify(Modifier modifier)
+    {
+        uint32_t sequence = BeginWrite_();
+
+        T value = Read_();
+        modifier(value);
+
+        Write_(value);
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+private:
+    typedef uint32_t Word;
+    static const size_t WORD_COUNT = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+
+    Seqlock(const Seqlock&);
+    Seqlock& operator=(const Seqlock&);
+
+    uint32_t BeginWrite_()
+    {
+        for (;;)
+        {
+            uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+
+            if (!(sequence & 1) &&
+                sequence_.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire))
+            {
+                // Keeps the stores to the value after the counter is made odd.
+                std::atomic_thread_fence(std::memory_order_release);
+                return sequence;
+            }
+
+            std::this_thread::yield();
+        }
+    }
+
+    T Read_() const
+    {
+        std::array<Word, WORD_COUNT> words;
+
+        for (size_t i = 0; i < WORD_COUNT; ++i)
+        {
+            words[i] = words_[i].load(std::memory_order_relaxed);
+        }
+
+        T value;
+        std::memcpy(&value, words.data(), sizeof(T));
+        return value;
+    }
+
+    void Write_(const T& value)
+    {
+        std::array<Word, WORD_COUNT> words = {};
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        for (size_t i = 0; i < WORD_COUNT; ++i)
+        {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+    }
+
+    std::atomic<uint32_t> sequence_;
+    std::array<std::atomic<Word>, WORD_COUNT> words_;
+};
+
+}  // namespace anh
+
+#endif  // ANH_SEQLOCK_H_
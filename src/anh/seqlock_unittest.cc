@@ -0,0 +1,101 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "anh/seqlock.h"
+
+using namespace anh;
+using namespace std;
+
+namespace {
+
+/// Every field holds the same value, so a torn read shows up as a mismatch.
+struct Triple
+{
+    uint32_t a;
+    uint32_t b;
+    uint32_t c;
+};
+
+BOOST_AUTO_TEST_SUITE(ANHSeqlock)
+
+BOOST_AUTO_TEST_CASE(DefaultConstructedValueIsZeroed)
+{
+    Seqlock<Triple> seqlock;
+    Triple value = seqlock.Load();
+
+    BOOST_CHECK_EQUAL(0u, value.a);
+    BOOST_CHECK_EQUAL(0u, value.b);
+    BOOST_CHECK_EQUAL(0u, value.c);
+}
+
+BOOST_AUTO_TEST_CASE(LoadReturnsLastStoredValue)
+{
+    Triple value = {1, 2, 3};
+    Seqlock<Triple> seqlock(value);
+
+    value.b = 20;
+    seqlock.Store(value);
+
+    Triple loaded = seqlock.Load();
+    BOOST_CHECK_EQUAL(1u, loaded.a);
+    BOOST_CHECK_EQUAL(20u, loaded.b);
+    BOOST_CHECK_EQUAL(3u, loaded.c);
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentReadersNeverSeeTornValues)
+{
+    Seqlock<Triple> seqlock;
+    atomic<bool> done(false);
+    atomic<uint32_t> torn_reads(0);
+
+    vector<thread> readers;
+    for (int i = 0; i < 2; ++i)
+    {
+        readers.emplace_back([&] {
+            while (!done)
+            {
+                Triple value = seqlock.Load();
+                if (value.a != value.b || value.b != value.c)
+                {
+                    ++torn_reads;
+                }
+            }
+        });
+    }
+
+    // Two writers incrementing through Modify must not lose an update.
+    auto writer = [&seqlock] {
+        for (uint32_t i = 0; i < 50000; ++i)
+        {
+            seqlock.Modify([] (Triple& value) {
+                ++value.a;
+                ++value.b;
+                ++value.c;
+            });
+        }
+    };
+
+    thread first_writer(writer);
+    thread second_writer(writer);
+    first_writer.join();
+    second_writer.join();
+
+    done = true;
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    BOOST_CHECK_EQUAL(0u, torn_reads);
+    BOOST_CHECK_EQUAL(100000u, seqlock.Load().a);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}  // namespace
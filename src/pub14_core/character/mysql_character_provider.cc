@@ -109,9 +109,7 @@ vector<CharacterData> MysqlCharacterProvider::GetCharactersForAccount(uint64_t a
 
     try {
         auto conn = kernel_->GetDatabaseManager()->getConnection("galaxy");
-        auto statement = std::shared_ptr<sql::PreparedStatement>(
-            conn->prepareStatement("CALL sp_ReturnAccountCharacters(?);")
-            );
+        auto statement = kernel_->GetDatabaseManager()->prepareStatement(conn, "CALL sp_ReturnAccountCharacters(?);");
         statement->setInt64(1, account_id);
         auto result_set = std::unique_ptr<sql::ResultSet>(statement->executeQuery());
 
@@ -172,9 +170,7 @@ bool MysqlCharacterProvider::DeleteCharacter(uint64_t character_id, uint64_t acc
 std::wstring MysqlCharacterProvider::GetRandomNameRequest(const std::string& base_model) {
     try {
         auto conn = kernel_->GetDatabaseManager()->getConnection("galaxy");
-        auto statement = std::shared_ptr<sql::PreparedStatement>(
-            conn->prepareStatement("CALL sp_CharacterNameCreate(?);")
-            );
+        auto statement = kernel_->GetDatabaseManager()->prepareStatement(conn, "CALL sp_CharacterNameCreate(?);");
         statement->setString(1, base_model);
         auto result_set = std::unique_ptr<sql::ResultSet>(statement->executeQuery());
         if (result_set->next())
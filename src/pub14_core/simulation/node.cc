@@ -26,6 +26,12 @@ Node::~Node(void)
 }
 
 void Node::InsertObject(std::shared_ptr<swganh::object::Object> obj)
+{
+	auto position = obj->GetPosition();
+	InsertObject_(std::move(obj), glm::vec2(position.x, position.z));
+}
+
+void Node::InsertObject_(std::shared_ptr<swganh::object::Object> obj, const glm::vec2& position)
 {
 	// If the amount of objects contained is equal to or exceeds (in the case of objects not fitting
 	// completely into one node), and we havn't reached the "maximum level" count, and we are a LEAF
@@ -42,35 +48,37 @@ void Node::InsertObject(std::shared_ptr<swganh::object::Object> obj)
 
 	if(state_ == BRANCH)
 	{
-		std::for_each(leaf_nodes_.begin(), leaf_nodes_.end(), [=, &obj, &success](std::shared_ptr<Node> node){
+		Point point(position.x, position.y);
+		for(const std::shared_ptr<Node>& node : leaf_nodes_)
+		{
 			// If we can fit within the node, traverse.
-			if(boost::geometry::within( Point(obj->GetPosition().x, obj->GetPosition().z) , node->GetRegion()))
+			if(boost::geometry::within(point, node->GetRegion()))
 			{
-				node->InsertObject(obj);
+				node->InsertObject_(obj, position);
 				success = true;
-				return;
+				break;
 			}
-		});
+		}
 	}
 
 	if(success)
 		return;
 
-	objects_.push_back(obj);
+	objects_.push_back(std::move(obj));
+	object_positions_.push_back(position);
 }
 
 void Node::RemoveObject(std::shared_ptr<swganh::object::Object> obj)
 {
 	// Search this node for the object by id, if it it found
 	// we can return;
-	for(auto i = objects_.begin(); i != objects_.end(); )
+	for(size_t i = 0; i < objects_.size(); ++i)
 	{
-		if(obj->GetObjectId() == (*i)->GetObjectId())
+		if(obj->GetObjectId() == objects_[i]->GetObjectId())
 		{
-			i = objects_.erase(i);
+			RemoveObjectAt_(i);
 			return;
 		}
-		i++;
 	}
 
 	// We didn't find the object in this branch, traverse through
@@ -78,7 +86,7 @@ void Node::RemoveObject(std::shared_ptr<swganh::object::Object> obj)
 	if(state_ == BRANCH)
 	{
 		Point obj_point(obj->GetPosition().x, obj->GetPosition().z);
-		for(std::shared_ptr<Node> node : leaf_nodes_)
+		for(const std::shared_ptr<Node>& node : leaf_nodes_)
 		{
 			// If we can actually fit inside the node, traverse farther.
 			if(boost::geometry::within(obj_point, node->GetRegion()))
@@ -109,16 +117,17 @@ void Node::Split()
 	leaf_nodes_[SW_QUADRANT] = std::make_shared<Node>(SW_QUADRANT, Region(region_.min_corner(), center), level_ + 1, max_level_, this);
 	leaf_nodes_[SE_QUADRANT] = std::make_shared<Node>(SE_QUADRANT, Region(bottom_center, right_center), level_ + 1, max_level_, this);
 
-	for(auto i = objects_.begin(); i != objects_.end();)
+	for(size_t i = 0; i < objects_.size();)
 	{
-		auto obj = (*i);
+		auto obj = objects_[i];
+		glm::vec2 position = object_positions_[i];
 		bool success = false;
-		for(std::shared_ptr<Node> node : leaf_nodes_)
+		for(const std::shared_ptr<Node>& node : leaf_nodes_)
 		{
-			if(boost::geometry::within(Point(obj->GetPosition().x, obj->GetPosition().z) , node->GetRegion()))
+			if(boost::geometry::within(Point(position.x, position.y), node->GetRegion()))
 			{
-				i = objects_.erase(i);
-				node->InsertObject(std::move(obj));
+				RemoveObjectAt_(i);
+				node->InsertObject_(std::move(obj), position);
 				success = true;
 				break;
 			}
@@ -133,40 +142,10 @@ std::vector<std::shared_ptr<swganh::object::Object>> Node::Query(QueryBox query_
 {
 	std::vector<std::shared_ptr<swganh::object::Object>> return_list;
 
-	std::for_each(objects_.begin(), objects_.end(), [=,& return_list](std::shared_ptr<swganh::object::Object> obj) {
-		if(boost::geometry::within(Point(obj->GetPosition().x, obj->GetPosition().z), query_box))
-			return_list.push_back(obj);
+	VisitObjectsInBox(query_box, [&return_list](const std::shared_ptr<swganh::object::Object>& obj) {
+		return_list.push_back(obj);
 	});
 
-	if(state_ == BRANCH)
-	{
-		for(std::shared_ptr<Node> node : leaf_nodes_)
-		{
-			// Node is within Query Box.
-			if(boost::geometry::within(node->GetRegion(), query_box))
-			{
-				auto contained_objects = node->GetContainedObjects();
-				return_list.insert( return_list.end(), contained_objects.begin(), contained_objects.end() );
-				continue;
-			}
-			
-			// Query Box is within node.
-			if(boost::geometry::within(query_box, node->GetRegion()))
-			{
-				std::vector<std::shared_ptr<swganh::object::Object>> list = node->Query(query_box);
-				return_list.insert( return_list.end(), list.begin(), list.end() );
-				break;
-			}
-
-			// Query Box intersects with node.
-			if(boost::geometry::intersects(query_box, node->GetRegion()))
-			{
-				std::vector<std::shared_ptr<swganh::object::Object>> list = node->Query(query_box);
-				return_list.insert( return_list.end(), list.begin(), list.end() );
-			}
-		}
-	}
-
 	return return_list;
 }
 
@@ -174,16 +153,9 @@ const std::vector<std::shared_ptr<swganh::object::Object>> Node::GetContainedObj
 {
 	std::vector<std::shared_ptr<swganh::object::Object>> objs;
 
-	objs.insert(objs.end(), objects_.begin(), objects_.end());
-
-	if(state_ == BRANCH)
-	{
-		for(const std::shared_ptr<Node> node : leaf_nodes_)
-		{
-			std::vector<std::shared_ptr<swganh::object::Object>> objs2 = node->GetContainedObjects();
-			objs.insert(objs.end(), objs2.begin(), objs2.end());
-		}
-	}
+	VisitContainedObjects([&objs](const std::shared_ptr<swganh::object::Object>& obj) {
+		objs.push_back(obj);
+	});
 
 	return objs;
 }
@@ -194,27 +166,28 @@ void Node::UpdateObject(std::shared_ptr<swganh::object::Object> obj, const glm::
 	Point new_position_point(new_position.x, new_position.z);
 
 	// Check the objects of this node.
-	for(auto i = objects_.begin(); i != objects_.end(); i++) {
-		auto node_obj = (*i);
-		if(node_obj->GetObjectId() == obj->GetObjectId())
+	for(size_t i = 0; i < objects_.size(); ++i) {
+		if(objects_[i]->GetObjectId() == obj->GetObjectId())
 		{
-			// If we are in the same node, we don't need to do anything.
+			// If we are in the same node, only the indexed position changes.
 			if(boost::geometry::within(new_position_point, region_))
 			{
+				object_positions_[i] = glm::vec2(new_position.x, new_position.z);
 				return;
 			}
 
-			// Move our object from this node to a new node.
-			std::shared_ptr<Node> node = GetRootNode_()->GetNodeWithinPoint_(new_position_point);
-			objects_.erase(i);
-			node->InsertObject(obj);
+			// Move our object from this node to a new node. The object still reports
+			// its old position at this point, so insert at the new one explicitly.
+			Node* node = GetRootNode_()->GetNodeWithinPoint_(new_position_point);
+			RemoveObjectAt_(i);
+			node->InsertObject_(obj, glm::vec2(new_position.x, new_position.z));
 			return;
 		}
 	};
 
 	if(state_ == BRANCH)
 	{
-		for(std::shared_ptr<Node> node : leaf_nodes_)
+		for(const std::shared_ptr<Node>& node : leaf_nodes_)
 		{
 			// Go further into the tree if our point is within our child node.
 			if(boost::geometry::within(old_position_point, node->GetRegion()))
@@ -226,7 +199,7 @@ void Node::UpdateObject(std::shared_ptr<swganh::object::Object> obj, const glm::
 	}
 }
 
-std::shared_ptr<Node> Node::GetNodeWithinPoint_(Point point)
+Node* Node::GetNodeWithinPoint_(Point point)
 {
 	// If we don't within the actual Spatial Indexing area, bail.
 	if(!boost::geometry::within(point, region_))
@@ -235,7 +208,7 @@ std::shared_ptr<Node> Node::GetNodeWithinPoint_(Point point)
 	if(state_ == BRANCH)
 	{
 		// See if we can fit inside leaf_nodes_
-		for(std::shared_ptr<Node> node : leaf_nodes_)
+		for(const std::shared_ptr<Node>& node : leaf_nodes_)
 		{
 			if(boost::geometry::within(point, node->GetRegion()))
 			{
@@ -245,7 +218,28 @@ std::shared_ptr<Node> Node::GetNodeWithinPoint_(Point point)
 	}
 
 	// If not, we are between or in this node.
-	return std::shared_ptr<Node>(shared_from_this());
+	return this;
+}
+
+void Node::RemoveObjectAt_(size_t index)
+{
+	objects_.erase(objects_.begin() + index);
+	object_positions_.erase(object_positions_.begin() + index);
+}
+
+float Node::DistanceSquaredToRegion_(const glm::vec2& point) const
+{
+	float dx = std::max(std::max(static_cast<float>(region_.min_corner().x()) - point.x, point.x - static_cast<float>(region_.max_corner().x())), 0.0f);
+	float dy = std::max(std::max(static_cast<float>(region_.min_corner().y()) - point.y, point.y - static_cast<float>(region_.max_corner().y())), 0.0f);
+	return dx * dx + dy * dy;
+}
+
+bool Node::RegionWithinRange_(const glm::vec2& point, float range_squared) const
+{
+	// The farthest point of the region is the corner opposite the query point.
+	float dx = std::max(point.x - static_cast<float>(region_.min_corner().x()), static_cast<float>(region_.max_corner().x()) - point.x);
+	float dy = std::max(point.y - static_cast<float>(region_.min_corner().y()), static_cast<float>(region_.max_corner().y()) - point.y);
+	return dx * dx + dy * dy <= range_squared;
 }
 
 } // namespace quadtree
\ No newline at end of file
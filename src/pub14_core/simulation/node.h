@@ -4,6 +4,7 @@
 #ifndef NODE_H_
 #define NODE_H_
 
+#include <algorithm>
 #include <vector>
 #include <memory>
 
@@ -64,6 +65,30 @@ public:
 	void Split();
 	std::vector<std::shared_ptr<swganh::object::Object>> Query(QueryBox query_box);
 
+	/**
+	 * Calls visitor with each object whose position lies within the box, edges included.
+	 *
+	 * Nothing is allocated and the objects are passed by reference, so visiting does not
+	 * touch their reference counts.
+	 */
+	template<typename Visitor>
+	void VisitObjectsInBox(const QueryBox& query_box, Visitor&& visitor);
+
+	/**
+	 * Calls visitor with each object within range of point, measured on the x/z plane.
+	 *
+	 * Nothing is allocated and the objects are passed by reference, so visiting does not
+	 * touch their reference counts.
+	 */
+	template<typename Visitor>
+	void VisitObjectsInRange(const glm::vec2& point, float range, Visitor&& visitor);
+
+	/**
+	 * Calls visitor with each object in this node and its children.
+	 */
+	template<typename Visitor>
+	void VisitContainedObjects(Visitor&& visitor);
+
 	const NodeQuadrant& GetQuadrant(void) { return quadrant_; }
 	const uint32_t& GetLevel(void) { return level_; }
 	const NodeState& GetState(void) { return state_; }
@@ -73,9 +98,15 @@ public:
 	const std::vector<std::shared_ptr<swganh::object::Object>> GetContainedObjects(void);
 
 protected:
-	void InsertObject_(std::shared_ptr<swganh::object::Object> obj);
-	void RemoveObject_(std::shared_ptr<swganh::object::Object> obj);
-	std::shared_ptr<Node> GetNodeWithinPoint_(Point point);
+	void InsertObject_(std::shared_ptr<swganh::object::Object> obj, const glm::vec2& position);
+	void RemoveObjectAt_(size_t index);
+	Node* GetNodeWithinPoint_(Point point);
+
+	/// The squared distance from point to the closest point of this node's region.
+	float DistanceSquaredToRegion_(const glm::vec2& point) const;
+
+	/// True if every point of this node's region is within range of point.
+	bool RegionWithinRange_(const glm::vec2& point, float range_squared) const;
 	
 	Node* GetRootNode_(void) { 	
 		// Go to the root.
@@ -92,10 +123,99 @@ private:
 	uint32_t max_level_;
 	NodeState state_;
 	std::vector<std::shared_ptr<swganh::object::Object>> objects_;
+	// The x/z position each object was indexed at, kept alongside objects_ so queries
+	// neither lock the objects nor chase their pointers to test positions.
+	std::vector<glm::vec2> object_positions_;
 	boost::array<std::shared_ptr<Node>, 4> leaf_nodes_;
 	Node* parent_;
 };
 
+template<typename Visitor>
+void Node::VisitObjectsInBox(const QueryBox& query_box, Visitor&& visitor)
+{
+	float min_x = static_cast<float>(query_box.min_corner().x());
+	float min_y = static_cast<float>(query_box.min_corner().y());
+	float max_x = static_cast<float>(query_box.max_corner().x());
+	float max_y = static_cast<float>(query_box.max_corner().y());
+
+	for(size_t i = 0; i < objects_.size(); ++i)
+	{
+		const glm::vec2& position = object_positions_[i];
+
+		if(position.x >= min_x && position.x <= max_x && position.y >= min_y && position.y <= max_y)
+			visitor(objects_[i]);
+	}
+
+	if(state_ == BRANCH)
+	{
+		for(const std::shared_ptr<Node>& node : leaf_nodes_)
+		{
+			const Region& region = node->region_;
+
+			// Skip nodes the box does not overlap.
+			if(region.min_corner().x() > max_x || region.max_corner().x() < min_x ||
+				region.min_corner().y() > max_y || region.max_corner().y() < min_y)
+				continue;
+
+			// Node is within Query Box.
+			if(region.min_corner().x() >= min_x && region.max_corner().x() <= max_x &&
+				region.min_corner().y() >= min_y && region.max_corner().y() <= max_y)
+			{
+				node->VisitContainedObjects(visitor);
+				continue;
+			}
+
+			node->VisitObjectsInBox(query_box, visitor);
+		}
+	}
+}
+
+template<typename Visitor>
+void Node::VisitObjectsInRange(const glm::vec2& point, float range, Visitor&& visitor)
+{
+	float range_squared = range * range;
+
+	for(size_t i = 0; i < objects_.size(); ++i)
+	{
+		glm::vec2 offset = object_positions_[i] - point;
+
+		if(offset.x * offset.x + offset.y * offset.y <= range_squared)
+			visitor(objects_[i]);
+	}
+
+	if(state_ == BRANCH)
+	{
+		for(const std::shared_ptr<Node>& node : leaf_nodes_)
+		{
+			// Skip nodes whose closest point is out of range.
+			if(node->DistanceSquaredToRegion_(point) > range_squared)
+				continue;
+
+			// Node is within range.
+			if(node->RegionWithinRange_(point, range_squared))
+			{
+				node->VisitContainedObjects(visitor);
+				continue;
+			}
+
+			node->VisitObjectsInRange(point, range, visitor);
+		}
+	}
+}
+
+template<typename Visitor>
+void Node::VisitContainedObjects(Visitor&& visitor)
+{
+	for(const std::shared_ptr<swganh::object::Object>& object : objects_)
+		visitor(object);
+
+	if(state_ == BRANCH)
+	{
+		for(const std::shared_ptr<Node>& node : leaf_nodes_)
+			node->VisitContainedObjects(visitor);
+	}
+}
+
 } // namespace quadtree
 
 #endif // NODE_H_
\ No newline at end of file
@@ -128,6 +128,106 @@ BOOST_AUTO_TEST_CASE(CanUpdateObject)
 	root_node_.RemoveObject(obj);
 }
 
+///
+BOOST_AUTO_TEST_CASE(RangeQueryFiltersByDistance)
+{
+	std::shared_ptr<swganh::object::Object> inside(new swganh::object::Object()), corner(new swganh::object::Object());
+	inside->SetEventDispatcher(&event_dispatcher_);
+	corner->SetEventDispatcher(&event_dispatcher_);
+	inside->SetObjectId(1);
+	corner->SetObjectId(2);
+
+	// Both are within the square bounding the circle, only one is within the circle.
+	inside->SetPosition(glm::vec3(105.0f, 0.0f, 95.0f));
+	corner->SetPosition(glm::vec3(108.0f, 0.0f, 108.0f));
+
+	root_node_.InsertObject(inside);
+	root_node_.InsertObject(corner);
+
+	std::vector<uint64_t> found;
+	root_node_.VisitObjectsInRange(glm::vec2(100.0f, 100.0f), 10.0f, [&found](const std::shared_ptr<swganh::object::Object>& obj) {
+		found.push_back(obj->GetObjectId());
+	});
+
+	BOOST_REQUIRE_EQUAL(1, found.size());
+	BOOST_CHECK_EQUAL(1, found[0]);
+
+	BOOST_CHECK_EQUAL(2, root_node_.Query(QueryBox(Point(90.0f, 90.0f), Point(110.0f, 110.0f))).size());
+
+	root_node_.RemoveObject(inside);
+	root_node_.RemoveObject(corner);
+}
+
+///
+BOOST_AUTO_TEST_CASE(QueriesUseUpdatedPosition)
+{
+	std::shared_ptr<swganh::object::Object> obj(new swganh::object::Object());
+	obj->SetEventDispatcher(&event_dispatcher_);
+	obj->SetPosition(glm::vec3(10.0f, 0.0f, 10.0f));
+
+	root_node_.InsertObject(obj);
+
+	// Move far enough to change nodes before the object's own position is updated.
+	glm::vec3 new_position(-500.0f, 0.0f, 400.0f);
+	root_node_.UpdateObject(obj, obj->GetPosition(), new_position);
+	obj->SetPosition(new_position);
+
+	size_t count = 0;
+	auto counter = [&count](const std::shared_ptr<swganh::object::Object>&) { ++count; };
+
+	root_node_.VisitObjectsInRange(glm::vec2(10.0f, 10.0f), 5.0f, counter);
+	BOOST_CHECK_EQUAL(0, count);
+
+	root_node_.VisitObjectsInRange(glm::vec2(-500.0f, 400.0f), 5.0f, counter);
+	BOOST_CHECK_EQUAL(1, count);
+
+	root_node_.RemoveObject(obj);
+	BOOST_CHECK_EQUAL(0, root_node_.GetContainedObjects().size());
+}
+
+///
+BOOST_AUTO_TEST_CASE(RangeQueryMatchesBruteForce)
+{
+	std::vector<std::shared_ptr<swganh::object::Object>> objects;
+	boost::random::mt19937 gen;
+	boost::random::uniform_real_distribution<> random_generator(-3000.0f, 3000.0f);
+
+	for(int i = 0; i < 5000; i++)
+	{
+		objects.push_back(std::make_shared<swganh::object::Object>());
+		objects[i]->SetEventDispatcher(&event_dispatcher_);
+		objects[i]->SetObjectId(i);
+		objects[i]->SetPosition(glm::vec3(random_generator(gen), 0.0f, random_generator(gen)));
+		root_node_.InsertObject(objects[i]);
+	}
+
+	const float ranges[] = {16.0f, 128.0f, 1024.0f};
+	for(int q = 0; q < 30; q++)
+	{
+		glm::vec2 center(random_generator(gen), random_generator(gen));
+		float range = ranges[q % 3];
+
+		size_t expected = 0;
+		for(auto& obj : objects)
+		{
+			glm::vec3 position = obj->GetPosition();
+			float dx = position.x - center.x, dz = position.z - center.y;
+			if(dx * dx + dz * dz <= range * range)
+				++expected;
+		}
+
+		size_t found = 0;
+		root_node_.VisitObjectsInRange(center, range, [&found](const std::shared_ptr<swganh::object::Object>&) { ++found; });
+
+		BOOST_CHECK_EQUAL(expected, found);
+	}
+
+	for(int i = 0; i < 5000; i++)
+	{
+		root_node_.RemoveObject(objects[i]);
+	}
+}
+
 ///
 BOOST_AUTO_TEST_CASE(CanInsertRemoveQueryOneThousand)
 {
@@ -9,6 +9,7 @@ using std::shared_ptr;
 
 using anh::app::KernelInterface;
 using swganh::object::Object;
+using swganh::simulation::ObjectVisitor;
 using namespace quadtree;
 
 QuadtreeSpatialProvider::QuadtreeSpatialProvider(anh::app::KernelInterface* kernel)
@@ -39,5 +40,32 @@ void QuadtreeSpatialProvider::UpdateObject(shared_ptr<Object> obj, glm::vec3 old
 
 std::vector<std::shared_ptr<swganh::object::Object>> QuadtreeSpatialProvider::GetObjectsInRange(glm::vec3 point, float range)
 {
-	return std::vector<shared_ptr<Object>>();
+	std::vector<shared_ptr<Object>> objects;
+
+	root_node_.VisitObjectsInRange(glm::vec2(point.x, point.z), range, [&objects](const shared_ptr<Object>& obj) {
+		objects.push_back(obj);
+	});
+
+	return objects;
+}
+
+std::vector<std::shared_ptr<swganh::object::Object>> QuadtreeSpatialProvider::GetObjectsInBox(glm::vec3 min, glm::vec3 max)
+{
+	std::vector<shared_ptr<Object>> objects;
+
+	root_node_.VisitObjectsInBox(QueryBox(Point(min.x, min.z), Point(max.x, max.z)), [&objects](const shared_ptr<Object>& obj) {
+		objects.push_back(obj);
+	});
+
+	return objects;
+}
+
+void QuadtreeSpatialProvider::VisitObjectsInRange(glm::vec3 point, float range, const ObjectVisitor& visitor)
+{
+	root_node_.VisitObjectsInRange(glm::vec2(point.x, point.z), range, visitor);
+}
+
+void QuadtreeSpatialProvider::VisitObjectsInBox(glm::vec3 min, glm::vec3 max, const ObjectVisitor& visitor)
+{
+	root_node_.VisitObjectsInBox(QueryBox(Point(min.x, min.z), Point(max.x, max.z)), visitor);
 }
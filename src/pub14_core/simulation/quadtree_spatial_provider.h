@@ -18,6 +18,10 @@ public:
 	virtual void UpdateObject(std::shared_ptr<swganh::object::Object> obj, glm::vec3 old_position, glm::vec3 new_position);
 
 	virtual std::vector<std::shared_ptr<swganh::object::Object>> GetObjectsInRange(glm::vec3 point, float range);
+	virtual std::vector<std::shared_ptr<swganh::object::Object>> GetObjectsInBox(glm::vec3 min, glm::vec3 max);
+
+	virtual void VisitObjectsInRange(glm::vec3 point, float range, const swganh::simulation::ObjectVisitor& visitor);
+	virtual void VisitObjectsInBox(glm::vec3 min, glm::vec3 max, const swganh::simulation::ObjectVisitor& visitor);
 
 private:
 	quadtree::Node root_node_;
@@ -49,6 +49,20 @@ using namespace swganh::combat;
 using namespace swganh::simulation;
 using namespace swganh::galaxy;
 
+namespace {
+
+    anh::database::PoolOptions MakePoolOptions(const AppConfig::DatabaseConfig& db_config)
+    {
+        anh::database::PoolOptions pool_options;
+        pool_options.min_connections = db_config.min_connections;
+        pool_options.max_connections = db_config.max_connections;
+        pool_options.checkout_timeout_ms = db_config.checkout_timeout_ms;
+
+        return pool_options;
+    }
+
+}  // namespace
+
 options_description AppConfig::BuildConfigDescription() {
     options_description desc;
 
@@ -80,6 +94,12 @@ options_description AppConfig::BuildConfigDescription() {
             "Username for authentication with the galaxy_manager datastore")
         ("db.galaxy_manager.password", boost::program_options::value<std::string>(&galaxy_manager_db.password),
             "Password for authentication with the galaxy_manager datastore")
+        ("db.galaxy_manager.min_connections", boost::program_options::value<uint32_t>(&galaxy_manager_db.min_connections)->default_value(1),
+            "Connections to the galaxy_manager datastore opened at startup")
+        ("db.galaxy_manager.max_connections", boost::program_options::value<uint32_t>(&galaxy_manager_db.max_connections)->default_value(8),
+            "Most connections to the galaxy_manager datastore open at once")
+        ("db.galaxy_manager.checkout_timeout_ms", boost::program_options::value<uint32_t>(&galaxy_manager_db.checkout_timeout_ms)->default_value(5000),
+            "Longest a request waits for a free connection to the galaxy_manager datastore")
 
         ("db.galaxy.host", boost::program_options::value<std::string>(&galaxy_db.host),
             "Host address for the galaxy datastore")
@@ -89,6 +109,14 @@ options_description AppConfig::BuildConfigDescription() {
             "Username for authentication with the galaxy datastore")
         ("db.galaxy.password", boost::program_options::value<std::string>(&galaxy_db.password),
             "Password for authentication with the galaxy datastore")
+        ("db.galaxy.min_connections", boost::program_options::value<uint32_t>(&galaxy_db.min_connections)->default_value(1),
+            "Connections to the galaxy datastore opened at startup")
+        ("db.galaxy.max_connections", boost::program_options::value<uint32_t>(&galaxy_db.max_connections)->default_value(8),
+            "Most connections to the galaxy datastore open at once")
+        ("db.galaxy.checkout_timeout_ms", boost::program_options::value<uint32_t>(&galaxy_db.checkout_timeout_ms)->default_value(5000),
+            "Longest a request waits for a free connection to the galaxy datastore")
+        ("db.threads", boost::program_options::value<uint32_t>(&db_threads)->default_value(2),
+            "Number of threads running queries submitted to the database manager")
             
         ("service.login.udp_port", 
             boost::program_options::value<uint16_t>(&login_config.listen_port),
@@ -105,6 +133,24 @@ options_description AppConfig::BuildConfigDescription() {
         ("service.login.auto_registration",
             boost::program_options::value<bool>(&login_config.login_auto_registration)->default_value(false),
             "Auto Registration flag")
+        ("service.login.batched_io",
+            boost::program_options::value<bool>(&login_config.batched_io)->default_value(false),
+            "Use batched datagram I/O (recvmmsg/sendmmsg) for the login service socket")
+        ("service.login.socket_shards",
+            boost::program_options::value<uint32_t>(&login_config.socket_shards)->default_value(1),
+            "Number of SO_REUSEPORT sockets, each with its own receive thread, the login service listens with")
+        ("service.login.send_window",
+            boost::program_options::value<uint32_t>(&login_config.send_window)->default_value(128),
+            "Maximum number of unacknowledged reliable packets in flight per login session")
+        ("service.login.flush_latency_ms",
+            boost::program_options::value<uint32_t>(&login_config.flush_latency_ms)->default_value(0),
+            "Longest a login session holds outgoing messages to batch them, 0 flushes as soon as possible")
+        ("service.login.flush_batch_size",
+            boost::program_options::value<uint32_t>(&login_config.flush_batch_size)->default_value(64),
+            "Number of queued outgoing messages that flushes a login session immediately")
+        ("service.login.compression_level",
+            boost::program_options::value<int>(&login_config.compression_level)->default_value(6),
+            "zlib level for compressing large outgoing login packets, 0 disables compression and 9 is smallest")
             
         ("service.connection.ping_port", boost::program_options::value<uint16_t>(&connection_config.ping_port),
             "The port the connection service will listen for incoming client ping requests on")
@@ -112,6 +158,46 @@ options_description AppConfig::BuildConfigDescription() {
             "The port the connection service will listen for incoming client connections on")
         ("service.connection.address", boost::program_options::value<string>(&connection_config.listen_address),
             "The public address the connection service will listen for incoming client connections on")
+        ("service.connection.batched_io",
+            boost::program_options::value<bool>(&connection_config.batched_io)->default_value(false),
+            "Use batched datagram I/O (recvmmsg/sendmmsg) for the connection service socket")
+        ("service.connection.socket_shards",
+            boost::program_options::value<uint32_t>(&connection_config.socket_shards)->default_value(1),
+            "Number of SO_REUSEPORT sockets, each with its own receive thread, the connection service listens with")
+        ("service.connection.send_window",
+            boost::program_options::value<uint32_t>(&connection_config.send_window)->default_value(128),
+            "Maximum number of unacknowledged reliable packets in flight per connection session")
+        ("service.connection.flush_latency_ms",
+            boost::program_options::value<uint32_t>(&connection_config.flush_latency_ms)->default_value(0),
+            "Longest a connection session holds outgoing messages to batch them, 0 flushes as soon as possible")
+        ("service.connection.flush_batch_size",
+            boost::program_options::value<uint32_t>(&connection_config.flush_batch_size)->default_value(64),
+            "Number of queued outgoing messages that flushes a connection session immediately")
+        ("service.connection.compression_level",
+            boost::program_options::value<int>(&connection_config.compression_level)->default_value(6),
+            "zlib level for compressing large outgoing connection packets, 0 disables compression and 9 is smallest")
+
+        ("service.simulation.replication_interval_ms",
+            boost::program_options::value<uint32_t>(&simulation_config.replication_interval_ms)->default_value(50),
+            "Length of the replication tick that merges object deltas into one message per view, 0 sends every delta immediately")
+        ("service.simulation.tick_interval_ms",
+            boost::program_options::value<uint32_t>(&simulation_config.tick_interval_ms)->default_value(50),
+            "Length of a scene's simulation tick, each scene ticks on a thread of its own")
+        ("service.simulation.pin_scene_threads",
+            boost::program_options::value<bool>(&simulation_config.pin_scene_threads)->default_value(false),
+            "Pin each scene's tick thread to a core of its own")
+        ("service.simulation.scene",
+            boost::program_options::value<std::vector<std::string>>(&simulation_config.scenes)->default_value(std::vector<std::string>(1, "corellia"), "corellia"),
+            "Label of a scene to start, may be given once for every scene")
+        ("service.simulation.persistence_threads",
+            boost::program_options::value<uint32_t>(&simulation_config.persistence_threads)->default_value(2),
+            "Number of threads writing saved objects to the database")
+        ("service.simulation.persistence_batch_size",
+            boost::program_options::value<uint32_t>(&simulation_config.persistence_batch_size)->default_value(64),
+            "Most saved objects a persistence thread writes in one go")
+        ("service.simulation.persistence_max_pending",
+            boost::program_options::value<uint32_t>(&simulation_config.persistence_max_pending)->default_value(4096),
+            "Most saved objects waiting on a persistence thread before saving blocks the caller")
     ;
 
     return desc;
@@ -141,14 +227,16 @@ void SwganhApp::Initialize(int argc, char* argv[]) {
         app_config.galaxy_manager_db.schema,
         app_config.galaxy_manager_db.host,
         app_config.galaxy_manager_db.username,
-        app_config.galaxy_manager_db.password);
+        app_config.galaxy_manager_db.password,
+        MakePoolOptions(app_config.galaxy_manager_db));
 
     kernel_->GetDatabaseManager()->registerStorageType(
         "galaxy",
         app_config.galaxy_db.schema,
         app_config.galaxy_db.host,
         app_config.galaxy_db.username,
-        app_config.galaxy_db.password);
+        app_config.galaxy_db.password,
+        MakePoolOptions(app_config.galaxy_db));
     
     CleanupServices_();
 
@@ -287,6 +375,12 @@ void SwganhApp::LoadCoreServices_()
 		login_service->galaxy_status_check_duration_secs(app_config.login_config.galaxy_status_check_duration_secs);
 		login_service->login_error_timeout_secs(app_config.login_config.login_error_timeout_secs);
         login_service->login_auto_registration(app_config.login_config.login_auto_registration);
+        login_service->batched_io(app_config.login_config.batched_io);
+        login_service->socket_shards(app_config.login_config.socket_shards);
+        login_service->send_window(app_config.login_config.send_window);
+        login_service->max_flush_latency(boost::posix_time::milliseconds(app_config.login_config.flush_latency_ms));
+        login_service->max_flush_batch_size(app_config.login_config.flush_batch_size);
+        login_service->compression_level(app_config.login_config.compression_level);
     
 		kernel_->GetServiceManager()->AddService("LoginService", move(login_service));
 	} 
@@ -298,6 +392,13 @@ void SwganhApp::LoadCoreServices_()
 			app_config.connection_config.ping_port, 
 			kernel_.get()));
 
+        connection_service->batched_io(app_config.connection_config.batched_io);
+        connection_service->socket_shards(app_config.connection_config.socket_shards);
+        connection_service->send_window(app_config.connection_config.send_window);
+        connection_service->max_flush_latency(boost::posix_time::milliseconds(app_config.connection_config.flush_latency_ms));
+        connection_service->max_flush_batch_size(app_config.connection_config.flush_batch_size);
+        connection_service->compression_level(app_config.connection_config.compression_level);
+
 		kernel_->GetServiceManager()->AddService("ConnectionService", move(connection_service));
 	}
 	if(strcmp("simulation", app_config.server_mode.c_str()) == 0 || strcmp("all", app_config.server_mode.c_str()) == 0)
@@ -333,7 +434,10 @@ void SwganhApp::LoadCoreServices_()
             unique_ptr<ChatService>(new ChatService(kernel_.get())));
 
 		unique_ptr<SimulationService> simulation_service(new SimulationService(kernel_.get()));
-		simulation_service->StartScene("corellia");
+		for (const auto& scene_label : kernel_->GetAppConfig().simulation_config.scenes)
+		{
+			simulation_service->StartScene(scene_label);
+		}
 
 		kernel_->GetServiceManager()->AddService("SimulationService", move(simulation_service));
 
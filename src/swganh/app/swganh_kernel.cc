@@ -53,7 +53,7 @@ AppConfig& SwganhKernel::GetAppConfig() {
 
 DatabaseManagerInterface* SwganhKernel::GetDatabaseManager() {
     if (!database_manager_) {
-        database_manager_.reset(new DatabaseManager(sql::mysql::get_driver_instance()));
+        database_manager_.reset(new DatabaseManager(sql::mysql::get_driver_instance(), app_config_.db_threads));
     }
 
     return database_manager_.get();
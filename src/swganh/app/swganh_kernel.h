@@ -41,8 +41,13 @@ struct AppConfig {
         std::string schema;
         std::string username;
         std::string password;
+        uint32_t min_connections;
+        uint32_t max_connections;
+        uint32_t checkout_timeout_ms;
     } galaxy_manager_db, galaxy_db;
 
+    uint32_t db_threads;
+
     /*!
     * @Brief Contains information about the Login config"
      */
@@ -52,6 +57,12 @@ struct AppConfig {
         int galaxy_status_check_duration_secs;
         int login_error_timeout_secs;
         bool login_auto_registration;
+        bool batched_io;
+        uint32_t socket_shards;
+        uint32_t send_window;
+        uint32_t flush_latency_ms;
+        uint32_t flush_batch_size;
+        int compression_level;
     } login_config;
     /*!
     * @Brief Contains information about the app config"
@@ -60,8 +71,24 @@ struct AppConfig {
         std::string listen_address;
         uint16_t listen_port;
         uint16_t ping_port;
+        bool batched_io;
+        uint32_t socket_shards;
+        uint32_t send_window;
+        uint32_t flush_latency_ms;
+        uint32_t flush_batch_size;
+        int compression_level;
     } connection_config;
 
+    struct SimulationConfig {
+        uint32_t replication_interval_ms;
+        uint32_t tick_interval_ms;
+        bool pin_scene_threads;
+        std::vector<std::string> scenes;
+        uint32_t persistence_threads;
+        uint32_t persistence_batch_size;
+        uint32_t persistence_max_pending;
+    } simulation_config;
+
     boost::program_options::options_description BuildConfigDescription();
 };
     
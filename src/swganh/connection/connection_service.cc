@@ -54,7 +54,6 @@ ConnectionService::ConnectionService(
     : swganh::network::BaseSwgServer(kernel->GetIoService())
     , kernel_(kernel)
     , ping_server_(nullptr)
-    , active_(kernel->GetIoService())
     , listen_address_(listen_address)
     , listen_port_(listen_port)
     , ping_port_(ping_port)
@@ -91,17 +90,6 @@ void ConnectionService::Start() {
     RegisterMessageHandler(&ConnectionService::HandleCmdSceneReady_, this);
 
     Server::Start(listen_port_);
-
-    active_.AsyncRepeated(boost::posix_time::milliseconds(5), [this] () {
-        boost::lock_guard<boost::mutex> lg(session_map_mutex_);
-        for_each(
-            begin(session_map_),
-            end(session_map_),
-            [=] (SessionMap::value_type& type)
-        {
-            type.second->Update();
-        });
-    });
 }
 
 void ConnectionService::Stop() {
@@ -118,25 +106,12 @@ uint16_t ConnectionService::listen_port() {
 
 shared_ptr<Session> ConnectionService::CreateSession(const udp::endpoint& endpoint)
 {
-    shared_ptr<ConnectionClient> session = nullptr;
-
-    {
-        boost::lock_guard<boost::mutex> lg(session_map_mutex_);
-        if (session_map_.find(endpoint) == session_map_.end())
-        {
-            session = make_shared<ConnectionClient>(this, kernel_->GetIoService(), endpoint);
-            session_map_.insert(make_pair(endpoint, session));
-        }
-    }
-
-    return session;
+    // If another thread registered the endpoint first its session is returned instead.
+    return session_map_.Insert(endpoint, make_shared<ConnectionClient>(this, kernel_->GetIoService(), endpoint));
 }
 
 bool ConnectionService::RemoveSession(std::shared_ptr<Session> session) {
-    {
-        boost::lock_guard<boost::mutex> lg(session_map_mutex_);
-        session_map_.erase(session->remote_endpoint());
-    }
+    session_map_.Erase(session->remote_endpoint());
 
     auto connection_client = static_pointer_cast<ConnectionClient>(session);
 
@@ -162,14 +137,10 @@ bool ConnectionService::RemoveSession(std::shared_ptr<Session> session) {
 }
 
 shared_ptr<Session> ConnectionService::GetSession(const udp::endpoint& endpoint) {
+    auto session = session_map_.Find(endpoint);
+    if (session)
     {
-        boost::lock_guard<boost::mutex> lg(session_map_mutex_);
-
-        auto find_iter = session_map_.find(endpoint);
-        if (find_iter != session_map_.end())
-        {
-            return find_iter->second;
-        }
+        return session;
     }
 
     return CreateSession(endpoint);
@@ -177,26 +148,10 @@ shared_ptr<Session> ConnectionService::GetSession(const udp::endpoint& endpoint)
 
 std::shared_ptr<ConnectionClient> ConnectionService::FindConnectionByPlayerId(uint64_t player_id)
 {
-    shared_ptr<ConnectionClient> connection = nullptr;
-
+    return session_map_.FindIf([player_id] (const shared_ptr<ConnectionClient>& client)
     {
-        boost::lock_guard<boost::mutex> lg(session_map_mutex_);
-
-        auto find_iter = find_if(
-            begin(session_map_),
-            end(session_map_),
-            [player_id] (SessionMap::value_type& item)
-        {
-            return item.second->GetPlayerId() == player_id;
-        });
-
-        if (find_iter != end(session_map_))
-        {
-            connection = find_iter->second;
-        }
-    }
-
-    return connection;
+        return client->GetPlayerId() == player_id;
+    });
 }
 
 void ConnectionService::RemoveClientTimerHandler_(
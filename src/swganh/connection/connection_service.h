@@ -11,11 +11,11 @@
 
 #include <boost/thread/mutex.hpp>
 
-#include "anh/active_object.h"
 #include "anh/hash_string.h"
 
 #include "anh/network/soe/packet_utilities.h"
 #include "anh/network/soe/session.h"
+#include "anh/network/soe/session_table.h"
 #include "anh/service/service_interface.h"
 
 #include "swganh/network/base_swg_server.h"
@@ -91,12 +91,8 @@ private:
         const std::shared_ptr<ConnectionClient>& client, 
         swganh::messages::CmdSceneReady message);
    
-    typedef std::map<
-        boost::asio::ip::udp::endpoint,
-        std::shared_ptr<ConnectionClient>
-    > SessionMap;
+    typedef anh::network::soe::SessionTable<ConnectionClient> SessionMap;
     
-    boost::mutex session_map_mutex_;
     SessionMap session_map_;
 
     swganh::app::SwganhKernel* kernel_;
@@ -109,7 +105,6 @@ private:
     swganh::login::LoginService* login_service_;
     swganh::simulation::SimulationService* simulation_service_;
 
-    anh::ActiveObject active_;
     std::string listen_address_;
     uint16_t listen_port_;
     uint16_t ping_port_;
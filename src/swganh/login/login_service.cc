@@ -53,7 +53,6 @@ LoginService::LoginService(string listen_address, uint16_t listen_port, SwganhKe
     , galaxy_status_timer_(kernel->GetIoService())
     , listen_address_(listen_address)
     , listen_port_(listen_port)
-    , active_(kernel->GetIoService())
 {
     account_provider_ = kernel->GetPluginManager()->CreateObject<providers::AccountProviderInterface>("LoginService::AccountProvider");
     
@@ -83,38 +82,21 @@ service::ServiceDescription LoginService::GetServiceDescription() {
 
 shared_ptr<Session> LoginService::CreateSession(const udp::endpoint& endpoint)
 {
-    shared_ptr<LoginClient> session = nullptr;
-
-    {
-        boost::lock_guard<boost::mutex> lg(session_map_mutex_);
-        if (session_map_.find(endpoint) == session_map_.end())
-        {
-            session = make_shared<LoginClient>(this, kernel_->GetIoService(), endpoint);
-            session_map_.insert(make_pair(endpoint, session));
-        }
-    }
-
-    return session;
+    // If another thread registered the endpoint first its session is returned instead.
+    return session_map_.Insert(endpoint, make_shared<LoginClient>(this, kernel_->GetIoService(), endpoint));
 }
 
 bool LoginService::RemoveSession(std::shared_ptr<Session> session) {
-    {
-        boost::lock_guard<boost::mutex> lg(session_map_mutex_);
-        session_map_.erase(session->remote_endpoint());
-    }
+    session_map_.Erase(session->remote_endpoint());
 
     return true;
 }
 
 shared_ptr<Session> LoginService::GetSession(const udp::endpoint& endpoint) {
+    auto session = session_map_.Find(endpoint);
+    if (session)
     {
-        boost::lock_guard<boost::mutex> lg(session_map_mutex_);
-
-        auto find_iter = session_map_.find(endpoint);
-        if (find_iter != session_map_.end())
-        {
-            return find_iter->second;
-        }
+        return session;
     }
 
     return CreateSession(endpoint);
@@ -138,17 +120,6 @@ void LoginService::Start() {
     Server::Start(listen_port_);
 
     UpdateGalaxyStatus_();
-
-    active_.AsyncRepeated(boost::posix_time::milliseconds(5), [this] () {
-        boost::lock_guard<boost::mutex> lg(session_map_mutex_);
-        for_each(
-            begin(session_map_),
-            end(session_map_),
-            [=] (SessionMap::value_type& type)
-        {
-            type.second->Update();
-        });
-    });
 }
 
 void LoginService::Stop()
@@ -195,14 +166,10 @@ void LoginService::UpdateGalaxyStatus_() {
 
     auto status_message = BuildLoginClusterStatus(galaxy_status_);
 
-    boost::lock_guard<boost::mutex> lg(session_map_mutex_);
-    std::for_each(
-        begin(session_map_),
-        end(session_map_),
-        [&status_message] (SessionMap::value_type& item)
+    session_map_.ForEach([&status_message] (const shared_ptr<LoginClient>& session)
     {
-        if (item.second) {
-            item.second->SendTo(status_message);
+        if (session) {
+            session->SendTo(status_message);
         }
     });
 }
@@ -9,11 +9,11 @@
 #include <boost/asio.hpp>
 #include <boost/thread/mutex.hpp>
 
-#include "anh/active_object.h"
 #include "anh/logger.h"
 
 #include "anh/network/soe/packet_utilities.h"
 #include "anh/network/soe/server.h"
+#include "anh/network/soe/session_table.h"
 #include "anh/service/service_interface.h"
 
 #include "swganh/network/base_swg_server.h"
@@ -97,12 +97,8 @@ private:
     std::vector<GalaxyStatus> GetGalaxyStatus_();
     void UpdateGalaxyStatus_();
     
-    typedef std::map<
-        boost::asio::ip::udp::endpoint,
-        std::shared_ptr<LoginClient>
-    > SessionMap;
+    typedef anh::network::soe::SessionTable<LoginClient> SessionMap;
     
-    boost::mutex session_map_mutex_;
     SessionMap session_map_;
 
     swganh::app::SwganhKernel* kernel_;
@@ -122,7 +118,6 @@ private:
     
     std::string listen_address_;
     uint16_t listen_port_;
-    anh::ActiveObject active_;
 };
 
 }} // namespace swganh::login
@@ -4,7 +4,11 @@
 #ifndef SWGANH_MESSAGES_DELTAS_MESSAGE_H_
 #define SWGANH_MESSAGES_DELTAS_MESSAGE_H_
 
+#include <algorithm>
 #include <cstdint>
+#include <limits>
+#include <vector>
+
 #include "anh/byte_buffer.h"
 #include "base_deltas_message.h"
 
@@ -17,6 +21,47 @@ namespace messages {
         static uint16_t Opcount() { return 5; }
         static uint32_t Opcode() { return 0x12862153; }
     };
+
+    /**
+     * Merges a sequence of deltas for one object into a single message per view.
+     *
+     * A deltas message carries its first update type in the header and every further
+     * update as a type followed by its data, so merging appends each later message as
+     * one more update. Updates keep their original order within a view and none are
+     * dropped, which leaves the client with the same state as applying the inputs
+     * one at a time. A view only spills into a second message if its update count
+     * would overflow.
+     *
+     * @param deltas The deltas to merge, in the order they were generated.
+     * @return The merged deltas, ordered by the first appearance of each view.
+     */
+    inline std::vector<DeltasMessage> CoalesceDeltas(const std::vector<DeltasMessage>& deltas)
+    {
+        std::vector<DeltasMessage> merged;
+
+        for (const auto& message : deltas)
+        {
+            // Objects only have a handful of views, find the newest message for this one.
+            auto target = std::find_if(merged.rbegin(), merged.rend(),
+                [&message] (const DeltasMessage& candidate)
+            {
+                return candidate.view_type == message.view_type;
+            });
+
+            if (target == merged.rend() ||
+                target->update_count + message.update_count > std::numeric_limits<uint16_t>::max())
+            {
+                merged.push_back(message);
+                continue;
+            }
+
+            target->update_count += message.update_count;
+            target->data.write<uint16_t>(message.update_type);
+            target->data.write(message.data.data(), message.data.size());
+        }
+
+        return merged;
+    }
     
 }}  // namespace swganh::messages
 
@@ -19,6 +19,9 @@ namespace messages {
         static uint16_t Opcount() { return 5; }
         static uint32_t Opcode() { return 0x80CE5E46; }
 
+        /// Where observable_id starts in the serialized message, after the header, controller_type and message_type.
+        static size_t ObservableIdOffset() { return 14; }
+
         ObjControllerMessage()
         {}
 
@@ -17,9 +17,6 @@ bool BuildingFactory::HasTemplate(const string& template_name)
     return false;
 }
 
-void BuildingFactory::PersistObject(const shared_ptr<Object>& object)
-{}
-
 void BuildingFactory::DeleteObjectFromStorage(const shared_ptr<Object>& object)
 {}
 
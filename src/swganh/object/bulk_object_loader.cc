@@ -0,0 +1,268 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include "swganh/object/bulk_object_loader.h"
+
+#include <sstream>
+#include <unordered_map>
+
+#include <cppconn/exception.h>
+#include <cppconn/connection.h>
+#include <cppconn/resultset.h>
+#include <cppconn/statement.h>
+#include <cppconn/sqlstring.h>
+#include "anh/logger.h"
+
+#include "anh/database/database_manager.h"
+#include "swganh/object/object.h"
+#include "swganh/object/object_factory.h"
+#include "swganh/object/object_manager.h"
+#include "swganh/object/creature/creature.h"
+#include "swganh/object/creature/creature_factory.h"
+#include "swganh/object/intangible/intangible.h"
+#include "swganh/object/intangible/intangible_factory.h"
+#include "swganh/object/tangible/tangible.h"
+#include "swganh/object/tangible/tangible_factory.h"
+
+using namespace std;
+using namespace anh::database;
+using namespace swganh::object;
+using namespace swganh::object::creature;
+using namespace swganh::object::intangible;
+using namespace swganh::object::tangible;
+
+namespace {
+
+    struct TreeEntry
+    {
+        uint64_t object_id;
+        uint64_t parent_id;
+        uint32_t type;
+        shared_ptr<Object> object;
+    };
+
+    /// Creates the types that are built from the tree's rows, nullptr for the rest.
+    shared_ptr<Object> CreateInstance(uint32_t type)
+    {
+        switch (type)
+        {
+        case Creature::type:
+            return make_shared<Creature>();
+        case Tangible::type:
+            return make_shared<Tangible>();
+        case Intangible::type:
+            return make_shared<Intangible>();
+        default:
+            return nullptr;
+        }
+    }
+
+    /// @return The object built from the tree's rows with the given id, if it is of the given type.
+    template<typename T>
+    shared_ptr<T> FindBuilt(const unordered_map<uint64_t, shared_ptr<Object>>& built, uint64_t object_id)
+    {
+        auto find_iter = built.find(object_id);
+
+        if (find_iter == built.end() || find_iter->second->GetType() != T::type)
+        {
+            return nullptr;
+        }
+
+        return static_pointer_cast<T>(find_iter->second);
+    }
+
+    /// @return The next result set of the statement, or nullptr when there are no more.
+    shared_ptr<sql::ResultSet> NextResult(const shared_ptr<sql::Statement>& statement)
+    {
+        if (!statement->getMoreResults())
+        {
+            return nullptr;
+        }
+
+        return shared_ptr<sql::ResultSet>(statement->getResultSet());
+    }
+}
+
+BulkObjectLoader::BulkObjectLoader(DatabaseManagerInterface* db_manager,
+                                   anh::EventDispatcher* event_dispatcher,
+                                   ObjectManager* object_manager)
+    : db_manager_(db_manager)
+    , event_dispatcher_(event_dispatcher)
+    , object_manager_(object_manager)
+{}
+
+vector<shared_ptr<Object>> BulkObjectLoader::LoadObjectTree(uint64_t root_id)
+{
+    vector<TreeEntry> entries;
+    unordered_map<uint64_t, shared_ptr<Object>> built;
+
+    try {
+        auto conn = db_manager_->getConnection("galaxy");
+        auto statement = shared_ptr<sql::Statement>(conn->createStatement());
+
+        stringstream ss;
+        ss << "CALL sp_GetObjectTree(" << root_id << ");";
+        statement->execute(ss.str());
+
+        auto result = shared_ptr<sql::ResultSet>(statement->getResultSet());
+        while (result && result->next())
+        {
+            TreeEntry entry;
+            entry.object_id = result->getUInt64("id");
+            entry.parent_id = result->getUInt64("parent_id");
+            entry.type = result->getUInt("type_id");
+            entry.object = CreateInstance(entry.type);
+
+            if (entry.object)
+            {
+                entry.object->SetObjectId(entry.object_id);
+                entry.object->SetEventDispatcher(event_dispatcher_);
+                ObjectFactory::LoadObjectRow(entry.object, result);
+
+                built.insert(make_pair(entry.object_id, entry.object));
+            }
+
+            entries.push_back(move(entry));
+        }
+
+        result = NextResult(statement);
+        while (result && result->next())
+        {
+            uint64_t object_id = result->getUInt64("id");
+
+            // Creatures are tangibles too.
+            shared_ptr<Tangible> tangible = FindBuilt<Tangible>(built, object_id);
+            if (!tangible)
+            {
+                tangible = FindBuilt<Creature>(built, object_id);
+            }
+
+            if (tangible)
+            {
+                TangibleFactory::LoadTangibleRow(tangible, result);
+            }
+        }
+
+        result = NextResult(statement);
+        while (result && result->next())
+        {
+            auto intangible = FindBuilt<Intangible>(built, result->getUInt64("id"));
+            if (intangible)
+            {
+                IntangibleFactory::LoadIntangibleRow(intangible, result);
+            }
+        }
+
+        result = NextResult(statement);
+        while (result && result->next())
+        {
+            auto creature = FindBuilt<Creature>(built, result->getUInt64("id"));
+            if (creature)
+            {
+                CreatureFactory::LoadCreatureRow(creature, result);
+            }
+        }
+
+        result = NextResult(statement);
+        while (result && result->next())
+        {
+            auto creature = FindBuilt<Creature>(built, result->getUInt64("creature_id"));
+            if (creature)
+            {
+                creature->AddSkill(result->getString("name"));
+            }
+        }
+
+        result = NextResult(statement);
+        while (result && result->next())
+        {
+            auto creature = FindBuilt<Creature>(built, result->getUInt64("creature_id"));
+            if (creature)
+            {
+                creature->AddSkillMod(SkillMod(result->getString("name"), result->getUInt("value"), 0));
+            }
+        }
+
+        result = NextResult(statement);
+        while (result && result->next())
+        {
+            auto creature = FindBuilt<Creature>(built, result->getUInt64("creature_id"));
+            if (creature)
+            {
+                creature->AddSkillCommand(make_pair(result->getInt("id"), result->getString("name")));
+            }
+        }
+
+        // Drain the trailing status result of the CALL so the connection can be reused.
+        while (statement->getMoreResults())
+        {}
+    }
+    catch(sql::SQLException &e)
+    {
+        LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
+        LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
+        return vector<shared_ptr<Object>>();
+    }
+
+    // The rows were loaded through the setters, yet the objects match storage. Intangibles
+    // don't track their changes, so they are left to be written as before.
+    for (auto& entry : entries)
+    {
+        if (entry.object && entry.type != Intangible::type)
+        {
+            entry.object->ClearPersistDirty();
+        }
+    }
+
+    // The remaining types each load themselves, once the tree's results are consumed.
+    for (auto& entry : entries)
+    {
+        if (entry.object)
+        {
+            continue;
+        }
+
+        try {
+            entry.object = object_manager_->CreateObjectFromStorage(entry.object_id, entry.type);
+        }
+        catch(const InvalidObjectType&)
+        {
+            LOG(warning) << "Skipping object " << entry.object_id << " of unmanaged type " << entry.type;
+        }
+
+        if (entry.object)
+        {
+            built.insert(make_pair(entry.object_id, entry.object));
+        }
+    }
+
+    vector<shared_ptr<Object>> objects;
+    objects.reserve(entries.size());
+
+    for (auto& entry : entries)
+    {
+        if (!entry.object)
+        {
+            continue;
+        }
+
+        if (entry.object_id != root_id)
+        {
+            auto parent_iter = built.find(entry.parent_id);
+            if (parent_iter != built.end())
+            {
+                // linking a child to the container it is stored in is not a change
+                bool was_clean = entry.object->GetPersistDirty() == Object::PERSIST_NONE;
+                parent_iter->second->AddContainedObject(entry.object, Object::LINK);
+                if (was_clean)
+                {
+                    entry.object->ClearPersistDirty();
+                }
+            }
+        }
+
+        objects.push_back(move(entry.object));
+    }
+
+    return objects;
+}
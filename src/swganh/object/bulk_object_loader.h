@@ -0,0 +1,55 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef SWGANH_OBJECT_BULK_OBJECT_LOADER_H_
+#define SWGANH_OBJECT_BULK_OBJECT_LOADER_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace anh {
+    class EventDispatcher;
+namespace database {
+    class DatabaseManagerInterface;
+}}  // namespace anh::database
+
+namespace swganh {
+namespace object {
+
+    class Object;
+    class ObjectManager;
+
+    /**
+     * Loads an object together with everything it contains, at any depth.
+     *
+     * The whole tree is fetched with a single call that returns one result set
+     * per table, covering every object in the tree at once, instead of a call
+     * per object. Tangibles, intangibles and creatures are built from those
+     * rows. Other types are loaded through their factory, one call each.
+     */
+    class BulkObjectLoader
+    {
+    public:
+        BulkObjectLoader(anh::database::DatabaseManagerInterface* db_manager,
+            anh::EventDispatcher* event_dispatcher,
+            ObjectManager* object_manager);
+
+        /**
+         * Loads the object with the given id and its contents.
+         *
+         * @return Every object of the tree with containers ahead of their contents,
+         *  the root first. Contents are already linked into their containers. Empty
+         *  when no object exists for the specified id or the tree could not be read.
+         */
+        std::vector<std::shared_ptr<Object>> LoadObjectTree(uint64_t root_id);
+
+    private:
+        anh::database::DatabaseManagerInterface* db_manager_;
+        anh::EventDispatcher* event_dispatcher_;
+        ObjectManager* object_manager_;
+    };
+
+}}  // namespace swganh::object
+
+#endif  // SWGANH_OBJECT_BULK_OBJECT_LOADER_H_
@@ -0,0 +1,195 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <boost/test/unit_test.hpp>
+#include <turtle/mock.hpp>
+
+#include <memory>
+#include <vector>
+
+#include <cppconn/exception.h>
+
+#include "anh/database/mock_cppconn.h"
+#include "anh/database/mock_database_manager.h"
+#include "swganh/object/bulk_object_loader.h"
+#include "swganh/object/object.h"
+#include "swganh/object/intangible/intangible.h"
+#include "swganh/object/tangible/tangible.h"
+
+using namespace std;
+using anh::database::MockConnection;
+using anh::database::MockDatabaseManager;
+using anh::database::MockResultSet;
+using anh::database::MockStatement;
+using swganh::object::BulkObjectLoader;
+using swganh::object::Object;
+using swganh::object::intangible::Intangible;
+using swganh::object::tangible::Tangible;
+
+namespace {
+
+/// Expects the result set to be read through the given number of rows.
+void ExpectRows(MockResultSet& result, uint32_t rows)
+{
+    mock::sequence s;
+
+    if (rows > 0)
+    {
+        MOCK_EXPECT(result, next).exactly(rows).in(s).returns(true);
+    }
+
+    MOCK_EXPECT(result, next).once().in(s).returns(false);
+}
+
+/// Expects the given column to yield one value per row, in order.
+void ExpectIds(MockResultSet& result, const sql::SQLString& column, const vector<uint64_t>& ids)
+{
+    mock::sequence s;
+
+    for (uint64_t id : ids)
+    {
+        MOCK_EXPECT(result, tag15).once().in(s).with(column).returns(id);
+    }
+}
+
+/// Accepts any of the columns that ObjectFactory::LoadObjectRow reads.
+void ExpectObjectColumns(MockResultSet& result)
+{
+    MOCK_EXPECT(result, tag7).returns(0.0);
+    MOCK_EXPECT(result, tag11).returns(0u);
+    MOCK_EXPECT(result, tag22).returns(sql::SQLString(""));
+}
+
+class BulkObjectLoaderTests
+{
+public:
+    BulkObjectLoaderTests()
+        : connection(make_shared<MockConnection>())
+        , statement(new MockStatement())
+        , loader(&db_manager, nullptr, nullptr)
+    {
+        MOCK_EXPECT(db_manager, getConnection).with(string("galaxy")).returns(connection);
+        MOCK_EXPECT(*connection, createStatement).once().returns(statement);
+    }
+
+    MockDatabaseManager db_manager;
+    shared_ptr<MockConnection> connection;
+
+    // Owned by the loader once it is handed out.
+    MockStatement* statement;
+
+    BulkObjectLoader loader;
+};
+
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(BulkObjectLoaderTest, BulkObjectLoaderTests)
+
+/// The rows of every result set are applied to the object they name, and the
+/// contents come back linked into their containers, containers first.
+BOOST_AUTO_TEST_CASE(TreeRowsAreBuiltAndLinked)
+{
+    // tree: a tangible holding a tangible holding an intangible
+    auto tree = new MockResultSet();
+    ExpectRows(*tree, 3);
+    ExpectIds(*tree, "id", { 1, 2, 3 });
+    ExpectIds(*tree, "parent_id", { 0, 1, 2 });
+    {
+        mock::sequence s;
+        MOCK_EXPECT(*tree, tag11).once().in(s).with(sql::SQLString("type_id")).returns(uint32_t(Tangible::type));
+        MOCK_EXPECT(*tree, tag11).once().in(s).with(sql::SQLString("type_id")).returns(uint32_t(Tangible::type));
+        MOCK_EXPECT(*tree, tag11).once().in(s).with(sql::SQLString("type_id")).returns(uint32_t(Intangible::type));
+    }
+    ExpectObjectColumns(*tree);
+
+    auto tangibles = new MockResultSet();
+    ExpectRows(*tangibles, 2);
+    ExpectIds(*tangibles, "id", { 2, 1 });
+    {
+        mock::sequence s;
+        MOCK_EXPECT(*tangibles, tag22).once().in(s).with(sql::SQLString("customization")).returns(sql::SQLString("child"));
+        MOCK_EXPECT(*tangibles, tag22).once().in(s).with(sql::SQLString("customization")).returns(sql::SQLString("root"));
+    }
+    MOCK_EXPECT(*tangibles, tag11).returns(0u);
+    MOCK_EXPECT(*tangibles, tag5).returns(false);
+
+    auto intangibles = new MockResultSet();
+    ExpectRows(*intangibles, 1);
+    ExpectIds(*intangibles, "id", { 3 });
+    MOCK_EXPECT(*intangibles, tag22).with(sql::SQLString("stf_detail_file")).returns(sql::SQLString("detail_file"));
+    MOCK_EXPECT(*intangibles, tag22).with(sql::SQLString("stf_detail_string")).returns(sql::SQLString("detail_string"));
+
+    // creatures, skills, skill mods and skill commands
+    vector<MockResultSet*> empty_results;
+    for (int i = 0; i < 4; ++i)
+    {
+        empty_results.push_back(new MockResultSet());
+        ExpectRows(*empty_results.back(), 0);
+    }
+
+    MOCK_EXPECT(*statement, execute).once().with(sql::SQLString("CALL sp_GetObjectTree(1);")).returns(true);
+    {
+        mock::sequence s;
+        MOCK_EXPECT(*statement, getResultSet).once().in(s).returns(tree);
+        MOCK_EXPECT(*statement, getResultSet).once().in(s).returns(tangibles);
+        MOCK_EXPECT(*statement, getResultSet).once().in(s).returns(intangibles);
+        for (auto result : empty_results)
+        {
+            MOCK_EXPECT(*statement, getResultSet).once().in(s).returns(result);
+        }
+    }
+    {
+        // six more result sets, then the trailing status of the CALL
+        mock::sequence s;
+        MOCK_EXPECT(*statement, getMoreResults).exactly(6).in(s).returns(true);
+        MOCK_EXPECT(*statement, getMoreResults).once().in(s).returns(false);
+    }
+
+    auto objects = loader.LoadObjectTree(1);
+
+    BOOST_REQUIRE_EQUAL(3u, objects.size());
+    BOOST_CHECK_EQUAL(1u, objects[0]->GetObjectId());
+    BOOST_CHECK_EQUAL(2u, objects[1]->GetObjectId());
+    BOOST_CHECK_EQUAL(3u, objects[2]->GetObjectId());
+
+    BOOST_CHECK(!objects[0]->GetContainer());
+    BOOST_CHECK(objects[1]->GetContainer() == objects[0]);
+    BOOST_CHECK(objects[2]->GetContainer() == objects[1]);
+
+    BOOST_REQUIRE(objects[0]->GetType() == Tangible::type);
+    BOOST_CHECK_EQUAL("root", static_pointer_cast<Tangible>(objects[0])->GetCustomization());
+    BOOST_REQUIRE(objects[1]->GetType() == Tangible::type);
+    BOOST_CHECK_EQUAL("child", static_pointer_cast<Tangible>(objects[1])->GetCustomization());
+
+    BOOST_REQUIRE(objects[2]->GetType() == Intangible::type);
+    auto intangible = static_pointer_cast<Intangible>(objects[2]);
+    BOOST_CHECK_EQUAL("detail_file", intangible->GetStfDetailFile());
+    BOOST_CHECK_EQUAL("detail_string", intangible->GetStfDetailString());
+
+    // loaded tangibles match storage
+    BOOST_CHECK_EQUAL(uint32_t(Object::PERSIST_NONE), objects[0]->GetPersistDirty());
+    BOOST_CHECK_EQUAL(uint32_t(Object::PERSIST_NONE), objects[1]->GetPersistDirty());
+}
+
+/// An id without an object yields an empty tree.
+BOOST_AUTO_TEST_CASE(MissingObjectYieldsAnEmptyTree)
+{
+    auto tree = new MockResultSet();
+    ExpectRows(*tree, 0);
+
+    MOCK_EXPECT(*statement, execute).once().returns(true);
+    MOCK_EXPECT(*statement, getResultSet).once().returns(tree);
+    MOCK_EXPECT(*statement, getMoreResults).returns(false);
+
+    BOOST_CHECK(loader.LoadObjectTree(1).empty());
+}
+
+/// A failed call yields an empty tree instead of throwing.
+BOOST_AUTO_TEST_CASE(FailedCallYieldsAnEmptyTree)
+{
+    MOCK_EXPECT(*statement, execute).once().throws(sql::SQLException("call failed"));
+
+    BOOST_CHECK(loader.LoadObjectTree(1).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
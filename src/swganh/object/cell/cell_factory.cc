@@ -17,9 +17,6 @@ bool CellFactory::HasTemplate(const string& template_name)
     return false;
 }
 
-void CellFactory::PersistObject(const shared_ptr<Object>& object)
-{}
-
 void CellFactory::DeleteObjectFromStorage(const shared_ptr<Object>& object)
 {}
 
@@ -17,8 +17,6 @@ namespace cell {
 
         bool HasTemplate(const std::string& template_name);
 
-        void PersistObject(const std::shared_ptr<swganh::object::Object>& object);
-
         void DeleteObjectFromStorage(const std::shared_ptr<swganh::object::Object>& object);
 
         std::shared_ptr<swganh::object::Object> CreateObjectFromStorage(uint64_t object_id);
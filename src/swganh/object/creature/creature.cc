@@ -6,6 +6,7 @@
 #include "anh/crc.h"
 
 #include "swganh/object/object_events.h"
+#include "swganh/object/property_channel.h"
 #include "swganh/object/player/player.h"
 #include "creature_message_builder.h"
 
@@ -72,11 +73,54 @@ uint32_t Creature::GetType() const
     return Creature::type;
 }
 
+uint32_t Creature::GetPersistGroup(Property property)
+{
+    switch (property)
+    {
+    case Property::BANK:
+    case Property::CASH:
+        return PERSIST_CREATURE_CREDITS;
+    case Property::STAT_WOUND:
+    case Property::STAT_ENCUMBERANCE:
+    case Property::STAT_CURRENT:
+    case Property::STAT_MAX:
+        return PERSIST_CREATURE_STATS;
+    case Property::POSTURE:
+    case Property::FACTION_RANK:
+    case Property::OWNER_ID:
+    case Property::SCALE:
+    case Property::BATTLE_FATIGUE:
+    case Property::STATE_BITMASK:
+    case Property::ACCELERATION_MULTIPLIER_BASE:
+    case Property::ACCELERATION_MULTIPLIER_MODIFIER:
+    case Property::SPEED_MULTIPLIER_BASE:
+    case Property::SPEED_MULTIPLIER_MODIFIER:
+    case Property::LISTEN_TO_ID:
+    case Property::RUN_SPEED:
+    case Property::SLOPE_MODIFIER_ANGLE:
+    case Property::SLOPE_MODIFIER_PERCENT:
+    case Property::TURN_RADIUS:
+    case Property::WALKING_SPEED:
+    case Property::WATER_MODIFIER_PERCENT:
+    case Property::COMBAT_LEVEL:
+    case Property::ANIMATION:
+    case Property::WEAPON_ID:
+    case Property::GROUP_ID:
+    case Property::GUILD_ID:
+    case Property::MOOD_ID:
+    case Property::PERFORMANCE_ID:
+    case Property::DISGUISE:
+        return PERSIST_CREATURE;
+    default:
+        // base stats, skills and the remaining session state are not written by the creature persist
+        return PERSIST_NONE;
+    }
+}
+
 void Creature::SetBankCredits(uint32_t bank_credits)
 {
     bank_credits_ = bank_credits;
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::Bank", static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::BANK, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 uint32_t Creature::GetBankCredits(void)
@@ -86,9 +130,8 @@ uint32_t Creature::GetBankCredits(void)
 
 void Creature::SetCashCredits(uint32_t cash_credits)
 {
-    cash_credits = cash_credits;
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::Cash",static_pointer_cast<Creature>(shared_from_this())));
+    cash_credits_ = cash_credits;
+    PropertyChannel<Creature>::Notify(Property::CASH, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 uint32_t Creature::GetCashCredits(void)
@@ -102,8 +145,7 @@ void Creature::SetStatBase(StatIndex stat_index, int32_t value)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         stat_base_list_.Update(stat_index, Stat(value));
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::StatBase",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::STAT_BASE, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 void Creature::AddStatBase(StatIndex stat_index, int32_t value)
@@ -113,8 +155,7 @@ void Creature::AddStatBase(StatIndex stat_index, int32_t value)
         uint32_t new_stat = stat_base_list_[stat_index].value + value;
         stat_base_list_.Update(stat_index, Stat(new_stat));
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::StatBase",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::STAT_BASE, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 void Creature::DeductStatBase(StatIndex stat_index, int32_t value)
@@ -132,8 +173,7 @@ void Creature::DeductStatBase(StatIndex stat_index, int32_t value)
         }
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::StatBase",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::STAT_BASE, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 NetworkArray<Stat> Creature::GetBaseStats(void)
@@ -155,8 +195,7 @@ void Creature::AddSkill(std::string skill)
         skills_.Add(Skill(skill));
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::Skill",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::SKILL, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 void Creature::RemoveSkill(std::string skill)
@@ -175,8 +214,7 @@ void Creature::RemoveSkill(std::string skill)
         skills_.Remove(iter);
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::Skill",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::SKILL, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 NetworkList<Skill> Creature::GetSkills(void)
@@ -238,8 +276,7 @@ void  Creature::RemoveSkillCommand(std::string skill_command)
 void Creature::SetPosture(Posture posture)
 {
     posture_ = posture;
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::Posture",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::POSTURE, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 Posture Creature::GetPosture(void)
@@ -260,8 +297,7 @@ bool Creature::IsIncapacitated()
 void Creature::SetFactionRank(uint8_t faction_rank)
 {
     faction_rank_ = faction_rank;
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::FactionRank",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::FACTION_RANK, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 uint8_t Creature::GetFactionRank(void)
@@ -272,8 +308,7 @@ uint8_t Creature::GetFactionRank(void)
 void Creature::SetOwnerId(uint64_t owner_id)
 {
     owner_id_ = owner_id;
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::OwnerId",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::OWNER_ID, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 uint64_t Creature::GetOwnerId(void)
@@ -288,8 +323,7 @@ void Creature::SetScale(float scale)
         scale_ = scale;
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::Scale",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::SCALE, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 float Creature::GetScale(void)
@@ -302,14 +336,12 @@ void Creature::SetBattleFatigue(uint32_t battle_fatigue)
 {
     battle_fatigue_ = battle_fatigue;
     
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::BattleFatigue",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::BATTLE_FATIGUE, static_pointer_cast<Creature>(shared_from_this()));
 }
 void Creature::AddBattleFatigue(uint32_t battle_fatigue)
 {
     battle_fatigue += battle_fatigue;
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::BattleFatigue",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::BATTLE_FATIGUE, static_pointer_cast<Creature>(shared_from_this()));
 }
 uint32_t Creature::GetBattleFatigue(void)
 {
@@ -319,8 +351,7 @@ uint32_t Creature::GetBattleFatigue(void)
 void Creature::SetStateBitmask(uint64_t state_bitmask)
 {
     state_bitmask_ = state_bitmask;
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::StateBitmask",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::STATE_BITMASK, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 uint64_t Creature::GetStateBitmask(void)
@@ -335,22 +366,19 @@ void Creature::ToggleStateOn(uint64_t state)
 {
     state_bitmask_ = ( state_bitmask_ | state);
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::StateBitmask",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::STATE_BITMASK, static_pointer_cast<Creature>(shared_from_this()));
 }
 void Creature::ToggleStateOff(uint64_t state)
 {
     state_bitmask_ = ( state_bitmask_ & ~ state);
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::StateBitmask",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::STATE_BITMASK, static_pointer_cast<Creature>(shared_from_this()));
 }
 void Creature::ToggleStateBitmask(uint64_t state_bitmask)
 {
     state_bitmask_ = (state_bitmask_ ^ state_bitmask);
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::StateBitmask",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::STATE_BITMASK, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 void Creature::SetStatWound(StatIndex stat_index, int32_t value)
@@ -360,8 +388,7 @@ void Creature::SetStatWound(StatIndex stat_index, int32_t value)
         stat_wound_list_.Update(stat_index, Stat(value));
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::StatWound",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::STAT_WOUND, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 void Creature::AddStatWound(StatIndex stat_index, int32_t value)
@@ -371,8 +398,7 @@ void Creature::AddStatWound(StatIndex stat_index, int32_t value)
         int32_t new_stat = stat_wound_list_[stat_index].value + value;
         stat_wound_list_.Update(stat_index, Stat(new_stat));
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::StatWound",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::STAT_WOUND, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 void Creature::DeductStatWound(StatIndex stat_index, int32_t value)
@@ -390,8 +416,7 @@ void Creature::DeductStatWound(StatIndex stat_index, int32_t value)
         }
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::StatWound",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::STAT_WOUND, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 NetworkArray<Stat> Creature::GetStatWounds(void)
@@ -413,8 +438,7 @@ void Creature::SetAccelerationMultiplierBase(float acceleration_multiplier_base)
         acceleration_multiplier_base_ = acceleration_multiplier_base;
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::AccelerationMultiplierBase",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::ACCELERATION_MULTIPLIER_BASE, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 float Creature::GetAccelerationMultiplierBase(void)
@@ -430,8 +454,7 @@ void Creature::SetAccelerationMultiplierModifier(float acceleration_multiplier_m
         acceleration_multiplier_modifier_ = acceleration_multiplier_modifier;
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::AccelerationMultiplierModifier",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::ACCELERATION_MULTIPLIER_MODIFIER, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 float Creature::GetAccelerationMultiplierModifier(void)
@@ -446,8 +469,7 @@ void Creature::SetStatEncumberance(StatIndex stat_index, int32_t value)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         stat_encumberance_list_.Update(stat_index, Stat(value));
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::StatEncumberance",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::STAT_ENCUMBERANCE, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 void Creature::AddStatEncumberance(StatIndex stat_index, int32_t value)
@@ -457,8 +479,7 @@ void Creature::AddStatEncumberance(StatIndex stat_index, int32_t value)
         int32_t new_stat = stat_encumberance_list_[stat_index].value + value;
         stat_encumberance_list_.Update(stat_index, Stat(new_stat));
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::StatEncumberance",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::STAT_ENCUMBERANCE, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 void Creature::DeductStatEncumberance(StatIndex stat_index, int32_t value)
@@ -475,8 +496,7 @@ void Creature::DeductStatEncumberance(StatIndex stat_index, int32_t value)
             stat_encumberance_list_.Update(stat_index, Stat(0));
         }
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::StatEncumberance",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::STAT_ENCUMBERANCE, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 NetworkArray<Stat> Creature::GetStatEncumberances(void)
@@ -497,8 +517,7 @@ void Creature::AddSkillMod(SkillMod mod)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         skill_mod_list_.Add(mod.identifier, mod);
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::SkillMod",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::SKILL_MOD, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 void Creature::RemoveSkillMod(std::string identifier)
@@ -517,8 +536,7 @@ void Creature::RemoveSkillMod(std::string identifier)
         skill_mod_list_.Remove(iter);
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::SkillMod",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::SKILL_MOD, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 void Creature::SetSkillMod(SkillMod mod)
@@ -527,8 +545,7 @@ void Creature::SetSkillMod(SkillMod mod)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         skill_mod_list_.Update(mod.identifier, mod);
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::SkillMod",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::SKILL_MOD, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 void Creature::ClearSkillMods(void)
@@ -537,8 +554,7 @@ void Creature::ClearSkillMods(void)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         skill_mod_list_.Clear();
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::SkillMod",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::SKILL_MOD, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 NetworkMap<std::string, SkillMod> Creature::GetSkillMods(void)
@@ -566,8 +582,7 @@ void Creature::SetSpeedMultiplierBase(float speed_multiplier_base)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         speed_multiplier_base_ = speed_multiplier_base;
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::SpeedMultiplierBase",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::SPEED_MULTIPLIER_BASE, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 float Creature::GetSpeedMultiplierBase(void)
@@ -582,8 +597,7 @@ void Creature::SetSpeedMultiplierModifier(float speed_multiplier_modifier)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         speed_multiplier_modifier_ = speed_multiplier_modifier;
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::SpeedMultiplierModifer",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::SPEED_MULTIPLIER_MODIFIER, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 float Creature::GetSpeedMultiplierModifier(void)
@@ -596,8 +610,7 @@ void Creature::SetListenToId(uint64_t listen_to_id)
 {
     listen_to_id_ = listen_to_id;
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::ListenToId",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::LISTEN_TO_ID, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 uint64_t Creature::GetListenToId(void)
@@ -611,8 +624,7 @@ void Creature::SetRunSpeed(float run_speed)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         run_speed_ = run_speed;
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::RunSpeed",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::RUN_SPEED, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 float Creature::GetRunSpeed(void)
@@ -627,8 +639,7 @@ void Creature::SetSlopeModifierAngle(float slope_modifier_angle)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         slope_modifier_angle_ = slope_modifier_angle;
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::SlopeModifierAngle",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::SLOPE_MODIFIER_ANGLE, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 float Creature::GetSlopeModifierAngle(void)
@@ -643,8 +654,7 @@ void Creature::SetSlopeModifierPercent(float slope_modifier_percent)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         slope_modifier_percent_ = slope_modifier_percent;
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::SlopeModifierPercent",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::SLOPE_MODIFIER_PERCENT, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 float Creature::GetSlopeModifierPercent(void)
@@ -659,8 +669,7 @@ void Creature::SetTurnRadius(float turn_radius)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         turn_radius_ = turn_radius;
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::TurnRadius",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::TURN_RADIUS, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 float Creature::GetTurnRadius(void)
@@ -675,8 +684,7 @@ void Creature::SetWalkingSpeed(float walking_speed)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         walking_speed_ = walking_speed;
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::WalkingSpeed",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::WALKING_SPEED, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 float Creature::GetWalkingSpeed(void)
@@ -691,8 +699,7 @@ void Creature::SetWaterModifierPercent(float water_modifier_percent)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         water_modifier_percent_ = water_modifier_percent;
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::WaterModifierPercent",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::WATER_MODIFIER_PERCENT, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 float Creature::GetWaterModifierPercent(void)
@@ -707,8 +714,7 @@ void Creature::AddMissionCriticalObject(MissionCriticalObject& object)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         mission_critical_object_list_.Add(object);
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::MissionCriticalObject",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::MISSION_CRITICAL_OBJECT, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 void Creature::RemoveMissionCriticalObject(uint64_t mission_owner, uint64_t object_id)
@@ -732,8 +738,7 @@ void Creature::RemoveMissionCriticalObject(uint64_t mission_owner, uint64_t obje
 
         mission_critical_object_list_.Remove(iter);
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::MissionCriticalObject",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::MISSION_CRITICAL_OBJECT, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 MissionCriticalObject Creature::GetMissionCriticalObject(uint64_t object_id, uint64_t mission_owner)
@@ -765,8 +770,7 @@ void Creature::SetCombatLevel(uint16_t combat_level)
 {
     combat_level_ = combat_level;
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::CombatLevel",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::COMBAT_LEVEL, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 uint16_t Creature::GetCombatLevel(void)
@@ -780,8 +784,7 @@ void Creature::SetAnimation(std::string animation)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         animation_ = animation;
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::Animation",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::ANIMATION, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 std::string Creature::GetAnimation(void)
@@ -796,8 +799,7 @@ void Creature::SetMoodAnimation(std::string mood_animation)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         mood_animation_ = mood_animation;
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::MoodAnimation",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::MOOD_ANIMATION, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 std::string Creature::GetMoodAnimation(void)
@@ -810,8 +812,7 @@ void Creature::SetWeaponId(uint64_t weapon_id)
 {
     weapon_id_ = weapon_id;
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::WeaponId",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::WEAPON_ID, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 uint64_t Creature::GetWeaponId(void)
@@ -823,8 +824,7 @@ void Creature::SetGroupId(uint64_t group_id)
 {
     group_id_ = group_id;
     
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::GroupId",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::GROUP_ID, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 uint64_t Creature::GetGroupId(void)
@@ -836,8 +836,7 @@ void Creature::SetInviteSenderId(uint64_t invite_sender_id)
 {
     invite_sender_id_ = invite_sender_id;
     
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::InviteSenderId",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::INVITE_SENDER_ID, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 uint64_t Creature::GetInviteSenderId(void)
@@ -864,8 +863,7 @@ void Creature::SetGuildId(uint32_t guild_id)
 {
     guild_id_ = guild_id;
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::GuildId",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::GUILD_ID, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 uint32_t Creature::GetGuildId(void)
@@ -877,8 +875,7 @@ void Creature::SetTargetId(uint64_t target_id)
 {
     target_id_ = target_id;
     
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::TargetId",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::TARGET_ID, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 uint64_t Creature::GetTargetId(void)
@@ -890,8 +887,7 @@ void Creature::SetMoodId(uint8_t mood_id)
 {
     mood_id_ = mood_id;
     
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::MoodId",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::MOOD_ID, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 uint8_t Creature::GetMoodId(void)
@@ -903,8 +899,7 @@ void Creature::SetPerformanceId(uint32_t performance_id)
 {
     performance_id_ = performance_id;
     
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::PerformanceId",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::PERFORMANCE_ID, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 uint32_t Creature::GetPerformanceId(void)
@@ -933,8 +928,7 @@ void Creature::SetStatCurrent(StatIndex stat_index, int32_t value)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         stat_current_list_.Update(stat_index, Stat(value));
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::StatCurrent",static_pointer_cast<Creature>(static_pointer_cast<Creature>(shared_from_this()))));
+    PropertyChannel<Creature>::Notify(Property::STAT_CURRENT, static_pointer_cast<Creature>(static_pointer_cast<Creature>(shared_from_this())));
 }
 
 void Creature::AddStatCurrent(StatIndex stat_index, int32_t value)
@@ -944,8 +938,7 @@ void Creature::AddStatCurrent(StatIndex stat_index, int32_t value)
         int32_t new_value = stat_current_list_[stat_index].value + value;
         stat_current_list_.Update(stat_index, Stat(new_value));
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::StatCurrent",static_pointer_cast<Creature>(static_pointer_cast<Creature>(shared_from_this()))));
+    PropertyChannel<Creature>::Notify(Property::STAT_CURRENT, static_pointer_cast<Creature>(static_pointer_cast<Creature>(shared_from_this())));
 }
 
 void Creature::DeductStatCurrent(StatIndex stat_index, int32_t value)
@@ -962,8 +955,7 @@ void Creature::DeductStatCurrent(StatIndex stat_index, int32_t value)
             stat_current_list_.Update(stat_index, Stat(0));
         }
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::StatCurrent",static_pointer_cast<Creature>(static_pointer_cast<Creature>(shared_from_this()))));
+    PropertyChannel<Creature>::Notify(Property::STAT_CURRENT, static_pointer_cast<Creature>(static_pointer_cast<Creature>(shared_from_this())));
 }
 
 NetworkArray<Stat> Creature::GetCurrentStats(void)
@@ -984,8 +976,7 @@ void Creature::SetStatMax(StatIndex stat_index, int32_t value)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         stat_max_list_.Update(stat_index, Stat(value));
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::StatMax",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::STAT_MAX, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 void Creature::AddStatMax(StatIndex stat_index, int32_t value)
@@ -994,8 +985,7 @@ void Creature::AddStatMax(StatIndex stat_index, int32_t value)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         stat_max_list_.Update(stat_index, Stat(stat_max_list_.At(stat_index).value + value));
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::StatMax",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::STAT_MAX, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 void Creature::DeductStatMax(StatIndex stat_index, int32_t value)
@@ -1012,8 +1002,7 @@ void Creature::DeductStatMax(StatIndex stat_index, int32_t value)
             stat_max_list_.Update(stat_index, Stat(0));
         }
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::StatMax",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::STAT_MAX, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 NetworkArray<Stat> Creature::GetMaxStats(void)
@@ -1035,8 +1024,7 @@ void Creature::AddEquipmentItem(EquipmentItem& item)
         equipment_list_.Add(item);
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::EquipmentItem",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::EQUIPMENT_ITEM, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 void Creature::RemoveEquipmentItem(uint64_t object_id)
@@ -1053,8 +1041,7 @@ void Creature::RemoveEquipmentItem(uint64_t object_id)
         }
         equipment_list_.Remove(iter);
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::EquipmentItem",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::EQUIPMENT_ITEM, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 void Creature::UpdateEquipmentItem(EquipmentItem& item)
@@ -1065,8 +1052,7 @@ void Creature::UpdateEquipmentItem(EquipmentItem& item)
         if(iter != end(equipment_list_))
             equipment_list_.Update(iter->first, item);
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::EquipmentItem",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::EQUIPMENT_ITEM, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 NetworkSortedList<EquipmentItem> Creature::GetEquipment(void)
@@ -1095,8 +1081,7 @@ void Creature::SetDisguise(std::string disguise)
         disguise_ = disguise;
     }
     
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::Disguise",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::DISGUISE, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 std::string Creature::GetDisguise(void)
@@ -1109,8 +1094,7 @@ void Creature::SetStationary(bool stationary)
 {
     stationary_ = stationary;
     
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::Stationary",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::STATIONARY, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 bool Creature::IsStationary(void)
@@ -1130,8 +1114,7 @@ void Creature::SetPvPStatus(PvpStatus status)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         pvp_status_ = status;
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::PvPStatus",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::PVP_STATUS, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 void Creature::TogglePvpStateOn(PvpStatus state)
@@ -1140,8 +1123,7 @@ void Creature::TogglePvpStateOn(PvpStatus state)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         pvp_status_ = static_cast<PvpStatus>(pvp_status_ | state);
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::PvPStatus",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::PVP_STATUS, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 void Creature::TogglePvpStateOff(PvpStatus state)
@@ -1150,8 +1132,7 @@ void Creature::TogglePvpStateOff(PvpStatus state)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         pvp_status_ = static_cast<PvpStatus>(pvp_status_ & ~state);
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::PvPStatus",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::PVP_STATUS, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 void Creature::TogglePvpState(PvpStatus state)
@@ -1160,8 +1141,7 @@ void Creature::TogglePvpState(PvpStatus state)
         boost::lock_guard<boost::mutex> lock(creature_mutex_);
         pvp_status_ = static_cast<PvpStatus>(pvp_status_ ^ state);
     }
-    GetEventDispatcher()->Dispatch(make_shared<CreatureEvent>
-        ("Creature::PvPStatus",static_pointer_cast<Creature>(shared_from_this())));
+    PropertyChannel<Creature>::Notify(Property::PVP_STATUS, static_pointer_cast<Creature>(shared_from_this()));
 }
 
 bool Creature::CheckPvpState(PvpStatus state) const
@@ -358,6 +358,55 @@ struct SkillCommands
 class Creature : public swganh::object::tangible::Tangible
 {
 public:
+    /**
+     * Properties whose changes are announced on the creature's PropertyChannel.
+     */
+    enum class Property : uint16_t
+    {
+        BANK,
+        CASH,
+        STAT_BASE,
+        SKILL,
+        POSTURE,
+        FACTION_RANK,
+        OWNER_ID,
+        SCALE,
+        BATTLE_FATIGUE,
+        STATE_BITMASK,
+        STAT_WOUND,
+        ACCELERATION_MULTIPLIER_BASE,
+        ACCELERATION_MULTIPLIER_MODIFIER,
+        STAT_ENCUMBERANCE,
+        SKILL_MOD,
+        SPEED_MULTIPLIER_BASE,
+        SPEED_MULTIPLIER_MODIFIER,
+        LISTEN_TO_ID,
+        RUN_SPEED,
+        SLOPE_MODIFIER_ANGLE,
+        SLOPE_MODIFIER_PERCENT,
+        TURN_RADIUS,
+        WALKING_SPEED,
+        WATER_MODIFIER_PERCENT,
+        MISSION_CRITICAL_OBJECT,
+        COMBAT_LEVEL,
+        ANIMATION,
+        MOOD_ANIMATION,
+        WEAPON_ID,
+        GROUP_ID,
+        INVITE_SENDER_ID,
+        GUILD_ID,
+        TARGET_ID,
+        MOOD_ID,
+        PERFORMANCE_ID,
+        STAT_CURRENT,
+        STAT_MAX,
+        EQUIPMENT_ITEM,
+        DISGUISE,
+        STATIONARY,
+        PVP_STATUS,
+        PROPERTY_COUNT
+    };
+
     Creature();
     ~Creature();
 
@@ -365,6 +414,11 @@ public:
     uint32_t GetType() const;
     const static uint32_t type = 0x4352454F;
 
+    /**
+     * @return The persistence group a property is stored with.
+     */
+    static uint32_t GetPersistGroup(Property property);
+
     // Bank Credits
     void SetBankCredits(uint32_t bank_credits);
     uint32_t GetBankCredits(void);
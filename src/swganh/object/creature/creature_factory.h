@@ -13,6 +13,7 @@ class DatabaseManagerInterface;
 }} // anh::database
 
 namespace sql {
+    class PreparedStatement;
     class Statement;
 }  // namespace sql
 
@@ -37,12 +38,17 @@ namespace creature {
 
         bool HasTemplate(const std::string& template_name);
 
-        void PersistObject(const std::shared_ptr<swganh::object::Object>& object);
+        void PersistObject(const std::shared_ptr<swganh::object::Object>& object, const std::shared_ptr<sql::Connection>& connection);
 
         void DeleteObjectFromStorage(const std::shared_ptr<swganh::object::Object>& object);
 
         std::shared_ptr<swganh::object::Object> CreateObjectFromStorage(uint64_t object_id);
 
+        /**
+         * Loads in creature values from the current row of a result set
+         */
+        static void LoadCreatureRow(const std::shared_ptr<Creature>& creature, const std::shared_ptr<sql::ResultSet>& result);
+
         std::shared_ptr<swganh::object::Object> CreateObjectFromTemplate(const std::string& template_name);
         
     private:
@@ -55,6 +61,14 @@ namespace creature {
         void LoadSkillCommands_(const std::shared_ptr<Creature>& creature, 
             const std::shared_ptr<sql::Statement>& statement);
 
+        /**
+         * Sets the wounds, encumberance, current and max of every stat, in that
+         * order, as the 36 parameters starting at the given one.
+         */
+        void SetStatParameters_(const std::shared_ptr<Creature>& creature,
+            const std::shared_ptr<sql::PreparedStatement>& statement,
+            uint32_t first_parameter);
+
         std::unordered_map<std::string, std::shared_ptr<Creature>>::iterator GetTemplateIter_(const std::string& template_name);
         std::unordered_map<std::string, std::shared_ptr<Creature>> creature_templates_;
     };
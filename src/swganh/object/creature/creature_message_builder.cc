@@ -6,6 +6,7 @@
 #include "swganh/messages/update_pvp_status_message.h"
 #include "swganh/messages/controllers/posture.h"
 #include "swganh/object/object_events.h"
+#include "swganh/object/property_channel.h"
 
 using namespace std;
 using namespace anh;
@@ -20,219 +21,67 @@ void CreatureMessageBuilder::RegisterEventHandlers()
         auto controller_event = static_pointer_cast<ControllerEvent>(incoming_event);
         SendBaselines(static_pointer_cast<Creature>(controller_event->object), controller_event->controller);
     });
-    event_dispatcher->Subscribe("Creature::Bank", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildBankCreditsDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::Cash", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildCashCreditsDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::StatBase", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildStatBaseDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::Skill", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildSkillDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::Posture", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildPostureDelta(value_event->Get());
-        BuildPostureUpdate(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::FactionRank", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildFactionRankDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::OwnerId", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildOwnerIdDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::Scale", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildScaleDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::BattleFatigue", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildScaleDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::StateBitmask", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildStateBitmaskDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::StateBitmask", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildStateBitmaskDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::StatWound", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildStatWoundDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::AccelerationMultiplierBase", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildAccelerationMultiplierBaseDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::AccelerationMultiplierModifier", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildAccelerationMultiplierModifierDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::StatEncumberance", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildStatEncumberanceDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::SkillMod", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildSkillModDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::SpeedMultiplierBase", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildSpeedMultiplierBaseDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::SpeedMultiplierModifer", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildSpeedMultiplierModifierDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::ListenToId", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildListenToIdDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::RunSpeed", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildRunSpeedDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::SlopeModifierAngle", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildSlopeModifierAngleDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::SlopeModifierPercent", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildSlopeModifierPercentDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::TurnRadius", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildTurnRadiusDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::WalkingSpeed", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildWalkingSpeedDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::WaterModifierPercent", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildWaterModifierPrecentDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::MissionCriticalObject", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildMissionCriticalObjectDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::Animation", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildAnimationDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::MoodAnimation", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildMoodAnimationDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::WeaponId", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildWeaponIdDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::GroupId", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildGroupIdDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::InviteSenderId", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildInviteSenderIdDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::GuildId", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildGuildIdDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::TargetId", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildTargetIdDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::PerformanceId", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildPerformanceIdDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::StatCurrent", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildStatCurrentDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::StatMax", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildStatMaxDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::EquipmentItem", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildEquipmentDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::Disguise", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildDisguiseDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Creature::Stationary", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildStationaryDelta(value_event->Get());
-    });
-   event_dispatcher->Subscribe("Creature::PvPStatus", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<CreatureEvent>(incoming_event);
-        BuildUpdatePvpStatusMessage(value_event->Get());
+    PropertyChannel<Creature>::Subscribe(Creature::Property::BANK, &BuildBankCreditsDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::CASH, &BuildCashCreditsDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::STAT_BASE, &BuildStatBaseDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::SKILL, &BuildSkillDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::POSTURE, &BuildPostureDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::POSTURE, &BuildPostureUpdate);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::FACTION_RANK, &BuildFactionRankDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::OWNER_ID, &BuildOwnerIdDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::SCALE, &BuildScaleDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::BATTLE_FATIGUE, &BuildScaleDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::STATE_BITMASK, &BuildStateBitmaskDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::STATE_BITMASK, &BuildStateBitmaskDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::STAT_WOUND, &BuildStatWoundDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::ACCELERATION_MULTIPLIER_BASE, &BuildAccelerationMultiplierBaseDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::ACCELERATION_MULTIPLIER_MODIFIER, &BuildAccelerationMultiplierModifierDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::STAT_ENCUMBERANCE, &BuildStatEncumberanceDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::SKILL_MOD, &BuildSkillModDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::SPEED_MULTIPLIER_BASE, &BuildSpeedMultiplierBaseDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::SPEED_MULTIPLIER_MODIFIER, &BuildSpeedMultiplierModifierDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::LISTEN_TO_ID, &BuildListenToIdDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::RUN_SPEED, &BuildRunSpeedDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::SLOPE_MODIFIER_ANGLE, &BuildSlopeModifierAngleDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::SLOPE_MODIFIER_PERCENT, &BuildSlopeModifierPercentDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::TURN_RADIUS, &BuildTurnRadiusDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::WALKING_SPEED, &BuildWalkingSpeedDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::WATER_MODIFIER_PERCENT, &BuildWaterModifierPrecentDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::MISSION_CRITICAL_OBJECT, &BuildMissionCriticalObjectDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::ANIMATION, &BuildAnimationDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::MOOD_ANIMATION, &BuildMoodAnimationDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::WEAPON_ID, &BuildWeaponIdDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::GROUP_ID, &BuildGroupIdDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::INVITE_SENDER_ID, &BuildInviteSenderIdDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::GUILD_ID, &BuildGuildIdDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::TARGET_ID, &BuildTargetIdDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::PERFORMANCE_ID, &BuildPerformanceIdDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::STAT_CURRENT, &BuildStatCurrentDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::STAT_MAX, &BuildStatMaxDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::EQUIPMENT_ITEM, &BuildEquipmentDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::DISGUISE, &BuildDisguiseDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::STATIONARY, &BuildStationaryDelta);
+    PropertyChannel<Creature>::Subscribe(Creature::Property::PVP_STATUS, &BuildUpdatePvpStatusMessage);
+}
+shared_ptr<const BaselinesSnapshot> CreatureMessageBuilder::GetBaselines(const shared_ptr<Creature>& creature)
+{
+    return creature->GetBaselinesSnapshot([&creature] () -> BaselinesCacheContainer
+    {
+        BaselinesCacheContainer baselines;
+        baselines.push_back(BuildBaseline1(creature));
+        baselines.push_back(BuildBaseline3(creature));
+        baselines.push_back(BuildBaseline4(creature));
+        baselines.push_back(BuildBaseline6(creature));
+        return baselines;
     });
 }
 void CreatureMessageBuilder::SendBaselines(const shared_ptr<Creature>& creature, const shared_ptr<ObjectController>& controller)
 {
-    creature->AddBaselineToCache(BuildBaseline1(creature));
-    creature->AddBaselineToCache(BuildBaseline3(creature));
-    creature->AddBaselineToCache(BuildBaseline4(creature));
-    creature->AddBaselineToCache(BuildBaseline6(creature));
-    for (auto& baseline : creature->GetBaselines())
+    for (auto& baseline : *GetBaselines(creature))
     {
         controller->Notify(baseline);
     }
-        
+
     SendEndBaselines(creature, controller);
 
     BuildUpdatePvpStatusMessage(creature);
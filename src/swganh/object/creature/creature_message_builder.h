@@ -26,6 +26,11 @@ public:
     }
     virtual void RegisterEventHandlers();
     virtual void SendBaselines(const std::shared_ptr<Creature>& creature, const std::shared_ptr<ObjectController>& controller);
+    /**
+     * Returns the creature's serialized baselines, built only if it changed since
+     * they were last asked for.
+     */
+    static std::shared_ptr<const BaselinesSnapshot> GetBaselines(const std::shared_ptr<Creature>& creature);
 private:
     // deltas
     static void BuildBankCreditsDelta(const std::shared_ptr<Creature>& creature);
@@ -17,9 +17,6 @@ bool FactoryCrateFactory::HasTemplate(const string& template_name)
     return false;
 }
 
-void FactoryCrateFactory::PersistObject(const shared_ptr<Object>& object)
-{}
-
 void FactoryCrateFactory::DeleteObjectFromStorage(const shared_ptr<Object>& object)
 {}
 
@@ -17,9 +17,6 @@ bool GroupFactory::HasTemplate(const string& template_name)
     return false;
 }
 
-void GroupFactory::PersistObject(const shared_ptr<Object>& object)
-{}
-
 void GroupFactory::DeleteObjectFromStorage(const shared_ptr<Object>& object)
 {}
 
@@ -17,9 +17,6 @@ bool GuildFactory::HasTemplate(const string& template_name)
     return false;
 }
 
-void GuildFactory::PersistObject(const shared_ptr<Object>& object)
-{}
-
 void GuildFactory::DeleteObjectFromStorage(const shared_ptr<Object>& object)
 {}
 
@@ -17,9 +17,6 @@ bool HarvesterInstallationFactory::HasTemplate(const string& template_name)
     return false;
 }
 
-void HarvesterInstallationFactory::PersistObject(const shared_ptr<Object>& object)
-{}
-
 void HarvesterInstallationFactory::DeleteObjectFromStorage(const shared_ptr<Object>& object)
 {}
 
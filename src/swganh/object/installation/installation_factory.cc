@@ -17,9 +17,6 @@ bool InstallationFactory::HasTemplate(const string& template_name)
     return false;
 }
 
-void InstallationFactory::PersistObject(const shared_ptr<Object>& object)
-{}
-
 void InstallationFactory::DeleteObjectFromStorage(const shared_ptr<Object>& object)
 {}
 
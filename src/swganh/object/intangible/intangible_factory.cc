@@ -35,7 +35,7 @@ void IntangibleFactory::LoadTemplates()
     try {
 
         auto conn = db_manager_->getConnection("galaxy");
-        auto statement = conn->prepareStatement("CALL sp_GetIntangibleTemplates();");
+        auto statement = db_manager_->prepareStatement(conn, "CALL sp_GetIntangibleTemplates();");
         auto result = unique_ptr<sql::ResultSet>(statement->executeQuery());
 
         while (result->next())
@@ -65,19 +65,21 @@ bool IntangibleFactory::HasTemplate(const string& template_name)
     return GetTemplateIter_(template_name) != end(intangible_templates_);
 }
 
-void IntangibleFactory::PersistObject(const shared_ptr<Object>& object)
+void IntangibleFactory::PersistObject(const shared_ptr<Object>& object, const shared_ptr<sql::Connection>& connection)
 {
     if (object->IsDirty() && object->GetType() == Intangible::type)
     {
         try 
         {
-            auto conn = db_manager_->getConnection("galaxy");
-            auto statement = conn->prepareStatement("CALL sp_PersistIntangible(?,?);");
+            auto statement = db_manager_->prepareStatement(connection, "CALL sp_PersistIntangible(?,?);");
             
             auto intangible = make_shared<Intangible>();
             statement->setString(1, intangible->GetStfDetailFile());
             statement->setString(2, intangible->GetStfDetailString());
             statement->execute();
+
+            // the statement writes everything stored for the type
+            object->ClearPersistDirty();
         }
             catch(sql::SQLException &e)
         {
@@ -92,7 +94,7 @@ void IntangibleFactory::DeleteObjectFromStorage(const shared_ptr<Object>& object
     try 
     {
         auto conn = db_manager_->getConnection("galaxy");
-        auto statement = conn->prepareStatement("CALL sp_DeleteIntangible(?);");
+        auto statement = db_manager_->prepareStatement(conn, "CALL sp_DeleteIntangible(?);");
         statement->setUInt64(1, object->GetObjectId());
         statement->execute();
     }
@@ -121,8 +123,7 @@ shared_ptr<Object> IntangibleFactory::CreateObjectFromStorage(uint64_t object_id
             result.reset(statement->getResultSet());
             while (result->next())
             {
-                intangible->SetStfDetail(result->getString("stf_detail_file"),
-                                         result->getString("stf_detail_string"));
+                LoadIntangibleRow(intangible, result);
             }
         }
     }
@@ -134,6 +135,12 @@ shared_ptr<Object> IntangibleFactory::CreateObjectFromStorage(uint64_t object_id
     return intangible;
 }
 
+void IntangibleFactory::LoadIntangibleRow(const shared_ptr<Intangible>& intangible, const shared_ptr<sql::ResultSet>& result)
+{
+    intangible->SetStfDetail(result->getString("stf_detail_file"),
+                             result->getString("stf_detail_string"));
+}
+
 shared_ptr<Object> IntangibleFactory::CreateObjectFromTemplate(const string& template_name)
 {
     auto object = make_shared<Intangible>();
@@ -32,12 +32,17 @@ namespace intangible {
 
         bool HasTemplate(const std::string& template_name);
 
-        void PersistObject(const std::shared_ptr<swganh::object::Object>& object);
+        void PersistObject(const std::shared_ptr<swganh::object::Object>& object, const std::shared_ptr<sql::Connection>& connection);
 
         void DeleteObjectFromStorage(const std::shared_ptr<swganh::object::Object>& object);
 
         std::shared_ptr<swganh::object::Object> CreateObjectFromStorage(uint64_t object_id);
 
+        /**
+         * Loads in intangible values from the current row of a result set
+         */
+        static void LoadIntangibleRow(const std::shared_ptr<Intangible>& intangible, const std::shared_ptr<sql::ResultSet>& result);
+
         std::shared_ptr<swganh::object::Object> CreateObjectFromTemplate(const std::string& template_name);
 
         virtual void RegisterEventHandlers(){}
@@ -17,9 +17,6 @@ bool ManufactureSchematicFactory::HasTemplate(const string& template_name)
     return false;
 }
 
-void ManufactureSchematicFactory::PersistObject(const shared_ptr<Object>& object)
-{}
-
 void ManufactureSchematicFactory::DeleteObjectFromStorage(const shared_ptr<Object>& object)
 {}
 
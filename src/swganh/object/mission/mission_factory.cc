@@ -17,9 +17,6 @@ bool MissionFactory::HasTemplate(const string& template_name)
     return false;
 }
 
-void MissionFactory::PersistObject(const shared_ptr<Object>& object)
-{}
-
 void MissionFactory::DeleteObjectFromStorage(const shared_ptr<Object>& object)
 {}
 
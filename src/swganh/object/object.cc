@@ -13,22 +13,29 @@
 #include "swganh/messages/scene_create_object_by_crc.h"
 #include "swganh/messages/scene_end_baselines.h"
 #include "swganh/messages/update_containment_message.h"
+#include "swganh/object/property_channel.h"
 
 using namespace anh::observer;
 using namespace std;
 using namespace swganh::object;
 using namespace swganh::messages;
 
+atomic<bool> Object::deltas_deferred_(false);
+atomic<uint64_t> Object::baselines_cache_hits_(0);
+atomic<uint64_t> Object::baselines_cache_misses_(0);
+
 Object::Object()
     : object_id_(0)
-    , template_string_("")
-    , position_(glm::vec3(0,0,0))
-    , orientation_(glm::quat(0,0,0,0))
+    , template_string_(make_shared<string>())
     , complexity_(0)
     , stf_name_file_("")
     , stf_name_string_("")
     , custom_name_(L"")
     , volume_(0)
+    , observers_(make_shared<ObserverContainer>())
+    , baselines_version_(0)
+    , snapshot_version_(0)
+    , persist_dirty_(PERSIST_ALL)
 {
 }
 
@@ -95,16 +102,18 @@ bool Object::IsContainerForObject(const shared_ptr<Object>& object)
 
 void Object::RemoveContainedObject(const shared_ptr<Object>& object)
 {
-	boost::lock_guard<boost::mutex> lock(object_mutex_);
-    auto find_iter = contained_objects_.find(object->GetObjectId());
-
-    if (find_iter == contained_objects_.end())
     {
-        /// @TODO consider whether encountering this scenario is an error
-        return;
-    }
+	    boost::lock_guard<boost::mutex> lock(object_mutex_);
+        auto find_iter = contained_objects_.find(object->GetObjectId());
+
+        if (find_iter == contained_objects_.end())
+        {
+            /// @TODO consider whether encountering this scenario is an error
+            return;
+        }
 
-    contained_objects_.erase(find_iter);
+        contained_objects_.erase(find_iter);
+    }
 
     if (HasController())
     {
@@ -145,7 +154,7 @@ void Object::RemoveAwareObject(const shared_ptr<Object>& object)
 	    boost::lock_guard<boost::mutex> lock(object_mutex_);
         auto find_iter = aware_objects_.find(object->GetObjectId());
 
-        if (find_iter != aware_objects_.end())
+        if (find_iter == aware_objects_.end())
         {
             return;
         }
@@ -153,29 +162,29 @@ void Object::RemoveAwareObject(const shared_ptr<Object>& object)
         aware_objects_.erase(find_iter);
     }
 
-    if (HasController())
+    // Mirrors AddAwareObject, which subscribes the aware object's controller.
+    if (object->HasController())
     {
-        object->Unsubscribe(GetController());
+        Unsubscribe(object->GetController());
     }
 }
 string Object::GetTemplate()
 {
-    boost::lock_guard<boost::mutex> lock(object_mutex_);
-	return template_string_;
+    return *atomic_load(&template_string_);
 }
 void Object::SetTemplate(const string& template_string)
 {
-    {
-        boost::lock_guard<boost::mutex> lock(object_mutex_);
-	    template_string_ = template_string;
-    }
-    GetEventDispatcher()->Dispatch(make_shared<ObjectEvent>
-        ("Object::Template",shared_from_this()));
+    atomic_store(&template_string_, make_shared<const string>(template_string));
+    PropertyChannel<Object>::Notify(Property::TEMPLATE, shared_from_this());
 }
 void Object::SetObjectId(uint64_t object_id)
 {
-    boost::lock_guard<boost::mutex> lock(object_mutex_);
-	object_id_ = object_id;
+    {
+        boost::lock_guard<boost::mutex> lock(object_mutex_);
+	    object_id_ = object_id;
+    }
+
+    InvalidateBaselines();
 }
 uint64_t Object::GetObjectId()
 {
@@ -195,63 +204,101 @@ void Object::SetCustomName(wstring custom_name)
         custom_name_ = custom_name;
     }
     
-    GetEventDispatcher()->Dispatch(make_shared<ObjectEvent>
-        ("Object::CustomName",shared_from_this()));
+    PropertyChannel<Object>::Notify(Property::CUSTOM_NAME, shared_from_this());
 }
 
 bool Object::HasObservers()
 {
 	boost::lock_guard<boost::mutex> lock(object_mutex_);
-    return !observers_.empty();
+    return !observers_->empty();
 }
 
 void Object::Subscribe(const shared_ptr<ObserverInterface>& observer)
 {
+    // Queued deltas predate the new observer, which gets the current state from its baselines.
+    FlushDeltas();
+
 	boost::lock_guard<boost::mutex> lock(object_mutex_);
-    auto find_iter = std::find_if(
-        observers_.begin(),
-        observers_.end(),
-        [&observer] (const std::shared_ptr<ObserverInterface>& stored_observer)
-    {
-        return observer == stored_observer;
-    });
+    auto find_iter = std::find(observers_->begin(), observers_->end(), observer);
 
-    if (find_iter != observers_.end())
+    if (find_iter != observers_->end())
     {
         return;
     }
 
-    observers_.push_back(observer);
+    auto observers = make_shared<ObserverContainer>(*observers_);
+    observers->push_back(observer);
+    observers_ = move(observers);
 }
 
 void Object::Unsubscribe(const shared_ptr<ObserverInterface>& observer)
 {
 	boost::lock_guard<boost::mutex> lock(object_mutex_);
-    auto find_iter = std::find_if(
-        observers_.begin(),
-        observers_.end(),
-        [&observer] (const std::shared_ptr<ObserverInterface>& stored_observer)
-    {
-        return observer == stored_observer;
-    });
+    auto find_iter = std::find(observers_->begin(), observers_->end(), observer);
 
-    if (find_iter == observers_.end())
+    if (find_iter == observers_->end())
     {
         return;
     }
 
-    observers_.erase(find_iter);
+    auto observers = make_shared<ObserverContainer>(*observers_);
+    observers->erase(observers->begin() + (find_iter - observers_->begin()));
+    observers_ = move(observers);
+}
+
+void Object::NotifyObservers(const BroadcastMessage& message)
+{
+    shared_ptr<const ObserverContainer> observers;
+
+    {
+        boost::lock_guard<boost::mutex> lock(object_mutex_);
+        observers = observers_;
+    }
+
+    for (const auto& observer : *observers)
+    {
+        observer->Notify(message);
+    }
 }
 
 void Object::NotifyObservers(const anh::ByteBuffer& message)
 {
-    NotifyObservers<anh::ByteBuffer>(message);
+    NotifyObservers(BroadcastMessage(message));
 }
 
 bool Object::IsDirty()
 {
 	boost::lock_guard<boost::mutex> lock(object_mutex_);
-    return !deltas_.empty();
+    return !deltas_.empty() || !pending_deltas_.empty();
+}
+
+void Object::MarkPersistDirty(uint32_t groups)
+{
+    if (groups != PERSIST_NONE)
+    {
+        persist_dirty_.fetch_or(groups);
+    }
+}
+
+uint32_t Object::TakePersistDirty(uint32_t groups)
+{
+    return persist_dirty_.fetch_and(~groups) & groups;
+}
+
+uint32_t Object::GetPersistDirty() const
+{
+    return persist_dirty_;
+}
+
+void Object::ClearPersistDirty()
+{
+    persist_dirty_ = PERSIST_NONE;
+}
+
+uint32_t Object::GetPersistGroup(Property property)
+{
+    // every property of the base object is stored by sp_PersistObject
+    return PERSIST_OBJECT;
 }
 void Object::ClearBaselines()
 {
@@ -305,11 +352,121 @@ DeltasCacheContainer Object::GetDeltas(uint64_t viewer_id)
 
 void Object::AddDeltasUpdate(DeltasMessage message)
 {
+    InvalidateBaselines();
+
+    if (deltas_deferred_)
+    {
+        bool was_clean;
+
+        {
+            boost::lock_guard<boost::mutex> lock(object_mutex_);
+            was_clean = pending_deltas_.empty();
+            pending_deltas_.push_back(move(message));
+        }
+
+        if (was_clean)
+        {
+            GetEventDispatcher()->Dispatch(make_shared<ObjectEvent>
+                ("Object::DeltasPending", shared_from_this()));
+        }
+
+        return;
+    }
+
     NotifyObservers(message);
 
 	boost::lock_guard<boost::mutex> lock(object_mutex_);
     deltas_.push_back(move(message));
 }
+
+void Object::FlushDeltas()
+{
+    // Serializes flushes so merged deltas reach observers in the order they were queued.
+    boost::lock_guard<boost::mutex> flush_lock(flush_mutex_);
+
+    DeltasCacheContainer pending;
+
+    {
+        boost::lock_guard<boost::mutex> lock(object_mutex_);
+        pending.swap(pending_deltas_);
+    }
+
+    if (pending.empty())
+    {
+        return;
+    }
+
+    for (auto& message : CoalesceDeltas(pending))
+    {
+        NotifyObservers(message);
+
+        boost::lock_guard<boost::mutex> lock(object_mutex_);
+        deltas_.push_back(move(message));
+    }
+}
+
+void Object::SetDeltasDeferred(bool deferred)
+{
+    deltas_deferred_ = deferred;
+}
+
+bool Object::IsDeltasDeferred()
+{
+    return deltas_deferred_;
+}
+shared_ptr<const BaselinesSnapshot> Object::GetBaselinesSnapshot(
+    const function<BaselinesCacheContainer ()>& build)
+{
+    uint32_t version;
+
+    {
+        boost::lock_guard<boost::mutex> lock(object_mutex_);
+        version = baselines_version_;
+
+        if (baselines_snapshot_ && snapshot_version_ == version)
+        {
+            ++baselines_cache_hits_;
+            return baselines_snapshot_;
+        }
+    }
+
+    ++baselines_cache_misses_;
+
+    auto snapshot = make_shared<BaselinesSnapshot>();
+
+    for (auto& baseline : build())
+    {
+        auto buffer = make_shared<anh::ByteBuffer>();
+        baseline.Serialize(*buffer);
+        snapshot->push_back(move(buffer));
+    }
+
+    // Only keep the snapshot if nothing changed while it was being built.
+    boost::lock_guard<boost::mutex> lock(object_mutex_);
+    if (version == baselines_version_)
+    {
+        baselines_snapshot_ = snapshot;
+        snapshot_version_ = version;
+    }
+
+    return snapshot;
+}
+
+void Object::InvalidateBaselines()
+{
+    ++baselines_version_;
+}
+
+uint64_t Object::GetBaselinesCacheHits()
+{
+    return baselines_cache_hits_;
+}
+
+uint64_t Object::GetBaselinesCacheMisses()
+{
+    return baselines_cache_misses_;
+}
+
 void Object::AddBaselineToCache(swganh::messages::BaselinesMessage baseline)
 {
     boost::lock_guard<boost::mutex> lock(object_mutex_);
@@ -318,18 +475,18 @@ void Object::AddBaselineToCache(swganh::messages::BaselinesMessage baseline)
 
 void Object::SetPosition(glm::vec3 position)
 {
-    {
-	    boost::lock_guard<boost::mutex> lock(object_mutex_);
-        position_ = position;
-    }
+    transform_.Modify([&position] (Transform& transform) {
+        transform.position[0] = position.x;
+        transform.position[1] = position.y;
+        transform.position[2] = position.z;
+    });
 
-    GetEventDispatcher()->Dispatch(make_shared<ObjectEvent>
-        ("Object::Position",shared_from_this()));
+    PropertyChannel<Object>::Notify(Property::POSITION, shared_from_this());
 }
 glm::vec3 Object::GetPosition()
 {
-	boost::lock_guard<boost::mutex> lock(object_mutex_);
-	return position_;
+    Transform transform = transform_.Load();
+    return glm::vec3(transform.position[0], transform.position[1], transform.position[2]);
 }
 bool Object::InRange(glm::vec3 target, float range)
 {
@@ -341,51 +498,53 @@ bool Object::InRange(glm::vec3 target, float range)
 }
 void Object::SetOrientation(glm::quat orientation)
 {
-    {
-	    boost::lock_guard<boost::mutex> lock(object_mutex_);
-        orientation_ = orientation;
-    }
+    transform_.Modify([&orientation] (Transform& transform) {
+        transform.orientation[0] = orientation.x;
+        transform.orientation[1] = orientation.y;
+        transform.orientation[2] = orientation.z;
+        transform.orientation[3] = orientation.w;
+    });
 
-    GetEventDispatcher()->Dispatch(make_shared<ObjectEvent>
-        ("Object::Orientation",shared_from_this()));
+    PropertyChannel<Object>::Notify(Property::ORIENTATION, shared_from_this());
 }
 glm::quat Object::GetOrientation()
 {
-	boost::lock_guard<boost::mutex> lock(object_mutex_);
-	return orientation_;
+    Transform transform = transform_.Load();
+    return glm::quat(transform.orientation[3], transform.orientation[0], transform.orientation[1], transform.orientation[2]);
 }
 void Object::FaceObject(const std::shared_ptr<Object>& object)
 {
     auto target_position = object->GetPosition();
-    {
-	    boost::lock_guard<boost::mutex> lock(object_mutex_);
-        
+
+    transform_.Modify([&target_position] (Transform& transform) {
+        glm::vec3 position(transform.position[0], transform.position[1], transform.position[2]);
+
         // Create a mirror direction vector for the direction we want to face.
-        glm::vec3 direction_vector = glm::normalize(target_position - position_);
+        glm::vec3 direction_vector = glm::normalize(target_position - position);
         direction_vector.x = -direction_vector.x;
 
         // Create a lookat matrix from the direction vector and convert it to a quaternion.
-        orientation_ = glm::toQuat(glm::lookAt(
+        glm::quat orientation = glm::toQuat(glm::lookAt(
                                      direction_vector, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f)));                        
 
         // If in the 3rd quadrant the signs need to be flipped.
-        if (orientation_.y <= 0.0f && orientation_.w >= 0.0f) {
-            orientation_.y = -orientation_.y;
-            orientation_.w = -orientation_.w;
- 
+        if (orientation.y <= 0.0f && orientation.w >= 0.0f) {
+            orientation.y = -orientation.y;
+            orientation.w = -orientation.w;
         }
-    }
-    GetEventDispatcher()->Dispatch(make_shared<ObjectEvent>
-        ("Object::Orientation",shared_from_this()));
+
+        transform.orientation[0] = orientation.x;
+        transform.orientation[1] = orientation.y;
+        transform.orientation[2] = orientation.z;
+        transform.orientation[3] = orientation.w;
+    });
+
+    PropertyChannel<Object>::Notify(Property::ORIENTATION, shared_from_this());
 }
 
 uint8_t Object::GetHeading()
 {
-    glm::quat tmp;
-    {
-	    boost::lock_guard<boost::mutex> lock(object_mutex_);
-        tmp = orientation_;
-    }
+    glm::quat tmp = GetOrientation();
 
     if (tmp.y < 0.0f && tmp.w > 0.0f) {
         tmp.w *= -1;
@@ -401,8 +560,7 @@ void Object::SetContainer(const std::shared_ptr<Object>& container)
         container_ = container;
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<ObjectEvent>
-        ("Object::Container",shared_from_this()));
+    PropertyChannel<Object>::Notify(Property::CONTAINER, shared_from_this());
 }
 
 shared_ptr<Object> Object::GetContainer()
@@ -418,8 +576,7 @@ void Object::SetComplexity(float complexity)
         complexity_ = complexity;
     }
     
-    GetEventDispatcher()->Dispatch(make_shared<ObjectEvent>
-        ("Object::Complexity",shared_from_this()));
+    PropertyChannel<Object>::Notify(Property::COMPLEXITY, shared_from_this());
 }
 
 float Object::GetComplexity()
@@ -436,8 +593,7 @@ void Object::SetStfName(const string& stf_file_name, const string& stf_string)
         stf_name_string_ = stf_string;
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<ObjectEvent>
-        ("Object::StfName",shared_from_this()));
+    PropertyChannel<Object>::Notify(Property::STF_NAME, shared_from_this());
 }
 
 string Object::GetStfNameFile()
@@ -456,8 +612,7 @@ void Object::SetVolume(uint32_t volume)
 {
     volume_ = volume;
 
-    GetEventDispatcher()->Dispatch(make_shared<ObjectEvent>
-        ("Object::Volume",shared_from_this()));
+    PropertyChannel<Object>::Notify(Property::VOLUME, shared_from_this());
 }
 
 uint32_t Object::GetVolume()
@@ -469,8 +624,7 @@ void Object::SetSceneId(uint32_t scene_id)
 {
     scene_id_ = scene_id;
         
-    GetEventDispatcher()->Dispatch(make_shared<ObjectEvent>
-        ("Object::SceneId",shared_from_this()));
+    PropertyChannel<Object>::Notify(Property::SCENE_ID, shared_from_this());
 }
 
 uint32_t Object::GetSceneId()
@@ -18,6 +18,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
 
+#include "anh/seqlock.h"
 #include "anh/observer/observable_interface.h"
 #include "anh/observer/observer_interface.h"
 
@@ -41,6 +42,10 @@ typedef std::vector<
     swganh::messages::DeltasMessage
 > DeltasCacheContainer;
 
+typedef std::vector<
+    std::shared_ptr<const anh::ByteBuffer>
+> BaselinesSnapshot;
+
 class Object : public anh::observer::ObservableInterface, public std::enable_shared_from_this<Object>
 {
 public:
@@ -81,6 +86,51 @@ public:
         UNLINK = 0xFFFFFFFF,
         LINK = 4
     };
+
+    /**
+     * Groups of stored fields that are written together. An object keeps track
+     * of the groups changed since it was last persisted, so only those are
+     * written again.
+     */
+    enum PersistGroup : uint32_t
+    {
+        PERSIST_NONE = 0,
+        PERSIST_OBJECT = 0x00000001,
+        PERSIST_TANGIBLE = 0x00000002,
+        PERSIST_CREATURE = 0x00000004,
+        PERSIST_CREATURE_CREDITS = 0x00000008,
+        PERSIST_CREATURE_STATS = 0x00000010,
+        PERSIST_PLAYER = 0x00000020,
+        PERSIST_PLAYER_XP = 0x00000040,
+        PERSIST_PLAYER_FRIENDS = 0x00000080,
+        PERSIST_PLAYER_IGNORED = 0x00000100,
+        PERSIST_PLAYER_DRAFT_SCHEMATICS = 0x00000200,
+        PERSIST_PLAYER_FORCE_SENSITIVE_QUESTS = 0x00000400,
+        PERSIST_PLAYER_QUEST_JOURNAL = 0x00000800,
+        PERSIST_PLAYER_WAYPOINTS = 0x00001000,
+        PERSIST_ALL = PERSIST_OBJECT | PERSIST_TANGIBLE | PERSIST_CREATURE
+            | PERSIST_CREATURE_CREDITS | PERSIST_CREATURE_STATS | PERSIST_PLAYER
+            | PERSIST_PLAYER_XP | PERSIST_PLAYER_FRIENDS | PERSIST_PLAYER_IGNORED
+            | PERSIST_PLAYER_DRAFT_SCHEMATICS | PERSIST_PLAYER_FORCE_SENSITIVE_QUESTS
+            | PERSIST_PLAYER_QUEST_JOURNAL | PERSIST_PLAYER_WAYPOINTS
+    };
+
+    /**
+     * Properties whose changes are announced on the object's PropertyChannel.
+     */
+    enum class Property : uint16_t
+    {
+        TEMPLATE,
+        CUSTOM_NAME,
+        POSITION,
+        ORIENTATION,
+        CONTAINER,
+        COMPLEXITY,
+        STF_NAME,
+        VOLUME,
+        SCENE_ID,
+        PROPERTY_COUNT
+    };
     
     typedef std::map<
         uint64_t,
@@ -227,15 +277,7 @@ public:
             return;
         }
 
-        boost::lock_guard<boost::mutex> lock(object_mutex_);
-
-        std::for_each(
-            observers_.begin(),
-            observers_.end(),
-            [this, &message] (const std::shared_ptr<anh::observer::ObserverInterface>& observer)
-        {
-            observer->Notify(message);
-        });
+        NotifyObservers(anh::observer::BroadcastMessage(message));
     }
 
     /**
@@ -246,17 +288,19 @@ public:
     template<typename T>
     void NotifyObservers(const T& message)
     {
-	    boost::lock_guard<boost::mutex> lock(object_mutex_);
-
-        std::for_each(
-            observers_.begin(),
-            observers_.end(),
-            [&message] (const std::shared_ptr<anh::observer::ObserverInterface>& observer)
-        {
-            observer->Notify(message);
-        });
+        NotifyObservers(anh::observer::BroadcastMessage(message));
     }
 
+    /**
+     * Notifies observers with a message that has already been serialized.
+     *
+     * The observers are notified outside of the object's lock and all of them
+     * share the message's buffer.
+     *
+     * @param message Message containing the updated state of the observable object.
+     */
+    void NotifyObservers(const anh::observer::BroadcastMessage& message);
+
     void NotifyObservers(const anh::ByteBuffer& message);
 
     /**
@@ -268,7 +312,44 @@ public:
     bool IsDirty();
 
     /**
-     * Regenerates the baselines and updates observers.
+     * Marks groups of stored fields as changed, setters do so through the
+     * object's PropertyChannel.
+     *
+     * @param groups A combination of PersistGroup values.
+     */
+    void MarkPersistDirty(uint32_t groups);
+
+    /**
+     * Clears the given groups, to be called right before they are written.
+     *
+     * A change made while the groups are being written marks them again, so
+     * it is written the next time around. Writers that fail mark the groups
+     * they took again.
+     *
+     * @param groups A combination of PersistGroup values.
+     * @return Those of the given groups that were marked.
+     */
+    uint32_t TakePersistDirty(uint32_t groups);
+
+    /**
+     * @return The groups of stored fields changed since they were last written.
+     *  A new object has every group marked until it is written or loaded.
+     */
+    uint32_t GetPersistDirty() const;
+
+    /**
+     * Marks the object as matching storage, called once it is loaded.
+     */
+    void ClearPersistDirty();
+
+    /**
+     * @return The persistence group a property is stored with.
+     */
+    static uint32_t GetPersistGroup(Property property);
+
+    /**
+     * Sends the object to a new observer, regenerating its baselines only if the
+     * object changed since they were last sent.
      */
     void MakeClean(std::shared_ptr<swganh::object::ObjectController> controller);
 
@@ -449,6 +530,57 @@ public:
      */
     void AddDeltasUpdate(swganh::messages::DeltasMessage message);
 
+    /**
+     * Sends the deltas queued since the last flush to the observers, merged into
+     * one message per view.
+     *
+     * Only has an effect while deltas are deferred.
+     */
+    void FlushDeltas();
+
+    /**
+     * Controls whether deltas are sent to observers as soon as they are added or
+     * queued until the object is flushed.
+     *
+     * While deferred, the first delta queued on a clean object dispatches an
+     * "Object::DeltasPending" event so a replication stage can flush it later.
+     *
+     * @param deferred True to queue deltas until FlushDeltas is called.
+     */
+    static void SetDeltasDeferred(bool deferred);
+
+    /**
+     * @return True if deltas are queued until the object is flushed.
+     */
+    static bool IsDeltasDeferred();
+
+    /**
+     * Returns the serialized baselines of every view of the object.
+     *
+     * They are built the first time they are asked for after the object changes
+     * and shared, unmodified, with every observer until it changes again.
+     *
+     * @param build Builds the baselines of every view, used on a cache miss.
+     * @return The serialized baselines, in the order build returned them.
+     */
+    std::shared_ptr<const BaselinesSnapshot> GetBaselinesSnapshot(
+        const std::function<BaselinesCacheContainer ()>& build);
+
+    /**
+     * Discards the baselines snapshot, called whenever the object changes.
+     */
+    void InvalidateBaselines();
+
+    /**
+     * @return The number of baselines requests served from a snapshot, across all objects.
+     */
+    static uint64_t GetBaselinesCacheHits();
+
+    /**
+     * @return The number of baselines requests that had to build them, across all objects.
+     */
+    static uint64_t GetBaselinesCacheMisses();
+
     void AddBaselineToCache(swganh::messages::BaselinesMessage baseline);
 
     /**
@@ -480,9 +612,19 @@ protected:
 
 	std::atomic<uint64_t> object_id_;                // create
 	std::atomic<uint32_t> scene_id_;				 // create
-    std::string template_string_;                    // create
-    glm::vec3 position_;                             // create
-    glm::quat orientation_;                          // create
+    /**
+     * Where the object is, read on every movement and range query.
+     */
+    struct Transform
+    {
+        float position[3];
+        float orientation[4];                        // x, y, z, w
+    };
+
+    // Read and replaced with the atomic shared_ptr functions, without taking the
+    // object lock. A replaced string lives until its last reader lets go of it.
+    std::shared_ptr<const std::string> template_string_; // create
+    anh::Seqlock<Transform> transform_;              // create
     float complexity_;                               // update 3
     std::string stf_name_file_;                      // update 3
     std::string stf_name_string_;                    // update 3
@@ -499,15 +641,29 @@ private:
     ObjectMap aware_objects_;
     ObjectMap contained_objects_;
 
-    ObserverContainer observers_;
+    // Replaced rather than modified, so notifying can walk a snapshot without the lock.
+    std::shared_ptr<const ObserverContainer> observers_;
     BaselinesCacheContainer baselines_;
     DeltasCacheContainer deltas_;
+    DeltasCacheContainer pending_deltas_;
+    boost::mutex flush_mutex_;
+
+    static std::atomic<bool> deltas_deferred_;
+
+    // Bumped on every change, a snapshot is only current while it matches.
+    std::atomic<uint32_t> baselines_version_;
+    uint32_t snapshot_version_;
+    std::shared_ptr<const BaselinesSnapshot> baselines_snapshot_;
+
+    static std::atomic<uint64_t> baselines_cache_hits_;
+    static std::atomic<uint64_t> baselines_cache_misses_;
 
     std::shared_ptr<Object> container_;
     std::shared_ptr<ObjectController> controller_;
     anh::EventDispatcher* event_dispatcher_;
 
     bool is_dirty_;
+    std::atomic<uint32_t> persist_dirty_;
 };
 
 }}  // namespace
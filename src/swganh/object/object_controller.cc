@@ -68,6 +68,11 @@ void ObjectController::Notify(const anh::ByteBuffer& message)
     client_->SendTo(message);
 }
 
+void ObjectController::Notify(const shared_ptr<const anh::ByteBuffer>& message)
+{
+    client_->SendTo(message);
+}
+
 bool ObjectController::SendSystemMessage(const wstring& custom_message, bool chatbox_only, bool send_to_inrange)
 {
     // Use regex to check if the chat string matches the stf string format.
@@ -92,6 +92,13 @@ namespace object {
          */
         void Notify(const anh::ByteBuffer& message);
 
+        /**
+         * Notifies the controller with a message shared with other observers.
+         *
+         * @param message The message to be delivered to the remote client as is.
+         */
+        void Notify(const std::shared_ptr<const anh::ByteBuffer>& message);
+
         // Send System Message
 
         /**
@@ -31,12 +31,17 @@ ObjectFactory::ObjectFactory(DatabaseManagerInterface* db_manager,
     , event_dispatcher_(event_dispatcher)
 {
 }
-void ObjectFactory::PersistObject(const shared_ptr<Object>& object)
+void ObjectFactory::PersistObject(const shared_ptr<Object>& object, const shared_ptr<sql::Connection>& connection)
 {
+    uint32_t groups = object->TakePersistDirty(Object::PERSIST_OBJECT);
+    if (groups == Object::PERSIST_NONE)
+    {
+        return;
+    }
+
     try {
-        auto conn = db_manager_->getConnection("galaxy");
-        auto statement = shared_ptr<sql::PreparedStatement>
-            (conn->prepareStatement("CALL sp_PersistObject(?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?);"));
+        auto statement = db_manager_->prepareStatement(connection,
+            "CALL sp_PersistObject(?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?);");
         PersistObject(object, statement);
         // Now execute the update
         statement->executeUpdate();
@@ -45,6 +50,7 @@ void ObjectFactory::PersistObject(const shared_ptr<Object>& object)
     {
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
+        object->MarkPersistDirty(groups);
     }
 }
 void ObjectFactory::PersistObject(const shared_ptr<Object>& object, const shared_ptr<sql::PreparedStatement>& prepared_statement)
@@ -91,23 +97,7 @@ void ObjectFactory::CreateBaseObjectFromStorage(const shared_ptr<Object>& object
         result->next();
         // Set Event Dispatcher
         object->SetEventDispatcher(event_dispatcher_);
-        object->SetSceneId(result->getUInt("scene_id"));
-        object->SetPosition(glm::vec3(result->getDouble("x_position"),result->getDouble("y_position"), result->getDouble("z_position")));
-        object->SetOrientation(glm::quat(
-            static_cast<float>(result->getDouble("x_orientation")),
-            static_cast<float>(result->getDouble("y_orientation")),
-            static_cast<float>(result->getDouble("z_orientation")), 
-            static_cast<float>(result->getDouble("w_orientation")))
-            );
-
-        object->SetComplexity(static_cast<float>(result->getDouble("complexity")));
-        object->SetStfName(result->getString("stf_name_file"),
-                           result->getString("stf_name_string"));
-        string custom_string = result->getString("custom_name");
-        object->SetCustomName(wstring(begin(custom_string), end(custom_string)));
-        object->SetVolume(result->getUInt("volume"));
-        object->SetTemplate(result->getString("iff_template"));
-        
+        LoadObjectRow(object, result);
     }
     catch(sql::SQLException &e)
     {
@@ -116,12 +106,32 @@ void ObjectFactory::CreateBaseObjectFromStorage(const shared_ptr<Object>& object
     }
 }
 
+void ObjectFactory::LoadObjectRow(const shared_ptr<Object>& object, const shared_ptr<sql::ResultSet>& result)
+{
+    object->SetSceneId(result->getUInt("scene_id"));
+    object->SetPosition(glm::vec3(result->getDouble("x_position"),result->getDouble("y_position"), result->getDouble("z_position")));
+    object->SetOrientation(glm::quat(
+        static_cast<float>(result->getDouble("x_orientation")),
+        static_cast<float>(result->getDouble("y_orientation")),
+        static_cast<float>(result->getDouble("z_orientation")),
+        static_cast<float>(result->getDouble("w_orientation")))
+        );
+
+    object->SetComplexity(static_cast<float>(result->getDouble("complexity")));
+    object->SetStfName(result->getString("stf_name_file"),
+                       result->getString("stf_name_string"));
+    string custom_string = result->getString("custom_name");
+    object->SetCustomName(wstring(begin(custom_string), end(custom_string)));
+    object->SetVolume(result->getUInt("volume"));
+    object->SetTemplate(result->getString("iff_template"));
+}
+
 uint32_t ObjectFactory::LookupType(uint64_t object_id) const
 {
     uint32_t type = 0;
     try {
         auto conn = db_manager_->getConnection("galaxy");
-        auto statement = conn->prepareStatement("CALL sp_GetType(?);");
+        auto statement = db_manager_->prepareStatement(conn, "CALL sp_GetType(?);");
         statement->setUInt64(1, object_id);
         auto result = unique_ptr<sql::ResultSet>(statement->executeQuery());        
         while (result->next())
@@ -138,25 +148,39 @@ uint32_t ObjectFactory::LookupType(uint64_t object_id) const
     }
 }
 
-void ObjectFactory::LoadContainedObjects(
-    const shared_ptr<Object>& object,
+ObjectFactory::ContainedObjectList ObjectFactory::ReadContainedObjects(
     const shared_ptr<Statement>& statement)
 {
+    ContainedObjectList contained_objects;
+
     // Check for contained objects        
     if (statement->getMoreResults())
     {
         unique_ptr<ResultSet> result(statement->getResultSet());
 
-        uint64_t contained_id;
-        uint32_t contained_type;
-
         while (result->next())
         {
-            contained_id = result->getUInt64("id");
-            contained_type = result->getUInt("type_id");
-            auto contained_object = simulation_service_->LoadObjectById(contained_id, contained_type);
+            contained_objects.emplace_back(result->getUInt64("id"), result->getUInt("type_id"));
+        }
+    }
 
-            object->AddContainedObject(contained_object, Object::LINK);
+    return contained_objects;
+}
+
+void ObjectFactory::LoadContainedObjects(
+    const shared_ptr<Object>& object,
+    const ContainedObjectList& contained_objects)
+{
+    for (auto& contained : contained_objects)
+    {
+        auto contained_object = simulation_service_->LoadObjectById(contained.first, contained.second);
+
+        // the link matches storage, so it leaves a clean object clean
+        bool was_clean = contained_object->GetPersistDirty() == Object::PERSIST_NONE;
+        object->AddContainedObject(contained_object, Object::LINK);
+        if (was_clean)
+        {
+            contained_object->ClearPersistDirty();
         }
     }
 }
\ No newline at end of file
@@ -4,6 +4,10 @@
 #ifndef SWGANH_OBJECT_OBJECT_FACTORY_H_
 #define SWGANH_OBJECT_OBJECT_FACTORY_H_
 
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 #include "swganh/object/object_factory_interface.h"
 #include "anh/event_dispatcher.h"
 
@@ -13,6 +17,7 @@ class DatabaseManagerInterface;
 }} // anh::database
 
 namespace sql {
+    class Connection;
     class ResultSet;
     class Statement;
     class PreparedStatement;
@@ -42,9 +47,19 @@ namespace object {
          * @param the result set from which to load the values from
          */
         void CreateBaseObjectFromStorage(const std::shared_ptr<Object>& object, const std::shared_ptr<sql::ResultSet>& result);
+        /**
+         * Loads in base values from the current row of a result set
+         *
+         * @param the object which to load values into
+         * @param the result set positioned at the object's row
+         */
+        static void LoadObjectRow(const std::shared_ptr<Object>& object, const std::shared_ptr<sql::ResultSet>& result);
         virtual void LoadTemplates(){}
         virtual bool HasTemplate(const std::string& template_name){ return false; }
-        virtual void PersistObject(const std::shared_ptr<Object>& object);
+        /**
+         * Writes the base object if it changed since it was last written.
+         */
+        virtual void PersistObject(const std::shared_ptr<Object>& object, const std::shared_ptr<sql::Connection>& connection);
         /**
          * Persists the Base Object Data
          *
@@ -61,10 +76,26 @@ namespace object {
         virtual void RegisterEventHandlers(){}
 
     protected:
-        
+        /// Ids and types of the objects contained in a loaded object.
+        typedef std::vector<std::pair<uint64_t, uint32_t>> ContainedObjectList;
 
+        /**
+         * Reads the contained objects from the next result set of a statement
+         *
+         * @param the statement the object was loaded with
+         */
+        ContainedObjectList ReadContainedObjects(const std::shared_ptr<sql::Statement>& statement);
+        /**
+         * Loads the contained objects and links them into their container
+         *
+         * Each object is loaded through its own factory, which checks out a
+         * connection of its own; release the container's connection first.
+         *
+         * @param the object which contains the others
+         * @param the objects read with ReadContainedObjects
+         */
         void LoadContainedObjects(const std::shared_ptr<Object>& object,
-            const std::shared_ptr<sql::Statement>& statement);
+            const ContainedObjectList& contained_objects);
 
         anh::database::DatabaseManagerInterface* db_manager_;   
         swganh::simulation::SimulationService* simulation_service_;
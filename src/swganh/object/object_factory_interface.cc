@@ -0,0 +1,14 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include "swganh/object/object_factory_interface.h"
+
+#include "swganh/object/object.h"
+
+using namespace std;
+using namespace swganh::object;
+
+void ObjectFactoryInterface::PersistObject(const shared_ptr<Object>& object, const shared_ptr<sql::Connection>& connection)
+{
+    object->ClearPersistDirty();
+}
@@ -8,6 +8,10 @@
 #include <memory>
 #include <string>
 
+namespace sql {
+    class Connection;
+}  // namespace sql
+
 namespace swganh {
 namespace object {
 
@@ -35,8 +39,12 @@ namespace object {
          * Persists the object's state to storage.
          *
          * @param object the object instance to persist.
+         * @param connection the connection to write with, the writes become part of
+         *  any transaction the caller has open on it.
+         *
+         * By default nothing is stored for the type, the object is only marked clean.
          */
-        virtual void PersistObject(const std::shared_ptr<Object>& object) = 0;
+        virtual void PersistObject(const std::shared_ptr<Object>& object, const std::shared_ptr<sql::Connection>& connection);
 
         /**
          * Deletes the requested object from storage.
@@ -100,7 +100,7 @@ void ObjectManager::DeleteObjectFromStorage(const std::shared_ptr<Object>& objec
     return find_iter->second->DeleteObjectFromStorage(object);
 }
 
-void ObjectManager::PersistObject(const std::shared_ptr<Object>& object)
+void ObjectManager::PersistObject(const std::shared_ptr<Object>& object, const std::shared_ptr<sql::Connection>& connection)
 {
     auto find_iter = factories_.find(object->GetType());
 
@@ -109,5 +109,5 @@ void ObjectManager::PersistObject(const std::shared_ptr<Object>& object)
         throw InvalidObjectType("Cannot persist object to storage for an unregistered type.");
     }
 
-    return find_iter->second->PersistObject(object);
+    return find_iter->second->PersistObject(object, connection);
 }
@@ -148,8 +148,9 @@ namespace object {
          * Persists the object's state to storage.
          *
          * @param object the object instance to persist.
+         * @param connection the connection to write with.
          */
-        void PersistObject(const std::shared_ptr<Object>& object);
+        void PersistObject(const std::shared_ptr<Object>& object, const std::shared_ptr<sql::Connection>& connection);
 
     private:
         anh::EventDispatcher* event_dispatcher_;
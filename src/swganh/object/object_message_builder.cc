@@ -6,6 +6,7 @@
 #include <cstdint>
 
 #include "swganh/object/object.h"
+#include "swganh/object/property_channel.h"
 #include "swganh/messages/baselines_message.h"
 #include "swganh/messages/deltas_message.h"
 #include "swganh/messages/scene_end_baselines.h"
@@ -17,26 +18,10 @@ using namespace swganh::object;
 
 void ObjectMessageBuilder::RegisterEventHandlers()
 {
-    event_dispatcher->Subscribe("Object::CustomName", [this] (const shared_ptr<EventInterface>& incoming_event)
-    {
-        auto value_event = static_pointer_cast<ObjectEvent>(incoming_event);
-        BuildCustomNameDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Object::StfName", [this] (const shared_ptr<EventInterface>& incoming_event)
-    {
-        auto value_event = static_pointer_cast<ObjectEvent>(incoming_event);
-        BuildStfNameDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Object::Complexity", [this] (const shared_ptr<EventInterface>& incoming_event)
-    {
-        auto value_event = static_pointer_cast<ObjectEvent>(incoming_event);
-        BuildComplexityDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Object::Volume", [this] (const shared_ptr<EventInterface>& incoming_event)
-    {
-        auto value_event = static_pointer_cast<ObjectEvent>(incoming_event);
-        BuildVolumeDelta(value_event->Get());
-    });
+    PropertyChannel<Object>::Subscribe(Object::Property::CUSTOM_NAME, &BuildCustomNameDelta);
+    PropertyChannel<Object>::Subscribe(Object::Property::STF_NAME, &BuildStfNameDelta);
+    PropertyChannel<Object>::Subscribe(Object::Property::COMPLEXITY, &BuildComplexityDelta);
+    PropertyChannel<Object>::Subscribe(Object::Property::VOLUME, &BuildVolumeDelta);
 }
 
 void ObjectMessageBuilder::SendEndBaselines(const shared_ptr<Object>& object, const shared_ptr<ObjectController>& controller)
@@ -0,0 +1,510 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE Object Test
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <map>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "anh/byte_buffer.h"
+#include "anh/event_dispatcher.h"
+#include "anh/observer/observer_interface.h"
+#include "swganh/messages/deltas_message.h"
+#include "swganh/messages/obj_controller_message.h"
+#include "swganh/object/object.h"
+#include "swganh/object/property_channel.h"
+
+using namespace std;
+using swganh::messages::CoalesceDeltas;
+using swganh::messages::DeltasMessage;
+using swganh::messages::ObjControllerMessage;
+using swganh::object::Object;
+using swganh::object::PropertyChannel;
+
+namespace {
+
+DeltasMessage CreateDeltas(uint8_t view_type, uint16_t update_type, uint32_t value)
+{
+    DeltasMessage message;
+    message.object_id = 1;
+    message.object_type = 0x4352454F;
+    message.view_type = view_type;
+    message.update_count = 1;
+    message.update_type = update_type;
+    message.data.write<uint32_t>(value);
+    return message;
+}
+
+/**
+ * Applies received deltas the way a client does, every update in these tests
+ * carries a single uint32 value.
+ */
+class ClientObserver : public anh::observer::ObserverInterface
+{
+public:
+    ClientObserver()
+        : messages_received(0)
+    {}
+
+    uint64_t GetId() const { return 0; }
+
+    void Notify(const anh::ByteBuffer& message)
+    {
+        anh::ByteBuffer buffer(message.data(), message.size());
+        buffer.read<uint16_t>();
+        BOOST_REQUIRE_EQUAL(DeltasMessage::Opcode(), buffer.read<uint32_t>());
+
+        buffer.read<uint64_t>();
+        buffer.read<uint32_t>();
+        uint8_t view_type = buffer.read<uint8_t>();
+        uint32_t size = buffer.read<uint32_t>();
+        uint16_t update_count = buffer.read<uint16_t>();
+
+        BOOST_REQUIRE_EQUAL(size, 4u + update_count * 4u + (update_count - 1) * 2u);
+
+        for (uint16_t i = 0; i < update_count; ++i)
+        {
+            uint16_t update_type = buffer.read<uint16_t>();
+            state[make_pair(view_type, update_type)] = buffer.read<uint32_t>();
+        }
+
+        ++messages_received;
+    }
+
+    map<pair<uint8_t, uint16_t>, uint32_t> state;
+    uint32_t messages_received;
+};
+
+/**
+ * Keeps every buffer it is notified with.
+ */
+class RecordingObserver : public anh::observer::ObserverInterface
+{
+public:
+    explicit RecordingObserver(uint64_t id)
+        : id_(id)
+    {}
+
+    uint64_t GetId() const { return id_; }
+
+    void Notify(const anh::ByteBuffer& message)
+    {
+        buffers.push_back(make_shared<const anh::ByteBuffer>(message));
+    }
+
+    void Notify(const shared_ptr<const anh::ByteBuffer>& message)
+    {
+        buffers.push_back(message);
+    }
+
+    vector<shared_ptr<const anh::ByteBuffer>> buffers;
+
+private:
+    uint64_t id_;
+};
+
+swganh::object::BaselinesCacheContainer BuildBaselines(const shared_ptr<Object>& object, uint32_t& builds)
+{
+    ++builds;
+
+    swganh::messages::BaselinesMessage message;
+    message.object_id = object->GetObjectId();
+    message.object_type = object->GetType();
+    message.view_type = Object::VIEW_3;
+    message.object_opcount = 1;
+    message.data.write(object->GetCustomName());
+
+    swganh::object::BaselinesCacheContainer baselines;
+    baselines.push_back(move(message));
+    return baselines;
+}
+
+uint32_t custom_name_changes = 0;
+
+void CountCustomNameChange(const shared_ptr<Object>& object)
+{
+    BOOST_CHECK(L"Han" == object->GetCustomName());
+    ++custom_name_changes;
+}
+
+}  // namespace
+
+///
+class ObjectTest {
+public:
+    ObjectTest()
+        : event_dispatcher_(io_service_)
+    {}
+
+    ~ObjectTest()
+    {
+        Object::SetDeltasDeferred(false);
+    }
+
+protected:
+    shared_ptr<Object> CreateObject()
+    {
+        auto object = make_shared<Object>();
+        object->SetEventDispatcher(&event_dispatcher_);
+        object->SetObjectId(1);
+        return object;
+    }
+
+    void SendUpdates(const shared_ptr<Object>& object)
+    {
+        object->AddDeltasUpdate(CreateDeltas(3, 2, 100));
+        object->AddDeltasUpdate(CreateDeltas(6, 1, 7));
+        object->AddDeltasUpdate(CreateDeltas(3, 4, 250));
+        object->AddDeltasUpdate(CreateDeltas(3, 2, 90));
+        object->AddDeltasUpdate(CreateDeltas(6, 1, 8));
+        object->AddDeltasUpdate(CreateDeltas(3, 2, 80));
+    }
+
+    boost::asio::io_service io_service_;
+    anh::EventDispatcher event_dispatcher_;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ObjectNotifications, ObjectTest)
+
+///
+BOOST_AUTO_TEST_CASE(CoalesceDeltasMergesEachViewIntoOneMessage)
+{
+    vector<DeltasMessage> deltas;
+    deltas.push_back(CreateDeltas(3, 2, 100));
+    deltas.push_back(CreateDeltas(6, 1, 7));
+    deltas.push_back(CreateDeltas(3, 4, 250));
+
+    auto merged = CoalesceDeltas(deltas);
+
+    BOOST_REQUIRE_EQUAL(2u, merged.size());
+
+    BOOST_CHECK_EQUAL(3, merged[0].view_type);
+    BOOST_CHECK_EQUAL(2, merged[0].update_count);
+    BOOST_CHECK_EQUAL(2, merged[0].update_type);
+
+    anh::ByteBuffer data = merged[0].data;
+    BOOST_CHECK_EQUAL(100u, data.read<uint32_t>());
+    BOOST_CHECK_EQUAL(4, data.read<uint16_t>());
+    BOOST_CHECK_EQUAL(250u, data.read<uint32_t>());
+
+    BOOST_CHECK_EQUAL(6, merged[1].view_type);
+    BOOST_CHECK_EQUAL(1, merged[1].update_count);
+}
+
+///
+BOOST_AUTO_TEST_CASE(CoalesceDeltasSpillsWhenUpdateCountWouldOverflow)
+{
+    vector<DeltasMessage> deltas;
+    deltas.push_back(CreateDeltas(3, 2, 100));
+    deltas.back().update_count = 65535;
+    deltas.push_back(CreateDeltas(3, 4, 250));
+    deltas.push_back(CreateDeltas(3, 5, 1));
+
+    auto merged = CoalesceDeltas(deltas);
+
+    BOOST_REQUIRE_EQUAL(2u, merged.size());
+    BOOST_CHECK_EQUAL(65535, merged[0].update_count);
+    BOOST_CHECK_EQUAL(2, merged[1].update_count);
+    BOOST_CHECK_EQUAL(4, merged[1].update_type);
+}
+
+///
+BOOST_AUTO_TEST_CASE(DeltasAreSentImmediatelyWhenNotDeferred)
+{
+    auto object = CreateObject();
+    auto client = make_shared<ClientObserver>();
+    object->Subscribe(client);
+
+    SendUpdates(object);
+
+    BOOST_CHECK_EQUAL(6u, client->messages_received);
+}
+
+///
+BOOST_AUTO_TEST_CASE(DeferredDeltasGiveSameClientStateWithFewerMessages)
+{
+    auto immediate_object = CreateObject();
+    auto immediate_client = make_shared<ClientObserver>();
+    immediate_object->Subscribe(immediate_client);
+
+    SendUpdates(immediate_object);
+
+    Object::SetDeltasDeferred(true);
+
+    auto deferred_object = CreateObject();
+    auto deferred_client = make_shared<ClientObserver>();
+    deferred_object->Subscribe(deferred_client);
+
+    SendUpdates(deferred_object);
+
+    BOOST_CHECK_EQUAL(0u, deferred_client->messages_received);
+    BOOST_CHECK(deferred_object->IsDirty());
+
+    deferred_object->FlushDeltas();
+
+    BOOST_CHECK_EQUAL(2u, deferred_client->messages_received);
+    BOOST_CHECK(immediate_client->state == deferred_client->state);
+    BOOST_CHECK_EQUAL(80u, (deferred_client->state[make_pair<uint8_t, uint16_t>(3, 2)]));
+
+    // Nothing left to send.
+    deferred_object->FlushDeltas();
+    BOOST_CHECK_EQUAL(2u, deferred_client->messages_received);
+}
+
+///
+BOOST_AUTO_TEST_CASE(FirstQueuedDeltaDispatchesPendingEvent)
+{
+    uint32_t pending_events = 0;
+    event_dispatcher_.Subscribe("Object::DeltasPending", [&pending_events] (shared_ptr<anh::EventInterface>)
+    {
+        ++pending_events;
+    });
+
+    Object::SetDeltasDeferred(true);
+
+    auto object = CreateObject();
+    SendUpdates(object);
+
+    io_service_.run();
+    io_service_.reset();
+    BOOST_CHECK_EQUAL(1u, pending_events);
+
+    object->FlushDeltas();
+    object->AddDeltasUpdate(CreateDeltas(3, 2, 70));
+
+    io_service_.run();
+    BOOST_CHECK_EQUAL(2u, pending_events);
+}
+
+///
+BOOST_AUTO_TEST_CASE(SubscribingFlushesQueuedDeltasToExistingObservers)
+{
+    Object::SetDeltasDeferred(true);
+
+    auto object = CreateObject();
+    auto existing_client = make_shared<ClientObserver>();
+    object->Subscribe(existing_client);
+
+    SendUpdates(object);
+
+    auto new_client = make_shared<ClientObserver>();
+    object->Subscribe(new_client);
+
+    BOOST_CHECK_EQUAL(2u, existing_client->messages_received);
+    BOOST_CHECK_EQUAL(0u, new_client->messages_received);
+}
+
+///
+BOOST_AUTO_TEST_CASE(BroadcastSharesOneBufferBetweenObservers)
+{
+    auto object = CreateObject();
+    auto first = make_shared<RecordingObserver>(10);
+    auto second = make_shared<RecordingObserver>(20);
+    object->Subscribe(first);
+    object->Subscribe(second);
+
+    object->NotifyObservers(CreateDeltas(3, 2, 100));
+
+    BOOST_REQUIRE_EQUAL(1u, first->buffers.size());
+    BOOST_REQUIRE_EQUAL(1u, second->buffers.size());
+    BOOST_CHECK(first->buffers[0] == second->buffers[0]);
+
+    anh::ByteBuffer expected;
+    CreateDeltas(3, 2, 100).Serialize(expected);
+    BOOST_CHECK(*first->buffers[0] == expected);
+}
+
+///
+BOOST_AUTO_TEST_CASE(BroadcastPatchesObservableIdForEachObserver)
+{
+    auto object = CreateObject();
+    auto first = make_shared<RecordingObserver>(10);
+    auto second = make_shared<RecordingObserver>(20);
+    object->Subscribe(first);
+    object->Subscribe(second);
+
+    ObjControllerMessage message(0x0000000B, 0x00000071);
+    message.tick_count = 5;
+    message.data.write<uint32_t>(42);
+
+    object->NotifyObservers(message);
+
+    BOOST_REQUIRE_EQUAL(1u, first->buffers.size());
+    BOOST_REQUIRE_EQUAL(1u, second->buffers.size());
+
+    // Each observer gets what serializing the message with its own id produces.
+    anh::ByteBuffer expected;
+    message.observable_id = 10;
+    message.Serialize(expected);
+    BOOST_CHECK(*first->buffers[0] == expected);
+
+    expected.clear();
+    message.observable_id = 20;
+    message.Serialize(expected);
+    BOOST_CHECK(*second->buffers[0] == expected);
+}
+
+///
+BOOST_AUTO_TEST_CASE(UnsubscribedObserversAreNotNotified)
+{
+    auto object = CreateObject();
+    auto first = make_shared<RecordingObserver>(10);
+    auto second = make_shared<RecordingObserver>(20);
+    object->Subscribe(first);
+    object->Subscribe(second);
+    object->Unsubscribe(first);
+
+    object->NotifyObservers(CreateDeltas(3, 2, 100));
+
+    BOOST_CHECK_EQUAL(0u, first->buffers.size());
+    BOOST_CHECK_EQUAL(1u, second->buffers.size());
+    BOOST_CHECK(object->HasObservers());
+}
+
+///
+BOOST_AUTO_TEST_CASE(PropertyChangeRunsHandlersBeforeSetterReturns)
+{
+    PropertyChannel<Object>::Subscribe(Object::Property::CUSTOM_NAME, &CountCustomNameChange);
+    PropertyChannel<Object>::Subscribe(Object::Property::CUSTOM_NAME, &CountCustomNameChange);
+
+    BOOST_CHECK(PropertyChannel<Object>::HasSubscribers(Object::Property::CUSTOM_NAME));
+    BOOST_CHECK(!PropertyChannel<Object>::HasSubscribers(Object::Property::VOLUME));
+
+    custom_name_changes = 0;
+
+    auto object = CreateObject();
+    object->SetCustomName(L"Han");
+
+    // Handled inline and only once, even though it was registered twice.
+    BOOST_CHECK_EQUAL(1u, custom_name_changes);
+    BOOST_CHECK(io_service_.poll() == 0);
+}
+
+///
+BOOST_AUTO_TEST_CASE(BaselinesAreBuiltOnceUntilTheObjectChanges)
+{
+    auto object = CreateObject();
+    uint32_t builds = 0;
+    auto build = [&object, &builds] () { return BuildBaselines(object, builds); };
+
+    uint64_t hits = Object::GetBaselinesCacheHits();
+    uint64_t misses = Object::GetBaselinesCacheMisses();
+
+    auto first = object->GetBaselinesSnapshot(build);
+    auto second = object->GetBaselinesSnapshot(build);
+
+    BOOST_CHECK_EQUAL(1u, builds);
+    BOOST_CHECK(first == second);
+    BOOST_CHECK_EQUAL(hits + 1, Object::GetBaselinesCacheHits());
+    BOOST_CHECK_EQUAL(misses + 1, Object::GetBaselinesCacheMisses());
+
+    BOOST_REQUIRE_EQUAL(1u, first->size());
+    anh::ByteBuffer expected;
+    BuildBaselines(object, builds)[0].Serialize(expected);
+    BOOST_CHECK(*first->at(0) == expected);
+}
+
+///
+BOOST_AUTO_TEST_CASE(PropertyChangeInvalidatesBaselines)
+{
+    auto object = CreateObject();
+    uint32_t builds = 0;
+    auto build = [&object, &builds] () { return BuildBaselines(object, builds); };
+
+    auto before = object->GetBaselinesSnapshot(build);
+    object->SetCustomName(L"Han");
+    auto after = object->GetBaselinesSnapshot(build);
+
+    BOOST_CHECK_EQUAL(2u, builds);
+    BOOST_CHECK(before != after);
+    BOOST_CHECK(*before->at(0) != *after->at(0));
+
+    // Deltas built outside of a property change also mean the snapshot is stale.
+    object->AddDeltasUpdate(CreateDeltas(3, 2, 100));
+    object->GetBaselinesSnapshot(build);
+
+    BOOST_CHECK_EQUAL(3u, builds);
+}
+
+///
+BOOST_AUTO_TEST_CASE(PropertyChangeMarksItsPersistGroup)
+{
+    auto object = CreateObject();
+
+    // Nothing of a new object is in storage yet.
+    BOOST_CHECK_EQUAL(uint32_t(Object::PERSIST_ALL), object->GetPersistDirty());
+
+    object->ClearPersistDirty();
+    object->SetCustomName(L"Han");
+
+    BOOST_CHECK_EQUAL(uint32_t(Object::PERSIST_OBJECT), object->GetPersistDirty());
+
+    // Taking a group hands it to the writer once.
+    BOOST_CHECK_EQUAL(uint32_t(Object::PERSIST_OBJECT), object->TakePersistDirty(Object::PERSIST_OBJECT | Object::PERSIST_TANGIBLE));
+    BOOST_CHECK_EQUAL(uint32_t(Object::PERSIST_NONE), object->TakePersistDirty(Object::PERSIST_OBJECT));
+    BOOST_CHECK_EQUAL(uint32_t(Object::PERSIST_NONE), object->GetPersistDirty());
+}
+
+///
+BOOST_AUTO_TEST_CASE(TakingEveryGroupLeavesANewObjectClean)
+{
+    auto object = CreateObject();
+
+    // The groups a player stores and those it doesn't cover all of a new object.
+    uint32_t player_groups = Object::PERSIST_OBJECT | Object::PERSIST_PLAYER | Object::PERSIST_PLAYER_XP
+        | Object::PERSIST_PLAYER_FRIENDS | Object::PERSIST_PLAYER_IGNORED | Object::PERSIST_PLAYER_DRAFT_SCHEMATICS
+        | Object::PERSIST_PLAYER_FORCE_SENSITIVE_QUESTS | Object::PERSIST_PLAYER_QUEST_JOURNAL
+        | Object::PERSIST_PLAYER_WAYPOINTS;
+
+    object->TakePersistDirty(player_groups);
+    object->TakePersistDirty(~player_groups);
+
+    BOOST_CHECK_EQUAL(uint32_t(Object::PERSIST_NONE), object->GetPersistDirty());
+
+    // No bits outside of the real groups are ever set.
+    object->MarkPersistDirty(Object::PERSIST_ALL);
+    BOOST_CHECK_EQUAL(uint32_t(Object::PERSIST_ALL), object->TakePersistDirty(0xFFFFFFFF));
+    BOOST_CHECK_EQUAL(uint32_t(Object::PERSIST_NONE), object->GetPersistDirty());
+}
+
+///
+BOOST_AUTO_TEST_CASE(TemplateReadsSeeWholeTemplatesWhileItIsReplaced)
+{
+    auto object = CreateObject();
+    const string male = "object/creature/player/shared_human_male.iff";
+    const string female = "object/creature/player/shared_human_female.iff";
+    object->SetTemplate(male);
+
+    atomic<bool> done(false);
+    atomic<uint32_t> torn_reads(0);
+
+    boost::thread reader([&] {
+        while (!done)
+        {
+            string read = object->GetTemplate();
+            if (read != male && read != female)
+            {
+                ++torn_reads;
+            }
+        }
+    });
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        object->SetTemplate(i % 2 ? male : female);
+    }
+
+    done = true;
+    reader.join();
+
+    BOOST_CHECK_EQUAL(0u, torn_reads);
+    BOOST_CHECK_EQUAL(male, object->GetTemplate());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,273 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include "swganh/object/persistence_queue.h"
+
+#include <algorithm>
+#include <exception>
+
+#include <cppconn/connection.h>
+#include <cppconn/exception.h>
+
+#include "anh/logger.h"
+#include "anh/database/scoped_transaction.h"
+
+#include "swganh/object/object.h"
+
+using namespace std;
+using namespace anh::database;
+using namespace swganh::object;
+
+PersistenceQueue::PersistenceQueue(ConnectionSource connect, PersistHandler persist, uint32_t worker_count, uint32_t batch_size, uint32_t max_pending)
+    : connect_(move(connect))
+    , persist_(move(persist))
+    , batch_size_(max(1u, batch_size))
+    , max_pending_(max(1u, max_pending))
+    , stopping_(false)
+    , written_(0)
+    , coalesced_(0)
+    , skipped_(0)
+{
+    worker_count = max(1u, worker_count);
+
+    for (uint32_t i = 0; i < worker_count; ++i)
+    {
+        workers_.push_back(unique_ptr<Worker>(new Worker));
+    }
+
+    for (auto& worker : workers_)
+    {
+        Worker* worker_ptr = worker.get();
+        worker->thread = boost::thread([this, worker_ptr] { Run_(*worker_ptr); });
+    }
+}
+
+PersistenceQueue::~PersistenceQueue()
+{
+    Stop();
+}
+
+void PersistenceQueue::Enqueue(const shared_ptr<Object>& object)
+{
+    if (object->GetPersistDirty() == Object::PERSIST_NONE)
+    {
+        ++skipped_;
+        return;
+    }
+
+    uint64_t object_id = object->GetObjectId();
+    Worker& worker = *workers_[object_id % workers_.size()];
+
+    {
+        boost::unique_lock<boost::mutex> lock(worker.mutex);
+
+        if (worker.pending.count(object_id))
+        {
+            ++coalesced_;
+            return;
+        }
+
+        while (worker.running && !stopping_ && worker.pending.size() >= max_pending_)
+        {
+            worker.condition.wait(lock);
+        }
+
+        if (worker.running)
+        {
+            worker.order.push_back(object_id);
+            worker.pending.insert(make_pair(object_id, object));
+
+            worker.condition.notify_all();
+            return;
+        }
+    }
+
+    WriteBatch_(vector<shared_ptr<Object>>(1, object));
+}
+
+void PersistenceQueue::Flush()
+{
+    for (auto& worker : workers_)
+    {
+        boost::unique_lock<boost::mutex> lock(worker->mutex);
+
+        while (worker->running && (!worker->order.empty() || worker->writing))
+        {
+            worker->condition.wait(lock);
+        }
+    }
+}
+
+void PersistenceQueue::Stop()
+{
+    if (stopping_.exchange(true))
+    {
+        return;
+    }
+
+    for (auto& worker : workers_)
+    {
+        boost::lock_guard<boost::mutex> lock(worker->mutex);
+        worker->condition.notify_all();
+    }
+
+    for (auto& worker : workers_)
+    {
+        worker->thread.join();
+    }
+
+    LOG(info) << "Persistence queue stopped after writing " << written_
+        << " objects, " << coalesced_ << " saves coalesced, " << skipped_ << " clean objects skipped";
+}
+
+size_t PersistenceQueue::GetPendingCount() const
+{
+    size_t pending = 0;
+
+    for (const auto& worker : workers_)
+    {
+        boost::lock_guard<boost::mutex> lock(worker->mutex);
+        pending += worker->pending.size();
+    }
+
+    return pending;
+}
+
+uint64_t PersistenceQueue::GetWrittenCount() const
+{
+    return written_;
+}
+
+uint64_t PersistenceQueue::GetCoalescedCount() const
+{
+    return coalesced_;
+}
+
+uint64_t PersistenceQueue::GetSkippedCount() const
+{
+    return skipped_;
+}
+
+void PersistenceQueue::Run_(Worker& worker)
+{
+    vector<shared_ptr<Object>> batch;
+    batch.reserve(batch_size_);
+
+    for (;;)
+    {
+        {
+            boost::unique_lock<boost::mutex> lock(worker.mutex);
+
+            // Wakes flushes waiting on the batch just written.
+            worker.writing = false;
+            worker.condition.notify_all();
+
+            while (worker.order.empty() && !stopping_)
+            {
+                worker.condition.wait(lock);
+            }
+
+            if (worker.order.empty())
+            {
+                worker.running = false;
+                worker.condition.notify_all();
+                return;
+            }
+
+            while (!worker.order.empty() && batch.size() < batch_size_)
+            {
+                auto find_iter = worker.pending.find(worker.order.front());
+                worker.order.pop_front();
+
+                batch.push_back(move(find_iter->second));
+                worker.pending.erase(find_iter);
+            }
+
+            // Wakes enqueues waiting for room.
+            worker.writing = true;
+            worker.condition.notify_all();
+        }
+
+        WriteBatch_(batch);
+
+        batch.clear();
+    }
+}
+
+void PersistenceQueue::WriteBatch_(const vector<shared_ptr<Object>>& batch)
+{
+    shared_ptr<sql::Connection> connection;
+    unique_ptr<ScopedTransaction> transaction;
+
+    try
+    {
+        if (connect_)
+        {
+            connection = connect_();
+            if (connection)
+            {
+                transaction.reset(new ScopedTransaction(connection));
+            }
+        }
+    }
+    catch(sql::SQLException &e)
+    {
+        LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
+        LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
+
+        // The objects keep their changes and go out with their next save.
+        return;
+    }
+
+    // What each object had left to write, restored if the transaction is lost.
+    vector<uint32_t> groups;
+    groups.reserve(batch.size());
+
+    uint64_t written = 0;
+
+    for (const auto& object : batch)
+    {
+        groups.push_back(object->GetPersistDirty());
+
+        if (Persist_(object, connection))
+        {
+            ++written;
+        }
+    }
+
+    if (transaction)
+    {
+        try
+        {
+            transaction->commit();
+        }
+        catch(sql::SQLException &e)
+        {
+            LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
+            LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
+
+            for (size_t i = 0; i < batch.size(); ++i)
+            {
+                batch[i]->MarkPersistDirty(groups[i]);
+            }
+
+            return;
+        }
+    }
+
+    written_ += written;
+}
+
+bool PersistenceQueue::Persist_(const shared_ptr<Object>& object, const shared_ptr<sql::Connection>& connection)
+{
+    try
+    {
+        persist_(object, connection);
+        return true;
+    }
+    catch(const exception& e)
+    {
+        LOG(error) << "Failed to persist object " << object->GetObjectId() << ": " << e.what();
+        return false;
+    }
+}
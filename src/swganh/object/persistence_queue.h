@@ -0,0 +1,143 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef SWGANH_OBJECT_PERSISTENCE_QUEUE_H_
+#define SWGANH_OBJECT_PERSISTENCE_QUEUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+namespace sql {
+    class Connection;
+}  // namespace sql
+
+namespace swganh {
+namespace object {
+
+    class Object;
+
+    /**
+     * Writes objects to storage behind the back of the threads that change them.
+     *
+     * Enqueuing an object only marks it for saving, dedicated worker threads
+     * later read its state and write it. An object enqueued again before it was
+     * written is only written once, with the state it has by then. Objects
+     * that have not changed since they were last written are not queued at all.
+     *
+     * Objects are spread over the workers by id, so the writes of one object
+     * always happen in order on the same worker. Each worker drains its queue in
+     * batches of up to batch_size objects, and writes each batch on one
+     * connection in a single transaction. If the transaction fails to commit,
+     * the objects of the batch are marked dirty again. When a worker has
+     * max_pending objects waiting, Enqueue blocks until it catches up instead of
+     * letting the backlog grow without bound.
+     *
+     * Everything enqueued before Stop is written before it returns.
+     */
+    class PersistenceQueue : boost::noncopyable
+    {
+    public:
+        typedef std::function<std::shared_ptr<sql::Connection> ()> ConnectionSource;
+        typedef std::function<void (const std::shared_ptr<Object>&, const std::shared_ptr<sql::Connection>&)> PersistHandler;
+
+        /**
+         * Starts the worker threads.
+         *
+         * @param connect Checks out the connection a batch is written on. When empty,
+         *  batches are written without a connection or transaction.
+         * @param persist Writes a single object on the batch's connection, invoked on the worker threads.
+         * @param worker_count Number of worker threads.
+         * @param batch_size Most objects a worker takes off its queue at once.
+         * @param max_pending Most objects waiting on a single worker before Enqueue blocks.
+         */
+        PersistenceQueue(ConnectionSource connect, PersistHandler persist, uint32_t worker_count, uint32_t batch_size, uint32_t max_pending);
+        ~PersistenceQueue();
+
+        /**
+         * Marks the object for saving.
+         *
+         * Once stopped the object is written immediately on the calling thread.
+         */
+        void Enqueue(const std::shared_ptr<Object>& object);
+
+        /**
+         * Blocks until every object enqueued so far is written.
+         */
+        void Flush();
+
+        /**
+         * Writes everything still queued and stops the worker threads.
+         */
+        void Stop();
+
+        /**
+         * @return The number of objects waiting to be written.
+         */
+        size_t GetPendingCount() const;
+
+        /**
+         * @return The number of objects written.
+         */
+        uint64_t GetWrittenCount() const;
+
+        /**
+         * @return The number of enqueues absorbed by an earlier one of the same object.
+         */
+        uint64_t GetCoalescedCount() const;
+
+        /**
+         * @return The number of enqueues skipped because the object had no changes to write.
+         */
+        uint64_t GetSkippedCount() const;
+
+    private:
+        struct Worker
+        {
+            Worker()
+                : writing(false)
+                , running(true)
+            {}
+
+            mutable boost::mutex mutex;
+            boost::condition_variable condition;
+
+            std::deque<uint64_t> order;
+            std::unordered_map<uint64_t, std::shared_ptr<Object>> pending;
+            bool writing;
+
+            // Cleared once the worker drained its queue and exited.
+            bool running;
+
+            boost::thread thread;
+        };
+
+        void Run_(Worker& worker);
+        void WriteBatch_(const std::vector<std::shared_ptr<Object>>& batch);
+        bool Persist_(const std::shared_ptr<Object>& object, const std::shared_ptr<sql::Connection>& connection);
+
+        ConnectionSource connect_;
+        PersistHandler persist_;
+        uint32_t batch_size_;
+        uint32_t max_pending_;
+
+        std::vector<std::unique_ptr<Worker>> workers_;
+
+        std::atomic<bool> stopping_;
+        std::atomic<uint64_t> written_;
+        std::atomic<uint64_t> coalesced_;
+        std::atomic<uint64_t> skipped_;
+    };
+
+}}  // namespace swganh::object
+
+#endif  // SWGANH_OBJECT_PERSISTENCE_QUEUE_H_
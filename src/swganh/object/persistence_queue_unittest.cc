@@ -0,0 +1,246 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <boost/test/unit_test.hpp>
+#include <turtle/mock.hpp>
+
+#include <atomic>
+#include <map>
+#include <memory>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <cppconn/exception.h>
+
+#include "anh/database/mock_cppconn.h"
+#include "swganh/object/object.h"
+#include "swganh/object/persistence_queue.h"
+
+using namespace std;
+using anh::database::MockConnection;
+using swganh::object::Object;
+using swganh::object::PersistenceQueue;
+
+namespace {
+
+shared_ptr<Object> CreateObject(uint64_t object_id)
+{
+    auto object = make_shared<Object>();
+    object->SetObjectId(object_id);
+    return object;
+}
+
+/// Records how often each object was written.
+struct WriteLog
+{
+    void Record(const shared_ptr<Object>& object)
+    {
+        boost::lock_guard<boost::mutex> lock(mutex);
+        ++writes[object->GetObjectId()];
+    }
+
+    boost::mutex mutex;
+    map<uint64_t, uint32_t> writes;
+};
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(PersistenceQueueTests)
+
+///
+BOOST_AUTO_TEST_CASE(StopWritesEverythingEnqueued)
+{
+    WriteLog log;
+    PersistenceQueue queue(PersistenceQueue::ConnectionSource(),
+        [&log] (const shared_ptr<Object>& object, const shared_ptr<sql::Connection>&) { log.Record(object); }, 2, 4, 1000);
+
+    for (uint64_t id = 1; id <= 100; ++id)
+    {
+        queue.Enqueue(CreateObject(id));
+    }
+
+    queue.Stop();
+
+    BOOST_CHECK_EQUAL(100u, log.writes.size());
+    BOOST_CHECK_EQUAL(100u, queue.GetWrittenCount());
+    BOOST_CHECK_EQUAL(0u, queue.GetPendingCount());
+
+    // Written on the caller's thread once stopped.
+    queue.Enqueue(CreateObject(101));
+    BOOST_CHECK_EQUAL(1u, log.writes[101]);
+}
+
+///
+BOOST_AUTO_TEST_CASE(SavesOfAPendingObjectAreCoalesced)
+{
+    WriteLog log;
+    boost::mutex gate;
+    atomic<uint32_t> started(0);
+
+    // Hold the worker in the first write so the rest pile up behind it.
+    boost::unique_lock<boost::mutex> hold(gate);
+
+    PersistenceQueue queue(PersistenceQueue::ConnectionSource(),
+        [&] (const shared_ptr<Object>& object, const shared_ptr<sql::Connection>&) {
+        ++started;
+        boost::lock_guard<boost::mutex> lock(gate);
+        log.Record(object);
+    }, 1, 1, 1000);
+
+    auto blocker = CreateObject(1);
+    auto object = CreateObject(2);
+
+    queue.Enqueue(blocker);
+    while (started == 0)
+    {
+        boost::this_thread::yield();
+    }
+
+    for (int i = 0; i < 10; ++i)
+    {
+        queue.Enqueue(object);
+    }
+
+    BOOST_CHECK_EQUAL(1u, queue.GetPendingCount());
+    BOOST_CHECK_EQUAL(9u, queue.GetCoalescedCount());
+
+    hold.unlock();
+    queue.Flush();
+
+    BOOST_CHECK_EQUAL(1u, log.writes[2]);
+    BOOST_CHECK_EQUAL(0u, queue.GetPendingCount());
+}
+
+///
+BOOST_AUTO_TEST_CASE(EnqueueBlocksWhileTheWorkerIsFull)
+{
+    WriteLog log;
+    boost::mutex gate;
+    boost::unique_lock<boost::mutex> hold(gate);
+
+    PersistenceQueue queue(PersistenceQueue::ConnectionSource(),
+        [&] (const shared_ptr<Object>& object, const shared_ptr<sql::Connection>&) {
+        boost::lock_guard<boost::mutex> lock(gate);
+        log.Record(object);
+    }, 1, 1, 2);
+
+    atomic<bool> enqueued(false);
+    boost::thread producer([&] {
+        for (uint64_t id = 1; id <= 4; ++id)
+        {
+            queue.Enqueue(CreateObject(id));
+        }
+
+        enqueued = true;
+    });
+
+    // One object is being written and two wait, the fourth can't be queued.
+    boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+    BOOST_CHECK(!enqueued);
+
+    hold.unlock();
+    producer.join();
+    queue.Flush();
+
+    BOOST_CHECK(enqueued);
+    BOOST_CHECK_EQUAL(4u, log.writes.size());
+}
+
+///
+BOOST_AUTO_TEST_CASE(CleanObjectsAreNotQueued)
+{
+    WriteLog log;
+    PersistenceQueue queue(PersistenceQueue::ConnectionSource(),
+        [&log] (const shared_ptr<Object>& object, const shared_ptr<sql::Connection>&) { log.Record(object); }, 1, 4, 1000);
+
+    auto object = CreateObject(1);
+    object->ClearPersistDirty();
+
+    queue.Enqueue(object);
+    queue.Flush();
+
+    BOOST_CHECK_EQUAL(0u, log.writes[1]);
+    BOOST_CHECK_EQUAL(1u, queue.GetSkippedCount());
+
+    object->SetVolume(2);
+    queue.Enqueue(object);
+    queue.Flush();
+
+    BOOST_CHECK_EQUAL(1u, log.writes[1]);
+    BOOST_CHECK_EQUAL(1u, queue.GetSkippedCount());
+}
+
+///
+BOOST_AUTO_TEST_CASE(EachBatchIsWrittenInOneTransaction)
+{
+    auto connection = make_shared<MockConnection>();
+    atomic<uint32_t> connections(0);
+    atomic<uint32_t> commits(0);
+
+    boost::mutex gate;
+    atomic<uint32_t> started(0);
+
+    MOCK_EXPECT(*connection, setAutoCommit).with(false).exactly(2);
+    MOCK_EXPECT(*connection, setAutoCommit).with(true).exactly(2);
+    MOCK_EXPECT(*connection, commit).exactly(2).calls([&commits] { ++commits; });
+
+    WriteLog log;
+    boost::unique_lock<boost::mutex> hold(gate);
+
+    PersistenceQueue queue(
+        [&] () -> shared_ptr<sql::Connection> { ++connections; return connection; },
+        [&] (const shared_ptr<Object>& object, const shared_ptr<sql::Connection>& batch_connection) {
+            BOOST_CHECK(batch_connection == connection);
+            ++started;
+            boost::lock_guard<boost::mutex> lock(gate);
+            log.Record(object);
+        }, 1, 4, 1000);
+
+    // The first object holds the worker until the other four form the second batch.
+    queue.Enqueue(CreateObject(1));
+    while (started == 0)
+    {
+        boost::this_thread::yield();
+    }
+
+    for (uint64_t id = 2; id <= 5; ++id)
+    {
+        queue.Enqueue(CreateObject(id));
+    }
+
+    hold.unlock();
+    queue.Flush();
+
+    BOOST_CHECK_EQUAL(5u, log.writes.size());
+    BOOST_CHECK_EQUAL(2u, connections);
+    BOOST_CHECK_EQUAL(2u, commits);
+    BOOST_CHECK_EQUAL(5u, queue.GetWrittenCount());
+}
+
+///
+BOOST_AUTO_TEST_CASE(ABatchThatFailsToCommitIsLeftDirty)
+{
+    auto connection = make_shared<MockConnection>();
+
+    MOCK_EXPECT(*connection, setAutoCommit);
+    MOCK_EXPECT(*connection, tag7);
+    MOCK_EXPECT(*connection, commit).once().throws(sql::SQLException("commit failed"));
+
+    // Written objects are clean, as a factory leaves them.
+    PersistenceQueue queue(
+        [&connection] () -> shared_ptr<sql::Connection> { return connection; },
+        [] (const shared_ptr<Object>& object, const shared_ptr<sql::Connection>&) { object->ClearPersistDirty(); },
+        1, 4, 1000);
+
+    auto object = CreateObject(1);
+    uint32_t groups = object->GetPersistDirty();
+
+    queue.Enqueue(object);
+    queue.Flush();
+
+    BOOST_CHECK_EQUAL(groups, object->GetPersistDirty());
+    BOOST_CHECK_EQUAL(0u, queue.GetWrittenCount());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
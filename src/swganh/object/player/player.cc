@@ -9,6 +9,7 @@
 
 #include "player_events.h"
 #include "swganh/object/object_events.h"
+#include "swganh/object/property_channel.h"
 #include "swganh/object/creature/creature.h"
 #include "swganh/object/waypoint/waypoint.h"
 
@@ -50,6 +51,47 @@ Player::Player()
 , jedi_state_(0)
 , gender_(MALE)
 {}
+
+uint32_t Player::GetPersistGroup(Property property)
+{
+    switch (property)
+    {
+    case Property::PROFESSION_TAG:
+    case Property::TOTAL_PLAY_TIME:
+    case Property::ADMIN_TAG:
+    case Property::MAX_FORCE_POWER:
+    case Property::EXPERIMENTATION_FLAG:
+    case Property::CRAFTING_STAGE:
+    case Property::NEAREST_CRAFTING_STATION:
+    case Property::EXPERIMENTATION_POINTS:
+    case Property::ACCOMPLISHMENT_COUNTER:
+    case Property::LANGUAGE:
+    case Property::CURRENT_STOMACH:
+    case Property::MAX_STOMACH:
+    case Property::CURRENT_DRINK:
+    case Property::MAX_DRINK:
+    case Property::JEDI_STATE:
+        return PERSIST_PLAYER;
+    case Property::EXPERIENCE:
+        return PERSIST_PLAYER_XP;
+    case Property::WAYPOINT:
+        return PERSIST_PLAYER_WAYPOINTS;
+    case Property::FORCE_SENSITIVE_QUESTS:
+    case Property::COMPLETED_FORCE_SENSITIVE_QUESTS:
+        return PERSIST_PLAYER_FORCE_SENSITIVE_QUESTS;
+    case Property::QUEST_JOURNAL:
+        return PERSIST_PLAYER_QUEST_JOURNAL;
+    case Property::DRAFT_SCHEMATIC:
+        return PERSIST_PLAYER_DRAFT_SCHEMATICS;
+    case Property::FRIEND:
+        return PERSIST_PLAYER_FRIENDS;
+    case Property::IGNORE_PLAYER:
+        return PERSIST_PLAYER_IGNORED;
+    default:
+        // status and profile flags, born date and force power are not stored
+        return PERSIST_NONE;
+    }
+}
 std::array<FlagBitmask, 4> Player::GetStatusFlags() 
 {
     boost::lock_guard<boost::mutex> lock(player_mutex_);
@@ -61,8 +103,7 @@ void Player::AddStatusFlag(StatusFlags flag, StatusIndex index)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         status_flags_[index] = FlagBitmask(status_flags_[index].bitmask | flag);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::StatusBitmask", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::STATUS_BITMASK, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::RemoveStatusFlag(StatusFlags flag, StatusIndex index)
@@ -71,8 +112,7 @@ void Player::RemoveStatusFlag(StatusFlags flag, StatusIndex index)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         status_flags_[index] = FlagBitmask(status_flags_[index].bitmask & ~flag);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::StatusBitmask", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::STATUS_BITMASK, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::ClearStatusFlags()
@@ -88,8 +128,7 @@ void Player::ClearStatusFlags()
                 value = FlagBitmask(0);
             });
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::StatusBitmask", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::STATUS_BITMASK, static_pointer_cast<Player>(shared_from_this()));
 }
 
 std::array<FlagBitmask, 4> Player::GetProfileFlags() 
@@ -104,8 +143,7 @@ void Player::AddProfileFlag(ProfileFlags flag, StatusIndex index)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         profile_flags_[index] = FlagBitmask(profile_flags_[index].bitmask | flag);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::ProfileFlag", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::PROFILE_FLAG, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::RemoveProfileFlag(ProfileFlags flag, StatusIndex index)
@@ -114,8 +152,7 @@ void Player::RemoveProfileFlag(ProfileFlags flag, StatusIndex index)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         profile_flags_[index] = FlagBitmask(profile_flags_[index].bitmask & ~flag);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::ProfileFlag", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::PROFILE_FLAG, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::ClearProfileFlags()
@@ -131,8 +168,7 @@ void Player::ClearProfileFlags()
             value = FlagBitmask(0);
         });
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::ProfileFlag", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::PROFILE_FLAG, static_pointer_cast<Player>(shared_from_this()));
 }
 
 std::string Player::GetProfessionTag() 
@@ -147,8 +183,7 @@ void Player::SetProfessionTag(string profession_tag)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         profession_tag_ = profession_tag;
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::ProfessionTag", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::PROFESSION_TAG, static_pointer_cast<Player>(shared_from_this()));
 }
 
 uint32_t Player::GetBornDate() 
@@ -160,8 +195,7 @@ void Player::SetBornDate(uint32_t born_date)
 {
     born_date_ = born_date;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::BornDate", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::BORN_DATE, static_pointer_cast<Player>(shared_from_this()));
 }
 
 uint32_t Player::GetTotalPlayTime() 
@@ -173,16 +207,14 @@ void Player::SetTotalPlayTime(uint32_t play_time)
 {
     total_playtime_ = play_time;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::TotalPlayTime", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::TOTAL_PLAY_TIME, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::IncrementTotalPlayTime(uint32_t increment)
 {
     total_playtime_ += increment;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::TotalPlayTime", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::TOTAL_PLAY_TIME, static_pointer_cast<Player>(shared_from_this()));
 }
 
 uint8_t Player::GetAdminTag() 
@@ -194,8 +226,7 @@ void Player::SetAdminTag(uint8_t tag)
 {
     admin_tag_ = tag;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::AdminTag", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::ADMIN_TAG, static_pointer_cast<Player>(shared_from_this()));
 }
 
 NetworkMap<string, XpData> Player::GetXp() 
@@ -210,8 +241,7 @@ void Player::AddExperience(XpData experience)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         experience_.Update(experience.type, experience);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::Experience", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::EXPERIENCE, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::DeductXp(XpData experience)
@@ -220,8 +250,7 @@ void Player::DeductXp(XpData experience)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         experience_.Update(experience.type, experience);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::Experience", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::EXPERIENCE, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::ClearXpType(string type)
@@ -239,8 +268,7 @@ void Player::ClearXpType(string type)
         experience_.Remove(iter);
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::Experience", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::EXPERIENCE, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::ResetXp(swganh::messages::containers::NetworkMap<std::string, XpData>& experience)
@@ -254,8 +282,7 @@ void Player::ResetXp(swganh::messages::containers::NetworkMap<std::string, XpDat
         }
         experience_.Reinstall();
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::Experience", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::EXPERIENCE, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::ClearAllXp()
@@ -264,8 +291,7 @@ void Player::ClearAllXp()
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         experience_.Clear();
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::Experience", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::EXPERIENCE, static_pointer_cast<Player>(shared_from_this()));
 }
 
 NetworkMap<uint64_t, PlayerWaypointSerializer> Player::GetWaypoints() 
@@ -280,8 +306,7 @@ void Player::AddWaypoint(PlayerWaypointSerializer waypoint)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         waypoints_.Add(waypoint.waypoint->GetObjectId(), waypoint);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::Waypoint", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::WAYPOINT, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::RemoveWaypoint(uint64_t waypoint_id)
@@ -303,8 +328,7 @@ void Player::RemoveWaypoint(uint64_t waypoint_id)
 
         waypoints_.Remove(find_iter);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::Waypoint", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::WAYPOINT, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::ModifyWaypoint(PlayerWaypointSerializer waypoint)
@@ -313,8 +337,7 @@ void Player::ModifyWaypoint(PlayerWaypointSerializer waypoint)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         waypoints_.Update(waypoint.waypoint->GetObjectId(), waypoint);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::Waypoint", static_pointer_cast<Player>(shared_from_this())));;
+    PropertyChannel<Player>::Notify(Property::WAYPOINT, static_pointer_cast<Player>(shared_from_this()));;
 }
 
 void Player::ClearAllWaypoints()
@@ -323,8 +346,7 @@ void Player::ClearAllWaypoints()
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         waypoints_.Clear();
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::Waypoint", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::WAYPOINT, static_pointer_cast<Player>(shared_from_this()));
 }
 
 uint32_t Player::GetCurrentForcePower() 
@@ -336,8 +358,7 @@ void Player::SetCurrentForcePower(uint32_t force_power)
 {
     current_force_power_ = force_power;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::ForcePower", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::FORCE_POWER, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::IncrementForcePower(int32_t force_power)
@@ -346,8 +367,7 @@ void Player::IncrementForcePower(int32_t force_power)
 
     current_force_power_ = (new_force_power > GetMaxForcePower()) ? GetMaxForcePower() : new_force_power;
     
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::ForcePower", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::FORCE_POWER, static_pointer_cast<Player>(shared_from_this()));
 }
 
 uint32_t Player::GetMaxForcePower() 
@@ -359,8 +379,7 @@ void Player::SetMaxForcePower(uint32_t force_power)
 {
     max_force_power_ = force_power;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::MaxForcePower", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::MAX_FORCE_POWER, static_pointer_cast<Player>(shared_from_this()));
 }
 
 uint32_t Player::GetCurrentForceSensitiveQuests()
@@ -372,24 +391,21 @@ void Player::AddCurrentForceSensitiveQuest(uint32_t quest_mask)
 {
     current_force_sensitive_quests_ = current_force_sensitive_quests_ | quest_mask;
     
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::ForceSensitiveQuests", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::FORCE_SENSITIVE_QUESTS, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::RemoveCurrentForceSensitiveQuest(uint32_t quest_mask)
 {
     current_force_sensitive_quests_ = current_force_sensitive_quests_ & ~quest_mask;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::ForceSensitiveQuests", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::FORCE_SENSITIVE_QUESTS, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::ClearCurrentForceSensitiveQuests()
 {
     current_force_sensitive_quests_ = 0;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::ForceSensitiveQuests", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::FORCE_SENSITIVE_QUESTS, static_pointer_cast<Player>(shared_from_this()));
 }
 
 uint32_t Player::GetCompletedForceSensitiveQuests()
@@ -401,24 +417,21 @@ void Player::AddCompletedForceSensitiveQuest(uint32_t quest_mask)
 {
     completed_force_sensitive_quests_ = completed_force_sensitive_quests_ | quest_mask;
     
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::CompletedForceSensitiveQuests", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::COMPLETED_FORCE_SENSITIVE_QUESTS, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::RemoveCompletedForceSensitiveQuest(uint32_t quest_mask)
 {
     completed_force_sensitive_quests_ = completed_force_sensitive_quests_ & ~quest_mask;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::CompletedForceSensitiveQuests", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::COMPLETED_FORCE_SENSITIVE_QUESTS, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::ClearCompletedForceSensitiveQuests()
 {
     completed_force_sensitive_quests_ = 0;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::CompletedForceSensitiveQuests", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::COMPLETED_FORCE_SENSITIVE_QUESTS, static_pointer_cast<Player>(shared_from_this()));
 }
 
 swganh::messages::containers::NetworkMap<uint32_t, QuestJournalData> Player::GetQuests() 
@@ -433,8 +446,7 @@ void Player::AddQuest(QuestJournalData quest)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         quest_journal_.Add(quest.quest_crc, quest);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::QuestJournal", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::QUEST_JOURNAL, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::RemoveQuest(QuestJournalData quest)
@@ -457,8 +469,7 @@ void Player::RemoveQuest(QuestJournalData quest)
 
         quest_journal_.Remove(find_iter);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::QuestJournal", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::QUEST_JOURNAL, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::UpdateQuest(QuestJournalData quest)
@@ -467,8 +478,7 @@ void Player::UpdateQuest(QuestJournalData quest)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         quest_journal_.Update(quest.quest_crc, quest);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::QuestJournal", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::QUEST_JOURNAL, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::ClearAllQuests()
@@ -477,8 +487,7 @@ void Player::ClearAllQuests()
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         quest_journal_.Clear();
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::QuestJournal", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::QUEST_JOURNAL, static_pointer_cast<Player>(shared_from_this()));
 }
 
 swganh::messages::containers::NetworkSortedList<Ability> Player::GetAbilityList() 
@@ -518,8 +527,7 @@ void Player::SetExperimentationFlag(uint32_t experimentation_flag)
 {
     experimentation_flag_ = experimentation_flag;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::ExperimentationFlag", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::EXPERIMENTATION_FLAG, static_pointer_cast<Player>(shared_from_this()));
 }
 
 uint32_t Player::GetCraftingStage() 
@@ -531,8 +539,7 @@ void Player::SetCraftingStage(uint32_t crafting_stage)
 {
     crafting_stage_ = crafting_stage;
     
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::CraftingStage", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::CRAFTING_STAGE, static_pointer_cast<Player>(shared_from_this()));
 }
 
 uint64_t Player::GetNearestCraftingStation() 
@@ -544,8 +551,7 @@ void Player::SetNearestCraftingStation(uint64_t crafting_station_id)
 {
     nearest_crafting_station_ = crafting_station_id;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::NearestCraftingStation", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::NEAREST_CRAFTING_STATION, static_pointer_cast<Player>(shared_from_this()));
 }
 
 swganh::messages::containers::NetworkSortedList<DraftSchematicData> Player::GetDraftSchematics() 
@@ -560,8 +566,7 @@ void Player::AddDraftSchematic(DraftSchematicData schematic)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         draft_schematics_.Add(schematic);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::DraftSchematic", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::DRAFT_SCHEMATIC, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::RemoveDraftSchematic(uint32_t schematic_id)
@@ -576,8 +581,7 @@ void Player::RemoveDraftSchematic(uint32_t schematic_id)
             
         draft_schematics_.Remove(iter);
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::DraftSchematic", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::DRAFT_SCHEMATIC, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::ClearDraftSchematics()
@@ -586,8 +590,7 @@ void Player::ClearDraftSchematics()
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         draft_schematics_.Clear();
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::DraftSchematic", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::DRAFT_SCHEMATIC, static_pointer_cast<Player>(shared_from_this()));
 }
 
 uint32_t Player::GetExperimentationPoints() 
@@ -599,24 +602,21 @@ void Player::AddExperimentationPoints(uint32_t points)
 {
     experimentation_points_ += points;
     
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::ExperimentationPoints", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::EXPERIMENTATION_POINTS, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::RemoveExperimentationPoints(uint32_t points)
 {
     experimentation_points_ -= points;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::ExperimentationPoints", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::EXPERIMENTATION_POINTS, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::ResetExperimentationPoints(uint32_t points)
 {
     experimentation_points_ = points;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::ExperimentationPoints", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::EXPERIMENTATION_POINTS, static_pointer_cast<Player>(shared_from_this()));
 }
 
 uint32_t Player::GetAccomplishmentCounter() 
@@ -628,16 +628,14 @@ void Player::ResetAccomplishmentCounter(uint32_t counter)
 {
     accomplishment_counter_ = counter;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::AccomplishmentCounter", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::ACCOMPLISHMENT_COUNTER, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::IncrementAccomplishmentCounter()
 {
     ++accomplishment_counter_;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::AccomplishmentCounter", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::ACCOMPLISHMENT_COUNTER, static_pointer_cast<Player>(shared_from_this()));
 }
 
 NetworkSortedVector<Name> Player::GetFriends()
@@ -664,8 +662,7 @@ void Player::AddFriend(string friend_name, uint64_t id)
         friends_.Add(Name(friend_name, id));
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::Friend", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::FRIEND, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::RemoveFriend(string friend_name)
@@ -685,6 +682,7 @@ void Player::RemoveFriend(string friend_name)
         friends_.ClearDeltas();
         friends_.Remove(iter);
     }
+    PropertyChannel<Player>::Notify(Property::FRIEND, static_pointer_cast<Player>(shared_from_this()));
     GetEventDispatcher()->Dispatch(make_shared<NameEvent>
         ("Player::RemoveFriend", static_pointer_cast<Player>(shared_from_this()), friend_id));
 }
@@ -695,8 +693,7 @@ void Player::ClearFriends()
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         friends_.Clear();
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::Friend", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::FRIEND, static_pointer_cast<Player>(shared_from_this()));
 }
 
 NetworkSortedVector<Name> Player::GetIgnoredPlayers()
@@ -724,8 +721,7 @@ void Player::IgnorePlayer(string player_name, uint64_t player_id)
         boost::lock_guard<boost::mutex> lock(player_mutex_);
         ignored_players_.Add(Name(player_name, player_id));
     }
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::IgnorePlayer", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::IGNORE_PLAYER, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::StopIgnoringPlayer(string player_name)
@@ -744,6 +740,7 @@ void Player::StopIgnoringPlayer(string player_name)
         remove_id = iter->id;
         ignored_players_.Remove(iter); 
     } 
+    PropertyChannel<Player>::Notify(Property::IGNORE_PLAYER, static_pointer_cast<Player>(shared_from_this()));
     GetEventDispatcher()->Dispatch(make_shared<NameEvent>("Player::RemoveIgnoredPlayer", static_pointer_cast<Player>(shared_from_this()), remove_id));
  
 }
@@ -755,8 +752,7 @@ void Player::ClearIgnored()
         ignored_players_.Clear();
     }
     
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::IgnorePlayer", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::IGNORE_PLAYER, static_pointer_cast<Player>(shared_from_this()));
 }
 
 uint32_t Player::GetLanguage() 
@@ -768,8 +764,7 @@ void Player::SetLanguage(uint32_t language_id)
 {
     language_ = language_id;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::Language", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::LANGUAGE, static_pointer_cast<Player>(shared_from_this()));
 }
 
 uint32_t Player::GetCurrentStomach() 
@@ -783,24 +778,21 @@ void Player::IncreaseCurrentStomach(uint32_t stomach)
 
     current_stomach_ = (new_stomach > GetMaxStomach()) ? GetMaxStomach() : new_stomach;
     
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::CurrentStomach", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::CURRENT_STOMACH, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::DecreaseCurrentStomach(uint32_t stomach)
 {
     current_stomach_ -= stomach;
     
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::CurrentStomach", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::CURRENT_STOMACH, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::ResetCurrentStomach(uint32_t stomach)
 {
     current_stomach_ = stomach;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::CurrentStomach", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::CURRENT_STOMACH, static_pointer_cast<Player>(shared_from_this()));
 }
 
 uint32_t Player::GetMaxStomach() 
@@ -812,8 +804,7 @@ void Player::ResetMaxStomach(uint32_t stomach)
 {
     max_stomach_ = stomach;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::MaxStomach", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::MAX_STOMACH, static_pointer_cast<Player>(shared_from_this()));
 }
 
 uint32_t Player::GetCurrentDrink() 
@@ -827,24 +818,21 @@ void Player::IncreaseCurrentDrink(uint32_t drink)
 
     current_drink_ = (new_drink > GetMaxDrink()) ? GetMaxDrink() : new_drink;
     
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::CurrentDrink", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::CURRENT_DRINK, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::DecreaseCurrentDrink(uint32_t drink)
 {
     current_drink_ -= drink;
     
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::CurrentDrink", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::CURRENT_DRINK, static_pointer_cast<Player>(shared_from_this()));
 }
 
 void Player::ResetCurrentDrink(uint32_t drink)
 {
     current_drink_ = drink;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::CurrentDrink", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::CURRENT_DRINK, static_pointer_cast<Player>(shared_from_this()));
 }
 
 uint32_t Player::GetMaxDrink() 
@@ -856,8 +844,7 @@ void Player::ResetMaxDrink(uint32_t drink)
 {
     max_drink_ = drink;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::MaxDrink", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::MAX_DRINK, static_pointer_cast<Player>(shared_from_this()));
 }
 
 uint32_t Player::GetJediState() 
@@ -869,8 +856,7 @@ void Player::SetJediState(uint32_t jedi_state)
 {
     jedi_state_ = jedi_state;
 
-    GetEventDispatcher()->Dispatch(make_shared<PlayerEvent>
-        ("Player::JediState", static_pointer_cast<Player>(shared_from_this())));
+    PropertyChannel<Player>::Notify(Property::JEDI_STATE, static_pointer_cast<Player>(shared_from_this()));
 }
 
 Gender Player::GetGender() 
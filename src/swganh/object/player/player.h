@@ -293,6 +293,41 @@ class PlayerMessageBuilder;
 class Player : public swganh::object::Object
 {
 public:
+    /**
+     * Properties whose changes are announced on the player's PropertyChannel.
+     */
+    enum class Property : uint16_t
+    {
+        STATUS_BITMASK,
+        PROFILE_FLAG,
+        PROFESSION_TAG,
+        BORN_DATE,
+        TOTAL_PLAY_TIME,
+        ADMIN_TAG,
+        EXPERIENCE,
+        WAYPOINT,
+        FORCE_POWER,
+        MAX_FORCE_POWER,
+        FORCE_SENSITIVE_QUESTS,
+        COMPLETED_FORCE_SENSITIVE_QUESTS,
+        QUEST_JOURNAL,
+        EXPERIMENTATION_FLAG,
+        CRAFTING_STAGE,
+        NEAREST_CRAFTING_STATION,
+        DRAFT_SCHEMATIC,
+        EXPERIMENTATION_POINTS,
+        ACCOMPLISHMENT_COUNTER,
+        FRIEND,
+        IGNORE_PLAYER,
+        LANGUAGE,
+        CURRENT_STOMACH,
+        MAX_STOMACH,
+        CURRENT_DRINK,
+        MAX_DRINK,
+        JEDI_STATE,
+        PROPERTY_COUNT
+    };
+
     Player();
     
     /**
@@ -301,6 +336,11 @@ public:
     virtual uint32_t GetType() const { return Player::type; }
     const static uint32_t type = 0x504c4159;
 
+    /**
+     * @return The persistence group a property is stored with.
+     */
+    static uint32_t GetPersistGroup(Property property);
+
     /**
      * @return The status flags for the player object.
      */
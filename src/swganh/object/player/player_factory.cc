@@ -17,6 +17,7 @@
 #include "anh/database/database_manager.h"
 #include "swganh/object/player/player.h"
 #include "swganh/object/player/player_events.h"
+#include "swganh/object/waypoint/waypoint_factory.h"
 
 #include "swganh/object/exception.h"
 #include "swganh/simulation/simulation_service.h"
@@ -26,6 +27,7 @@ using namespace anh::database;
 using namespace swganh::object;
 using namespace swganh::object::player;
 using namespace swganh::simulation;
+using swganh::object::waypoint::WaypointFactory;
 
 uint32_t PlayerFactory::GetType() const { return Player::type; }
 
@@ -69,16 +71,45 @@ unordered_map<string,shared_ptr<Player>>::iterator PlayerFactory::GetTemplateIte
     return iter;
 }
 
-void PlayerFactory::PersistObject(const shared_ptr<Object>& object)
+void PlayerFactory::PersistObject(const shared_ptr<Object>& object, const shared_ptr<sql::Connection>& connection)
 {
+    auto player = static_pointer_cast<Player>(object);
+
+    // sp_PersistPlayer writes the base object too, without player changes only the base is written
+    if (player->GetPersistDirty() & Object::PERSIST_PLAYER)
+    {
+        PersistPlayer_(player, connection);
+    }
+    else
+    {
+        ObjectFactory::PersistObject(object, connection);
+    }
+
+    PersistFriends_(player, connection);
+    PersistIgnoredList_(player, connection);
+    PersistXP_(player, connection);
+    PersistDraftSchematics_(player, connection);
+    PersistForceSensitiveQuests_(player, connection);
+    PersistQuestJournal_(player, connection);
+    PersistWaypoints_(player, connection);
+
+    // a player stores no other groups
+    player->TakePersistDirty(~(Object::PERSIST_OBJECT | Object::PERSIST_PLAYER
+        | Object::PERSIST_PLAYER_XP | Object::PERSIST_PLAYER_FRIENDS | Object::PERSIST_PLAYER_IGNORED
+        | Object::PERSIST_PLAYER_DRAFT_SCHEMATICS | Object::PERSIST_PLAYER_FORCE_SENSITIVE_QUESTS
+        | Object::PERSIST_PLAYER_QUEST_JOURNAL | Object::PERSIST_PLAYER_WAYPOINTS));
+}
+
+void PlayerFactory::PersistPlayer_(const shared_ptr<Player>& player, const shared_ptr<sql::Connection>& connection)
+{
+    uint32_t groups = player->TakePersistDirty(Object::PERSIST_OBJECT | Object::PERSIST_PLAYER);
+
     try 
     {
-        auto conn = db_manager_->getConnection("galaxy");
-        auto statement = shared_ptr<sql::PreparedStatement>
-			(conn->prepareStatement("CALL sp_PersistPlayer(?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?);"));
-        ObjectFactory::PersistObject(object, statement);
+        auto statement = db_manager_->prepareStatement(connection,
+			"CALL sp_PersistPlayer(?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?);");
+        ObjectFactory::PersistObject(player, statement);
 
-		auto player = static_pointer_cast<Player>(object);
 		statement->setString(17, player->GetProfessionTag());
 		statement->setUInt64(18, player->GetTotalPlayTime());
 		statement->setUInt(19, player->GetAdminTag());
@@ -96,19 +127,12 @@ void PlayerFactory::PersistObject(const shared_ptr<Object>& object)
 		statement->setUInt(31, player->GetJediState());
 
         statement->executeUpdate();
-
-        PersistFriends_(player);
-        PersistIgnoredList_(player);
-        PersistXP_(player);
-        PersistDraftSchematics_(player);
-        PersistForceSensitiveQuests_(player);
-        PersistQuestJournal_(player);
-        PersistWaypoints_(player);
     }
         catch(sql::SQLException &e)
     {
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
+        player->MarkPersistDirty(groups);
     }
     
 }
@@ -118,7 +142,7 @@ void PlayerFactory::DeleteObjectFromStorage(const shared_ptr<Object>& object)
     try 
     {
         auto conn = db_manager_->getConnection("galaxy");
-        auto statement = conn->prepareStatement("CALL sp_DeletePlayer(?);");
+        auto statement = db_manager_->prepareStatement(conn, "CALL sp_DeletePlayer(?);");
         statement->setUInt64(1, object->GetObjectId());
         statement->execute();
     }
@@ -179,6 +203,8 @@ shared_ptr<Object> PlayerFactory::CreateObjectFromStorage(uint64_t object_id)
             LoadXP_(player, statement);
         }
 
+        // loading went through the setters, yet the player matches storage
+        player->ClearPersistDirty();
     }
     catch(sql::SQLException &e)
     {
@@ -265,24 +291,32 @@ void PlayerFactory::LoadXP_(shared_ptr<Player> player, const std::shared_ptr<sql
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
 }
-void PlayerFactory::PersistXP_(const shared_ptr<Player>& player)
+void PlayerFactory::PersistXP_(const shared_ptr<Player>& player, const shared_ptr<sql::Connection>& connection)
 {
+    uint32_t groups = player->TakePersistDirty(Object::PERSIST_PLAYER_XP);
+    if (groups == Object::PERSIST_NONE)
+    {
+        return;
+    }
+
     try 
     {
-        auto conn = db_manager_->getConnection("galaxy");
         auto xp = player->GetXp();
+        auto statement = db_manager_->prepareStatement(connection, "CALL sp_UpdateExperience(?,?);");
         for(auto& xpData : xp)
         {
-            auto statement = conn->prepareStatement("CALL sp_UpdateExperience(?,?);");
             statement->setString(1,xpData.first);
             statement->setUInt(2,xpData.second.value);
             auto result = unique_ptr<sql::ResultSet>(statement->executeQuery());
+            // read the CALL's status result before executing it again
+            while (statement->getMoreResults()) {}
         };
     }
         catch(sql::SQLException &e)
     {
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
+        player->MarkPersistDirty(groups);
     }
 }
 void PlayerFactory::LoadWaypoints_(shared_ptr<Player> player, const std::shared_ptr<sql::Statement>& statement)
@@ -301,11 +335,28 @@ void PlayerFactory::LoadWaypoints_(shared_ptr<Player> player, const std::shared_
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
 }
-void PlayerFactory::PersistWaypoints_(const shared_ptr<Player>& player)
+void PlayerFactory::PersistWaypoints_(const shared_ptr<Player>& player, const shared_ptr<sql::Connection>& connection)
 {
-    auto waypoints = player->GetWaypoints();
-    event_dispatcher_->Dispatch(make_shared<anh::ValueEvent<swganh::messages::containers::NetworkMap<uint64_t, PlayerWaypointSerializer>>>
-                                ("PersistWaypoints", waypoints));
+    uint32_t groups = player->TakePersistDirty(Object::PERSIST_PLAYER_WAYPOINTS);
+    if (groups == Object::PERSIST_NONE)
+    {
+        return;
+    }
+
+    try
+    {
+        auto waypoints = player->GetWaypoints();
+        for (auto& waypoint : waypoints)
+        {
+            WaypointFactory::PersistWaypoint(db_manager_, waypoint.second.waypoint, connection);
+        }
+    }
+        catch(sql::SQLException &e)
+    {
+        LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
+        LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
+        player->MarkPersistDirty(groups);
+    }
 }
 void PlayerFactory::LoadDraftSchematics_(shared_ptr<Player> player, const std::shared_ptr<sql::Statement>& statement)
 {
@@ -330,25 +381,33 @@ void PlayerFactory::LoadDraftSchematics_(shared_ptr<Player> player, const std::s
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
 }
-void PlayerFactory::PersistDraftSchematics_(const shared_ptr<Player>& player)
+void PlayerFactory::PersistDraftSchematics_(const shared_ptr<Player>& player, const shared_ptr<sql::Connection>& connection)
 {
+    uint32_t groups = player->TakePersistDirty(Object::PERSIST_PLAYER_DRAFT_SCHEMATICS);
+    if (groups == Object::PERSIST_NONE)
+    {
+        return;
+    }
+
     try 
     {
-        auto conn = db_manager_->getConnection("galaxy");
         auto draft_schematics = player->GetDraftSchematics();
+        auto statement = db_manager_->prepareStatement(connection, "CALL sp_UpdateDraftSchematic(?,?,?);");
         for(auto& schematic : draft_schematics)
         {
-            auto statement = conn->prepareStatement("CALL sp_UpdateDraftSchematic(?,?,?);");
             statement->setUInt64(1, player->GetObjectId());
             statement->setUInt(2,schematic.second.schematic_id);
             statement->setUInt(3, schematic.second.schematic_crc);
             auto result = unique_ptr<sql::ResultSet>(statement->executeQuery());
+            // read the CALL's status result before executing it again
+            while (statement->getMoreResults()) {}
         };
     }
         catch(sql::SQLException &e)
     {
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
+        player->MarkPersistDirty(groups);
     }
 }
 void PlayerFactory::LoadQuestJournal_(shared_ptr<Player> player, const std::shared_ptr<sql::Statement>& statement)
@@ -376,16 +435,21 @@ void PlayerFactory::LoadQuestJournal_(shared_ptr<Player> player, const std::shar
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
 }
-void PlayerFactory::PersistQuestJournal_(const shared_ptr<Player>& player)
+void PlayerFactory::PersistQuestJournal_(const shared_ptr<Player>& player, const shared_ptr<sql::Connection>& connection)
 {
+    uint32_t groups = player->TakePersistDirty(Object::PERSIST_PLAYER_QUEST_JOURNAL);
+    if (groups == Object::PERSIST_NONE)
+    {
+        return;
+    }
+
     try 
     {
-        auto conn = db_manager_->getConnection("galaxy");
         auto quests = player->GetQuests();
+        auto statement = db_manager_->prepareStatement(connection, "CALL sp_UpdateQuestJournal(?,?,?,?,?,?);");
         
         for(auto& quest : quests)
         {
-            auto statement = conn->prepareStatement("CALL sp_UpdateQuestJournal(?,?,?,?,?,?);");
             statement->setUInt64(1, player->GetObjectId());
             statement->setUInt64(2, quest.second.owner_id);
             statement->setUInt(3, quest.second.quest_crc);
@@ -394,12 +458,15 @@ void PlayerFactory::PersistQuestJournal_(const shared_ptr<Player>& player)
             statement->setUInt(6, quest.second.completed_flag);
             
             auto result = unique_ptr<sql::ResultSet>(statement->executeQuery());
+            // read the CALL's status result before executing it again
+            while (statement->getMoreResults()) {}
         };
     }
         catch(sql::SQLException &e)
     {
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
+        player->MarkPersistDirty(groups);
     }
 }
 void PlayerFactory::LoadForceSensitiveQuests_(shared_ptr<Player> player, const std::shared_ptr<sql::Statement>& statement)
@@ -428,12 +495,17 @@ void PlayerFactory::LoadForceSensitiveQuests_(shared_ptr<Player> player, const s
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
 }
-void PlayerFactory::PersistForceSensitiveQuests_(const shared_ptr<Player>& player)
+void PlayerFactory::PersistForceSensitiveQuests_(const shared_ptr<Player>& player, const shared_ptr<sql::Connection>& connection)
 {
+    uint32_t groups = player->TakePersistDirty(Object::PERSIST_PLAYER_FORCE_SENSITIVE_QUESTS);
+    if (groups == Object::PERSIST_NONE)
+    {
+        return;
+    }
+
     try 
     {
-        auto conn = db_manager_->getConnection("galaxy");
-        auto statement = conn->prepareStatement("CALL sp_UpdateFSQuests(?,?,?);");
+        auto statement = db_manager_->prepareStatement(connection, "CALL sp_UpdateFSQuests(?,?,?);");
         statement->setUInt64(1, player->GetObjectId());
         statement->setUInt(2, player->GetCurrentForceSensitiveQuests());
         statement->setUInt(3, player->GetCompletedForceSensitiveQuests());
@@ -444,6 +516,7 @@ void PlayerFactory::PersistForceSensitiveQuests_(const shared_ptr<Player>& playe
     {
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
+        player->MarkPersistDirty(groups);
     }
 }
 void PlayerFactory::RemoveFriend_(const std::shared_ptr<Player>& player, uint64_t friend_id)
@@ -452,7 +525,7 @@ void PlayerFactory::RemoveFriend_(const std::shared_ptr<Player>& player, uint64_
     {
         auto conn = db_manager_->getConnection("galaxy");
         
-        auto statement = conn->prepareStatement("CALL sp_RemoveFriend(?,?);");
+        auto statement = db_manager_->prepareStatement(conn, "CALL sp_RemoveFriend(?,?);");
         statement->setUInt64(1, player->GetObjectId());
         statement->setUInt64(2, friend_id);
 
@@ -464,25 +537,33 @@ void PlayerFactory::RemoveFriend_(const std::shared_ptr<Player>& player, uint64_
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
 }
-void PlayerFactory::PersistFriends_(const shared_ptr<Player>& player)
+void PlayerFactory::PersistFriends_(const shared_ptr<Player>& player, const shared_ptr<sql::Connection>& connection)
 {
+    uint32_t groups = player->TakePersistDirty(Object::PERSIST_PLAYER_FRIENDS);
+    if (groups == Object::PERSIST_NONE)
+    {
+        return;
+    }
+
     try 
     {
-        auto conn = db_manager_->getConnection("galaxy");
         auto friends = player->GetFriends();
+        auto statement = db_manager_->prepareStatement(connection, "CALL sp_UpdateFriends(?,?);");
         
         for(auto& friend_name : friends)
         {
-            auto statement = conn->prepareStatement("CALL sp_UpdateFriends(?,?);");
             statement->setUInt64(1, player->GetObjectId());
             statement->setUInt64(2, friend_name.id);
             auto result = unique_ptr<sql::ResultSet>(statement->executeQuery());
+            // read the CALL's status result before executing it again
+            while (statement->getMoreResults()) {}
         };
     }
         catch(sql::SQLException &e)
     {
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
+        player->MarkPersistDirty(groups);
     }
 }
 void PlayerFactory::LoadFriends_(shared_ptr<Player> player, const std::shared_ptr<sql::Statement>& statement)
@@ -523,25 +604,33 @@ void PlayerFactory::LoadIgnoredList_(shared_ptr<Player> player, const std::share
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
 }
-void PlayerFactory::PersistIgnoredList_(const shared_ptr<Player>& player)
+void PlayerFactory::PersistIgnoredList_(const shared_ptr<Player>& player, const shared_ptr<sql::Connection>& connection)
 {
+    uint32_t groups = player->TakePersistDirty(Object::PERSIST_PLAYER_IGNORED);
+    if (groups == Object::PERSIST_NONE)
+    {
+        return;
+    }
+
     try 
     {
-        auto conn = db_manager_->getConnection("galaxy");
         auto ignored_players = player->GetIgnoredPlayers();
+        auto statement = db_manager_->prepareStatement(connection, "CALL sp_UpdateIgnoreList(?,?);");
         
         for(auto& player_name : ignored_players)
         {
-            auto statement = conn->prepareStatement("CALL sp_UpdateIgnoreList(?,?);");
             statement->setUInt64(1, player->GetObjectId());
             statement->setUInt64(2, player_name.id);
             auto result = unique_ptr<sql::ResultSet>(statement->executeQuery());
+            // read the CALL's status result before executing it again
+            while (statement->getMoreResults()) {}
         };
     }
         catch(sql::SQLException &e)
     {
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
+        player->MarkPersistDirty(groups);
     }
 }
 void PlayerFactory::RemoveFromIgnoredList_(const shared_ptr<Player>& player, uint64_t ignore_player_id)
@@ -550,7 +639,7 @@ void PlayerFactory::RemoveFromIgnoredList_(const shared_ptr<Player>& player, uin
     {
         auto conn = db_manager_->getConnection("galaxy");
         
-        auto statement = conn->prepareStatement("CALL sp_RemoveIgnoredPlayer(?,?);");
+        auto statement = db_manager_->prepareStatement(conn, "CALL sp_RemoveIgnoredPlayer(?,?);");
         statement->setUInt64(1, player->GetObjectId());
         statement->setUInt64(2, ignore_player_id);
 
@@ -37,7 +37,7 @@ namespace player {
 
         bool HasTemplate(const std::string& template_name);
 
-        void PersistObject(const std::shared_ptr<swganh::object::Object>& object);
+        void PersistObject(const std::shared_ptr<swganh::object::Object>& object, const std::shared_ptr<sql::Connection>& connection);
 
         void DeleteObjectFromStorage(const std::shared_ptr<swganh::object::Object>& object);
 
@@ -51,24 +51,25 @@ namespace player {
         void RegisterEventHandlers();
     private:
         // Helpers
+        void PersistPlayer_(const std::shared_ptr<Player>& player, const std::shared_ptr<sql::Connection>& connection);
         void LoadStatusFlags_(std::shared_ptr<Player> player, const std::shared_ptr<sql::Statement>& statement);
         void LoadProfileFlags_(std::shared_ptr<Player> player, const std::shared_ptr<sql::Statement>& statement);
         void LoadXP_(std::shared_ptr<Player> player, const std::shared_ptr<sql::Statement>& statement);
-        void PersistXP_(const std::shared_ptr<Player>& player);
+        void PersistXP_(const std::shared_ptr<Player>& player, const std::shared_ptr<sql::Connection>& connection);
         void LoadWaypoints_(std::shared_ptr<Player> player, const std::shared_ptr<sql::Statement>& statement);
-        void PersistWaypoints_(const std::shared_ptr<Player>& player);
+        void PersistWaypoints_(const std::shared_ptr<Player>& player, const std::shared_ptr<sql::Connection>& connection);
         void LoadDraftSchematics_(std::shared_ptr<Player> player, const std::shared_ptr<sql::Statement>& statement);
-        void PersistDraftSchematics_(const std::shared_ptr<Player>& player);
+        void PersistDraftSchematics_(const std::shared_ptr<Player>& player, const std::shared_ptr<sql::Connection>& connection);
         void LoadQuestJournal_(std::shared_ptr<Player> player, const std::shared_ptr<sql::Statement>& statement);
-        void PersistQuestJournal_(const std::shared_ptr<Player>& player);
+        void PersistQuestJournal_(const std::shared_ptr<Player>& player, const std::shared_ptr<sql::Connection>& connection);
         void LoadForceSensitiveQuests_(std::shared_ptr<Player> player, const std::shared_ptr<sql::Statement>& statement);
-        void PersistForceSensitiveQuests_(const std::shared_ptr<Player>& player);
+        void PersistForceSensitiveQuests_(const std::shared_ptr<Player>& player, const std::shared_ptr<sql::Connection>& connection);
         void LoadFriends_(std::shared_ptr<Player> player, const std::shared_ptr<sql::Statement>& statement);
-        void PersistFriends_(const std::shared_ptr<Player>& player);
+        void PersistFriends_(const std::shared_ptr<Player>& player, const std::shared_ptr<sql::Connection>& connection);
         void RemoveFriend_(const std::shared_ptr<Player>& player, uint64_t friend_id);
         void LoadIgnoredList_(std::shared_ptr<Player> player, const std::shared_ptr<sql::Statement>& statement);
         void RemoveFromIgnoredList_(const std::shared_ptr<Player>& player, uint64_t ignore_player_id);
-        void PersistIgnoredList_(const std::shared_ptr<Player>& player);
+        void PersistIgnoredList_(const std::shared_ptr<Player>& player, const std::shared_ptr<sql::Connection>& connection);
 
         std::unordered_map<std::string, std::shared_ptr<Player>>::iterator GetTemplateIter_(const std::string& template_name);
         std::unordered_map<std::string, std::shared_ptr<Player>> player_templates_;
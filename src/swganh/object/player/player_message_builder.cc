@@ -12,6 +12,7 @@
 #include "swganh/messages/scene_end_baselines.h"
 #include "swganh/object/player/player_events.h"
 #include "swganh/object/object_events.h"
+#include "swganh/object/property_channel.h"
 #include "swganh/object/waypoint/waypoint.h"
 
 using namespace anh;
@@ -28,166 +29,54 @@ void PlayerMessageBuilder::RegisterEventHandlers()
         auto controller_event = static_pointer_cast<ControllerEvent>(incoming_event);
         SendBaselines(static_pointer_cast<Player>(controller_event->object), controller_event->controller);
     });
-    event_dispatcher->Subscribe("Player::StatusBitmask", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildStatusBitmaskDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::ProfileFlag", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildProfileBitmaskDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::ProfessionTag", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildProfessionTagDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::BornDate", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildBornDateDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::TotalPlayTime", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildPlayTimeDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::AdminTag", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildAdminTagDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::Experience", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildXpDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::Waypoint", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildWaypointDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::ForcePower", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildCurrentForcePowerDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::MaxForcePower", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildMaxForcePowerDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::ForceSensitiveQuests", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildForceSensitiveQuestDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::CompletedForceSensitiveQuests", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildCompletedForceSensitiveQuestDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::QuestJournal", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildQuestJournalDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::ExperimentationFlag", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildExperimentationFlagDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::CraftingStage", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildCraftingStageDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::NearestCraftingStation", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildNearestCraftingStationDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::DraftSchematic", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildDraftSchematicDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::ExperimentationPoints", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildExperimentationPointsDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::AccomplishmentCounter", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildAccomplishmentCounterDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::RemoveFriend", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto name_event = static_pointer_cast<NameEvent>(incoming_event);
-        BuildFriendsDelta(name_event->player);
-    });
-    event_dispatcher->Subscribe("Player::RemoveIgnoredPlayer", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto name_event = static_pointer_cast<NameEvent>(incoming_event);
-        BuildIgnoredDelta(name_event->player);
-    });
-    event_dispatcher->Subscribe("Player::Friend", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildFriendsDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::IgnorePlayer", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildIgnoredDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::Language", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildLanguageDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::CurrentStomach", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildCurrentStomachDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::MaxStomach", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildMaxStomachDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::CurrentDrink", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildCurrentDrinkDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::MaxDrink", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildMaxDrinkDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Player::JediState", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<PlayerEvent>(incoming_event);
-        BuildJediStateDelta(value_event->Get());
+    PropertyChannel<Player>::Subscribe(Player::Property::STATUS_BITMASK, &BuildStatusBitmaskDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::PROFILE_FLAG, &BuildProfileBitmaskDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::PROFESSION_TAG, &BuildProfessionTagDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::BORN_DATE, &BuildBornDateDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::TOTAL_PLAY_TIME, &BuildPlayTimeDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::ADMIN_TAG, &BuildAdminTagDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::EXPERIENCE, &BuildXpDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::WAYPOINT, &BuildWaypointDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::FORCE_POWER, &BuildCurrentForcePowerDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::MAX_FORCE_POWER, &BuildMaxForcePowerDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::FORCE_SENSITIVE_QUESTS, &BuildForceSensitiveQuestDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::COMPLETED_FORCE_SENSITIVE_QUESTS, &BuildCompletedForceSensitiveQuestDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::QUEST_JOURNAL, &BuildQuestJournalDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::EXPERIMENTATION_FLAG, &BuildExperimentationFlagDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::CRAFTING_STAGE, &BuildCraftingStageDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::NEAREST_CRAFTING_STATION, &BuildNearestCraftingStationDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::DRAFT_SCHEMATIC, &BuildDraftSchematicDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::EXPERIMENTATION_POINTS, &BuildExperimentationPointsDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::ACCOMPLISHMENT_COUNTER, &BuildAccomplishmentCounterDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::FRIEND, &BuildFriendsDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::IGNORE_PLAYER, &BuildIgnoredDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::LANGUAGE, &BuildLanguageDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::CURRENT_STOMACH, &BuildCurrentStomachDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::MAX_STOMACH, &BuildMaxStomachDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::CURRENT_DRINK, &BuildCurrentDrinkDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::MAX_DRINK, &BuildMaxDrinkDelta);
+    PropertyChannel<Player>::Subscribe(Player::Property::JEDI_STATE, &BuildJediStateDelta);
+}
+
+shared_ptr<const BaselinesSnapshot> PlayerMessageBuilder::GetBaselines(const shared_ptr<Player>& player)
+{
+    return player->GetBaselinesSnapshot([&player] () -> BaselinesCacheContainer
+    {
+        BaselinesCacheContainer baselines;
+        baselines.push_back(BuildBaseline3(player));
+        baselines.push_back(BuildBaseline6(player));
+        baselines.push_back(BuildBaseline8(player));
+        baselines.push_back(BuildBaseline9(player));
+        return baselines;
     });
 }
-
 void PlayerMessageBuilder::SendBaselines(const shared_ptr<Player>& player, const shared_ptr<ObjectController>& controller)
 {
-    player->AddBaselineToCache(BuildBaseline3(player));
-    player->AddBaselineToCache(BuildBaseline6(player));
-    player->AddBaselineToCache(BuildBaseline8(player));
-    player->AddBaselineToCache(BuildBaseline9(player));
-    
-   
-    for (auto& baseline : player->GetBaselines())
+    for (auto& baseline : *GetBaselines(player))
     {
         controller->Notify(baseline);
     }
-        
+
     SendEndBaselines(player, controller);
 }
 void PlayerMessageBuilder::BuildStatusBitmaskDelta(const shared_ptr<Player>& object)
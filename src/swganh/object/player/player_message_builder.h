@@ -26,6 +26,11 @@ namespace player {
             RegisterEventHandlers();
         }
         virtual void SendBaselines(const std::shared_ptr<Player>& player, const std::shared_ptr<ObjectController>& controller);
+        /**
+         * Returns the player's serialized baselines, built only if it changed since
+         * they were last asked for.
+         */
+        static std::shared_ptr<const BaselinesSnapshot> GetBaselines(const std::shared_ptr<Player>& player);
         virtual void RegisterEventHandlers();
         // deltas
         static void BuildStatusBitmaskDelta(const std::shared_ptr<Player>& object);
@@ -0,0 +1,91 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef SWGANH_OBJECT_PROPERTY_CHANNEL_H_
+#define SWGANH_OBJECT_PROPERTY_CHANNEL_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace swganh {
+namespace object {
+
+    /**
+     * Notifies interested parties that a property of an object of type T changed.
+     *
+     * T declares its properties as the enum T::Property, ending in PROPERTY_COUNT,
+     * and maps each to the group it is persisted with in T::GetPersistGroup.
+     * Message builders subscribe a handler per property, and setters notify the
+     * channel once they have released the object's lock. Handlers run inline, so
+     * a notification doesn't allocate, post to the io_service or hash a name. The
+     * deltas handlers build are batched per tick by the replication stage.
+     *
+     * Handlers are registered while the simulation starts, before any object
+     * changes, and stay registered for the lifetime of the process.
+     */
+    template<typename T>
+    class PropertyChannel
+    {
+    public:
+        typedef typename T::Property Property;
+        typedef void (*Handler)(const std::shared_ptr<T>& object);
+
+        /**
+         * Registers a handler for changes to the given property.
+         *
+         * Registering the same handler for a property again has no effect.
+         */
+        static void Subscribe(Property property, Handler handler)
+        {
+            auto& handlers = Handlers()[static_cast<size_t>(property)];
+
+            if (std::find(handlers.begin(), handlers.end(), handler) == handlers.end())
+            {
+                handlers.push_back(handler);
+            }
+        }
+
+        /**
+         * Invokes the handlers registered for the given property in the calling thread.
+         *
+         * The object's baselines snapshot no longer matches it, so it is discarded
+         * first, and the property's persistence group is marked for writing.
+         */
+        static void Notify(Property property, const std::shared_ptr<T>& object)
+        {
+            object->InvalidateBaselines();
+            object->MarkPersistDirty(T::GetPersistGroup(property));
+
+            for (Handler handler : Handlers()[static_cast<size_t>(property)])
+            {
+                handler(object);
+            }
+        }
+
+        /**
+         * @return True if any handler is registered for the given property.
+         */
+        static bool HasSubscribers(Property property)
+        {
+            return !Handlers()[static_cast<size_t>(property)].empty();
+        }
+
+    private:
+        typedef std::array<
+            std::vector<Handler>,
+            static_cast<size_t>(Property::PROPERTY_COUNT)
+        > HandlerTable;
+
+        static HandlerTable& Handlers()
+        {
+            static HandlerTable handlers;
+            return handlers;
+        }
+    };
+
+}}  // namespace swganh::object
+
+#endif  // SWGANH_OBJECT_PROPERTY_CHANNEL_H_
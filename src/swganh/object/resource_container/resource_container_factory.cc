@@ -17,9 +17,6 @@ bool ResourceContainerFactory::HasTemplate(const string& template_name)
     return false;
 }
 
-void ResourceContainerFactory::PersistObject(const shared_ptr<Object>& object)
-{}
-
 void ResourceContainerFactory::DeleteObjectFromStorage(const shared_ptr<Object>& object)
 {}
 
@@ -17,9 +17,6 @@ bool ShipFactory::HasTemplate(const string& template_name)
     return false;
 }
 
-void ShipFactory::PersistObject(const shared_ptr<Object>& object)
-{}
-
 void ShipFactory::DeleteObjectFromStorage(const shared_ptr<Object>& object)
 {}
 
@@ -17,9 +17,6 @@ bool StaticFactory::HasTemplate(const string& template_name)
     return false;
 }
 
-void StaticFactory::PersistObject(const shared_ptr<Object>& object)
-{}
-
 void StaticFactory::DeleteObjectFromStorage(const shared_ptr<Object>& object)
 {}
 
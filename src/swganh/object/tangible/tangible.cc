@@ -4,6 +4,7 @@
 #include "tangible.h"
 
 #include "swganh/object/object_events.h"
+#include "swganh/object/property_channel.h"
 using namespace std;
 using namespace swganh::object;
 using namespace swganh::object::tangible;
@@ -43,14 +44,30 @@ Tangible::Tangible(const std::string& customization, std::vector<uint32_t> compo
     });
 }
 
+uint32_t Tangible::GetPersistGroup(Property property)
+{
+    switch (property)
+    {
+    case Property::CUSTOMIZATION:
+    case Property::OPTIONS_MASK:
+    case Property::INCAP_TIMER:
+    case Property::CONDITION_DAMAGE:
+    case Property::MAX_CONDITION:
+    case Property::STATIC:
+        return PERSIST_TANGIBLE;
+    default:
+        // component customizations and defenders are not stored
+        return PERSIST_NONE;
+    }
+}
+
 void Tangible::AddCustomization(const string& customization)
 {
     {
         boost::lock_guard<boost::mutex> lock(tangible_mutex_);
         customization_.append(customization);
     }
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
-        ("Tangible::Customization",static_pointer_cast<Tangible>(shared_from_this())));
+    PropertyChannel<Tangible>::Notify(Property::CUSTOMIZATION, static_pointer_cast<Tangible>(shared_from_this()));
 }
 
 std::string Tangible::GetCustomization(void)
@@ -65,8 +82,7 @@ void Tangible::SetCustomization(const string& customization)
         boost::lock_guard<boost::mutex> lock(tangible_mutex_);
         customization_ = customization;
     }
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
-        ("Tangible::Customization",static_pointer_cast<Tangible>(shared_from_this())));
+    PropertyChannel<Tangible>::Notify(Property::CUSTOMIZATION, static_pointer_cast<Tangible>(shared_from_this()));
 }
 void Tangible::RemoveComponentCustomization(uint32_t customization)
 {
@@ -84,8 +100,7 @@ void Tangible::RemoveComponentCustomization(uint32_t customization)
         component_customization_list_.Remove(iter);
     }
     
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
-        ("Tangible::ComponentCustomization",static_pointer_cast<Tangible>(shared_from_this())));
+    PropertyChannel<Tangible>::Notify(Property::COMPONENT_CUSTOMIZATION, static_pointer_cast<Tangible>(shared_from_this()));
 }
 void Tangible::AddComponentCustomization(uint32_t customization)
 {
@@ -94,8 +109,7 @@ void Tangible::AddComponentCustomization(uint32_t customization)
         component_customization_list_.Add(ComponentCustomization(customization));
     }
     
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
-        ("Tangible::ComponentCustomization",static_pointer_cast<Tangible>(shared_from_this())));
+    PropertyChannel<Tangible>::Notify(Property::COMPONENT_CUSTOMIZATION, static_pointer_cast<Tangible>(shared_from_this()));
 }
 
 NetworkList<ComponentCustomization> Tangible::GetComponentCustomization(void)
@@ -110,23 +124,20 @@ void Tangible::ClearComponentCustomization()
         boost::lock_guard<boost::mutex> lock(tangible_mutex_);
         component_customization_list_.Clear();
     }
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
-        ("Tangible::ComponentCustomization",static_pointer_cast<Tangible>(shared_from_this())));
+    PropertyChannel<Tangible>::Notify(Property::COMPONENT_CUSTOMIZATION, static_pointer_cast<Tangible>(shared_from_this()));
 }
 
 void Tangible::SetOptionsMask(uint32_t options_mask)
 {
     options_bitmask_ = options_mask;
 
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
-        ("Tangible::OptionsMask",static_pointer_cast<Tangible>(shared_from_this())));
+    PropertyChannel<Tangible>::Notify(Property::OPTIONS_MASK, static_pointer_cast<Tangible>(shared_from_this()));
 }
 
 void Tangible::ToggleOption(uint32_t option)
 {
 	options_bitmask_ ^= option;
-	GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
-        ("Tangible::OptionsMask",static_pointer_cast<Tangible>(shared_from_this())));
+	PropertyChannel<Tangible>::Notify(Property::OPTIONS_MASK, static_pointer_cast<Tangible>(shared_from_this()));
 }
 
 uint32_t Tangible::GetOptionsMask(void)
@@ -137,8 +148,7 @@ uint32_t Tangible::GetOptionsMask(void)
 void Tangible::SetIncapTimer(uint32_t incap_timer)
 {
     incap_timer_ = incap_timer;
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
-        ("Tangible::IncapTimer",static_pointer_cast<Tangible>(shared_from_this())));
+    PropertyChannel<Tangible>::Notify(Property::INCAP_TIMER, static_pointer_cast<Tangible>(shared_from_this()));
 }
 
 uint32_t Tangible::GetIncapTimer(void)
@@ -149,8 +159,7 @@ uint32_t Tangible::GetIncapTimer(void)
 void Tangible::SetConditionDamage(uint32_t damage)
 {
     condition_damage_ = damage;
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
-        ("Tangible::ConditionDamage",static_pointer_cast<Tangible>(shared_from_this())));
+    PropertyChannel<Tangible>::Notify(Property::CONDITION_DAMAGE, static_pointer_cast<Tangible>(shared_from_this()));
 }
 
 uint32_t Tangible::GetCondition(void)
@@ -161,8 +170,7 @@ uint32_t Tangible::GetCondition(void)
 void Tangible::SetMaxCondition(uint32_t max_condition)
 {
     max_condition_ = max_condition;
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
-        ("Tangible::MaxCondition",static_pointer_cast<Tangible>(shared_from_this())));
+    PropertyChannel<Tangible>::Notify(Property::MAX_CONDITION, static_pointer_cast<Tangible>(shared_from_this()));
 }
 
 uint32_t Tangible::GetMaxCondition(void)
@@ -173,8 +181,7 @@ uint32_t Tangible::GetMaxCondition(void)
 void Tangible::SetStatic(bool is_static)
 {
     is_static_ = is_static;
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
-        ("Tangible::Static",static_pointer_cast<Tangible>(shared_from_this())));
+    PropertyChannel<Tangible>::Notify(Property::STATIC, static_pointer_cast<Tangible>(shared_from_this()));
 }
 
 bool Tangible::IsStatic(void)
@@ -201,8 +208,7 @@ void Tangible::AddDefender(uint64_t defender)
         defender_list_.Add(Defender(defender));
     }
 
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
-        ("Tangible::Defenders",static_pointer_cast<Tangible>(shared_from_this())));
+    PropertyChannel<Tangible>::Notify(Property::DEFENDERS, static_pointer_cast<Tangible>(shared_from_this()));
 }
 void Tangible::RemoveDefender(uint64_t defender)
 {
@@ -220,8 +226,7 @@ void Tangible::RemoveDefender(uint64_t defender)
         defender_list_.Remove(iter);
     }
     
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
-        ("Tangible::Defenders",static_pointer_cast<Tangible>(shared_from_this())));
+    PropertyChannel<Tangible>::Notify(Property::DEFENDERS, static_pointer_cast<Tangible>(shared_from_this()));
 }
 void Tangible::ResetDefenders(std::vector<uint64_t> defenders)
 {
@@ -233,8 +238,7 @@ void Tangible::ResetDefenders(std::vector<uint64_t> defenders)
         });
         defender_list_.Reinstall();
     }
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
-        ("Tangible::Defenders",static_pointer_cast<Tangible>(shared_from_this())));
+    PropertyChannel<Tangible>::Notify(Property::DEFENDERS, static_pointer_cast<Tangible>(shared_from_this()));
 }
 
 NetworkSortedVector<Defender> Tangible::GetDefenders()
@@ -249,8 +253,7 @@ void Tangible::ClearDefenders()
         boost::lock_guard<boost::mutex> lock(tangible_mutex_);
         defender_list_.Clear();
     }   
-    GetEventDispatcher()->Dispatch(make_shared<TangibleEvent>
-        ("Tangible::Defenders",static_pointer_cast<Tangible>(shared_from_this())));
+    PropertyChannel<Tangible>::Notify(Property::DEFENDERS, static_pointer_cast<Tangible>(shared_from_this()));
 }
 
 void Tangible::ActivateAutoAttack()
@@ -89,10 +89,31 @@ class TangibleMessageBuilder;
 class Tangible : public swganh::object::Object
 {
 public:
+    /**
+     * Properties whose changes are announced on the tangible's PropertyChannel.
+     */
+    enum class Property : uint16_t
+    {
+        CUSTOMIZATION,
+        COMPONENT_CUSTOMIZATION,
+        OPTIONS_MASK,
+        INCAP_TIMER,
+        CONDITION_DAMAGE,
+        MAX_CONDITION,
+        STATIC,
+        DEFENDERS,
+        PROPERTY_COUNT
+    };
+
     // TANO
     virtual uint32_t GetType() const { return Tangible::type; }
     const static uint32_t type = 0x54414e4f;
 
+    /**
+     * @return The persistence group a property is stored with.
+     */
+    static uint32_t GetPersistGroup(Property property);
+
     Tangible();
     Tangible(const std::string& customization, std::vector<uint32_t> component_customization, uint32_t bitmask_options,
         uint32_t incap_timer, uint32_t damage_amount, uint32_t max_condition, bool is_static, std::vector<uint64_t> defenders);
@@ -36,7 +36,7 @@ void TangibleFactory::LoadTemplates()
     try {
 
         auto conn = db_manager_->getConnection("galaxy");
-        auto statement = conn->prepareStatement("CALL sp_GetTangibleTemplates();");
+        auto statement = db_manager_->prepareStatement(conn, "CALL sp_GetTangibleTemplates();");
         auto result = unique_ptr<sql::ResultSet>(statement->executeQuery());
 
         while (result->next())
@@ -66,13 +66,29 @@ unordered_map<string, shared_ptr<Tangible>>::iterator TangibleFactory::GetTempla
     });
     return found;
 }
-void TangibleFactory::PersistObject(const shared_ptr<Object>& object)
+void TangibleFactory::PersistObject(const shared_ptr<Object>& object, const shared_ptr<sql::Connection>& connection)
 {
+    PersistTangible_(object, connection);
+
+    // a tangible stores no other groups
+    object->TakePersistDirty(~(Object::PERSIST_OBJECT | Object::PERSIST_TANGIBLE));
+}
+
+void TangibleFactory::PersistTangible_(const shared_ptr<Object>& object, const shared_ptr<sql::Connection>& connection)
+{
+    // sp_PersistTangible writes the base object too, without tangible changes only the base is written
+    if (!(object->GetPersistDirty() & Object::PERSIST_TANGIBLE))
+    {
+        ObjectFactory::PersistObject(object, connection);
+        return;
+    }
+
+    uint32_t groups = object->TakePersistDirty(Object::PERSIST_OBJECT | Object::PERSIST_TANGIBLE);
+
     try 
     {
-        auto conn = db_manager_->getConnection("galaxy");
-        auto statement = shared_ptr<sql::PreparedStatement>
-            (conn->prepareStatement("CALL sp_PersistTangible(?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?);"));
+        auto statement = db_manager_->prepareStatement(connection,
+            "CALL sp_PersistTangible(?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?,?);");
         ObjectFactory::PersistObject(object, statement);
         // cast to tangible
         auto tangible = static_pointer_cast<Tangible>(object);
@@ -88,6 +104,7 @@ void TangibleFactory::PersistObject(const shared_ptr<Object>& object)
     {
         LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
+        object->MarkPersistDirty(groups);
     }
 }
 
@@ -96,7 +113,7 @@ void TangibleFactory::DeleteObjectFromStorage(const shared_ptr<Object>& object)
     try 
     {
         auto conn = db_manager_->getConnection("galaxy");
-        auto statement = conn->prepareStatement("CALL sp_DeleteTangible(?);");
+        auto statement = db_manager_->prepareStatement(conn, "CALL sp_DeleteTangible(?);");
         statement->setUInt64(1, object->GetObjectId());
         statement->execute();
     }
@@ -116,12 +133,7 @@ void TangibleFactory::CreateTangible(const shared_ptr<Tangible>& tangible, const
             result.reset(statement->getResultSet());
             while (result->next())
             {
-                tangible->SetCustomization(result->getString("customization"));
-                tangible->SetOptionsMask(result->getUInt("options_bitmask"));
-                tangible->SetIncapTimer(result->getUInt("incap_timer"));
-                tangible->SetConditionDamage(result->getUInt("condition_damage"));
-                tangible->SetMaxCondition(result->getUInt("max_condition"));
-                tangible->SetStatic(result->getBoolean("is_static"));
+                LoadTangibleRow(tangible, result);
             }
         }
     }
@@ -131,6 +143,15 @@ void TangibleFactory::CreateTangible(const shared_ptr<Tangible>& tangible, const
         LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
     }
 }
+void TangibleFactory::LoadTangibleRow(const shared_ptr<Tangible>& tangible, const shared_ptr<sql::ResultSet>& result)
+{
+    tangible->SetCustomization(result->getString("customization"));
+    tangible->SetOptionsMask(result->getUInt("options_bitmask"));
+    tangible->SetIncapTimer(result->getUInt("incap_timer"));
+    tangible->SetConditionDamage(result->getUInt("condition_damage"));
+    tangible->SetMaxCondition(result->getUInt("max_condition"));
+    tangible->SetStatic(result->getBoolean("is_static"));
+}
 shared_ptr<Object> TangibleFactory::CreateObjectFromStorage(uint64_t object_id)
 {
     auto tangible = make_shared<Tangible>();
@@ -144,6 +165,9 @@ shared_ptr<Object> TangibleFactory::CreateObjectFromStorage(uint64_t object_id)
 
         statement->execute(ss.str());
         CreateTangible(tangible, statement);  
+
+        // loading went through the setters, yet the tangible matches storage
+        tangible->ClearPersistDirty();
     }
     catch(sql::SQLException &e)
     {
@@ -38,18 +38,27 @@ namespace tangible {
 
         bool HasTemplate(const std::string& template_name);
 
-        void PersistObject(const std::shared_ptr<swganh::object::Object>& object);
+        void PersistObject(const std::shared_ptr<swganh::object::Object>& object, const std::shared_ptr<sql::Connection>& connection);
 
         void DeleteObjectFromStorage(const std::shared_ptr<swganh::object::Object>& object);
 
         std::shared_ptr<swganh::object::Object> CreateObjectFromStorage(uint64_t object_id);
         void CreateTangible(const std::shared_ptr<Tangible>& tangible, const std::shared_ptr<sql::Statement>& statement);
+        /**
+         * Loads in tangible values from the current row of a result set
+         */
+        static void LoadTangibleRow(const std::shared_ptr<Tangible>& tangible, const std::shared_ptr<sql::ResultSet>& result);
 
         std::shared_ptr<swganh::object::Object> CreateObjectFromTemplate(const std::string& template_name);
         
         virtual uint32_t GetType() const;
         const static uint32_t type;
         virtual void RegisterEventHandlers(){}
+    protected:
+        /**
+         * Writes the base object and tangible groups that changed since they were last written.
+         */
+        void PersistTangible_(const std::shared_ptr<swganh::object::Object>& object, const std::shared_ptr<sql::Connection>& connection);
     private:
         std::unordered_map<std::string, std::shared_ptr<swganh::object::tangible::Tangible>>::iterator GetTemplateIter_(const std::string& template_name);
         std::unordered_map<std::string, std::shared_ptr<swganh::object::tangible::Tangible>> tangible_templates_;
@@ -7,6 +7,7 @@
 
 #include "tangible.h"
 #include "swganh/object/object_events.h"
+#include "swganh/object/property_channel.h"
 #include "swganh/messages/scene_end_baselines.h"
 #include "swganh/messages/deltas_message.h"
 #include "swganh/messages/baselines_message.h"
@@ -25,63 +26,34 @@ void TangibleMessageBuilder::RegisterEventHandlers()
         auto controller_event = static_pointer_cast<ControllerEvent>(incoming_event);
         SendBaselines(static_pointer_cast<Tangible>(controller_event->object), controller_event->controller);
     });
-    event_dispatcher->Subscribe("Tangible::Customization", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<TangibleEvent>(incoming_event);
-        BuildCustomizationDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Tangible::ComponentCustomization", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<TangibleEvent>(incoming_event);
-        BuildComponentCustomizationDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Tangible::OptionsMask", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<TangibleEvent>(incoming_event);
-        BuildOptionsMaskDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Tangible::IncapTimer", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<TangibleEvent>(incoming_event);
-        BuildIncapTimerDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Tangible::ConditionDamage", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<TangibleEvent>(incoming_event);
-        BuildConditionDamageDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Tangible::MaxCondition", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<TangibleEvent>(incoming_event);
-        BuildMaxConditionDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Tangible::Static", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<TangibleEvent>(incoming_event);
-        BuildStaticDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Tangible::Customization", [this] (shared_ptr<EventInterface> incoming_event)
-    {
-        auto value_event = static_pointer_cast<TangibleEvent>(incoming_event);
-        BuildCustomizationDelta(value_event->Get());
-    });
-    event_dispatcher->Subscribe("Tangible::Defenders", [this] (shared_ptr<EventInterface> incoming_event)
+    PropertyChannel<Tangible>::Subscribe(Tangible::Property::CUSTOMIZATION, &BuildCustomizationDelta);
+    PropertyChannel<Tangible>::Subscribe(Tangible::Property::COMPONENT_CUSTOMIZATION, &BuildComponentCustomizationDelta);
+    PropertyChannel<Tangible>::Subscribe(Tangible::Property::OPTIONS_MASK, &BuildOptionsMaskDelta);
+    PropertyChannel<Tangible>::Subscribe(Tangible::Property::INCAP_TIMER, &BuildIncapTimerDelta);
+    PropertyChannel<Tangible>::Subscribe(Tangible::Property::CONDITION_DAMAGE, &BuildConditionDamageDelta);
+    PropertyChannel<Tangible>::Subscribe(Tangible::Property::MAX_CONDITION, &BuildMaxConditionDelta);
+    PropertyChannel<Tangible>::Subscribe(Tangible::Property::STATIC, &BuildStaticDelta);
+    PropertyChannel<Tangible>::Subscribe(Tangible::Property::CUSTOMIZATION, &BuildCustomizationDelta);
+    PropertyChannel<Tangible>::Subscribe(Tangible::Property::DEFENDERS, &BuildDefendersDelta);
+}
+shared_ptr<const BaselinesSnapshot> TangibleMessageBuilder::GetBaselines(const shared_ptr<Tangible>& tangible)
+{
+    return tangible->GetBaselinesSnapshot([&tangible] () -> BaselinesCacheContainer
     {
-        auto value_event = static_pointer_cast<TangibleEvent>(incoming_event);
-        BuildDefendersDelta(value_event->Get());
+        BaselinesCacheContainer baselines;
+        baselines.push_back(BuildBaseline3(tangible));
+        baselines.push_back(BuildBaseline6(tangible));
+        baselines.push_back(BuildBaseline7(tangible));
+        return baselines;
     });
 }
 void TangibleMessageBuilder::SendBaselines(const shared_ptr<Tangible>& tangible, const shared_ptr<ObjectController>& controller)
 {
-    tangible->AddBaselineToCache(BuildBaseline3(tangible));
-    tangible->AddBaselineToCache(BuildBaseline6(tangible));
-    tangible->AddBaselineToCache(BuildBaseline7(tangible));
-
-    for (auto& baseline : tangible->GetBaselines())
+    for (auto& baseline : *GetBaselines(tangible))
     {
         controller->Notify(baseline);
     }
-        
+
     SendEndBaselines(tangible, controller);
 }
 void TangibleMessageBuilder::BuildCustomizationDelta(const shared_ptr<Tangible>& tangible)
@@ -5,6 +5,7 @@
 #define SWGANH_OBJECT_TANGIBLE_TANGIBLE_MESSAGE_BUILDER_H_
 
 #include "swganh/object/object_message_builder.h"
+#include "swganh/object/tangible/tangible.h"
 
 namespace swganh {
 namespace object {
@@ -21,6 +22,11 @@ namespace tangible {
         }
         virtual void RegisterEventHandlers();
         virtual void SendBaselines(const std::shared_ptr<Tangible>& tangible, const std::shared_ptr<ObjectController>& controller);
+        /**
+         * Returns the tangible's serialized baselines, built only if it changed since
+         * they were last asked for.
+         */
+        static std::shared_ptr<const BaselinesSnapshot> GetBaselines(const std::shared_ptr<Tangible>& tangible);
         // deltas
         static void BuildCustomizationDelta(const std::shared_ptr<Tangible>& tangible);
         static void BuildComponentCustomizationDelta(const std::shared_ptr<Tangible>& tangible);
@@ -39,10 +39,20 @@ void WaypointFactory::RegisterEventHandlers()
     {
         auto value_event = static_pointer_cast<ValueEvent<NetworkMap<uint64_t, player::PlayerWaypointSerializer>>>(incoming_event);
         auto waypoints = value_event->Get();
-        for(auto& waypoint_pair : waypoints)
+
+        try
         {
-            PersistObject(waypoint_pair.second.waypoint);
-        };
+            auto conn = db_manager_->getConnection("galaxy");
+            for(auto& waypoint_pair : waypoints)
+            {
+                PersistObject(waypoint_pair.second.waypoint, conn);
+            };
+        }
+        catch(sql::SQLException &e)
+        {
+            LOG(error) << "SQLException at " << __FILE__ << " (" << __LINE__ << ": " << __FUNCTION__ << ")";
+            LOG(error) << "MySQL Error: (" << e.getErrorCode() << ": " << e.getSQLState() << ") " << e.what();
+        }
     });
     event_dispatcher_->Subscribe("LoadWaypoints", [this] (shared_ptr<anh::EventInterface> incoming_event)
     {
@@ -77,7 +87,7 @@ void WaypointFactory::LoadTemplates()
 {
     try {
         auto conn = db_manager_->getConnection("galaxy");
-        auto statement = conn->prepareStatement("CALL sp_GetWaypointTemplates();");
+        auto statement = db_manager_->prepareStatement(conn, "CALL sp_GetWaypointTemplates();");
         auto result = unique_ptr<sql::ResultSet>(statement->executeQuery());
 
 		while (result->next())
@@ -117,33 +127,16 @@ unordered_map<string,shared_ptr<Waypoint>>::iterator WaypointFactory::GetTemplat
     return iter;
 }
 
-void WaypointFactory::PersistObject(const shared_ptr<Object>& object)
+void WaypointFactory::PersistObject(const shared_ptr<Object>& object, const shared_ptr<sql::Connection>& connection)
 {
     if (object->IsDirty() && object->GetType() ==  Waypoint::type)
     {
         try 
         {
-            auto waypoint = static_pointer_cast<Waypoint>(object);
-            auto conn = db_manager_->getConnection("galaxy");
-            auto statement = conn->prepareStatement("CALL sp_PersistWaypoint(?,?,?,?,?,?,?,?,?,?,?,?,?);");
-            statement->setDouble(1,waypoint->GetComplexity());
-            statement->setString(2, waypoint->GetStfNameFile());
-            statement->setString(3, waypoint->GetStfNameString());
-
-            auto custom_name = waypoint->GetCustomName();
-            statement->setString(4, string(begin(custom_name), end(custom_name)));
-
-            statement->setUInt(5, waypoint->GetVolume());
-
-            auto coords = waypoint->GetCoordinates();
-            statement->setDouble(6, coords.x);
-            statement->setDouble(7, coords.y);
-            statement->setDouble(8, coords.z);
-            statement->setUInt(9, waypoint->GetActiveFlag());
-            statement->setString(10, waypoint->GetPlanet());
-            statement->setString(11, waypoint->GetNameStandard());
-            statement->setString(12, waypoint->GetColor());
-            statement->execute();
+            PersistWaypoint(db_manager_, static_pointer_cast<Waypoint>(object), connection);
+
+            // the statement writes everything stored for the type
+            object->ClearPersistDirty();
         }
             catch(sql::SQLException &e)
         {
@@ -153,12 +146,37 @@ void WaypointFactory::PersistObject(const shared_ptr<Object>& object)
     }
 }
 
+void WaypointFactory::PersistWaypoint(DatabaseManagerInterface* db_manager,
+                                      const shared_ptr<Waypoint>& waypoint,
+                                      const shared_ptr<sql::Connection>& connection)
+{
+    auto statement = db_manager->prepareStatement(connection, "CALL sp_PersistWaypoint(?,?,?,?,?,?,?,?,?,?,?,?,?);");
+    statement->setDouble(1,waypoint->GetComplexity());
+    statement->setString(2, waypoint->GetStfNameFile());
+    statement->setString(3, waypoint->GetStfNameString());
+
+    auto custom_name = waypoint->GetCustomName();
+    statement->setString(4, string(begin(custom_name), end(custom_name)));
+
+    statement->setUInt(5, waypoint->GetVolume());
+
+    auto coords = waypoint->GetCoordinates();
+    statement->setDouble(6, coords.x);
+    statement->setDouble(7, coords.y);
+    statement->setDouble(8, coords.z);
+    statement->setUInt(9, waypoint->GetActiveFlag());
+    statement->setString(10, waypoint->GetPlanet());
+    statement->setString(11, waypoint->GetNameStandard());
+    statement->setString(12, waypoint->GetColor());
+    statement->execute();
+}
+
 void WaypointFactory::DeleteObjectFromStorage(const shared_ptr<Object>& object)
 {
     try 
     {
         auto conn = db_manager_->getConnection("galaxy");
-        auto statement = conn->prepareStatement("CALL sp_DeleteWaypoint(?);");
+        auto statement = db_manager_->prepareStatement(conn, "CALL sp_DeleteWaypoint(?);");
         statement->setUInt64(1, object->GetObjectId());
         statement->execute();
     }
@@ -36,7 +36,15 @@ namespace waypoint {
 
         bool HasTemplate(const std::string& template_name);
 
-        void PersistObject(const std::shared_ptr<swganh::object::Object>& object);
+        void PersistObject(const std::shared_ptr<swganh::object::Object>& object, const std::shared_ptr<sql::Connection>& connection);
+        /**
+         * Writes a waypoint through the given connection
+         *
+         * @throws sql::SQLException when the write fails
+         */
+        static void PersistWaypoint(anh::database::DatabaseManagerInterface* db_manager,
+            const std::shared_ptr<Waypoint>& waypoint,
+            const std::shared_ptr<sql::Connection>& connection);
 
         void DeleteObjectFromStorage(const std::shared_ptr<swganh::object::Object>& object);
 
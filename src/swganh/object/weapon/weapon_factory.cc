@@ -17,9 +17,6 @@ bool WeaponFactory::HasTemplate(const string& template_name)
     return false;
 }
 
-void WeaponFactory::PersistObject(const shared_ptr<Object>& object)
-{}
-
 void WeaponFactory::DeleteObjectFromStorage(const shared_ptr<Object>& object)
 {}
 
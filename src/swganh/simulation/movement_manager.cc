@@ -15,7 +15,7 @@
 #include "swganh/messages/update_transform_message.h"
 #include "swganh/messages/update_transform_with_parent_message.h"
 
-#include "swganh/simulation/spatial_provider_interface.h"
+#include "swganh/simulation/scene_manager.h"
 
 using namespace anh::event_dispatcher;
 using namespace std;
@@ -25,8 +25,8 @@ using namespace swganh::object;
 using namespace swganh::object::creature;
 using namespace swganh::simulation;
 
-MovementManager::MovementManager(anh::EventDispatcher* event_dispatcher, std::shared_ptr<SpatialProviderInterface> spatial_provider)
-	: spatial_provider_(spatial_provider)
+MovementManager::MovementManager(anh::EventDispatcher* event_dispatcher, std::shared_ptr<SceneManager> scene_manager)
+	: scene_manager_(scene_manager)
 {
     RegisterEvents(event_dispatcher);
 }
@@ -44,8 +44,12 @@ void MovementManager::HandleDataTransform(
 
     counter_map_[object->GetObjectId()] = message.counter;
     
-	glm::vec3 old_position = object->GetPosition();
-	spatial_provider_->UpdateObject(controller->GetObject(), old_position, message.position);
+	// Update the index and awareness before the object reports its new position.
+	auto scene = scene_manager_->GetScene(object->GetSceneId());
+	if (scene)
+	{
+		scene->UpdateObject(object, object->GetPosition(), message.position);
+	}
 
     object->SetPosition(message.position);
     object->SetOrientation(message.orientation);
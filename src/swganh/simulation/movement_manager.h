@@ -34,12 +34,12 @@ namespace object {
 
 namespace swganh {
 namespace simulation {
-	class SpatialProviderInterface;
+	class SceneManager;
 
     class MovementManager
     {
     public:
-		explicit MovementManager(anh::EventDispatcher* event_dispatcher, std::shared_ptr<SpatialProviderInterface> spatial_provider);
+		explicit MovementManager(anh::EventDispatcher* event_dispatcher, std::shared_ptr<SceneManager> scene_manager);
 
         void HandleDataTransform(
             const std::shared_ptr<swganh::object::ObjectController>& controller, 
@@ -66,7 +66,7 @@ namespace simulation {
         > UpdateCounterMap;
 
         UpdateCounterMap counter_map_;
-		std::shared_ptr<SpatialProviderInterface> spatial_provider_;
+		std::shared_ptr<SceneManager> scene_manager_;
     };
 
 }}  // namespace swganh::simulation
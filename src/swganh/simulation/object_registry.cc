@@ -0,0 +1,210 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include "swganh/simulation/object_registry.h"
+
+#include "swganh/object/object.h"
+
+using namespace std;
+using namespace swganh::simulation;
+
+using swganh::object::Object;
+
+ObjectRegistry::ObjectRegistry()
+{}
+
+ObjectRegistry::~ObjectRegistry()
+{}
+
+ObjectHandle ObjectRegistry::Insert(const shared_ptr<Object>& object)
+{
+    uint64_t object_id = object->GetObjectId();
+    uint32_t type = object->GetType();
+
+    boost::lock_guard<boost::mutex> lock(mutex_);
+
+    auto find_iter = slot_index_.find(object_id);
+    if (find_iter != slot_index_.end())
+    {
+        return ObjectHandle(find_iter->second, slots_[find_iter->second].generation);
+    }
+
+    uint32_t index;
+    if (!free_slots_.empty())
+    {
+        index = free_slots_.back();
+        free_slots_.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(slots_.size());
+        slots_.push_back(Slot());
+    }
+
+    TypeStorage& storage = types_[type];
+
+    Slot& slot = slots_[index];
+    ++slot.generation;
+    slot.type = type;
+    slot.dense_index = static_cast<uint32_t>(storage.objects.size());
+
+    storage.objects.push_back(object);
+    storage.slots.push_back(index);
+    storage.snapshot.reset();
+
+    slot_index_.insert(make_pair(object_id, index));
+
+    return ObjectHandle(index, slot.generation);
+}
+
+bool ObjectRegistry::Remove(uint64_t object_id)
+{
+    // Released once the lock is, in case this was the last reference.
+    shared_ptr<Object> removed;
+
+    boost::lock_guard<boost::mutex> lock(mutex_);
+
+    auto find_iter = slot_index_.find(object_id);
+    if (find_iter == slot_index_.end())
+    {
+        return false;
+    }
+
+    uint32_t index = find_iter->second;
+    slot_index_.erase(find_iter);
+
+    Slot& slot = slots_[index];
+    ++slot.generation;
+
+    // Move the type's last object into the vacated position.
+    TypeStorage& storage = types_[slot.type];
+    uint32_t last = static_cast<uint32_t>(storage.objects.size() - 1);
+
+    removed = move(storage.objects[slot.dense_index]);
+
+    if (slot.dense_index != last)
+    {
+        storage.objects[slot.dense_index] = move(storage.objects[last]);
+        storage.slots[slot.dense_index] = storage.slots[last];
+        slots_[storage.slots[last]].dense_index = slot.dense_index;
+    }
+
+    storage.objects.pop_back();
+    storage.slots.pop_back();
+    storage.snapshot.reset();
+
+    free_slots_.push_back(index);
+
+    return true;
+}
+
+shared_ptr<Object> ObjectRegistry::Find(uint64_t object_id) const
+{
+    boost::lock_guard<boost::mutex> lock(mutex_);
+
+    auto find_iter = slot_index_.find(object_id);
+    if (find_iter == slot_index_.end())
+    {
+        return nullptr;
+    }
+
+    const Slot& slot = slots_[find_iter->second];
+    return types_.find(slot.type)->second.objects[slot.dense_index];
+}
+
+ObjectHandle ObjectRegistry::FindHandle(uint64_t object_id) const
+{
+    boost::lock_guard<boost::mutex> lock(mutex_);
+
+    auto find_iter = slot_index_.find(object_id);
+    if (find_iter == slot_index_.end())
+    {
+        return ObjectHandle();
+    }
+
+    return ObjectHandle(find_iter->second, slots_[find_iter->second].generation);
+}
+
+shared_ptr<Object> ObjectRegistry::Get(ObjectHandle handle) const
+{
+    boost::lock_guard<boost::mutex> lock(mutex_);
+
+    if (handle.index >= slots_.size())
+    {
+        return nullptr;
+    }
+
+    const Slot& slot = slots_[handle.index];
+    if (slot.generation != handle.generation || !(slot.generation & 1))
+    {
+        return nullptr;
+    }
+
+    return types_.find(slot.type)->second.objects[slot.dense_index];
+}
+
+void ObjectRegistry::ForEachOfType(uint32_t type, const ObjectVisitor& visitor)
+{
+    shared_ptr<const ObjectList> snapshot;
+
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        snapshot = GetSnapshot_(type);
+    }
+
+    if (!snapshot)
+    {
+        return;
+    }
+
+    for (const auto& object : *snapshot)
+    {
+        visitor(object);
+    }
+}
+
+void ObjectRegistry::ForEach(const ObjectVisitor& visitor)
+{
+    vector<shared_ptr<const ObjectList>> snapshots;
+
+    {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        snapshots.reserve(types_.size());
+
+        for (const auto& entry : types_)
+        {
+            snapshots.push_back(GetSnapshot_(entry.first));
+        }
+    }
+
+    for (const auto& snapshot : snapshots)
+    {
+        for (const auto& object : *snapshot)
+        {
+            visitor(object);
+        }
+    }
+}
+
+size_t ObjectRegistry::size() const
+{
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    return slot_index_.size();
+}
+
+shared_ptr<const ObjectRegistry::ObjectList> ObjectRegistry::GetSnapshot_(uint32_t type)
+{
+    auto find_iter = types_.find(type);
+    if (find_iter == types_.end())
+    {
+        return nullptr;
+    }
+
+    TypeStorage& storage = find_iter->second;
+    if (!storage.snapshot)
+    {
+        storage.snapshot = make_shared<const ObjectList>(storage.objects);
+    }
+
+    return storage.snapshot;
+}
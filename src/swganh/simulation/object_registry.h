@@ -0,0 +1,152 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef SWGANH_SIMULATION_OBJECT_REGISTRY_H_
+#define SWGANH_SIMULATION_OBJECT_REGISTRY_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
+
+#include "swganh/simulation/spatial_provider_interface.h"
+
+namespace swganh {
+namespace object {
+    class Object;
+}}  // namespace swganh::object
+
+namespace swganh {
+namespace simulation {
+
+    /**
+     * Refers to an object in an ObjectRegistry.
+     *
+     * A handle outlives the object it refers to safely, once the object is
+     * removed the handle no longer resolves, even if its slot is reused.
+     */
+    struct ObjectHandle
+    {
+        ObjectHandle()
+            : index(0)
+            , generation(0)
+        {}
+
+        ObjectHandle(uint32_t index_, uint32_t generation_)
+            : index(index_)
+            , generation(generation_)
+        {}
+
+        bool IsValid() const { return generation != 0; }
+
+        uint32_t index;
+        uint32_t generation;
+    };
+
+    /**
+     * Holds the objects loaded into the simulation.
+     *
+     * Objects live in slots addressed by generational handles, with a side
+     * index from object id to slot. Every object type is also kept densely
+     * packed so a tick can walk all creatures, say, as a flat array.
+     *
+     * The lock is only held for the length of a lookup or update, never while
+     * calling back into a visitor. Iterating walks an immutable snapshot of
+     * the type's array that is rebuilt only after the type changed. An object
+     * removed meanwhile stays alive until the last snapshot holding it is
+     * released, so visitors are free to add, remove and look up objects.
+     */
+    class ObjectRegistry
+    {
+    public:
+        ObjectRegistry();
+        ~ObjectRegistry();
+
+        /**
+         * Adds an object to the registry.
+         *
+         * @return The object's handle, the existing one if its id is already registered.
+         */
+        ObjectHandle Insert(const std::shared_ptr<swganh::object::Object>& object);
+
+        /**
+         * Removes the object with the given id.
+         *
+         * @return True if the object was registered.
+         */
+        bool Remove(uint64_t object_id);
+
+        /**
+         * @return The object with the given id, or nullptr if it isn't registered.
+         */
+        std::shared_ptr<swganh::object::Object> Find(uint64_t object_id) const;
+
+        /**
+         * @return The handle of the object with the given id, invalid if it isn't registered.
+         */
+        ObjectHandle FindHandle(uint64_t object_id) const;
+
+        /**
+         * @return The object the handle refers to, or nullptr if it was removed.
+         */
+        std::shared_ptr<swganh::object::Object> Get(ObjectHandle handle) const;
+
+        /**
+         * Invokes the visitor for every registered object of the given type.
+         *
+         * @param type The type as returned by Object::GetType, e.g. Creature::type.
+         */
+        void ForEachOfType(uint32_t type, const ObjectVisitor& visitor);
+
+        /**
+         * Invokes the visitor for every registered object.
+         */
+        void ForEach(const ObjectVisitor& visitor);
+
+        /**
+         * @return The number of registered objects.
+         */
+        size_t size() const;
+
+    private:
+        typedef std::vector<std::shared_ptr<swganh::object::Object>> ObjectList;
+
+        struct Slot
+        {
+            Slot()
+                : generation(0)
+                , type(0)
+                , dense_index(0)
+            {}
+
+            // Odd while the slot holds an object.
+            uint32_t generation;
+            uint32_t type;
+            uint32_t dense_index;
+        };
+
+        struct TypeStorage
+        {
+            ObjectList objects;
+            std::vector<uint32_t> slots;
+
+            // Rebuilt from objects the first time it is iterated after a change.
+            std::shared_ptr<const ObjectList> snapshot;
+        };
+
+        std::shared_ptr<const ObjectList> GetSnapshot_(uint32_t type);
+
+        mutable boost::mutex mutex_;
+
+        std::vector<Slot> slots_;
+        std::vector<uint32_t> free_slots_;
+        std::unordered_map<uint64_t, uint32_t> slot_index_;
+        std::map<uint32_t, TypeStorage> types_;
+    };
+
+}}  // namespace swganh::simulation
+
+#endif  // SWGANH_SIMULATION_OBJECT_REGISTRY_H_
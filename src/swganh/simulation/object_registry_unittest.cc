@@ -0,0 +1,141 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+
+#include "swganh/object/object.h"
+#include "swganh/simulation/object_registry.h"
+
+using namespace std;
+using swganh::object::Object;
+using swganh::simulation::ObjectHandle;
+using swganh::simulation::ObjectRegistry;
+
+namespace {
+
+/// An object of its own type, so tests can tell the dense arrays apart.
+class TestCreature : public Object
+{
+public:
+    virtual uint32_t GetType() const { return TestCreature::type; }
+    const static uint32_t type = 0x4352454F;
+};
+
+template<typename T>
+shared_ptr<T> CreateObject(uint64_t object_id)
+{
+    auto object = make_shared<T>();
+    object->SetObjectId(object_id);
+    return object;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(ObjectRegistryTests)
+
+///
+BOOST_AUTO_TEST_CASE(FindsInsertedObjectsByIdAndHandle)
+{
+    ObjectRegistry registry;
+    auto object = CreateObject<Object>(10);
+
+    ObjectHandle handle = registry.Insert(object);
+
+    BOOST_CHECK(handle.IsValid());
+    BOOST_CHECK(registry.Find(10) == object);
+    BOOST_CHECK(registry.Get(handle) == object);
+    BOOST_CHECK(!registry.Find(11));
+    BOOST_CHECK_EQUAL(1u, registry.size());
+
+    // Inserting the same id again hands back the original handle.
+    ObjectHandle again = registry.Insert(object);
+    BOOST_CHECK_EQUAL(handle.index, again.index);
+    BOOST_CHECK_EQUAL(handle.generation, again.generation);
+    BOOST_CHECK_EQUAL(1u, registry.size());
+}
+
+///
+BOOST_AUTO_TEST_CASE(HandleOfRemovedObjectStaysInvalidWhenSlotIsReused)
+{
+    ObjectRegistry registry;
+
+    ObjectHandle removed_handle = registry.Insert(CreateObject<Object>(10));
+    BOOST_CHECK(registry.Remove(10));
+    BOOST_CHECK(!registry.Remove(10));
+
+    auto replacement = CreateObject<Object>(20);
+    ObjectHandle replacement_handle = registry.Insert(replacement);
+
+    BOOST_CHECK_EQUAL(removed_handle.index, replacement_handle.index);
+    BOOST_CHECK(!registry.Get(removed_handle));
+    BOOST_CHECK(!registry.Find(10));
+    BOOST_CHECK(registry.Get(replacement_handle) == replacement);
+    BOOST_CHECK(!registry.Get(ObjectHandle()));
+}
+
+///
+BOOST_AUTO_TEST_CASE(VisitsOnlyObjectsOfTheRequestedType)
+{
+    ObjectRegistry registry;
+
+    for (uint64_t id = 1; id <= 6; ++id)
+    {
+        if (id % 2)
+        {
+            registry.Insert(CreateObject<TestCreature>(id));
+        }
+        else
+        {
+            registry.Insert(CreateObject<Object>(id));
+        }
+    }
+
+    registry.Remove(3);
+
+    set<uint64_t> creatures;
+    registry.ForEachOfType(TestCreature::type, [&creatures] (const shared_ptr<Object>& object) {
+        creatures.insert(object->GetObjectId());
+    });
+
+    set<uint64_t> expected_creatures;
+    expected_creatures.insert(1);
+    expected_creatures.insert(5);
+    BOOST_CHECK(creatures == expected_creatures);
+
+    uint32_t visited = 0;
+    registry.ForEach([&visited] (const shared_ptr<Object>&) { ++visited; });
+    BOOST_CHECK_EQUAL(5u, visited);
+}
+
+///
+BOOST_AUTO_TEST_CASE(VisitorCanRemoveObjectsWhileIterating)
+{
+    ObjectRegistry registry;
+    weak_ptr<Object> first;
+
+    {
+        auto object = CreateObject<Object>(1);
+        first = object;
+        registry.Insert(object);
+    }
+
+    registry.Insert(CreateObject<Object>(2));
+    registry.Insert(CreateObject<Object>(3));
+
+    uint32_t visited = 0;
+    registry.ForEachOfType(0, [&] (const shared_ptr<Object>& object) {
+        ++visited;
+        registry.Remove(object->GetObjectId());
+
+        // Removed, but kept alive for the rest of this iteration.
+        BOOST_CHECK(!first.expired());
+    });
+
+    BOOST_CHECK_EQUAL(3u, visited);
+    BOOST_CHECK_EQUAL(0u, registry.size());
+    BOOST_CHECK(first.expired());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
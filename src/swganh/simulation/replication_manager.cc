@@ -0,0 +1,152 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include "replication_manager.h"
+
+#include "anh/event_dispatcher.h"
+
+#include "swganh/object/object.h"
+
+using namespace std;
+using namespace swganh::object;
+using namespace swganh::simulation;
+
+ReplicationManager::ReplicationManager(anh::EventDispatcher* event_dispatcher, boost::asio::io_service& io_service, uint32_t interval_ms)
+    : timer_(io_service)
+    , interval_ms_(interval_ms)
+{
+    RegisterEvents_(event_dispatcher);
+}
+
+ReplicationManager::~ReplicationManager()
+{}
+
+void ReplicationManager::Start()
+{
+    if (interval_ms_ == 0)
+    {
+        return;
+    }
+
+    Object::SetDeltasDeferred(true);
+
+    ScheduleTick_();
+}
+
+void ReplicationManager::Stop()
+{
+    Object::SetDeltasDeferred(false);
+
+    timer_.cancel();
+
+    Flush();
+}
+
+void ReplicationManager::Flush()
+{
+    map<uint32_t, ObjectList> dirty_objects;
+
+    {
+        boost::lock_guard<boost::mutex> lock(dirty_mutex_);
+        dirty_objects.swap(dirty_objects_);
+    }
+
+    for (auto& scene_objects : dirty_objects)
+    {
+        for (auto& object : scene_objects.second)
+        {
+            object->FlushDeltas();
+        }
+    }
+}
+
+void ReplicationManager::FlushScene(uint32_t scene_id)
+{
+    ObjectList dirty_objects;
+
+    {
+        boost::lock_guard<boost::mutex> lock(dirty_mutex_);
+
+        auto find_iter = dirty_objects_.find(scene_id);
+        if (find_iter == dirty_objects_.end())
+        {
+            return;
+        }
+
+        dirty_objects.swap(find_iter->second);
+        dirty_objects_.erase(find_iter);
+    }
+
+    for (auto& object : dirty_objects)
+    {
+        object->FlushDeltas();
+    }
+}
+
+void ReplicationManager::AddTickedScene(uint32_t scene_id)
+{
+    boost::lock_guard<boost::mutex> lock(dirty_mutex_);
+    ticked_scenes_.insert(scene_id);
+}
+
+void ReplicationManager::RemoveTickedScene(uint32_t scene_id)
+{
+    boost::lock_guard<boost::mutex> lock(dirty_mutex_);
+    ticked_scenes_.erase(scene_id);
+}
+
+void ReplicationManager::FlushUnticked_()
+{
+    ObjectList dirty_objects;
+
+    {
+        boost::lock_guard<boost::mutex> lock(dirty_mutex_);
+
+        for (auto iter = dirty_objects_.begin(); iter != dirty_objects_.end();)
+        {
+            if (ticked_scenes_.count(iter->first))
+            {
+                ++iter;
+                continue;
+            }
+
+            dirty_objects.insert(dirty_objects.end(), iter->second.begin(), iter->second.end());
+            iter = dirty_objects_.erase(iter);
+        }
+    }
+
+    for (auto& object : dirty_objects)
+    {
+        object->FlushDeltas();
+    }
+}
+
+void ReplicationManager::RegisterEvents_(anh::EventDispatcher* event_dispatcher)
+{
+    event_dispatcher->Subscribe(
+        "Object::DeltasPending",
+        [this] (shared_ptr<anh::EventInterface> incoming_event)
+    {
+        const auto& object = static_pointer_cast<Object::ObjectEvent>(incoming_event)->Get();
+
+        boost::lock_guard<boost::mutex> lock(dirty_mutex_);
+        dirty_objects_[object->GetSceneId()].push_back(object);
+    });
+}
+
+void ReplicationManager::ScheduleTick_()
+{
+    auto self = shared_from_this();
+
+    timer_.expires_from_now(boost::posix_time::milliseconds(interval_ms_));
+    timer_.async_wait([self] (const boost::system::error_code& error)
+    {
+        if (error || !Object::IsDeltasDeferred())
+        {
+            return;
+        }
+
+        self->FlushUnticked_();
+        self->ScheduleTick_();
+    });
+}
@@ -0,0 +1,96 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef SWGANH_SIMULATION_REPLICATION_MANAGER_H_
+#define SWGANH_SIMULATION_REPLICATION_MANAGER_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/thread/mutex.hpp>
+
+namespace anh {
+    class EventDispatcher;
+}  // namespace anh
+
+namespace swganh {
+namespace object {
+    class Object;
+}}  // namespace swganh::object
+
+namespace swganh {
+namespace simulation {
+
+    /**
+     * Sends object deltas to observers once per replication tick.
+     *
+     * While running, objects queue their deltas instead of sending them immediately.
+     * Every tick each object that changed is flushed, which merges everything it
+     * queued into a single deltas message per view.
+     *
+     * The objects of a scene ticked on a thread of its own are flushed by that
+     * scene's replication phase through FlushScene, the timer only flushes the
+     * objects of the remaining scenes.
+     */
+    class ReplicationManager : public std::enable_shared_from_this<ReplicationManager>
+    {
+    public:
+        /**
+         * @param interval_ms Length of a replication tick, 0 sends every delta as soon as it is built.
+         */
+        ReplicationManager(anh::EventDispatcher* event_dispatcher, boost::asio::io_service& io_service, uint32_t interval_ms);
+        ~ReplicationManager();
+
+        /**
+         * Starts deferring deltas and flushing them every tick.
+         */
+        void Start();
+
+        /**
+         * Stops the tick, flushes what is still queued and resumes sending deltas immediately.
+         */
+        void Stop();
+
+        /**
+         * Flushes the queued deltas of every object that changed since the last tick.
+         */
+        void Flush();
+
+        /**
+         * Flushes the queued deltas of the objects in the given scene.
+         */
+        void FlushScene(uint32_t scene_id);
+
+        /**
+         * Leaves flushing the objects of a scene to its own tick, through FlushScene.
+         */
+        void AddTickedScene(uint32_t scene_id);
+
+        /**
+         * Hands flushing the objects of a scene back to the timer.
+         */
+        void RemoveTickedScene(uint32_t scene_id);
+
+    private:
+        typedef std::vector<std::shared_ptr<swganh::object::Object>> ObjectList;
+
+        void RegisterEvents_(anh::EventDispatcher* event_dispatcher);
+        void ScheduleTick_();
+        void FlushUnticked_();
+
+        boost::asio::deadline_timer timer_;
+        uint32_t interval_ms_;
+
+        boost::mutex dirty_mutex_;
+        std::map<uint32_t, ObjectList> dirty_objects_;
+        std::set<uint32_t> ticked_scenes_;
+    };
+
+}}  // namespace swganh::simulation
+
+#endif  // SWGANH_SIMULATION_REPLICATION_MANAGER_H_
@@ -0,0 +1,117 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+
+#include <boost/asio/io_service.hpp>
+
+#include "anh/byte_buffer.h"
+#include "anh/event_dispatcher.h"
+#include "anh/observer/observer_interface.h"
+#include "swganh/messages/deltas_message.h"
+#include "swganh/object/object.h"
+#include "swganh/simulation/replication_manager.h"
+
+using namespace std;
+using swganh::messages::DeltasMessage;
+using swganh::object::Object;
+using swganh::simulation::ReplicationManager;
+
+namespace {
+
+/// Counts the messages it is notified with.
+class CountingObserver : public anh::observer::ObserverInterface
+{
+public:
+    CountingObserver()
+        : messages_received(0)
+    {}
+
+    uint64_t GetId() const { return 0; }
+
+    void Notify(const anh::ByteBuffer& message)
+    {
+        ++messages_received;
+    }
+
+    uint32_t messages_received;
+};
+
+DeltasMessage CreateDeltas(uint64_t object_id)
+{
+    DeltasMessage message;
+    message.object_id = object_id;
+    message.object_type = 0x4352454F;
+    message.view_type = 3;
+    message.update_count = 1;
+    message.update_type = 2;
+    message.data.write<uint32_t>(100);
+    return message;
+}
+
+}  // namespace
+
+///
+class ReplicationManagerTest {
+public:
+    ReplicationManagerTest()
+        : event_dispatcher_(io_service_)
+        , replication_manager_(make_shared<ReplicationManager>(&event_dispatcher_, io_service_, 100))
+    {
+        Object::SetDeltasDeferred(true);
+    }
+
+    ~ReplicationManagerTest()
+    {
+        Object::SetDeltasDeferred(false);
+    }
+
+protected:
+    /// Creates an object in the given scene with an observer, and queues a delta on it.
+    shared_ptr<CountingObserver> CreateChangedObject(uint64_t object_id, uint32_t scene_id)
+    {
+        auto object = make_shared<Object>();
+        object->SetEventDispatcher(&event_dispatcher_);
+        object->SetObjectId(object_id);
+        object->SetSceneId(scene_id);
+
+        auto observer = make_shared<CountingObserver>();
+        object->Subscribe(observer);
+
+        object->AddDeltasUpdate(CreateDeltas(object_id));
+        objects_.push_back(object);
+
+        return observer;
+    }
+
+    boost::asio::io_service io_service_;
+    anh::EventDispatcher event_dispatcher_;
+    shared_ptr<ReplicationManager> replication_manager_;
+    vector<shared_ptr<Object>> objects_;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ReplicationManagerTests, ReplicationManagerTest)
+
+///
+BOOST_AUTO_TEST_CASE(FlushSceneOnlySendsTheDeltasOfThatScene)
+{
+    auto first = CreateChangedObject(1, 1);
+    auto second = CreateChangedObject(2, 2);
+
+    // Delivers the pending events to the replication manager.
+    io_service_.run();
+
+    replication_manager_->FlushScene(1);
+
+    BOOST_CHECK_EQUAL(1u, first->messages_received);
+    BOOST_CHECK_EQUAL(0u, second->messages_received);
+
+    replication_manager_->Flush();
+
+    BOOST_CHECK_EQUAL(1u, first->messages_received);
+    BOOST_CHECK_EQUAL(1u, second->messages_received);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -4,10 +4,16 @@
 #include "swganh/simulation/scene.h"
 
 #include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
 
 #include "swganh/object/object.h"
 #include "swganh/object/object_controller.h"
 #include "swganh/messages/scene_destroy_object.h"
+#include "swganh/simulation/spatial_provider_interface.h"
 
 using namespace std;
 using namespace swganh::messages;
@@ -17,8 +23,11 @@ using namespace swganh::simulation;
 class Scene::SceneImpl
 {
 public:
-    SceneImpl(SceneDescription description)
+    SceneImpl(SceneDescription description, shared_ptr<SpatialProviderInterface> spatial_provider)
         : description_(move(description))
+        , spatial_provider_(move(spatial_provider))
+        , enter_range_(Scene::DEFAULT_AWARENESS_ENTER_RANGE)
+        , exit_range_(Scene::DEFAULT_AWARENESS_EXIT_RANGE)
     {}
 
     const SceneDescription& GetDescription() const
@@ -33,53 +42,164 @@ public:
 
     void AddObject(const shared_ptr<Object>& object)
     {
-		InsertObject(object);
+        boost::lock_guard<boost::mutex> lock(scene_mutex_);
 
-        for_each(begin(object_map_), end(object_map_),
-            [&object] (const ObjectMap::value_type& object_entry) 
+        if (HasObject(object))
         {
-            auto& stored_object = object_entry.second;
+            // Already in the scene, typically a client reconnecting to its character.
+            // Send it everything it can currently see again.
+            auto visibility_iter = visibility_.find(object->GetObjectId());
+            if (visibility_iter != visibility_.end())
+            {
+                ShowTree(object, object);
 
-            stored_object->AddAwareObject(object);
-            object->AddAwareObject(stored_object);
-        });
+                for_each(begin(visibility_iter->second), end(visibility_iter->second),
+                    [this, &object] (uint64_t other_id)
+                {
+                    ShowTree(object_map_[other_id], object);
+                });
+            }
 
-        auto contained_objects = object->GetContainedObjects();
-        
-        for_each(begin(contained_objects), end(contained_objects),
-            [this] (const ObjectMap::value_type& object_entry) 
+            return;
+        }
+
+        InsertObjectTree(object);
+
+        auto root = GetRoot(object);
+
+        if (root != object && HasObject(root))
         {
-            auto& stored_object = object_entry.second;
-            AddObject(stored_object);
-        });
+            // Contained objects are seen by whoever sees their container.
+            ShowTree(object, root);
 
+            auto& observers = visibility_[root->GetObjectId()];
+            for_each(begin(observers), end(observers), [this, &object] (uint64_t observer_id)
+            {
+                ShowTree(object, object_map_[observer_id]);
+            });
+
+            return;
+        }
+
+        visibility_[object->GetObjectId()];
+        spatial_provider_->AddObject(object);
+
+        // Every object sees itself and its own contents.
+        ShowTree(object, object);
+
+        spatial_provider_->VisitObjectsInRange(object->GetPosition(), enter_range_,
+            [this, &object] (const shared_ptr<Object>& other)
+        {
+            if (other != object)
+            {
+                Link(object, other);
+            }
+        });
     }
     
     void RemoveObject(const shared_ptr<Object>& object)
     {
+        boost::lock_guard<boost::mutex> lock(scene_mutex_);
+
         if (!HasObject(object))
         {
             return;
         }
 
-		EraseObject(object);
-                
-        SceneDestroyObject destroy_message;
-        destroy_message.object_id = object->GetObjectId();
+        auto visibility_iter = visibility_.find(object->GetObjectId());
 
-        for_each(begin(object_map_), end(object_map_),
-            [&object, &destroy_message] (const ObjectMap::value_type& object_entry) 
+        if (visibility_iter != visibility_.end())
         {
-            auto& stored_object = object_entry.second;
-            
-            stored_object->RemoveContainedObject(object);
-            stored_object->RemoveAwareObject(object);
+            for_each(begin(visibility_iter->second), end(visibility_iter->second),
+                [this, &object] (uint64_t other_id)
+            {
+                auto& other = object_map_[other_id];
+
+                HideTree(object, other, true);
+                HideTree(other, object, false);
 
-            if (stored_object->HasController())
+                visibility_[other_id].erase(object->GetObjectId());
+            });
+
+            visibility_.erase(visibility_iter);
+            spatial_provider_->RemoveObject(object);
+        }
+        else
+        {
+            auto root = GetRoot(object);
+
+            if (HasObject(root))
             {
-                stored_object->GetController()->Notify(destroy_message);
+                HideTree(object, root, true);
+
+                auto& observers = visibility_[root->GetObjectId()];
+                for_each(begin(observers), end(observers), [this, &object] (uint64_t observer_id)
+                {
+                    HideTree(object, object_map_[observer_id], true);
+                });
+            }
+        }
+
+        auto container = object->GetContainer();
+        if (container)
+        {
+            container->RemoveContainedObject(object);
+        }
+
+        EraseObjectTree(object);
+    }
+
+    void UpdateObject(const shared_ptr<Object>& object, const glm::vec3& old_position, const glm::vec3& new_position)
+    {
+        boost::lock_guard<boost::mutex> lock(scene_mutex_);
+
+        // Only top level objects are indexed, contents move with their container.
+        auto visibility_iter = visibility_.find(object->GetObjectId());
+        if (visibility_iter == visibility_.end())
+        {
+            return;
+        }
+
+        spatial_provider_->UpdateObject(object, old_position, new_position);
+
+        auto& linked = visibility_iter->second;
+
+        spatial_provider_->VisitObjectsInRange(new_position, enter_range_,
+            [this, &object, &linked] (const shared_ptr<Object>& other)
+        {
+            if (other != object && linked.find(other->GetObjectId()) == linked.end())
+            {
+                Link(object, other);
             }
         });
+
+        float exit_range_squared = exit_range_ * exit_range_;
+
+        stale_links_.clear();
+        for_each(begin(linked), end(linked), [this, &new_position, exit_range_squared] (uint64_t other_id)
+        {
+            glm::vec3 position = object_map_[other_id]->GetPosition();
+            float dx = position.x - new_position.x;
+            float dz = position.z - new_position.z;
+
+            if (dx * dx + dz * dz > exit_range_squared)
+            {
+                stale_links_.push_back(other_id);
+            }
+        });
+
+        for_each(begin(stale_links_), end(stale_links_), [this, &object] (uint64_t other_id)
+        {
+            Unlink(object, object_map_[other_id]);
+        });
+    }
+
+    void SetAwarenessRange(float enter_range, float exit_range)
+    {
+        boost::lock_guard<boost::mutex> lock(scene_mutex_);
+
+        enter_range_ = enter_range;
+        exit_range_ = max(enter_range, exit_range);
     }
 
 	void InsertObject(const shared_ptr<Object>& object)
@@ -114,17 +234,120 @@ private:
 
     typedef std::set<std::shared_ptr<Object>> ObjectSet;
 
+    /// The top level objects each top level object is currently aware of.
+    typedef std::unordered_map<
+        uint64_t,
+        std::unordered_set<uint64_t>
+    > VisibilityMap;
+
+    void InsertObjectTree(const shared_ptr<Object>& object)
+    {
+        InsertObject(object);
+
+        auto contained_objects = object->GetContainedObjects();
+        for_each(begin(contained_objects), end(contained_objects),
+            [this] (const Object::ObjectMap::value_type& object_entry)
+        {
+            InsertObjectTree(object_entry.second);
+        });
+    }
+
+    void EraseObjectTree(const shared_ptr<Object>& object)
+    {
+        EraseObject(object);
+        visibility_.erase(object->GetObjectId());
+
+        auto contained_objects = object->GetContainedObjects();
+        for_each(begin(contained_objects), end(contained_objects),
+            [this] (const Object::ObjectMap::value_type& object_entry)
+        {
+            EraseObjectTree(object_entry.second);
+        });
+    }
+
+    shared_ptr<Object> GetRoot(shared_ptr<Object> object)
+    {
+        for (auto container = object->GetContainer(); container; container = container->GetContainer())
+        {
+            object = container;
+        }
+
+        return object;
+    }
+
+    /// Makes observer aware of subject and everything subject contains.
+    void ShowTree(const shared_ptr<Object>& subject, const shared_ptr<Object>& observer)
+    {
+        subject->AddAwareObject(observer);
+
+        auto contained_objects = subject->GetContainedObjects();
+        for_each(begin(contained_objects), end(contained_objects),
+            [this, &observer] (const Object::ObjectMap::value_type& object_entry)
+        {
+            ShowTree(object_entry.second, observer);
+        });
+    }
+
+    /// Removes observer's awareness of subject and its contents, optionally telling its client.
+    void HideTree(const shared_ptr<Object>& subject, const shared_ptr<Object>& observer, bool send_destroy)
+    {
+        subject->RemoveAwareObject(observer);
+
+        auto contained_objects = subject->GetContainedObjects();
+        for_each(begin(contained_objects), end(contained_objects),
+            [this, &observer] (const Object::ObjectMap::value_type& object_entry)
+        {
+            HideTree(object_entry.second, observer, false);
+        });
+
+        if (send_destroy && observer->HasController())
+        {
+            SceneDestroyObject destroy_message;
+            destroy_message.object_id = subject->GetObjectId();
+
+            observer->GetController()->Notify(destroy_message);
+        }
+    }
+
+    void Link(const shared_ptr<Object>& object, const shared_ptr<Object>& other)
+    {
+        visibility_[object->GetObjectId()].insert(other->GetObjectId());
+        visibility_[other->GetObjectId()].insert(object->GetObjectId());
+
+        ShowTree(object, other);
+        ShowTree(other, object);
+    }
+
+    void Unlink(const shared_ptr<Object>& object, const shared_ptr<Object>& other)
+    {
+        visibility_[object->GetObjectId()].erase(other->GetObjectId());
+        visibility_[other->GetObjectId()].erase(object->GetObjectId());
+
+        HideTree(object, other, true);
+        HideTree(other, object, true);
+    }
+
     ObjectSet objects_;
     ObjectMap object_map_;
+    VisibilityMap visibility_;
+    std::vector<uint64_t> stale_links_;
 
     SceneDescription description_;
+    shared_ptr<SpatialProviderInterface> spatial_provider_;
+    float enter_range_;
+    float exit_range_;
+
+    boost::mutex scene_mutex_;
 };
 
-Scene::Scene(SceneDescription description)
-: impl_(new SceneImpl(move(description)))
+const float Scene::DEFAULT_AWARENESS_ENTER_RANGE = 128.0f;
+const float Scene::DEFAULT_AWARENESS_EXIT_RANGE = 160.0f;
+
+Scene::Scene(SceneDescription description, shared_ptr<SpatialProviderInterface> spatial_provider)
+: impl_(new SceneImpl(move(description), move(spatial_provider)))
 {}
 
-Scene::Scene(uint32_t scene_id, string name, string label, string description, string terrain) 
+Scene::Scene(uint32_t scene_id, string name, string label, string description, string terrain, shared_ptr<SpatialProviderInterface> spatial_provider) 
 {
     SceneDescription scene_description;
 
@@ -134,7 +357,7 @@ Scene::Scene(uint32_t scene_id, string name, string label, string description, s
     scene_description.description = move(description);
     scene_description.terrain = move(terrain);
 
-    impl_.reset(new SceneImpl(move(scene_description)));
+    impl_.reset(new SceneImpl(move(scene_description), move(spatial_provider)));
 }
 
 uint32_t Scene::GetSceneId() const
@@ -169,3 +392,13 @@ void Scene::RemoveObject(const std::shared_ptr<swganh::object::Object>& object)
 {
     impl_->RemoveObject(object);
 }
+
+void Scene::UpdateObject(const std::shared_ptr<swganh::object::Object>& object, const glm::vec3& old_position, const glm::vec3& new_position)
+{
+    impl_->UpdateObject(object, old_position, new_position);
+}
+
+void Scene::SetAwarenessRange(float enter_range, float exit_range)
+{
+    impl_->SetAwarenessRange(enter_range, exit_range);
+}
@@ -12,6 +12,8 @@
 
 #include <boost/noncopyable.hpp>
 
+#include <glm/glm.hpp>
+
 namespace swganh {
 namespace object {
     class Object;
@@ -20,6 +22,8 @@ namespace object {
 namespace swganh {
 namespace simulation {
 
+    class SpatialProviderInterface;
+
     struct SceneDescription
     {
         uint32_t id;
@@ -29,16 +33,34 @@ namespace simulation {
         std::string terrain;
     };
 
+    /**
+     * A zone of the galaxy and the objects in it.
+     *
+     * Awareness between objects in a scene is driven by their distance. Two top level
+     * objects become aware of each other, contents included, when they come within the
+     * enter range and stop being aware when they move beyond the larger exit range. The
+     * gap between the two keeps objects near the edge from flickering in and out.
+     */
     class Scene : boost::noncopyable
     {
     public:
-        explicit Scene(SceneDescription description);
+        /// Range at which objects become aware of each other.
+        static const float DEFAULT_AWARENESS_ENTER_RANGE;
+
+        /// Range at which objects that are aware of each other lose awareness.
+        static const float DEFAULT_AWARENESS_EXIT_RANGE;
+
+        /**
+         * @param spatial_provider Index of the objects in this scene, owned by the scene.
+         */
+        Scene(SceneDescription description, std::shared_ptr<SpatialProviderInterface> spatial_provider);
         Scene(
             uint32_t id,
             std::string name,
             std::string label,
             std::string description,
-            std::string terrain);
+            std::string terrain,
+            std::shared_ptr<SpatialProviderInterface> spatial_provider);
 
         uint32_t GetSceneId() const;
         const std::string& GetName() const;
@@ -50,6 +72,23 @@ namespace simulation {
 
         void RemoveObject(const std::shared_ptr<swganh::object::Object>& object);
 
+        /**
+         * Moves an object within the scene and updates what it is aware of.
+         *
+         * Must be called before the object's own position is updated.
+         */
+        void UpdateObject(
+            const std::shared_ptr<swganh::object::Object>& object,
+            const glm::vec3& old_position,
+            const glm::vec3& new_position);
+
+        /**
+         * Sets the ranges at which objects gain and lose awareness of each other.
+         *
+         * The exit range is raised to the enter range if it is smaller.
+         */
+        void SetAwarenessRange(float enter_range, float exit_range);
+
     private:
         Scene();
 
@@ -75,7 +75,7 @@ std::shared_ptr<Scene> SceneManager::GetScene(uint32_t scene_id) const
 	return find_iter->second;
 }
 
-void SceneManager::StartScene(const std::string& scene_label)
+void SceneManager::StartScene(const std::string& scene_label, std::shared_ptr<SpatialProviderInterface> spatial_provider)
 {
 	auto description_iter = scene_descriptions_.find(scene_label);
 
@@ -93,7 +93,7 @@ void SceneManager::StartScene(const std::string& scene_label)
 
     LOG(info) << "Starting scene: " << scene_label;
 
-    auto scene = make_shared<Scene>(description_iter->second);
+    auto scene = make_shared<Scene>(description_iter->second, move(spatial_provider));
 
     scenes_.insert(make_pair(scene_label, scene));
 }
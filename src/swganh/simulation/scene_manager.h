@@ -17,6 +17,8 @@ namespace sql {
 
 namespace swganh {
 namespace simulation {
+
+    class SpatialProviderInterface;
     
     class SceneManager
     {
@@ -27,7 +29,10 @@ namespace simulation {
         std::shared_ptr<Scene> GetScene(const std::string& scene_label) const;
 		std::shared_ptr<Scene> GetScene(uint32_t scene_id) const;
 
-        void StartScene(const std::string& scene_label);
+        /**
+         * Starts a scene, objects added to it are indexed by the given spatial provider.
+         */
+        void StartScene(const std::string& scene_label, std::shared_ptr<SpatialProviderInterface> spatial_provider);
         void StopScene(const std::string& scene_label);
 
     private:
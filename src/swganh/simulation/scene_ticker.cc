@@ -0,0 +1,228 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include "swganh/simulation/scene_ticker.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "anh/logger.h"
+
+using namespace std;
+using namespace swganh::simulation;
+
+using boost::posix_time::microsec_clock;
+using boost::posix_time::milliseconds;
+
+namespace {
+    void PinThreadToCore(boost::thread& thread, int core)
+    {
+#ifdef __linux__
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(core % max(1u, boost::thread::hardware_concurrency()), &cpu_set);
+
+        pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set), &cpu_set);
+#endif
+    }
+}
+
+SceneTicker::SceneTicker(string label, uint32_t interval_ms)
+    : label_(move(label))
+    , interval_ms_(max(1u, interval_ms))
+    , timer_(io_service_)
+    , ticks_(0)
+    , overruns_(0)
+    , skipped_ticks_(0)
+    , last_tick_us_(0)
+    , max_tick_us_(0)
+    , total_tick_us_(0)
+{
+    for (auto& handlers : handlers_)
+    {
+        handlers = make_shared<const HandlerList>();
+    }
+}
+
+SceneTicker::~SceneTicker()
+{
+    Stop();
+}
+
+void SceneTicker::AddPhaseHandler(TickPhase phase, TickHandler handler)
+{
+    boost::lock_guard<boost::mutex> lock(handlers_mutex_);
+
+    // Replaced rather than modified, a running tick keeps the list it started with.
+    auto handlers = make_shared<HandlerList>(*handlers_[phase]);
+    handlers->push_back(move(handler));
+
+    handlers_[phase] = move(handlers);
+}
+
+void SceneTicker::Post(function<void ()> work)
+{
+    boost::lock_guard<boost::mutex> lock(input_mutex_);
+    input_.push_back(move(work));
+}
+
+void SceneTicker::Start(int core)
+{
+    if (thread_.joinable())
+    {
+        return;
+    }
+
+    LOG(info) << "Ticking scene " << label_ << " every " << interval_ms_ << "ms";
+
+    io_service_.reset();
+
+    next_tick_ = microsec_clock::universal_time() + milliseconds(interval_ms_);
+    ScheduleTick_();
+
+    thread_ = boost::thread([this] { io_service_.run(); });
+
+    if (core >= 0)
+    {
+        PinThreadToCore(thread_, core);
+    }
+}
+
+void SceneTicker::Stop()
+{
+    if (!thread_.joinable())
+    {
+        return;
+    }
+
+    io_service_.stop();
+    thread_.join();
+
+    // Work posted since the last tick, such as removing the objects of players
+    // that just logged out, still runs now that this is the only thread.
+    RunInput_();
+
+    TickMetrics metrics = GetMetrics();
+
+    LOG(info) << "Stopped ticking scene " << label_ << " after " << metrics.ticks << " ticks, "
+        << metrics.overruns << " overruns, " << metrics.skipped_ticks << " skipped, "
+        << metrics.max_tick_us << "us longest";
+}
+
+const string& SceneTicker::GetLabel() const
+{
+    return label_;
+}
+
+uint32_t SceneTicker::GetInterval() const
+{
+    return interval_ms_;
+}
+
+TickMetrics SceneTicker::GetMetrics() const
+{
+    TickMetrics metrics;
+    metrics.ticks = ticks_;
+    metrics.overruns = overruns_;
+    metrics.skipped_ticks = skipped_ticks_;
+    metrics.last_tick_us = last_tick_us_;
+    metrics.max_tick_us = max_tick_us_;
+    metrics.total_tick_us = total_tick_us_;
+
+    return metrics;
+}
+
+void SceneTicker::ScheduleTick_()
+{
+    timer_.expires_at(next_tick_);
+    timer_.async_wait([this] (const boost::system::error_code& error)
+    {
+        if (error)
+        {
+            return;
+        }
+
+        Tick_();
+        ScheduleTick_();
+    });
+}
+
+void SceneTicker::Tick_()
+{
+    uint64_t tick = ++ticks_;
+    auto start = chrono::steady_clock::now();
+
+    for (int phase = INPUT; phase < PHASE_COUNT; ++phase)
+    {
+        RunPhase_(static_cast<TickPhase>(phase), tick);
+    }
+
+    uint32_t tick_us = static_cast<uint32_t>(
+        chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count());
+
+    // Only this thread writes the timings, readers just need a whole value.
+    last_tick_us_ = tick_us;
+    total_tick_us_ += tick_us;
+    if (tick_us > max_tick_us_)
+    {
+        max_tick_us_ = tick_us;
+    }
+
+    next_tick_ += milliseconds(interval_ms_);
+
+    auto now = microsec_clock::universal_time();
+    if (next_tick_ < now)
+    {
+        // Run the late tick straight away but drop any that were missed entirely.
+        uint64_t missed = (now - next_tick_).total_milliseconds() / interval_ms_;
+
+        ++overruns_;
+        skipped_ticks_ += missed;
+        next_tick_ += milliseconds(missed * interval_ms_);
+    }
+}
+
+void SceneTicker::RunPhase_(TickPhase phase, uint64_t tick)
+{
+    if (phase == INPUT)
+    {
+        RunInput_();
+    }
+
+    shared_ptr<const HandlerList> handlers;
+
+    {
+        boost::lock_guard<boost::mutex> lock(handlers_mutex_);
+        handlers = handlers_[phase];
+    }
+
+    for (const auto& handler : *handlers)
+    {
+        // A failing handler must not end the scene's thread, the rest still run.
+        try {
+            handler(tick);
+        } catch(const std::exception& e) {
+            LOG(warning) << "Error in phase " << phase << " of scene " << label_
+                << " at tick " << tick << ": " << e.what();
+        }
+    }
+}
+
+void SceneTicker::RunInput_()
+{
+    vector<function<void ()>> input;
+
+    {
+        boost::lock_guard<boost::mutex> lock(input_mutex_);
+        input.swap(input_);
+    }
+
+    for (auto& work : input)
+    {
+        try {
+            work();
+        } catch(const std::exception& e) {
+            LOG(warning) << "Error in work posted to scene " << label_ << ": " << e.what();
+        }
+    }
+}
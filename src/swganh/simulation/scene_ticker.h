@@ -0,0 +1,142 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#ifndef SWGANH_SIMULATION_SCENE_TICKER_H_
+#define SWGANH_SIMULATION_SCENE_TICKER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+namespace swganh {
+namespace simulation {
+
+    /**
+     * Tick timings of a SceneTicker, durations are in microseconds.
+     */
+    struct TickMetrics
+    {
+        uint64_t ticks;
+
+        /// Ticks that ran past the start of the next one.
+        uint64_t overruns;
+
+        /// Ticks dropped to catch up after an overrun.
+        uint64_t skipped_ticks;
+
+        uint32_t last_tick_us;
+        uint32_t max_tick_us;
+        uint64_t total_tick_us;
+    };
+
+    /**
+     * Runs a scene's simulation loop at a fixed rate on a worker thread of its own.
+     *
+     * Every tick runs its phases in order: the input phase first runs the work
+     * posted since the last tick, then the handlers of each phase are invoked.
+     * Ticks are scheduled against a fixed timeline rather than relative to the
+     * end of the last one, so the rate does not drift. A tick that runs past the
+     * start of the next is counted as an overrun and the ticks it missed are
+     * skipped instead of run back to back.
+     *
+     * Each scene owning its thread keeps its state on a single core and lets
+     * scenes tick in parallel with each other and with the network io threads.
+     */
+    class SceneTicker : boost::noncopyable
+    {
+    public:
+        enum TickPhase
+        {
+            INPUT = 0,
+            SIMULATION,
+            REPLICATION,
+            PHASE_COUNT
+        };
+
+        /**
+         * @param tick The number of the running tick, starting at 1.
+         */
+        typedef std::function<void (uint64_t tick)> TickHandler;
+
+        /**
+         * @param label Label of the ticked scene, used to name it in the log.
+         * @param interval_ms Length of a tick.
+         */
+        SceneTicker(std::string label, uint32_t interval_ms);
+        ~SceneTicker();
+
+        /**
+         * Adds a handler invoked every tick during the given phase, in the order added.
+         */
+        void AddPhaseHandler(TickPhase phase, TickHandler handler);
+
+        /**
+         * Queues work to run on the scene's thread during the next input phase.
+         *
+         * An exception thrown by the work, or by a phase handler, is logged and
+         * the tick carries on.
+         */
+        void Post(std::function<void ()> work);
+
+        /**
+         * Starts ticking on a new thread.
+         *
+         * @param core The core to pin the thread to, or -1 to leave it to the scheduler.
+         */
+        void Start(int core = -1);
+
+        /**
+         * Finishes the running tick, if any, joins the thread and then runs the
+         * work still queued for the next input phase.
+         */
+        void Stop();
+
+        const std::string& GetLabel() const;
+        uint32_t GetInterval() const;
+
+        TickMetrics GetMetrics() const;
+
+    private:
+        typedef std::vector<TickHandler> HandlerList;
+
+        void ScheduleTick_();
+        void Tick_();
+        void RunPhase_(TickPhase phase, uint64_t tick);
+
+        /// Runs the work posted since it last ran, errors are logged and don't stop the rest.
+        void RunInput_();
+
+        std::string label_;
+        uint32_t interval_ms_;
+
+        boost::asio::io_service io_service_;
+        boost::asio::deadline_timer timer_;
+        boost::posix_time::ptime next_tick_;
+        boost::thread thread_;
+
+        boost::mutex handlers_mutex_;
+        std::shared_ptr<const HandlerList> handlers_[PHASE_COUNT];
+
+        boost::mutex input_mutex_;
+        std::vector<std::function<void ()>> input_;
+
+        std::atomic<uint64_t> ticks_;
+        std::atomic<uint64_t> overruns_;
+        std::atomic<uint64_t> skipped_ticks_;
+        std::atomic<uint32_t> last_tick_us_;
+        std::atomic<uint32_t> max_tick_us_;
+        std::atomic<uint64_t> total_tick_us_;
+    };
+
+}}  // namespace swganh::simulation
+
+#endif  // SWGANH_SIMULATION_SCENE_TICKER_H_
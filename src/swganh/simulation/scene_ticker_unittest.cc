@@ -0,0 +1,215 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/thread/thread.hpp>
+
+#include "swganh/simulation/scene_ticker.h"
+
+using namespace std;
+using swganh::simulation::SceneTicker;
+using swganh::simulation::TickMetrics;
+
+namespace {
+
+/// Waits up to a second for the ticker to have run the given number of ticks.
+bool WaitForTicks(const SceneTicker& ticker, uint64_t ticks)
+{
+    for (int i = 0; i < 1000 && ticker.GetMetrics().ticks < ticks; ++i)
+    {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+    }
+
+    return ticker.GetMetrics().ticks >= ticks;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(SceneTickerTests)
+
+///
+BOOST_AUTO_TEST_CASE(RunsPostedWorkThenPhasesInOrder)
+{
+    SceneTicker ticker("test", 1);
+
+    boost::mutex mutex;
+    vector<string> calls;
+
+    auto record = [&mutex, &calls] (string call) {
+        boost::lock_guard<boost::mutex> lock(mutex);
+        calls.push_back(move(call));
+    };
+
+    // Added out of order, run by phase.
+    ticker.AddPhaseHandler(SceneTicker::REPLICATION, [&] (uint64_t) { record("replication"); });
+    ticker.AddPhaseHandler(SceneTicker::SIMULATION, [&] (uint64_t) { record("simulation"); });
+    ticker.AddPhaseHandler(SceneTicker::INPUT, [&] (uint64_t) { record("input"); });
+
+    ticker.Post([&] { record("posted"); });
+
+    ticker.Start();
+    BOOST_REQUIRE(WaitForTicks(ticker, 1));
+    ticker.Stop();
+
+    BOOST_REQUIRE(calls.size() >= 4);
+    BOOST_CHECK_EQUAL("posted", calls[0]);
+    BOOST_CHECK_EQUAL("input", calls[1]);
+    BOOST_CHECK_EQUAL("simulation", calls[2]);
+    BOOST_CHECK_EQUAL("replication", calls[3]);
+
+    // Posted work only runs once.
+    BOOST_CHECK_EQUAL(1, count(calls.begin(), calls.end(), string("posted")));
+}
+
+///
+BOOST_AUTO_TEST_CASE(CountsOverrunsAndSkipsMissedTicks)
+{
+    SceneTicker ticker("test", 2);
+
+    ticker.AddPhaseHandler(SceneTicker::SIMULATION, [] (uint64_t tick) {
+        if (tick == 1)
+        {
+            boost::this_thread::sleep(boost::posix_time::milliseconds(20));
+        }
+    });
+
+    ticker.Start();
+    BOOST_REQUIRE(WaitForTicks(ticker, 2));
+    ticker.Stop();
+
+    TickMetrics metrics = ticker.GetMetrics();
+    BOOST_CHECK(metrics.overruns >= 1);
+    BOOST_CHECK(metrics.skipped_ticks >= 5);
+    BOOST_CHECK(metrics.max_tick_us >= 20000);
+}
+
+///
+BOOST_AUTO_TEST_CASE(ScenesTickOnSeparateThreads)
+{
+    SceneTicker first("first", 1);
+    SceneTicker second("second", 1);
+
+    boost::thread::id first_thread, second_thread;
+    first.AddPhaseHandler(SceneTicker::SIMULATION, [&first_thread] (uint64_t) {
+        first_thread = boost::this_thread::get_id();
+    });
+    second.AddPhaseHandler(SceneTicker::SIMULATION, [&second_thread] (uint64_t) {
+        second_thread = boost::this_thread::get_id();
+    });
+
+    first.Start();
+    second.Start();
+    BOOST_REQUIRE(WaitForTicks(first, 1));
+    BOOST_REQUIRE(WaitForTicks(second, 1));
+    first.Stop();
+    second.Stop();
+
+    BOOST_CHECK(first_thread != boost::this_thread::get_id());
+    BOOST_CHECK(first_thread != second_thread);
+}
+
+///
+BOOST_AUTO_TEST_CASE(WorkPostedFromAnotherThreadRunsOnTheSceneThreadBeforeItsPhases)
+{
+    SceneTicker ticker("test", 1);
+
+    boost::mutex mutex;
+    vector<pair<string, boost::thread::id>> calls;
+
+    auto record = [&mutex, &calls] (string call) {
+        boost::lock_guard<boost::mutex> lock(mutex);
+        calls.push_back(make_pair(move(call), boost::this_thread::get_id()));
+    };
+
+    ticker.AddPhaseHandler(SceneTicker::SIMULATION, [&] (uint64_t) { record("simulation"); });
+    ticker.AddPhaseHandler(SceneTicker::REPLICATION, [&] (uint64_t) { record("replication"); });
+
+    ticker.Start();
+    BOOST_REQUIRE(WaitForTicks(ticker, 1));
+
+    // Posted the way a network thread hands a scene a controller message.
+    boost::thread::id posting_thread;
+    boost::thread poster([&] {
+        posting_thread = boost::this_thread::get_id();
+        ticker.Post([&] { record("posted"); });
+    });
+    poster.join();
+
+    uint64_t posted_tick = ticker.GetMetrics().ticks;
+    BOOST_REQUIRE(WaitForTicks(ticker, posted_tick + 2));
+    ticker.Stop();
+
+    auto posted = find_if(calls.begin(), calls.end(), [] (const pair<string, boost::thread::id>& call) {
+        return call.first == "posted";
+    });
+
+    BOOST_REQUIRE(posted != calls.end());
+    BOOST_REQUIRE(calls.end() - posted >= 3);
+
+    BOOST_CHECK(posted->second != posting_thread);
+    BOOST_CHECK(posted->second != boost::this_thread::get_id());
+
+    // The rest of the posted work's tick runs in phase order on the same thread.
+    BOOST_CHECK_EQUAL("simulation", (posted + 1)->first);
+    BOOST_CHECK_EQUAL("replication", (posted + 2)->first);
+    BOOST_CHECK((posted + 1)->second == posted->second);
+    BOOST_CHECK((posted + 2)->second == posted->second);
+}
+
+///
+BOOST_AUTO_TEST_CASE(ThrowingWorkIsLoggedAndTheSceneKeepsTicking)
+{
+    SceneTicker ticker("test", 1);
+
+    boost::mutex mutex;
+    vector<string> calls;
+
+    auto record = [&mutex, &calls] (string call) {
+        boost::lock_guard<boost::mutex> lock(mutex);
+        calls.push_back(move(call));
+    };
+
+    ticker.AddPhaseHandler(SceneTicker::SIMULATION, [] (uint64_t tick) {
+        if (tick == 1)
+        {
+            throw runtime_error("handler failed");
+        }
+    });
+    ticker.AddPhaseHandler(SceneTicker::SIMULATION, [&] (uint64_t) { record("simulation"); });
+
+    // e.g. a controller handler rejecting a malformed message
+    ticker.Post([] { throw runtime_error("Cell movement currently disabled"); });
+    ticker.Post([&] { record("posted"); });
+
+    ticker.Start();
+    BOOST_REQUIRE(WaitForTicks(ticker, 3));
+    ticker.Stop();
+
+    BOOST_REQUIRE(calls.size() >= 3);
+    BOOST_CHECK_EQUAL("posted", calls[0]);
+    BOOST_CHECK_EQUAL("simulation", calls[1]);
+    BOOST_CHECK_EQUAL("simulation", calls[2]);
+}
+
+///
+BOOST_AUTO_TEST_CASE(StopRunsWorkStillQueued)
+{
+    SceneTicker ticker("test", 1000);
+    ticker.Start();
+
+    bool ran = false;
+    ticker.Post([&ran] { ran = true; });
+
+    // Stopped long before the first tick would have run the work.
+    ticker.Stop();
+
+    BOOST_CHECK(ran);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,209 @@
+// This file is part of SWGANH which is released under the MIT license.
+// See file LICENSE or go to http://swganh.com/LICENSE
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "swganh/object/object.h"
+#include "swganh/simulation/scene.h"
+#include "swganh/simulation/spatial_provider_interface.h"
+
+using namespace std;
+using swganh::object::Object;
+using swganh::simulation::ObjectVisitor;
+using swganh::simulation::Scene;
+using swganh::simulation::SceneDescription;
+using swganh::simulation::SpatialProviderInterface;
+
+namespace {
+
+/// Keeps the indexed objects in a list and answers range queries by scanning it.
+class StubSpatialProvider : public SpatialProviderInterface
+{
+public:
+    StubSpatialProvider()
+        : SpatialProviderInterface(nullptr)
+    {}
+
+    void AddObject(shared_ptr<Object> obj)
+    {
+        objects.push_back(obj);
+    }
+
+    void RemoveObject(shared_ptr<Object> obj)
+    {
+        objects.erase(remove(objects.begin(), objects.end(), obj), objects.end());
+    }
+
+    void UpdateObject(shared_ptr<Object> obj, glm::vec3 old_position, glm::vec3 new_position)
+    {}
+
+    vector<shared_ptr<Object>> GetObjectsInRange(glm::vec3 point, float range)
+    {
+        vector<shared_ptr<Object>> in_range;
+        VisitObjectsInRange(point, range, [&in_range] (const shared_ptr<Object>& object)
+        {
+            in_range.push_back(object);
+        });
+
+        return in_range;
+    }
+
+    vector<shared_ptr<Object>> GetObjectsInBox(glm::vec3 min, glm::vec3 max)
+    {
+        return vector<shared_ptr<Object>>();
+    }
+
+    void VisitObjectsInRange(glm::vec3 point, float range, const ObjectVisitor& visitor)
+    {
+        for (auto& object : objects)
+        {
+            glm::vec3 position = object->GetPosition();
+            float dx = position.x - point.x;
+            float dz = position.z - point.z;
+
+            if (dx * dx + dz * dz <= range * range)
+            {
+                visitor(object);
+            }
+        }
+    }
+
+    void VisitObjectsInBox(glm::vec3 min, glm::vec3 max, const ObjectVisitor& visitor)
+    {}
+
+    vector<shared_ptr<Object>> objects;
+};
+
+shared_ptr<Object> CreateObject(uint64_t object_id, float x)
+{
+    auto object = make_shared<Object>();
+    object->SetObjectId(object_id);
+    object->SetPosition(glm::vec3(x, 0.0f, 0.0f));
+
+    return object;
+}
+
+/// Moves an object the way the movement handlers do.
+void MoveObject(Scene& scene, const shared_ptr<Object>& object, float x)
+{
+    glm::vec3 new_position(x, 0.0f, 0.0f);
+
+    scene.UpdateObject(object, object->GetPosition(), new_position);
+    object->SetPosition(new_position);
+}
+
+class SceneTests
+{
+public:
+    SceneTests()
+        : spatial_provider(make_shared<StubSpatialProvider>())
+        , scene(CreateDescription(), spatial_provider)
+    {}
+
+    static SceneDescription CreateDescription()
+    {
+        SceneDescription description;
+        description.id = 1;
+        description.name = "corellia";
+
+        return description;
+    }
+
+    shared_ptr<StubSpatialProvider> spatial_provider;
+    Scene scene;
+};
+
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(SceneTest, SceneTests)
+
+/// Objects added within the enter range become aware of each other, those
+/// beyond it don't.
+BOOST_AUTO_TEST_CASE(ObjectsWithinEnterRangeBecomeAware)
+{
+    auto object = CreateObject(1, 0.0f);
+    auto near_object = CreateObject(2, 100.0f);
+    auto far_object = CreateObject(3, 150.0f);
+
+    scene.AddObject(object);
+    scene.AddObject(near_object);
+    scene.AddObject(far_object);
+
+    BOOST_CHECK(object->IsAwareOfObject(near_object));
+    BOOST_CHECK(near_object->IsAwareOfObject(object));
+
+    BOOST_CHECK(!object->IsAwareOfObject(far_object));
+    BOOST_CHECK(!far_object->IsAwareOfObject(object));
+}
+
+/// Awareness starts at the enter range of 128 and only ends past the exit
+/// range of 160.
+BOOST_AUTO_TEST_CASE(AwarenessEndsOnlyBeyondTheExitRange)
+{
+    auto object = CreateObject(1, 0.0f);
+    auto other = CreateObject(2, 200.0f);
+
+    scene.AddObject(object);
+    scene.AddObject(other);
+
+    MoveObject(scene, other, 130.0f);
+    BOOST_CHECK(!object->IsAwareOfObject(other));
+
+    MoveObject(scene, other, 120.0f);
+    BOOST_CHECK(object->IsAwareOfObject(other));
+
+    MoveObject(scene, other, 150.0f);
+    BOOST_CHECK(object->IsAwareOfObject(other));
+    BOOST_CHECK(other->IsAwareOfObject(object));
+
+    MoveObject(scene, other, 170.0f);
+    BOOST_CHECK(!object->IsAwareOfObject(other));
+    BOOST_CHECK(!other->IsAwareOfObject(object));
+}
+
+/// Contents are seen by whoever sees their container.
+BOOST_AUTO_TEST_CASE(ContainedObjectsFollowTheirContainersAwareness)
+{
+    auto container = CreateObject(1, 0.0f);
+    auto contained = CreateObject(2, 0.0f);
+    container->AddContainedObject(contained, Object::LINK);
+
+    auto other = CreateObject(3, 200.0f);
+
+    scene.AddObject(container);
+    scene.AddObject(other);
+
+    BOOST_CHECK(!contained->IsAwareOfObject(other));
+
+    MoveObject(scene, other, 100.0f);
+    BOOST_CHECK(contained->IsAwareOfObject(other));
+
+    MoveObject(scene, other, 200.0f);
+    BOOST_CHECK(!contained->IsAwareOfObject(other));
+}
+
+/// Removing a container takes its contents out of the scene with it, so they
+/// can be added again later on their own.
+BOOST_AUTO_TEST_CASE(RemovingAContainerRemovesItsContents)
+{
+    auto container = CreateObject(1, 0.0f);
+    auto contained = CreateObject(2, 0.0f);
+    container->AddContainedObject(contained, Object::LINK);
+
+    scene.AddObject(container);
+    scene.RemoveObject(container);
+
+    BOOST_CHECK(spatial_provider->objects.empty());
+
+    container->RemoveContainedObject(contained);
+    scene.AddObject(contained);
+
+    BOOST_REQUIRE_EQUAL(1u, spatial_provider->objects.size());
+    BOOST_CHECK(spatial_provider->objects.front() == contained);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
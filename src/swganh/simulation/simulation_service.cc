@@ -3,6 +3,8 @@
 
 #include "swganh/simulation/simulation_service.h"
 
+#include <chrono>
+
 #include <boost/algorithm/string.hpp>
 
 #include "anh/byte_buffer.h"
@@ -19,9 +21,11 @@
 
 #include "swganh/messages/select_character.h"
 
+#include "swganh/object/bulk_object_loader.h"
 #include "swganh/object/object.h"
 #include "swganh/object/object_controller.h"
 #include "swganh/object/object_manager.h"
+#include "swganh/object/persistence_queue.h"
 
 // factories
 #include "swganh/object/creature/creature_factory.h"
@@ -46,6 +50,9 @@
 #include "swganh/messages/update_containment_message.h"
 
 #include "swganh/simulation/movement_manager.h"
+#include "swganh/simulation/object_registry.h"
+#include "swganh/simulation/replication_manager.h"
+#include "swganh/simulation/scene_ticker.h"
 
 using namespace anh;
 using namespace std;
@@ -68,7 +75,6 @@ public:
     SimulationServiceImpl(SwganhKernel* kernel)
         : kernel_(kernel)
     {
-		spatial_provider_ = kernel->GetPluginManager()->CreateObject<SpatialProviderInterface>("SimulationService::SpatialProvider");
     }
 
     const shared_ptr<ObjectManager>& GetObjectManager()
@@ -95,29 +101,155 @@ public:
     {
         if (!movement_manager_)
         {
-			movement_manager_ = make_shared<MovementManager>(kernel_->GetEventDispatcher(), spatial_provider_);
+			movement_manager_ = make_shared<MovementManager>(kernel_->GetEventDispatcher(), GetSceneManager());
         }
 
         return movement_manager_.get();
     }
 
+    const shared_ptr<ReplicationManager>& GetReplicationManager()
+    {
+        if (!replication_manager_)
+        {
+            replication_manager_ = make_shared<ReplicationManager>(
+                kernel_->GetEventDispatcher(),
+                kernel_->GetIoService(),
+                kernel_->GetAppConfig().simulation_config.replication_interval_ms);
+        }
+
+        return replication_manager_;
+    }
+
+    PersistenceQueue* GetPersistenceQueue()
+    {
+        if (!persistence_queue_)
+        {
+            const auto& simulation_config = kernel_->GetAppConfig().simulation_config;
+            auto object_manager = GetObjectManager();
+            auto db_manager = kernel_->GetDatabaseManager();
+
+            persistence_queue_.reset(new PersistenceQueue(
+                [db_manager] { return db_manager->getConnection("galaxy"); },
+                [object_manager] (const shared_ptr<Object>& object, const shared_ptr<sql::Connection>& connection)
+                {
+                    object_manager->PersistObject(object, connection);
+                },
+                simulation_config.persistence_threads,
+                simulation_config.persistence_batch_size,
+                simulation_config.persistence_max_pending));
+        }
+
+        return persistence_queue_.get();
+    }
+
+    void StartSceneTicker(const shared_ptr<Scene>& scene)
+    {
+        const auto& simulation_config = kernel_->GetAppConfig().simulation_config;
+
+        if (simulation_config.tick_interval_ms == 0)
+        {
+            return;
+        }
+
+        auto ticker = make_shared<SceneTicker>(scene->GetLabel(), simulation_config.tick_interval_ms);
+
+        // The scene's deltas go out at the end of each of its ticks instead of on the replication timer.
+        uint32_t scene_id = scene->GetSceneId();
+        auto replication_manager = GetReplicationManager();
+
+        ticker->AddPhaseHandler(SceneTicker::REPLICATION, [replication_manager, scene_id] (uint64_t) {
+            replication_manager->FlushScene(scene_id);
+        });
+        replication_manager->AddTickedScene(scene_id);
+
+        boost::lock_guard<boost::mutex> lock(scene_tickers_mutex_);
+
+        // Spread the scenes over the cores, core 0 is left to the io threads.
+        int core = simulation_config.pin_scene_threads ? static_cast<int>(scene_tickers_.size()) + 1 : -1;
+        ticker->Start(core);
+
+        scene_tickers_.insert(make_pair(scene->GetSceneId(), ticker));
+    }
+
+    void StopSceneTicker(const shared_ptr<Scene>& scene)
+    {
+        shared_ptr<SceneTicker> ticker;
+
+        {
+            boost::lock_guard<boost::mutex> lock(scene_tickers_mutex_);
+
+            auto find_iter = scene_tickers_.find(scene->GetSceneId());
+            if (find_iter == scene_tickers_.end())
+            {
+                return;
+            }
+
+            ticker = move(find_iter->second);
+            scene_tickers_.erase(find_iter);
+        }
+
+        ticker->Stop();
+        GetReplicationManager()->RemoveTickedScene(scene->GetSceneId());
+    }
+
+    void StopSceneTickers()
+    {
+        map<uint32_t, shared_ptr<SceneTicker>> scene_tickers;
+
+        {
+            boost::lock_guard<boost::mutex> lock(scene_tickers_mutex_);
+            scene_tickers.swap(scene_tickers_);
+        }
+
+        for (auto& entry : scene_tickers)
+        {
+            entry.second->Stop();
+            GetReplicationManager()->RemoveTickedScene(entry.first);
+        }
+    }
+
+    shared_ptr<SceneTicker> GetSceneTicker(uint32_t scene_id)
+    {
+        boost::lock_guard<boost::mutex> lock(scene_tickers_mutex_);
+
+        auto find_iter = scene_tickers_.find(scene_id);
+        if (find_iter == scene_tickers_.end())
+        {
+            return nullptr;
+        }
+
+        return find_iter->second;
+    }
+
+    void PostToScene(uint32_t scene_id, function<void ()> work)
+    {
+        auto ticker = GetSceneTicker(scene_id);
+        if (!ticker)
+        {
+            work();
+            return;
+        }
+
+        ticker->Post(move(work));
+    }
+
     void PersistObject(uint64_t object_id)
     {
-        auto find_iter = loaded_objects_.find(object_id);
+        auto object = loaded_objects_.Find(object_id);
 
-        if (find_iter == loaded_objects_.end())
+        if (!object)
         {
             LOG(warning) << "Nothing to persist, no object saved";
             return;
             //throw swganh::object::InvalidObject("Requested object already loaded");
         }
-        object_manager_->PersistObject(find_iter->second);
+        GetPersistenceQueue()->Enqueue(object);
     }
 	void PersistRelatedObjects(uint64_t parent_object_id)
 	{
-		auto find_iter = loaded_objects_.find(parent_object_id);
+		auto parent_object = loaded_objects_.Find(parent_object_id);
 
-        if (find_iter == loaded_objects_.end())
+        if (!parent_object)
         {
             LOG(warning) << "Nothing to persist, no object saved";
             return;
@@ -126,7 +258,7 @@ public:
 		// first persist the parent object
 		PersistObject(parent_object_id);
 		// get all the contained objects
-		auto contained_objects = find_iter->second->GetContainedObjects();
+		auto contained_objects = parent_object->GetContainedObjects();
 		for_each(begin(contained_objects), end(contained_objects), [=](pair<uint64_t, shared_ptr<Object>> pair){
 			// if there's objects contained within this object do a recursion call
 			auto inner_contained = pair.second->GetContainedObjects();
@@ -144,59 +276,87 @@ public:
 	}
     shared_ptr<Object> LoadObjectById(uint64_t object_id)
     {
-        auto find_iter = loaded_objects_.find(object_id);
+        auto object = loaded_objects_.Find(object_id);
 
-        if (find_iter != loaded_objects_.end())
+        if (object)
         {
-            return find_iter->second;
+            return object;
             LOG(warning) << "Requested object already loaded";
         }
 
-        auto object = object_manager_->CreateObjectFromStorage(object_id);
+        object = object_manager_->CreateObjectFromStorage(object_id);
 
-        loaded_objects_.insert(make_pair(object_id, object));
-		spatial_provider_->AddObject(object); // Add object to spatial indexing.
+        loaded_objects_.Insert(object);
         return object;
     }
     shared_ptr<Object> LoadObjectById(uint64_t object_id, uint32_t type)
     {
-        auto find_iter = loaded_objects_.find(object_id);
+        auto object = loaded_objects_.Find(object_id);
 
-        if (find_iter != loaded_objects_.end())
+        if (object)
         {
-            return find_iter->second;
+            return object;
             LOG(warning) << "Requested object already loaded";
         }
 
-        auto object = object_manager_->CreateObjectFromStorage(object_id, type);
+        object = object_manager_->CreateObjectFromStorage(object_id, type);
 
-        loaded_objects_.insert(make_pair(object_id, object));
-		spatial_provider_->AddObject(object); // Add object to spatial indexing.
+        loaded_objects_.Insert(object);
         return object;
     }
 
-    shared_ptr<Object> GetObjectById(uint64_t object_id)
+    shared_ptr<Object> LoadObjectTreeById(uint64_t object_id, uint32_t type)
     {
-        auto find_iter = loaded_objects_.find(object_id);
+        auto object = loaded_objects_.Find(object_id);
 
-        if (find_iter == loaded_objects_.end())
+        if (object)
         {
-            return nullptr;
+            return object;
         }
 
-        return find_iter->second;
+        auto start = chrono::steady_clock::now();
+
+        BulkObjectLoader loader(kernel_->GetDatabaseManager(), kernel_->GetEventDispatcher(), GetObjectManager().get());
+        auto objects = loader.LoadObjectTree(object_id);
+
+        if (objects.empty())
+        {
+            LOG(warning) << "Bulk loading object " << object_id << " failed, loading it alone";
+            return LoadObjectById(object_id, type);
+        }
+
+        for (const auto& loaded_object : objects)
+        {
+            loaded_objects_.Insert(loaded_object);
+        }
+
+        LOG(info) << "Loaded object " << object_id << " with " << objects.size() - 1 << " contained objects in "
+            << chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count() << "ms";
+
+        return objects.front();
+    }
+
+    shared_ptr<Object> GetObjectById(uint64_t object_id)
+    {
+        return loaded_objects_.Find(object_id);
     }
 
     void RemoveObjectById(uint64_t object_id)
     {
-        auto find_iter = loaded_objects_.find(object_id);
+        auto object = loaded_objects_.Find(object_id);
 
-        if (find_iter == loaded_objects_.end())
+        if (!object)
         {
             LOG(warning) << "Requested an invalid object";
+            return;
         }
 
-        RemoveObject(find_iter->second);
+        RemoveObject(object);
+    }
+
+    void VisitObjectsOfType(uint32_t type, const ObjectVisitor& visitor)
+    {
+        loaded_objects_.ForEachOfType(type, visitor);
     }
 
     void RemoveObject(const shared_ptr<Object>& object)
@@ -204,14 +364,12 @@ public:
         auto scene = scene_manager_->GetScene(object->GetSceneId());
         if (scene)
         {
-            scene->RemoveObject(object);
+            PostToScene(scene->GetSceneId(), [scene, object] { scene->RemoveObject(object); });
         }
 
-		spatial_provider_->RemoveObject(object); // Remove the object from spatial indexing.
-
         StopControllingObject(object);
 
-        loaded_objects_.unsafe_erase(loaded_objects_.find(object->GetObjectId()));
+        loaded_objects_.Remove(object->GetObjectId());
 
         auto contained_objects = object->GetContainedObjects();
         for_each(
@@ -228,10 +386,9 @@ public:
         shared_ptr<ObjectController> controller = nullptr;
 
         // If a controller already exists update it, otherwise create a new controller record.
-        auto find_iter = controlled_objects_.find(object->GetObjectId());
-        if (find_iter != controlled_objects_.end())
+        if (controlled_objects_.Find(object->GetObjectId()) && object->HasController())
         {
-            controller = find_iter->second;
+            controller = object->GetController();
             controller->SetRemoteClient(client);
         }
         else
@@ -239,7 +396,7 @@ public:
             controller = make_shared<ObjectController>(object, client);
             object->SetController(controller);
 
-            controlled_objects_.insert(make_pair(object->GetObjectId(), controller));
+            controlled_objects_.Insert(object);
         }
 
         auto connection_client = std::static_pointer_cast<ConnectionClient>(client);
@@ -250,14 +407,7 @@ public:
 
     void StopControllingObject(const shared_ptr<Object>& object)
     {
-        auto find_iter = controlled_objects_.find(object->GetObjectId());
-
-        if (find_iter == controlled_objects_.end())
-        {
-            return;
-        }
-
-        controlled_objects_.unsafe_erase(find_iter);
+        controlled_objects_.Remove(object->GetObjectId());
     }
 
     void RegisterControllerHandler(uint32_t handler_id, swganh::object::ObjControllerHandler&& handler)
@@ -298,7 +448,17 @@ public:
             return;
         }
 
-        find_iter->second(client->GetController(), move(message));
+        auto controller = client->GetController();
+        if (!controller)
+        {
+            return;
+        }
+
+        // Movement and every other command on the object run on its scene's thread.
+        const auto& handler = find_iter->second;
+        PostToScene(controller->GetObject()->GetSceneId(), [handler, controller, message] () mutable {
+            handler(controller, move(message));
+        });
     }
 
     void HandleSelectCharacter(
@@ -309,7 +469,7 @@ public:
 
         if (!object)
         {
-            object = LoadObjectById(message.character_id, creature::Creature::type);
+            object = LoadObjectTreeById(message.character_id, creature::Creature::type);
         }
 
         /// @TODO REFACTOR Move this functionality out to a PlayerService
@@ -350,22 +510,23 @@ public:
         client->SendTo(start_scene);
 
         // Add object to scene and send baselines
-        scene->AddObject(object);
+        PostToScene(scene->GetSceneId(), [scene, object] { scene->AddObject(object); });
     }
 
 	void SendToAll(ByteBuffer message)
 	{
-		for_each(begin(controlled_objects_), end(controlled_objects_), [=] (const pair<uint64_t, shared_ptr<ObjectController>>& pair) {
-            auto controller = pair.second;
-            controller->GetRemoteClient()->SendTo(message);
+		controlled_objects_.ForEach([&message] (const shared_ptr<Object>& object) {
+            auto controller = object->GetController();
+            if (controller)
+                controller->GetRemoteClient()->SendTo(message);
         });
 	}
 
     void SendToAllInScene(ByteBuffer message, uint32_t scene_id)
     {
-        for_each(begin(controlled_objects_), end(controlled_objects_), [=] (const pair<uint64_t, shared_ptr<ObjectController>>& pair) {
-            auto controller = pair.second;
-            if (controller->GetObject()->GetSceneId() == scene_id)
+        controlled_objects_.ForEach([&message, scene_id] (const shared_ptr<Object>& object) {
+            auto controller = object->GetController();
+            if (controller && object->GetSceneId() == scene_id)
                 controller->GetRemoteClient()->SendTo(message);
         });
     }
@@ -374,14 +535,20 @@ private:
     shared_ptr<ObjectManager> object_manager_;
     shared_ptr<SceneManager> scene_manager_;
     shared_ptr<MovementManager> movement_manager_;
+    shared_ptr<ReplicationManager> replication_manager_;
+    unique_ptr<PersistenceQueue> persistence_queue_;
     SwganhKernel* kernel_;
+
+    boost::mutex scene_tickers_mutex_;
+    map<uint32_t, shared_ptr<SceneTicker>> scene_tickers_;
 	ServerInterface* server_;
-	shared_ptr<SpatialProviderInterface> spatial_provider_;
 
     ObjControllerHandlerMap controller_handlers_;
 
-    Concurrency::concurrent_unordered_map<uint64_t, shared_ptr<Object>> loaded_objects_;
-    Concurrency::concurrent_unordered_map<uint64_t, shared_ptr<ObjectController>> controlled_objects_;
+    ObjectRegistry loaded_objects_;
+
+    // The objects a client controls, each holds its controller.
+    ObjectRegistry controlled_objects_;
 };
 
 }}  // namespace swganh::simulation
@@ -389,7 +556,10 @@ private:
 SimulationService::SimulationService(SwganhKernel* kernel)
     : impl_(new SimulationServiceImpl(kernel))
     , kernel_(kernel)
-{}
+{
+    // Once only, the message builders subscribe to the baselines events.
+    RegisterObjectFactories();
+}
 
 SimulationService::~SimulationService()
 {}
@@ -411,15 +581,38 @@ ServiceDescription SimulationService::GetServiceDescription()
 void SimulationService::StartScene(const std::string& scene_label)
 {
     impl_->GetSceneManager()->LoadSceneDescriptionsFromDatabase(kernel_->GetDatabaseManager()->getConnection("galaxy"));
-    impl_->GetSceneManager()->StartScene(scene_label);
-    // load factories
-    RegisterObjectFactories();
+    // Each scene gets its own index, scenes share coordinates but not objects.
+    auto spatial_provider = kernel_->GetPluginManager()->CreateObject<SpatialProviderInterface>("SimulationService::SpatialProvider");
+    impl_->GetSceneManager()->StartScene(scene_label, spatial_provider);
+    impl_->StartSceneTicker(impl_->GetSceneManager()->GetScene(scene_label));
 }
 
 void SimulationService::StopScene(const std::string& scene_label)
 {
+    auto scene = impl_->GetSceneManager()->GetScene(scene_label);
+    if (scene)
+    {
+        impl_->StopSceneTicker(scene);
+    }
+
     impl_->GetSceneManager()->StopScene(scene_label);
 }
+
+shared_ptr<SceneTicker> SimulationService::GetSceneTicker(const std::string& scene_label)
+{
+    auto scene = impl_->GetSceneManager()->GetScene(scene_label);
+    if (!scene)
+    {
+        return nullptr;
+    }
+
+    return impl_->GetSceneTicker(scene->GetSceneId());
+}
+
+void SimulationService::PostToScene(uint32_t scene_id, std::function<void ()> work)
+{
+    impl_->PostToScene(scene_id, move(work));
+}
 void SimulationService::RegisterObjectFactories()
 {
         auto db_manager = kernel_->GetDatabaseManager();
@@ -452,6 +645,11 @@ shared_ptr<Object> SimulationService::LoadObjectById(uint64_t object_id, uint32_
     return impl_->LoadObjectById(object_id, type);
 }
 
+shared_ptr<Object> SimulationService::LoadObjectTreeById(uint64_t object_id, uint32_t type)
+{
+    return impl_->LoadObjectTreeById(object_id, type);
+}
+
 shared_ptr<Object> SimulationService::GetObjectById(uint64_t object_id)
 {
     return impl_->GetObjectById(object_id);
@@ -467,6 +665,11 @@ void SimulationService::RemoveObject(const shared_ptr<Object>& object)
     impl_->RemoveObject(object);
 }
 
+void SimulationService::VisitObjectsOfType(uint32_t type, const ObjectVisitor& visitor)
+{
+    impl_->VisitObjectsOfType(type, visitor);
+}
+
 shared_ptr<ObjectController> SimulationService::StartControllingObject(
     const shared_ptr<Object>& object,
     shared_ptr<ConnectionClient> client)
@@ -516,4 +719,19 @@ void SimulationService::Start()
 
     RegisterControllerHandler(
         &MovementManager::HandleDataTransformWithParent, impl_->GetMovementManager());
+
+    impl_->GetReplicationManager()->Start();
+    impl_->GetPersistenceQueue();
+}
+
+void SimulationService::Stop()
+{
+    impl_->StopSceneTickers();
+
+    // Sends the pending deltas and stops deferring new ones while the objects are
+    // still around to be written.
+    impl_->GetReplicationManager()->Stop();
+
+    // Written out before the database goes away.
+    impl_->GetPersistenceQueue()->Stop();
 }
@@ -31,6 +31,8 @@ namespace object {
 namespace swganh {
 namespace simulation {
     
+    class ObjectVisitor;
+    class SceneTicker;
     class SimulationServiceImpl;
 
     class SimulationService : public anh::service::ServiceInterface
@@ -45,6 +47,18 @@ namespace simulation {
         void StartScene(const std::string& scene_label);
         void StopScene(const std::string& scene_label);
 
+        /**
+         * @return The ticker running the scene's simulation loop, or nullptr if the scene isn't running.
+         */
+        std::shared_ptr<SceneTicker> GetSceneTicker(const std::string& scene_label);
+
+        /**
+         * Queues work to run on the scene's thread during its next input phase.
+         *
+         * Runs the work immediately when the scene isn't ticking.
+         */
+        void PostToScene(uint32_t scene_id, std::function<void ()> work);
+
         void RegisterObjectFactories();
 
         void PersistObject(uint64_t object_id);
@@ -67,6 +81,15 @@ namespace simulation {
 #endif
         }
         
+        /**
+         * Loads an object together with everything it contains, at any depth,
+         * fetching the whole tree at once rather than an object at a time.
+         *
+         * @param type The object's type, used when the tree can't be fetched at once.
+         * @return The object, contents already linked into their containers.
+         */
+        std::shared_ptr<swganh::object::Object> LoadObjectTreeById(uint64_t object_id, uint32_t type);
+
         std::shared_ptr<swganh::object::Object> GetObjectById(uint64_t object_id);
 
         template<typename T>
@@ -86,6 +109,14 @@ namespace simulation {
          */
         void RemoveObjectById(uint64_t object_id);
         void RemoveObject(const std::shared_ptr<swganh::object::Object>& object);
+
+        /**
+         * Invokes the visitor for every loaded object of the given type, e.g. to
+         * regenerate every creature each tick.
+         *
+         * @param type The type as returned by Object::GetType, e.g. Creature::type.
+         */
+        void VisitObjectsOfType(uint32_t type, const ObjectVisitor& visitor);
         
         std::shared_ptr<swganh::object::ObjectController> StartControllingObject(
             const std::shared_ptr<swganh::object::Object>& object,
@@ -181,6 +212,7 @@ namespace simulation {
         }
 
         void Start();
+        void Stop();
 
     private:
 
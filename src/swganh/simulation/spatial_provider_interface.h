@@ -6,6 +6,7 @@
 
 #include <vector>
 #include <memory>
+#include <type_traits>
 
 #include <boost/geometry/geometries/box.hpp>
 #include <boost/geometry/geometries/point_xy.hpp>
@@ -26,6 +27,38 @@ namespace object {
 namespace swganh {
 namespace simulation {
 
+/**
+ * A non-owning reference to a callable invoked once per object found by a spatial query.
+ *
+ * Unlike std::function this never allocates; the referenced callable must outlive the
+ * query it is passed to, which is always the case for a lambda passed in directly.
+ */
+class ObjectVisitor
+{
+public:
+	template<typename Callable>
+	ObjectVisitor(Callable&& callable,
+		typename std::enable_if<!std::is_same<typename std::decay<Callable>::type, ObjectVisitor>::value>::type* = nullptr)
+		: callable_(const_cast<void*>(static_cast<const void*>(std::addressof(callable))))
+		, invoke_(&Invoke_<typename std::remove_reference<Callable>::type>)
+	{}
+
+	void operator()(const std::shared_ptr<swganh::object::Object>& object) const
+	{
+		invoke_(callable_, object);
+	}
+
+private:
+	template<typename Callable>
+	static void Invoke_(void* callable, const std::shared_ptr<swganh::object::Object>& object)
+	{
+		(*static_cast<Callable*>(callable))(object);
+	}
+
+	void* callable_;
+	void (*invoke_)(void*, const std::shared_ptr<swganh::object::Object>&);
+};
+
 /**
  * Provides Spatial Indexing functionality.
  */
@@ -39,7 +72,30 @@ public:
 	virtual void RemoveObject(std::shared_ptr<swganh::object::Object> obj) = 0;
 	virtual void UpdateObject(std::shared_ptr<swganh::object::Object> obj, glm::vec3 old_position, glm::vec3 new_position) = 0;
 
+	/**
+	 * Returns the objects within range of point, measured on the x/z plane.
+	 */
 	virtual std::vector<std::shared_ptr<swganh::object::Object>> GetObjectsInRange(glm::vec3 point, float range) = 0;
+
+	/**
+	 * Returns the objects whose x/z position lies within the box spanned by min and max.
+	 */
+	virtual std::vector<std::shared_ptr<swganh::object::Object>> GetObjectsInBox(glm::vec3 min, glm::vec3 max) = 0;
+
+	/**
+	 * Calls visitor with each object within range of point, measured on the x/z plane.
+	 *
+	 * Prefer this over GetObjectsInRange on hot paths, it neither allocates nor copies the
+	 * object handles. The index must not be modified from within the visitor.
+	 */
+	virtual void VisitObjectsInRange(glm::vec3 point, float range, const ObjectVisitor& visitor) = 0;
+
+	/**
+	 * Calls visitor with each object whose x/z position lies within the box spanned by min and max.
+	 *
+	 * The index must not be modified from within the visitor.
+	 */
+	virtual void VisitObjectsInBox(glm::vec3 min, glm::vec3 max, const ObjectVisitor& visitor) = 0;
 };
 
 }} // namespace swganh::simulation